@@ -0,0 +1,90 @@
+// benchmarks/BVHBenchmark.cpp
+
+#include "Benchmark.h"
+#include "BVH.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <string>
+
+namespace {
+
+    // Same distribution as the culling benchmark so the two are comparable
+    std::vector<AABB> MakeScene(size_t count) {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+        std::uniform_real_distribution<float> size(0.25f, 4.0f);
+        std::vector<AABB> bounds(count);
+        for (AABB& box : bounds) {
+            glm::vec3 center(position(rng), position(rng), position(rng));
+            glm::vec3 extents(size(rng), size(rng), size(rng));
+            box.Min = center - extents;
+            box.Max = center + extents;
+        }
+        return bounds;
+    }
+
+    void RunBVH(size_t count) {
+        std::vector<AABB> bounds = MakeScene(count);
+        const std::string suffix = ", " + std::to_string(count / 1000) + "k objects";
+        BVH bvh;
+
+        Benchmark::Measure("build" + suffix, 3, [&]() { bvh.Build(bounds); }, 1, double(count));
+        const BVH::Stats& stats = bvh.GetStats();
+        std::printf("  %u nodes, %u leaves, depth %u, SAH cost %.1f\n", stats.NodeCount, stats.LeafCount, stats.MaxDepth, stats.BuildCost);
+
+        // Small jitter per refit, like objects drifting between frames
+        std::mt19937 rng(99);
+        std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+        std::vector<AABB> moved = bounds;
+        Benchmark::Measure("refit" + suffix, 10, [&]() {
+            for (AABB& box : moved) {
+                glm::vec3 offset(jitter(rng), jitter(rng), jitter(rng));
+                box.Min += offset;
+                box.Max += offset;
+            }
+            bvh.Refit(moved);
+        }, 1, double(count));
+        std::printf("  SAH degradation after refits: x%.2f\n", bvh.GetDegradation());
+        bvh.Build(bounds);
+
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::mat4 projection = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 0.1f, 1000.0f);
+        Frustum frustum = Frustum::FromMatrix(projection * view);
+        std::vector<uint32_t> results;
+        Benchmark::Measure("frustum query" + suffix, 20, [&]() {
+            results.clear();
+            bvh.QueryFrustum(frustum, results);
+            Benchmark::DoNotOptimize(results);
+        }, 2, double(count));
+        std::printf("  visible: %zu of %zu\n", results.size(), count);
+
+        const int rayCount = 10000;
+        std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+        std::vector<glm::vec3> directions(rayCount);
+        for (glm::vec3& d : directions) d = glm::vec3(direction(rng), direction(rng), direction(rng));
+        size_t hits = 0;
+        Benchmark::Measure("raycast x" + std::to_string(rayCount) + suffix, 5, [&]() {
+            hits = 0;
+            for (const glm::vec3& d : directions) hits += bvh.Raycast(glm::vec3(0.0f), d).IsValid() ? 1 : 0;
+            Benchmark::DoNotOptimize(hits);
+        }, 1, double(rayCount));
+        std::printf("  rays hit: %zu of %d\n", hits, rayCount);
+
+        const int sphereCount = 1000;
+        std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+        std::vector<glm::vec3> centers(sphereCount);
+        for (glm::vec3& c : centers) c = glm::vec3(position(rng), position(rng), position(rng));
+        Benchmark::Measure("sphere query r=25 x" + std::to_string(sphereCount) + suffix, 5, [&]() {
+            results.clear();
+            for (const glm::vec3& c : centers) bvh.QuerySphere(c, 25.0f, results);
+            Benchmark::DoNotOptimize(results);
+        }, 1, double(sphereCount));
+    }
+
+} // namespace
+
+BENCHMARK(BVHQueries) {
+    RunBVH(100000);
+    RunBVH(1000000);
+}
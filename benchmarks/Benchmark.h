@@ -0,0 +1,87 @@
+// benchmarks/Benchmark.h
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Minimal harness for the CPU-side engine systems: every benchmark registers itself
+// with BENCHMARK(Name) and reports through Benchmark::Measure.
+namespace Benchmark {
+
+    struct Result {
+        double MinMs = 0.0;
+        double MedianMs = 0.0;
+        double MeanMs = 0.0;
+    };
+
+    // Runs fn 'iterations' times after 'warmup' untimed runs and prints one line.
+    inline Result Measure(const std::string& label, int iterations, const std::function<void()>& fn, int warmup = 2, double itemsPerRun = 0.0) {
+        for (int i = 0; i < warmup; ++i) fn();
+        std::vector<double> samples;
+        samples.reserve(iterations);
+        for (int i = 0; i < iterations; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            samples.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::sort(samples.begin(), samples.end());
+        Result result;
+        result.MinMs = samples.front();
+        result.MedianMs = samples[samples.size() / 2];
+        for (double s : samples) result.MeanMs += s;
+        result.MeanMs /= samples.size();
+
+        if (itemsPerRun > 0.0) {
+            std::printf("  %-44s min %9.3f ms  median %9.3f ms  mean %9.3f ms  %8.1f M items/s\n", label.c_str(),
+                        result.MinMs, result.MedianMs, result.MeanMs, itemsPerRun / (result.MedianMs * 1000.0));
+        } else {
+            std::printf("  %-44s min %9.3f ms  median %9.3f ms  mean %9.3f ms\n", label.c_str(),
+                        result.MinMs, result.MedianMs, result.MeanMs);
+        }
+        return result;
+    }
+
+    struct Entry {
+        const char* Name;
+        void (*Run)();
+    };
+
+    inline std::vector<Entry>& Registry() {
+        static std::vector<Entry> entries;
+        return entries;
+    }
+
+    struct Registrar {
+        Registrar(const char* name, void (*run)()) { Registry().push_back({ name, run }); }
+    };
+
+    // Keeps results observable so the optimizer can't drop the work: the compiler has to assume
+    // the value's memory is read here.
+    template <typename T>
+    inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        // No inline asm on MSVC x64: a volatile read of the value, and no reordering across it
+        (void)*reinterpret_cast<const volatile char*>(&value);
+        _ReadWriteBarrier();
+#endif
+    }
+
+} // namespace Benchmark
+
+#define BENCHMARK(Name) \
+    static void Name(); \
+    static Benchmark::Registrar Name##_registrar(#Name, &Name); \
+    static void Name()
+
+#endif // BENCHMARK_H
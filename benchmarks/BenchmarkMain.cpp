@@ -0,0 +1,23 @@
+// benchmarks/BenchmarkMain.cpp
+// Usage: EngineBenchmarks [filter]   (runs every benchmark whose name contains 'filter')
+
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <cstring>
+
+int main(int argc, char* argv[]) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    int ran = 0;
+    for (const Benchmark::Entry& entry : Benchmark::Registry()) {
+        if (filter && std::strstr(entry.Name, filter) == nullptr) continue;
+        std::printf("[%s]\n", entry.Name);
+        entry.Run();
+        ++ran;
+    }
+    if (ran == 0) {
+        std::printf("No benchmarks matched '%s'.\n", filter ? filter : "");
+        return 1;
+    }
+    return 0;
+}
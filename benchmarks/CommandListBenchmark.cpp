@@ -0,0 +1,76 @@
+// benchmarks/CommandListBenchmark.cpp
+
+#include "Benchmark.h"
+#include "CommandList.h"
+#include "JobSystem.h"
+
+#include <random>
+#include <string>
+
+namespace {
+
+    struct FakeObject {
+        glm::mat4 Model;
+        glm::vec3 Center;
+        uint32_t Material;
+    };
+
+    std::vector<FakeObject> MakeObjects(size_t count) {
+        std::mt19937 rng(21);
+        std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+        std::vector<FakeObject> objects(count);
+        for (FakeObject& object : objects) {
+            object.Center = glm::vec3(position(rng), position(rng), position(rng));
+            object.Model = glm::mat4(1.0f);
+            object.Model[3] = glm::vec4(object.Center, 1.0f);
+            object.Material = rng() % 64;
+        }
+        return objects;
+    }
+
+    void RunRecording(size_t count, JobSystem& jobs) {
+        std::vector<FakeObject> objects = MakeObjects(count);
+        const glm::mat4 viewProjection(1.0f);
+        const glm::vec3 camera(0.0f);
+        CommandQueue queue;
+        auto record = [&](size_t begin, size_t end, unsigned int workerIndex) {
+            CommandList& list = queue.GetList(workerIndex);
+            for (size_t i = begin; i < end; ++i) {
+                const FakeObject& object = objects[i];
+                const float depth = glm::length(object.Center - camera) / 100.0f;
+                list.Draw(SortKey::Make(0, object.Material, depth, static_cast<uint32_t>(i)), nullptr, nullptr,
+                          DrawUniforms{ object.Model, viewProjection * object.Model });
+            }
+        };
+        const std::string suffix = ", " + std::to_string(count / 1000) + "k draws";
+
+        Benchmark::Measure("record, 1 thread" + suffix, 10, [&]() {
+            queue.BeginFrame(1);
+            record(0, count, 0);
+        }, 2, double(count));
+        Benchmark::Measure("record, " + std::to_string(jobs.GetWorkerCount()) + " worker(s)" + suffix, 10, [&]() {
+            queue.BeginFrame(jobs.GetWorkerCount());
+            jobs.ParallelFor(count, 256, record);
+        }, 2, double(count));
+        Benchmark::Measure("merge + radix sort" + suffix, 10, [&]() {
+            queue.Merge();
+        }, 2, double(count));
+        std::printf("  %u packets from %u list(s)\n", queue.GetLastStats().Packets, queue.GetLastStats().ListsUsed);
+
+        size_t replayed = 0;
+        Benchmark::Measure("replay walk (no GL)" + suffix, 10, [&]() {
+            replayed = 0;
+            queue.Replay(0, [&](const DrawPacket& packet, const DrawUniforms& uniforms) {
+                replayed += packet.UniformIndex + static_cast<size_t>(uniforms.MVP[3][0] != 0.0f);
+            });
+            Benchmark::DoNotOptimize(replayed);
+        }, 2, double(count));
+    }
+
+} // namespace
+
+BENCHMARK(CommandLists) {
+    JobSystem jobs;
+    RunRecording(10000, jobs);
+    RunRecording(100000, jobs);
+}
@@ -0,0 +1,57 @@
+// benchmarks/CullingBenchmark.cpp
+
+#include "Benchmark.h"
+#include "FrustumCuller.h"
+#include "JobSystem.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <string>
+
+namespace {
+
+    // Objects scattered through a 1 km cube; the camera sees a few percent of them
+    void FillScene(FrustumCuller& culler, size_t count) {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+        std::uniform_real_distribution<float> size(0.25f, 4.0f);
+        culler.Clear();
+        culler.Reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            glm::vec3 center(position(rng), position(rng), position(rng));
+            glm::vec3 extents(size(rng), size(rng), size(rng));
+            AABB box;
+            box.Min = center - extents;
+            box.Max = center + extents;
+            culler.Add(box);
+        }
+    }
+
+    Frustum MakeCameraFrustum() {
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::mat4 projection = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 0.1f, 1000.0f);
+        return Frustum::FromMatrix(projection * view);
+    }
+
+    void RunCulling(size_t count, JobSystem& jobs) {
+        FrustumCuller culler;
+        FillScene(culler, count);
+        Frustum frustum = MakeCameraFrustum();
+        std::vector<uint32_t> visible;
+        const std::string suffix = std::to_string(count / 1000) + "k objects";
+
+        Benchmark::Measure(std::string("single-thread ") + FrustumCuller::GetSimdPathName() + ", " + suffix, 20,
+                           [&]() { culler.Cull(frustum, visible); Benchmark::DoNotOptimize(visible); }, 2, double(count));
+        size_t visibleCount = visible.size();
+        Benchmark::Measure("parallel x" + std::to_string(jobs.GetWorkerCount()) + ", " + suffix, 20,
+                           [&]() { culler.Cull(frustum, visible, &jobs); Benchmark::DoNotOptimize(visible); }, 2, double(count));
+        std::printf("  visible: %zu of %zu\n", visibleCount, count);
+    }
+
+} // namespace
+
+BENCHMARK(FrustumCulling) {
+    JobSystem jobs;
+    RunCulling(100000, jobs);
+    RunCulling(1000000, jobs);
+}
@@ -0,0 +1,87 @@
+// benchmarks/ECSBenchmark.cpp
+
+#include "Benchmark.h"
+#include "ECS.h"
+#include "JobSystem.h"
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <random>
+#include <string>
+
+namespace {
+
+    struct Position { glm::vec3 Value; };
+    struct Velocity { glm::vec3 Value; };
+    struct Health { float Value; };
+    struct Frozen { uint8_t Unused; };
+
+    const size_t ENTITY_COUNT = 1000000;
+
+    // Half the entities also carry Health, so queries span two archetypes
+    std::vector<Entity> Populate(World& world, size_t count) {
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+        std::vector<Entity> entities;
+        entities.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            Position position{ glm::vec3(value(rng), value(rng), value(rng)) };
+            Velocity velocity{ glm::vec3(value(rng), value(rng), value(rng)) };
+            entities.push_back((i & 1) ? world.CreateEntity(position, velocity, Health{ 100.0f }) : world.CreateEntity(position, velocity));
+        }
+        return entities;
+    }
+
+    void Integrate(const ChunkView& chunk) {
+        Position* positions = chunk.Get<Position>();
+        const Velocity* velocities = chunk.Get<Velocity>();
+        for (size_t i = 0; i < chunk.Size(); ++i) positions[i].Value += velocities[i].Value * (1.0f / 60.0f);
+    }
+
+} // namespace
+
+BENCHMARK(ECSIteration) {
+    World world;
+    Populate(world, ENTITY_COUNT);
+    Query moving = world.CreateQuery<Position, Velocity>();
+    std::printf("  %zu entities, %zu archetypes, %zu chunks\n", world.GetEntityCount(), world.GetArchetypeCount(), world.GetChunkCount());
+
+    Benchmark::Measure("position += velocity, serial, 1M", 20, [&]() {
+        world.ForEachChunk(moving, Integrate);
+    }, 2, double(ENTITY_COUNT));
+
+    JobSystem jobs;
+    Benchmark::Measure("position += velocity, " + std::to_string(jobs.GetWorkerCount()) + " worker(s), 1M", 20, [&]() {
+        world.ForEachChunkParallel(moving, &jobs, Integrate);
+    }, 2, double(ENTITY_COUNT));
+
+    // Random access through entity handles, for comparison with linear chunk walks
+    std::vector<Entity> entities;
+    world.ForEachChunk(moving, [&](const ChunkView& chunk) { entities.insert(entities.end(), chunk.GetEntities(), chunk.GetEntities() + chunk.Size()); });
+    std::shuffle(entities.begin(), entities.end(), std::mt19937(9));
+    Benchmark::Measure("GetComponent in random order, 1M", 5, [&]() {
+        for (Entity entity : entities) {
+            world.GetComponent<Position>(entity)->Value += world.GetComponent<Velocity>(entity)->Value * (1.0f / 60.0f);
+        }
+    }, 1, double(ENTITY_COUNT));
+}
+
+BENCHMARK(ECSStructuralChanges) {
+    World world;
+    std::vector<Entity> entities;
+    Benchmark::Measure("create 1M (2 archetypes)", 3, [&]() {
+        world.Clear();
+        entities = Populate(world, ENTITY_COUNT);
+    }, 1, double(ENTITY_COUNT));
+
+    // Each entity moves to the tagged archetype and back (two moves per entity)
+    Benchmark::Measure("add + remove tag, 1M", 3, [&]() {
+        for (Entity entity : entities) world.AddComponent(entity, Frozen{});
+        for (Entity entity : entities) world.RemoveComponent<Frozen>(entity);
+    }, 1, double(ENTITY_COUNT) * 2.0);
+
+    Benchmark::Measure("destroy 1M + recreate", 3, [&]() {
+        for (Entity entity : entities) world.DestroyEntity(entity);
+        entities = Populate(world, ENTITY_COUNT);
+    }, 1, double(ENTITY_COUNT) * 2.0);
+}
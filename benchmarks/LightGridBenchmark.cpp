@@ -0,0 +1,57 @@
+// benchmarks/LightGridBenchmark.cpp
+
+#include "Benchmark.h"
+#include "LightGrid.h"
+#include "JobSystem.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <string>
+
+namespace {
+
+    // Lights scattered in front of the camera, a quarter of them spots
+    std::vector<Light> MakeLights(size_t count) {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> lateral(-8.0f, 8.0f);
+        std::uniform_real_distribution<float> depth(-30.0f, 0.0f);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::vector<Light> lights(count);
+        for (Light& light : lights) {
+            light.Position = glm::vec3(lateral(rng), lateral(rng) * 0.5f, depth(rng));
+            light.Range = 1.0f + 2.0f * unit(rng);
+            if (unit(rng) < 0.25f) {
+                light.SpotOuterCos = 0.8f;
+                light.SpotInnerCos = 0.9f;
+            }
+        }
+        return lights;
+    }
+
+    void RunBinning(size_t count, JobSystem& jobs) {
+        std::vector<Light> lights = MakeLights(count);
+        const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 3.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        const glm::mat4 projection = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 0.1f, 100.0f);
+        const std::string suffix = ", " + std::to_string(count) + " lights";
+        LightGrid grid;
+        ClusteredLightData data;
+
+        Benchmark::Measure("bin, 1 thread" + suffix, 20, [&]() {
+            grid.Build(view, projection, lights, data);
+        }, 2, double(count));
+        Benchmark::Measure("bin, " + std::to_string(jobs.GetWorkerCount()) + " worker(s)" + suffix, 20, [&]() {
+            grid.Build(view, projection, lights, data, &jobs);
+        }, 2, double(count));
+        const LightGrid::Stats& stats = grid.GetLastStats();
+        std::printf("  %u visible, %u assignments, max %u per cluster, %u of %u clusters used\n", stats.VisibleLights,
+                    stats.Assignments, stats.MaxPerCluster, stats.OccupiedClusters, grid.GetClusterCount());
+    }
+
+} // namespace
+
+BENCHMARK(LightGrid) {
+    JobSystem jobs;
+    RunBinning(10, jobs);
+    RunBinning(100, jobs);
+    RunBinning(1000, jobs);
+}
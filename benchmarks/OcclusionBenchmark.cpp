@@ -0,0 +1,103 @@
+// benchmarks/OcclusionBenchmark.cpp
+
+#include "Benchmark.h"
+#include "FrustumCuller.h"
+#include "JobSystem.h"
+#include "OcclusionCuller.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <string>
+
+namespace {
+
+    // Unit cube as raw vertices, so walls go through the same simplification path as imported meshes
+    void MakeCube(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+        vertices.clear();
+        for (int i = 0; i < 8; ++i) {
+            Vertex v{};
+            v.Position[0] = (i & 1) ? 0.5f : -0.5f;
+            v.Position[1] = (i & 2) ? 0.5f : -0.5f;
+            v.Position[2] = (i & 4) ? 0.5f : -0.5f;
+            vertices.push_back(v);
+        }
+        indices = { 0, 1, 3, 0, 3, 2,  4, 6, 7, 4, 7, 5,  0, 4, 5, 0, 5, 1,
+                    2, 3, 7, 2, 7, 6,  0, 2, 6, 0, 6, 4,  1, 5, 7, 1, 7, 3 };
+    }
+
+    struct Hallway {
+        std::vector<glm::mat4> Walls;
+        std::vector<AABB> Props;
+    };
+
+    // An L-shaped corridor: 4 m wide, running 60 m down -z then 60 m along +x, with
+    // props scattered over the whole 200 m square the building sits in
+    Hallway MakeHallway(size_t propCount) {
+        Hallway scene;
+        auto wall = [&](glm::vec3 center, glm::vec3 size) {
+            scene.Walls.push_back(glm::scale(glm::translate(glm::mat4(1.0f), center), size));
+        };
+        wall(glm::vec3(-2.5f, 2.0f, -30.0f), glm::vec3(1.0f, 4.0f, 62.0f)); // Left of first leg
+        wall(glm::vec3(2.5f, 2.0f, -28.0f), glm::vec3(1.0f, 4.0f, 54.0f));  // Right of first leg, open at the corner
+        wall(glm::vec3(30.0f, 2.0f, -61.5f), glm::vec3(62.0f, 4.0f, 1.0f)); // Far side of second leg
+        wall(glm::vec3(33.0f, 2.0f, -56.5f), glm::vec3(56.0f, 4.0f, 1.0f)); // Near side of second leg
+
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> size(0.25f, 1.0f);
+        scene.Props.resize(propCount);
+        for (AABB& box : scene.Props) {
+            glm::vec3 center(position(rng), size(rng), position(rng) - 50.0f);
+            glm::vec3 extents(size(rng));
+            box.Min = center - extents;
+            box.Max = center + extents;
+        }
+        return scene;
+    }
+
+    void RunOcclusion(size_t propCount, JobSystem& jobs) {
+        Hallway scene = MakeHallway(propCount);
+        std::vector<Vertex> cubeVertices;
+        std::vector<unsigned int> cubeIndices;
+        MakeCube(cubeVertices, cubeIndices);
+
+        OcclusionCuller occlusion;
+        occlusion.Initialize(320, 240);
+        uint32_t cube = occlusion.AddOccluderMesh(OcclusionCuller::SimplifyOccluder(cubeVertices, cubeIndices));
+
+        FrustumCuller frustumCuller;
+        frustumCuller.Reserve(scene.Props.size());
+        for (const AABB& box : scene.Props) frustumCuller.Add(box);
+
+        // Standing at the start of the corridor, looking down it
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 1.7f, 0.0f), glm::vec3(0.0f, 1.7f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::mat4 projection = glm::perspective(glm::radians(60.0f), 800.0f / 600.0f, 0.1f, 300.0f);
+        glm::mat4 viewProjection = projection * view;
+        std::vector<uint32_t> frustumVisible;
+        frustumCuller.Cull(Frustum::FromMatrix(viewProjection), frustumVisible, &jobs);
+
+        const std::string suffix = ", " + std::to_string(propCount / 1000) + "k props";
+        std::vector<uint32_t> visible;
+        auto runFrame = [&](JobSystem* frameJobs) {
+            occlusion.BeginFrame(viewProjection);
+            for (const glm::mat4& wall : scene.Walls) occlusion.SubmitOccluder(cube, wall);
+            occlusion.RasterizeOccluders(frameJobs);
+            visible = frustumVisible;
+            occlusion.CullOccludees(scene.Props, visible, frameJobs);
+            Benchmark::DoNotOptimize(visible);
+        };
+        Benchmark::Measure("raster + test, single-thread" + suffix, 20, [&]() { runFrame(nullptr); }, 2, double(frustumVisible.size()));
+        Benchmark::Measure("raster + test, parallel x" + std::to_string(jobs.GetWorkerCount()) + suffix, 20, [&]() { runFrame(&jobs); }, 2, double(frustumVisible.size()));
+
+        const OcclusionCuller::Stats& stats = occlusion.GetLastStats();
+        std::printf("  in frustum: %zu of %zu, occlusion rejected %u (%.1f%%), raster %.3f ms, test %.3f ms\n",
+                    frustumVisible.size(), propCount, stats.Rejected, stats.GetRejectedPercent(), stats.RasterMilliseconds, stats.TestMilliseconds);
+    }
+
+} // namespace
+
+BENCHMARK(OcclusionCulling) {
+    JobSystem jobs;
+    RunOcclusion(10000, jobs);
+    RunOcclusion(100000, jobs);
+}
@@ -0,0 +1,67 @@
+// benchmarks/TransformBenchmark.cpp
+
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include "TransformSystem.h"
+
+#include <random>
+#include <string>
+
+namespace {
+
+    // Forest of 'roots' trees with a fixed fanout, created breadth-first per tree, roughly 'count' nodes in total
+    std::vector<TransformHandle> MakeHierarchy(TransformSystem& transforms, size_t count, size_t roots, size_t fanout) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+        std::vector<TransformHandle> handles;
+        handles.reserve(count);
+        for (size_t r = 0; r < roots; ++r) handles.push_back(transforms.Create());
+        for (size_t parent = 0; handles.size() < count; ++parent) {
+            for (size_t c = 0; c < fanout && handles.size() < count; ++c) {
+                TransformHandle handle = transforms.Create(handles[parent]);
+                transforms.SetLocal(handle, glm::vec3(offset(rng), offset(rng), offset(rng)),
+                                    glm::angleAxis(offset(rng), glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(1.0f));
+                handles.push_back(handle);
+            }
+        }
+        return handles;
+    }
+
+    void RunTransforms(size_t count, JobSystem* jobs) {
+        TransformSystem transforms;
+        std::vector<TransformHandle> handles = MakeHierarchy(transforms, count, 100, 4);
+        transforms.Update(jobs); // Sort once so the timed runs measure steady-state updates
+        const std::string suffix = std::string(jobs ? ", parallel" : ", serial") + ", " + std::to_string(count / 1000) + "k nodes";
+
+        Benchmark::Measure("all dirty" + suffix, 10, [&]() {
+            for (TransformHandle handle : handles) transforms.SetLocalScale(handle, glm::vec3(1.0f));
+            transforms.Update(jobs);
+        }, 2, double(count));
+        const TransformSystem::Stats& stats = transforms.GetLastStats();
+        std::printf("  %u levels\n", stats.Levels);
+
+        // 1% of nodes move each frame; their subtrees come along
+        std::mt19937 rng(7);
+        std::vector<TransformHandle> moving;
+        for (size_t i = 0; i < count / 100; ++i) moving.push_back(handles[rng() % handles.size()]);
+        float angle = 0.0f;
+        Benchmark::Measure("1% dirty" + suffix, 20, [&]() {
+            angle += 0.01f;
+            for (TransformHandle handle : moving) transforms.SetLocalRotation(handle, glm::angleAxis(angle, glm::vec3(0.0f, 1.0f, 0.0f)));
+            transforms.Update(jobs);
+        }, 2, double(count));
+        std::printf("  recomputed %u, skipped %u\n", transforms.GetLastStats().Recomputed, transforms.GetLastStats().Skipped);
+
+        Benchmark::Measure("nothing dirty" + suffix, 20, [&]() { transforms.Update(jobs); }, 2, double(count));
+    }
+
+} // namespace
+
+BENCHMARK(TransformHierarchy) {
+    JobSystem jobs;
+    std::printf("  %u worker(s)\n", jobs.GetWorkerCount());
+    RunTransforms(100000, nullptr);
+    RunTransforms(100000, &jobs);
+    RunTransforms(1000000, nullptr);
+    RunTransforms(1000000, &jobs);
+}
@@ -0,0 +1,54 @@
+// include/AppConfig.h
+#ifndef APPCONFIG_H
+#define APPCONFIG_H
+
+#include "FramePacer.h"
+#include "CaptureWriter.h"
+#include <string>
+
+// Startup options, parsed from the command line in main().
+struct AppConfig {
+    bool RenderThread = false; // --render-thread: GL submission on its own thread, overlapping the next simulation frame
+
+    // Headless mode (--headless): hidden window, rendering into an offscreen framebuffer. On Linux
+    // without a display server SDL's "offscreen" video driver (EGL pbuffer) is used.
+    bool Headless = false;
+    int Width = 800;            // --size WxH: framebuffer size (window size when not headless)
+    int Height = 600;
+    int FrameCount = 0;         // --frames N: quit after N frames (0 = until the window closes / SIGINT)
+    std::string OutputDir;      // --output DIR: write rendered frames there (asynchronous readback)
+    int CaptureInterval = 1;    // --capture-every N: only every Nth frame to --output
+    CaptureFormat OutputFormat = CaptureFormat::PPM; // --capture-format ppm|png|y4m
+    std::string StatsPath;      // --stats FILE: per-frame timings as CSV, written on exit
+    bool DepthPrepass = false;  // --depth-prepass: start with the depth pre-pass on (toggleable in the overlay)
+    bool Shadows = true;        // --no-shadows: start with cascaded shadow maps off
+    bool ShadowCache = true;    // --no-shadow-cache: redraw static casters into every cascade every frame
+    int LightCount = 0;         // --lights N: clustered point/spot lights orbiting the scene (adjustable in the overlay)
+    PacingMode Pacing = PacingMode::VSync; // --pacing vsync|adaptive|uncapped|limit (headless and benchmarks run uncapped)
+    int FpsLimit = 60;          // --fps-limit N: rate of PacingMode::Limited; implies --pacing limit
+    int SimulationRate = 60;    // --sim-rate HZ: fixed simulation steps per second, independent of the frame rate
+    int MaxSimulationSteps = 6; // --max-sim-steps N: catch-up limit per frame; time beyond it is dropped
+    bool DeformingMesh = false; // --deforming-mesh: a rippling sheet under the model, rewritten every frame as a dynamic mesh
+
+    // Dynamic resolution (--dynamic-resolution MS): the scene renders offscreen at a scale that
+    // keeps its GPU time under MS milliseconds, then is upscaled under the native-resolution UI.
+    bool DynamicResolution = false;
+    float GpuBudgetMilliseconds = 16.0f;
+    float MinResolutionScale = 0.5f; // --resolution-scale MIN:MAX, per axis
+    float MaxResolutionScale = 1.0f;
+    bool SharpenUpscale = true;      // --upscale bilinear|sharpen
+
+    // Benchmark mode (--benchmark N): the camera follows a path instead of input, the simulation
+    // steps at a fixed rate, and after the warm-up N frames are measured. Pacing is uncapped.
+    int BenchmarkFrames = 0;
+    int WarmupFrames = 120;     // --warmup N: frames run before measuring starts
+    int FixedFps = 60;          // --fixed-fps N: simulated timestep is 1/N seconds
+    std::string CameraPathFile; // --camera-path FILE: path to replay (default: an orbit around the scene)
+    std::string ReportPath = "benchmark"; // --report NAME: writes NAME.json and NAME.csv
+    std::string RecordPathFile; // --record-path FILE: record the live camera as a path, saved on exit
+
+    // Fills 'out' from argv. Prints usage and returns false on an unknown or malformed argument.
+    static bool Parse(int argc, char* argv[], AppConfig& out);
+};
+
+#endif // APPCONFIG_H
@@ -7,11 +7,45 @@
 
 // Include new class headers
 #include "Mesh.h"
-#include "Texture.h"
+#include "FrustumCuller.h"
+#include "BVH.h"
+#include "OcclusionCuller.h"
+#include "TransformSystem.h"
+#include "ECS.h"
+#include "SystemScheduler.h"
+#include "SceneSystems.h"
+#include "CommandList.h"
+#include "AppConfig.h"
+#include "FrameSnapshot.h"
+#include "TripleBuffer.h"
+#include "Profiler.h"
+#include "CameraPath.h"
+#include "LightGrid.h"
+#include "ShadowCascades.h"
+#include "ResolutionScaler.h"
+#include "FramePacer.h"
+#include "FixedTimestep.h"
+#include "RenderGraph.h"
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 // Forward declarations
 class Renderer;
 class Shader;
+class GeometryBuffer;
+class JobSystem;
+class OcclusionQueries;
+class GpuProfiler;
+class ClusteredLighting;
+class ShadowMaps;
+class ShaderVariants;
+class MaterialLibrary;
+class DynamicResolution;
+class FrameCapture;
+class CaptureWriter;
+class RenderGraphExecutor;
 // Removed forward decl for Vertex as we use Mesh now
 typedef struct Mix_Chunk Mix_Chunk;
 
@@ -26,7 +60,7 @@ public:
     Application();
     ~Application();
 
-    bool Initialize();
+    bool Initialize(const AppConfig& config = AppConfig());
     void Run();
     void Shutdown();
 
@@ -39,19 +73,136 @@ private:
     void ProcessEvents();
     void HandleKeyboardInput(const Uint8* keyboardState, float deltaTime);
     void HandleMouseInput(float xoffset, float yoffset);
+    void UpdateCameraFront();                 // From m_CameraYaw/m_CameraPitch
     void Update(float deltaTime);
     void Render();
+    void BuildFrame(FrameSnapshot& frame);   // Main thread: culling, packet recording, UI; no GL calls
+    void SubmitFrame(FrameSnapshot& frame, double waitMilliseconds); // GL thread: replays a snapshot and presents
+    bool StartRenderThread();
+    void StopRenderThread();
+    void RenderThreadMain();
+    bool WriteFrameStats() const;             // --stats CSV, after the GL thread has stopped
+    bool IsCollectingFrameTimings() const { return !m_Config.StatsPath.empty() || m_Config.BenchmarkFrames > 0; }
+    bool WriteBenchmarkReport() const;        // --benchmark results over the measured frames
     void RenderUI();
+    void RenderStatsOverlay();
+    void RenderGpuProfilerPanel();
+#ifdef ENGINE_ENABLE_PROFILER
+    void RenderProfilerPanel();
+#endif
+    glm::mat4 GetViewMatrix() const;
+    glm::mat4 GetProjectionMatrix() const;
+    void UpdateSceneBounds();
+    void PickObject(int mouseX, int mouseY);
+    void RequestMusic(AudioRequest request);
+    void SetLightCount(int count);            // Creates or destroys orbiting light entities
+    bool CreateStaticScene(const MeshRenderer& prop); // Ground plane plus static copies of 'prop', all shadow casters that never move
+    bool CreateDeformingMesh();               // --deforming-mesh: a dynamic sheet under the model
+    void DeformSheet(double time);            // Fills m_DeformingVertices with the ripple at 'time'
+    void UpdateDeformingMesh(double time);    // GL thread: rewrites and commits the sheet
+    glm::vec3 GetSunDirection() const;
+    void BuildShadowDraws(FrameSnapshot& frame); // Main thread: cascade fits and culled casters
+    void RenderShadowPass(const FrameSnapshot& frame); // GL thread
 
     // --- Core Components ---
     SDL_Window* m_Window = nullptr;
     std::unique_ptr<Renderer> m_Renderer;
+    std::unique_ptr<GeometryBuffer> m_GeometryBuffer; // Shared VBO/EBO/VAO for all meshes
+    std::unique_ptr<JobSystem> m_JobSystem;           // Worker pool for parallel CPU work
+    AppConfig m_Config;
+
+    // --- Frame Pipeline ---
+    // The main thread builds snapshots, the GL thread (render thread, or the main thread itself
+    // without --render-thread) draws them in order.
+    TripleBuffer<FrameSnapshot> m_Frames;
+    uint64_t m_FrameIndex = 0;
+    std::thread m_RenderThread;               // Owns the GL context while running
+    std::mutex m_RenderStatsMutex;
+    RenderThreadStats m_RenderStats;          // Written by the GL thread under m_RenderStatsMutex
+    double m_BuildMilliseconds = 0.0;         // Main thread: last BuildFrame
+    double m_FrameWaitMilliseconds = 0.0;     // Main thread: blocked waiting for a free snapshot slot
+    std::unique_ptr<GpuProfiler> m_GpuProfiler; // Timestamp queries around the GL thread's passes
+    bool m_ShowGpuProfiler = false;
+#ifdef ENGINE_ENABLE_PROFILER
+    bool m_ShowProfiler = false;
+    bool m_ProfilerPaused = false;            // Keep showing the same frame
+    std::vector<Profiler::TrackSnapshot> m_ProfilerTracks; // Last complete frame, every thread
+    int64_t m_ProfilerFrameBegin = 0;
+    int64_t m_ProfilerFrameEnd = 0;
+#endif
+    CommandQueue::Stats m_CommandStats;       // Recording/sort stats of the last built frame
+    std::chrono::steady_clock::time_point m_LastFrameStart;
+    std::vector<FrameTiming> m_FrameTimings;  // GL thread: one per submitted frame with --stats or --benchmark
+    std::unique_ptr<CaptureWriter> m_CaptureWriter; // --output: encodes and writes frames on its own thread
+    std::unique_ptr<FrameCapture> m_FrameCapture; // --output: GL thread, pixel pack buffer ring feeding m_CaptureWriter
+    FramePacer m_FramePacer;                  // Main thread: frame deltas and the frame limiter
+    PacingMode m_Pacing = PacingMode::VSync;  // Overlay setting
+    int m_FpsLimit = 60;
+    int m_RequestedSwapInterval = 0;          // GL thread: last frame.SwapInterval applied
+    int m_SwapInterval = 0;                   // GL thread: what the driver accepted for it
+    std::chrono::steady_clock::time_point m_LastPresentEnd; // GL thread
+    FrameIntervals m_PresentIntervals;        // GL thread: present-to-present
+    RenderGraph m_RenderGraph;                // GL thread: the frame's passes, declared and compiled every frame
+    std::unique_ptr<RenderGraphExecutor> m_GraphExecutor; // Pooled transient targets and framebuffers behind it
+    std::string m_RenderGraphLayout;          // GL thread: pass order last logged
 
     // --- Scene / Game Objects ---
-    // Renamed shader, added Mesh and Texture
-    std::unique_ptr<Shader> m_LitTexturedShader;
-    std::unique_ptr<Mesh> m_LoadedMesh;
-    std::unique_ptr<Texture> m_DiffuseTexture;
+    std::unique_ptr<ShaderVariants> m_LitShaders; // lit_textured permutations, compiled on the GL thread
+    uint32_t m_LitShadowsFeature = 0;         // Feature bits of m_LitShaders
+    uint32_t m_LitLightsFeature = 0;
+    uint32_t m_LitBatchFeature = 0;
+    std::unique_ptr<Shader> m_DepthOnlyShader;         // Position-only program for the depth pre-pass
+    bool m_UseDepthPrepass = false;
+    std::unique_ptr<ShaderVariants> m_DepthShaders;    // depth_only again, for the DRAW_BATCH build
+    const Shader* m_DepthBatchShader = nullptr;        // Batched pre-pass, same gl_Position as the batched lit program
+    bool m_UseDrawBatches = false;                     // Only ever set when the renderer supports them
+    std::unique_ptr<DynamicResolution> m_DynamicResolution; // Scaled scene size and the upscale before the UI
+    std::unique_ptr<Shader> m_UpscaleShader;  // Sharpening upscale; without it the upscale is a bilinear blit
+    ResolutionScaler m_ResolutionScaler;      // GL thread: picks the scale from measured GPU time
+    uint64_t m_ResolvedGpuFrames = 0;         // GL thread: GPU profiler frames already fed to the scaler
+    bool m_UseDynamicResolution = false;
+    bool m_SharpenUpscale = true;
+    float m_GpuBudgetMilliseconds = 16.0f;
+    float m_MinResolutionScale = 0.5f;
+    float m_MaxResolutionScale = 1.0f;
+    std::unique_ptr<ClusteredLighting> m_ClusteredLighting; // Texture buffers behind the lit shader's cluster lookup
+    LightGrid m_LightGrid;                    // Bins m_Lights into froxels every frame
+    std::vector<Light> m_Lights;              // Extracted from the World by the light-list system
+    std::vector<Entity> m_LightEntities;      // In creation order; light i is always generated the same way
+    int m_LightCountSetting = 0;              // Overlay slider
+    std::unique_ptr<ShadowMaps> m_ShadowMaps; // Cascade depth array and static cache
+    ShadowCascades m_ShadowCascades;          // Stable fits and cache decisions, main thread
+    std::vector<uint32_t> m_ShadowCasters;    // Scratch: objects culled against one cascade
+    ShadowFrameStats m_ShadowStats;           // Last built frame
+    bool m_UseShadows = true;
+    bool m_UseShadowCache = true;
+    uint32_t m_StaticVersion = 0;             // Bumped whenever static objects are added, removed or moved
+    float m_SunAzimuth = -45.0f;              // Degrees around +y
+    float m_SunElevation = 54.7f;             // Degrees above the horizon
+    std::vector<std::unique_ptr<Mesh>> m_Meshes;       // Assets referenced by MeshRenderer components
+    Mesh* m_DeformingMesh = nullptr;          // --deforming-mesh: in m_Meshes, rewritten by the GL thread every frame
+    std::vector<Vertex> m_DeformingVertices;  // Its CPU-side shape, GL thread after Initialize
+    std::unique_ptr<MaterialLibrary> m_Materials; // Every diffuse texture, packed into texture arrays
+    World m_World;                            // Entities and their components
+    SystemScheduler m_Simulation;             // Fixed-step systems: rotation, light orbits
+    SystemScheduler m_Systems;                // Per-frame: interpolated poses, audio, render-list extraction
+    FixedTimestep m_Timestep;                 // Real time -> simulation steps
+    float m_InterpolationAlpha = 0.0f;        // Frame's position between the last two steps; read by pose systems
+    double m_SimulationStepMilliseconds = 0.0; // Last step's cost
+    int m_SimulationRateSetting = 60;         // Overlay slider
+    TransformSystem m_Transforms;             // Hierarchy behind every TransformComponent
+    std::vector<SceneObject> m_SceneObjects;  // Render list, rebuilt from the World every frame
+    FrustumCuller m_FrustumCuller;            // World bounds of m_SceneObjects (same indices)
+    FrustumCuller::Stats m_CullStats;         // Camera pass; the shadow cascades reuse the culler afterwards
+    std::vector<uint32_t> m_VisibleObjects;   // Filled each frame by culling
+    std::vector<AABB> m_ObjectWorldBounds;    // Per-object world boxes, input to the BVH
+    BVH m_SceneBVH;                           // Refit every frame, rebuilt in the background when degraded
+    bool m_UseBVHCulling = false;             // Toggle between SoA frustum culling and BVH traversal
+    int m_PickedObject = -1;                  // Last object hit by a mouse pick (-1 for none)
+    OcclusionCuller m_OcclusionCuller;        // CPU masked depth buffer, tested after frustum culling
+    bool m_UseOcclusionCulling = true;
+    std::unique_ptr<OcclusionQueries> m_OcclusionQueries; // GPU box queries + conditional rendering
+    bool m_UseOcclusionQueries = true;
 
     // --- Camera State ---
     glm::vec3 m_CameraPos = glm::vec3(0.0f, 0.0f, 3.0f);
@@ -65,17 +216,19 @@ private:
     bool m_FirstMouse = true;
     float m_LastMouseX = 0.0f;
     float m_LastMouseY = 0.0f;
+    CameraPath m_CameraPath;                  // Replayed with --benchmark, recorded with --record-path
+    double m_SimulationTime = 0.0;            // Seconds of (unpaused) simulated time, at the latest step
+    double m_PoseTime = 0.0;                  // Simulation time rendered this frame, between the last two steps
+    double m_LastPathKeyframe = -1.0;         // Simulation time of the last recorded keyframe
 
     // --- State ---
     GameState m_CurrentState = GameState::Playing;
     bool m_IsRunning = false;
-    Uint64 m_TickCountLast = 0;
-    float m_RotationAngle = 0.0f; // Keep object rotation for now
 
 
     bool m_MixerInitialized = false;
     bool m_SoundLoaded = false;
-    int m_MusicChannel = -1; // <-- ADD THIS LINE (-1 means not playing)
+    Entity m_MusicEntity;                // Carries the AudioSource for m_TestSound
     Mix_Chunk* m_TestSound = nullptr;
     bool LoadAudio();
     void CloseAudio();
@@ -0,0 +1,92 @@
+// include/BVH.h
+#ifndef BVH_H
+#define BVH_H
+
+#include "Bounds.h"
+#include <cstdint>
+#include <future>
+#include <vector>
+
+// 32-byte node, two per cache line. Interior nodes keep their children adjacent at
+// LeftFirst and LeftFirst + 1; leaves reference Count entries of the primitive index list.
+// Children always come after their parent, so a reverse sweep refits the whole tree.
+struct alignas(32) BVHNode {
+    float BoundsMin[3];
+    uint32_t LeftFirst; // First child (interior) or first primitive (leaf)
+    float BoundsMax[3];
+    uint32_t Count;     // 0 for interior nodes
+
+    bool IsLeaf() const { return Count > 0; }
+};
+static_assert(sizeof(BVHNode) == 32, "BVHNode must stay 32 bytes");
+
+struct RayHit {
+    uint32_t ObjectIndex = ~0u;
+    float Distance = 0.0f; // Along the (normalized) ray to the object's box
+
+    bool IsValid() const { return ObjectIndex != ~0u; }
+};
+
+// Bounding volume hierarchy over per-object world boxes, built with binned SAH.
+// Objects are referred to by their index in the bounds array passed to Build/Refit.
+class BVH {
+public:
+    struct Stats {
+        uint32_t NodeCount = 0;
+        uint32_t LeafCount = 0;
+        uint32_t MaxDepth = 0;
+        double BuildMilliseconds = 0.0;
+        float BuildCost = 0.0f; // SAH cost right after the last full build
+        float CurrentCost = 0.0f; // SAH cost after the last refit
+    };
+
+    BVH();
+    ~BVH();
+
+    void Build(const std::vector<AABB>& objectBounds);
+    // Recomputes boxes bottom-up for moved objects; topology is kept, so the object count must match.
+    void Refit(const std::vector<AABB>& objectBounds);
+    // Empties the tree, waiting for any background rebuild first.
+    void Clear();
+
+    // Builds a fresh tree from a copy of the bounds on a background thread.
+    void BeginRebuildAsync(const std::vector<AABB>& objectBounds);
+    // If the background build finished, swaps it in and refits it to the current bounds.
+    bool PollRebuild(const std::vector<AABB>& currentBounds);
+    bool IsRebuildPending() const { return m_PendingRebuild.valid(); }
+    // Ratio of current to freshly-built SAH cost; large values mean refits have degraded the tree.
+    float GetDegradation() const;
+
+    // --- Queries (append object indices) ---
+    void QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& outObjects) const;
+    void QuerySphere(const glm::vec3& center, float radius, std::vector<uint32_t>& outObjects) const;
+    // Closest object box hit by the ray (direction need not be normalized), within maxDistance.
+    RayHit Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance = 1e30f) const;
+
+    bool IsEmpty() const { return m_Nodes.empty(); }
+    size_t GetObjectCount() const { return m_ObjectCount; }
+    const Stats& GetStats() const { return m_Stats; }
+    const std::vector<BVHNode>& GetNodes() const { return m_Nodes; }
+
+    BVH(const BVH&) = delete; BVH& operator=(const BVH&) = delete;
+
+private:
+    struct Tree {
+        std::vector<BVHNode> Nodes;
+        std::vector<uint32_t> PrimitiveIndices;
+        Stats TreeStats;
+    };
+
+    static Tree BuildTree(const std::vector<AABB>& objectBounds);
+    static float ComputeCost(const std::vector<BVHNode>& nodes);
+    void Adopt(Tree&& tree);
+
+    std::vector<BVHNode> m_Nodes;
+    std::vector<uint32_t> m_PrimitiveIndices; // Object indices, grouped by leaf
+    std::vector<AABB> m_ObjectBounds;         // Copy of the last built/refitted bounds for exact leaf tests
+    size_t m_ObjectCount = 0;
+    Stats m_Stats;
+    std::future<Tree> m_PendingRebuild;
+};
+
+#endif // BVH_H
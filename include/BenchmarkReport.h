@@ -0,0 +1,40 @@
+// include/BenchmarkReport.h
+#ifndef BENCHMARKREPORT_H
+#define BENCHMARKREPORT_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Summary of a benchmark run: mean/stddev/p50/p95/p99/max per metric over the measured frames, plus
+// the settings the run used, so two reports can be compared side by side.
+class BenchmarkReport {
+public:
+    struct Metric {
+        std::string Name;      // e.g. "cpu_frame_ms"
+        size_t Samples = 0;
+        double Mean = 0.0;
+        double StdDev = 0.0;   // Frame-to-frame consistency; two runs with the same mean can pace very differently
+        double P50 = 0.0;
+        double P95 = 0.0;
+        double P99 = 0.0;
+        double Max = 0.0;
+    };
+
+    // Settings recorded alongside the numbers (frames, timestep, camera path, build options...).
+    void SetInfo(const std::string& key, const std::string& value);
+    // Sorts 'samples' in place; an empty metric is reported with zero samples.
+    void AddMetric(const std::string& name, std::vector<double>& samples);
+    const std::vector<Metric>& GetMetrics() const { return m_Metrics; }
+
+    bool WriteJson(const std::string& filePath) const;
+    bool WriteCsv(const std::string& filePath) const; // One row per metric
+    void Print() const;
+
+private:
+    std::vector<std::pair<std::string, std::string>> m_Info;
+    std::vector<Metric> m_Metrics;
+};
+
+#endif // BENCHMARKREPORT_H
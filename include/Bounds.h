@@ -0,0 +1,47 @@
+// include/Bounds.h
+#ifndef BOUNDS_H
+#define BOUNDS_H
+
+#include "VertexArray.h" // Vertex struct
+#include <glm/glm.hpp>
+#include <vector>
+
+// Axis-aligned bounding box. Default-constructed boxes are empty (Min > Max).
+struct AABB {
+    glm::vec3 Min = glm::vec3(1e30f);
+    glm::vec3 Max = glm::vec3(-1e30f);
+
+    bool IsEmpty() const { return Min.x > Max.x || Min.y > Max.y || Min.z > Max.z; }
+    glm::vec3 GetCenter() const { return (Min + Max) * 0.5f; }
+    glm::vec3 GetExtents() const { return (Max - Min) * 0.5f; }
+    void Expand(const glm::vec3& point) { Min = glm::min(Min, point); Max = glm::max(Max, point); }
+    void Expand(const AABB& other) { Min = glm::min(Min, other.Min); Max = glm::max(Max, other.Max); }
+    float GetSurfaceArea() const {
+        glm::vec3 d = Max - Min;
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+};
+
+struct BoundingSphere {
+    glm::vec3 Center = glm::vec3(0.0f);
+    float Radius = 0.0f;
+};
+
+// Six inward-facing planes (xyz = normal, w = distance), extracted from a view-projection
+// matrix (Gribb/Hartmann). Order: left, right, bottom, top, near, far.
+struct Frustum {
+    glm::vec4 Planes[6];
+
+    static Frustum FromMatrix(const glm::mat4& viewProjection);
+    bool IntersectsAABB(const AABB& box) const;
+    bool IntersectsSphere(const glm::vec3& center, float radius) const;
+};
+
+namespace Bounds {
+    // Object-space bounds from raw vertex positions (sphere is centred on the box).
+    void Compute(const std::vector<Vertex>& vertices, AABB& outBox, BoundingSphere& outSphere);
+    // Conservative world-space box of a transformed box (Arvo's method).
+    AABB Transform(const AABB& box, const glm::mat4& matrix);
+}
+
+#endif // BOUNDS_H
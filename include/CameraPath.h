@@ -0,0 +1,41 @@
+// include/CameraPath.h
+#ifndef CAMERAPATH_H
+#define CAMERAPATH_H
+
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+// Camera keyframes over simulated time, for repeatable benchmark runs. Paths are authored
+// (MakeOrbit) or recorded from a live session, and stored as text: one
+// "time x y z yaw pitch" line per keyframe, '#' starts a comment.
+class CameraPath {
+public:
+    struct Keyframe {
+        float Time = 0.0f;    // Seconds of simulated time
+        glm::vec3 Position = glm::vec3(0.0f);
+        float Yaw = -90.0f;   // Degrees, as Application's camera
+        float Pitch = 0.0f;
+    };
+
+    bool Load(const std::string& filePath);
+    bool Save(const std::string& filePath) const;
+
+    // Keyframes must be added in increasing time.
+    void AddKeyframe(const Keyframe& keyframe);
+    void Clear() { m_Keyframes.clear(); }
+    bool IsEmpty() const { return m_Keyframes.empty(); }
+    size_t GetKeyframeCount() const { return m_Keyframes.size(); }
+    float GetDuration() const { return m_Keyframes.empty() ? 0.0f : m_Keyframes.back().Time; }
+
+    // Catmull-Rom through the positions, linear yaw/pitch. Holds the first/last keyframe outside the path.
+    Keyframe Sample(float time) const;
+
+    // One loop around 'center' at 'radius', 'height' above it, always facing the center.
+    static CameraPath MakeOrbit(const glm::vec3& center, float radius, float height, float duration, int keyframes = 16);
+
+private:
+    std::vector<Keyframe> m_Keyframes;
+};
+
+#endif // CAMERAPATH_H
@@ -0,0 +1,83 @@
+// include/CaptureWriter.h
+#ifndef CAPTUREWRITER_H
+#define CAPTUREWRITER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class CaptureFormat {
+    PPM, // One binary PPM per frame
+    PNG, // One PNG per frame
+    Y4M  // All frames in one raw YUV 4:2:0 video (capture.y4m), playable and encodable by ffmpeg
+};
+
+// Encodes and writes captured frames on its own thread, in submission order, so file I/O and
+// format conversion never run on the GL thread. Pixel buffers are recycled between frames.
+// Submit() blocks only when MaxQueued frames are already waiting, so a slow disk slows the
+// capture down instead of growing memory without bound or losing frames.
+class CaptureWriter {
+public:
+    static constexpr size_t MaxQueued = 8;
+
+    struct Stats {
+        uint64_t Written = 0;
+        uint64_t Failed = 0;
+        uint64_t Blocked = 0;            // Submits that had to wait for room in the queue
+        uint32_t Queued = 0;
+        double EncodeMilliseconds = 0.0; // Last frame, conversion and write
+    };
+
+    static const char* GetFormatName(CaptureFormat format);
+    static bool ParseFormat(const std::string& name, CaptureFormat& out); // "ppm", "png", "y4m"
+
+    CaptureWriter();
+    ~CaptureWriter();
+
+    // 'fps' and 'fpsDivisor' give the Y4M frame rate (fps / fpsDivisor); other formats ignore them.
+    bool Start(const std::string& directory, CaptureFormat format, int width, int height, int fps, int fpsDivisor);
+    // Writes everything still queued, then joins the thread.
+    void Stop();
+    bool IsRunning() const { return m_Thread.joinable(); }
+
+    // A buffer of 'bytes' for the next frame, reusing one a written frame gave back when possible.
+    std::vector<uint8_t> AcquireBuffer(size_t bytes);
+    // Tightly packed RGBA, bottom row first (as glReadPixels returns it).
+    void Submit(uint64_t frameIndex, std::vector<uint8_t>&& rgba);
+    Stats GetStats() const;
+
+    CaptureWriter(const CaptureWriter&) = delete; CaptureWriter& operator=(const CaptureWriter&) = delete; CaptureWriter(CaptureWriter&&) = delete; CaptureWriter& operator=(CaptureWriter&&) = delete;
+
+private:
+    struct Frame {
+        uint64_t Index = 0;
+        std::vector<uint8_t> Pixels;
+    };
+
+    void ThreadMain();
+    bool Write(const Frame& frame);
+    bool WriteY4MFrame(const std::vector<uint8_t>& rgba);
+
+    std::string m_Directory;
+    CaptureFormat m_Format = CaptureFormat::PPM;
+    int m_Width = 0;
+    int m_Height = 0;
+    std::ofstream m_Video;                // Y4M only
+    std::vector<uint8_t> m_Planes;        // Y4M scratch: Y, then U, then V
+
+    std::thread m_Thread;
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_Ready;      // Frames queued, or stopping
+    std::condition_variable m_Room;       // Queue below MaxQueued
+    std::deque<Frame> m_Queue;
+    std::vector<std::vector<uint8_t>> m_FreeBuffers;
+    bool m_Stopping = false;
+    Stats m_Stats;
+};
+
+#endif // CAPTUREWRITER_H
@@ -0,0 +1,52 @@
+// include/ClusteredLighting.h
+#ifndef CLUSTEREDLIGHTING_H
+#define CLUSTEREDLIGHTING_H
+
+#include "LightGrid.h"
+#include <glad/glad.h>
+#include <cstddef>
+
+class Shader;
+
+// GL side of clustered forward lighting: uploads a frame's ClusteredLightData into three
+// texture buffers (lights, per-cluster offset/count, light indices) and points a shader's
+// uLights/uClusters/uLightIndices samplers at them. Texture buffers keep this on GL 3.3.
+class ClusteredLighting {
+public:
+    // Texture units used by Bind(); unit 0 stays the diffuse texture.
+    static constexpr int LightsUnit = 1;
+    static constexpr int ClustersUnit = 2;
+    static constexpr int IndicesUnit = 3;
+
+    ClusteredLighting();
+    ~ClusteredLighting();
+
+    bool Initialize();
+    void Shutdown();
+
+    // GL thread, once per frame. Buffers are orphaned, so this never waits on earlier draws.
+    void Upload(const ClusteredLightData& data);
+    // Binds the buffers and sets the cluster uniforms (the shader's uView is set per frame by the caller).
+    // 'viewportWidth/Height' map gl_FragCoord to tiles.
+    void Bind(const Shader& shader, int viewportWidth, int viewportHeight) const;
+
+    ClusteredLighting(const ClusteredLighting&) = delete; ClusteredLighting& operator=(const ClusteredLighting&) = delete; ClusteredLighting(ClusteredLighting&&) = delete; ClusteredLighting& operator=(ClusteredLighting&&) = delete;
+
+private:
+    struct TextureBuffer {
+        GLuint Buffer = 0;
+        GLuint Texture = 0;
+    };
+
+    static void UploadBuffer(const TextureBuffer& target, const void* data, size_t bytes);
+
+    TextureBuffer m_Lights;   // GL_RGBA32F
+    TextureBuffer m_Clusters; // GL_RG32UI
+    TextureBuffer m_Indices;  // GL_R32UI
+    glm::uvec3 m_Dimensions = glm::uvec3(0);
+    float m_SliceScale = 0.0f;
+    float m_SliceBias = 0.0f;
+    int m_LightCount = 0;
+};
+
+#endif // CLUSTEREDLIGHTING_H
@@ -0,0 +1,99 @@
+// include/CommandList.h
+#ifndef COMMANDLIST_H
+#define COMMANDLIST_H
+
+#include <glm/glm.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class Mesh;
+struct Material;
+
+// Per-draw data packed while recording; the replay turns it into uniforms.
+struct DrawUniforms {
+    glm::mat4 Model;
+    glm::mat4 MVP;
+};
+
+// One backend-agnostic draw: resources by pointer, uniforms by index into the recording list.
+// No GL calls happen while packets are recorded.
+struct DrawPacket {
+    uint64_t SortKey = 0;
+    const Mesh* MeshRef = nullptr;
+    const Material* MaterialRef = nullptr;
+    uint32_t UniformIndex = 0;
+    int32_t OcclusionQuery = -1; // Predicate the draw on this query handle, -1 for none
+};
+
+// Sort key layout, most significant first:
+//   [63:60] layer   (render pass / ordering bucket)
+//   [59:44] material (16 bits, groups texture array binds)
+//   [43:20] depth   (24 bits, near first so opaque draws reject hidden pixels early)
+//   [19:0]  sequence (low bits of the object index; keeps equal keys in a stable order)
+namespace SortKey {
+    inline uint64_t Make(uint32_t layer, uint32_t material, float depth01, uint32_t sequence) {
+        depth01 = depth01 < 0.0f ? 0.0f : (depth01 > 1.0f ? 1.0f : depth01);
+        const uint64_t depth = static_cast<uint64_t>(depth01 * float((1u << 24) - 1));
+        return (uint64_t(layer & 0xFu) << 60) | (uint64_t(material & 0xFFFFu) << 44) | (depth << 20) | uint64_t(sequence & 0xFFFFFu);
+    }
+    inline uint32_t GetLayer(uint64_t key) { return static_cast<uint32_t>(key >> 60); }
+}
+
+// Linear, append-only recording buffer owned by one thread for the frame. Reset keeps capacity,
+// so steady-state recording doesn't allocate.
+class CommandList {
+public:
+    void Reset();
+    void Draw(uint64_t sortKey, const Mesh* mesh, const Material* material, const DrawUniforms& uniforms, int32_t occlusionQuery = -1);
+    void Reserve(size_t packets);
+
+    size_t Size() const { return m_Packets.size(); }
+    const DrawPacket& GetPacket(size_t index) const { return m_Packets[index]; }
+    const DrawUniforms& GetUniforms(const DrawPacket& packet) const { return m_Uniforms[packet.UniformIndex]; }
+
+private:
+    std::vector<DrawPacket> m_Packets;
+    std::vector<DrawUniforms> m_Uniforms;
+};
+
+// Per-frame set of command lists, one per recording thread (JobSystem worker index). After
+// recording, Merge() sorts every packet by key; Replay() then walks them on the GL thread.
+class CommandQueue {
+public:
+    struct Stats {
+        uint32_t Packets = 0;
+        uint32_t ListsUsed = 0;   // Lists that recorded at least one packet
+        double RecordMilliseconds = 0.0; // BeginFrame to Merge
+        double SortMilliseconds = 0.0;
+    };
+
+    // Resets all lists; listCount is usually JobSystem::GetWorkerCount().
+    void BeginFrame(unsigned int listCount);
+    CommandList& GetList(unsigned int index) { return *m_Lists[index]; }
+    size_t GetListCount() const { return m_Lists.size(); }
+
+    void Merge();
+    // Calls fn for every merged packet of 'layer', in key order.
+    void Replay(uint32_t layer, const std::function<void(const DrawPacket&, const DrawUniforms&)>& fn) const;
+    size_t GetPacketCount() const { return m_Sorted.size(); }
+
+    const Stats& GetLastStats() const { return m_LastStats; }
+
+private:
+    struct SortEntry {
+        uint64_t Key;
+        uint32_t List;
+        uint32_t Index;
+    };
+
+    std::vector<std::unique_ptr<CommandList>> m_Lists; // Separate allocations, so recording threads don't share cache lines
+    std::vector<SortEntry> m_Sorted;
+    std::vector<SortEntry> m_SortScratch;
+    std::chrono::steady_clock::time_point m_FrameStart;
+    Stats m_LastStats;
+};
+
+#endif // COMMANDLIST_H
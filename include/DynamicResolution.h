@@ -0,0 +1,47 @@
+// include/DynamicResolution.h
+#ifndef DYNAMICRESOLUTION_H
+#define DYNAMICRESOLUTION_H
+
+#include <glad/glad.h>
+
+class Shader;
+
+// Scaled scene target sizing and upscaling for dynamic resolution. The scene draws into the
+// lower-left corner of a target sized for the largest scale (a render graph transient), so
+// changing the scale never reallocates; Upscale() then stretches that corner over the output,
+// and the UI draws on top at native resolution. The scale itself comes from ResolutionScaler.
+class DynamicResolution {
+public:
+    DynamicResolution();
+    ~DynamicResolution();
+
+    // Needs a current context. Output size is the native framebuffer size.
+    bool Initialize(int outputWidth, int outputHeight, float maxScale);
+    void Shutdown();
+    bool IsInitialized() const { return m_EmptyVAO != 0; }
+
+    // Sets the scene size for 'scale', growing the target size if the scene no longer fits.
+    void SetScale(float scale);
+    int GetSceneWidth() const { return m_SceneWidth; }
+    int GetSceneHeight() const { return m_SceneHeight; }
+    int GetTargetWidth() const { return m_TargetWidth; }
+    int GetTargetHeight() const { return m_TargetHeight; }
+
+    // Upscales the scene into the bound framebuffer, which has to be output-sized: a bilinear blit
+    // from 'sceneFramebuffer', or a sharpening pass over 'sceneTexture' through 'sharpenShader'
+    // (upscale.vert/.frag) when one is given.
+    void Upscale(GLuint sceneTexture, GLuint sceneFramebuffer, const Shader* sharpenShader, float sharpness) const;
+
+    DynamicResolution(const DynamicResolution&) = delete; DynamicResolution& operator=(const DynamicResolution&) = delete; DynamicResolution(DynamicResolution&&) = delete; DynamicResolution& operator=(DynamicResolution&&) = delete;
+
+private:
+    GLuint m_EmptyVAO = 0; // Core profile needs a VAO even for the buffer-less fullscreen triangle
+    int m_OutputWidth = 0;
+    int m_OutputHeight = 0;
+    int m_TargetWidth = 0;
+    int m_TargetHeight = 0;
+    int m_SceneWidth = 0;
+    int m_SceneHeight = 0;
+};
+
+#endif // DYNAMICRESOLUTION_H
@@ -0,0 +1,240 @@
+// include/ECS.h
+#ifndef ECS_H
+#define ECS_H
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+class JobSystem;
+
+// Archetype-based entity component system. Every distinct set of component types is an
+// archetype; its entities live in fixed-size 16 KiB chunks that hold one tightly packed array
+// per component, so systems walk chunks linearly. Adding or removing a component moves the
+// entity to another archetype (cached per archetype as graph edges).
+// Components must be trivially copyable: rows are moved with memcpy and never destructed.
+// Structural changes (create/destroy/add/remove) must not happen while iterating a query.
+
+typedef uint64_t ComponentMask;
+static constexpr uint32_t MaxComponentTypes = 64;
+
+struct Entity {
+    uint32_t Index = ~0u;
+    uint32_t Generation = 0;
+
+    bool IsValid() const { return Index != ~0u; }
+    bool operator==(const Entity& other) const { return Index == other.Index && Generation == other.Generation; }
+    bool operator!=(const Entity& other) const { return !(*this == other); }
+};
+const Entity NullEntity{};
+
+// Process-wide component type ids, assigned on first use of each type.
+class ComponentRegistry {
+public:
+    struct Info {
+        size_t Size = 0;
+        size_t Alignment = 0;
+    };
+
+    template <typename T>
+    static uint32_t GetId() {
+        static_assert(std::is_trivially_copyable<T>::value, "ECS components must be trivially copyable");
+        static_assert(sizeof(T) <= 1024, "ECS components must fit many times into a chunk");
+        static_assert(alignof(T) <= 64, "ECS components can be aligned to at most 64 bytes");
+        static const uint32_t id = Register(sizeof(T), alignof(T));
+        return id;
+    }
+    static Info GetInfo(uint32_t id);
+
+private:
+    static uint32_t Register(size_t size, size_t alignment);
+};
+
+template <typename... T>
+ComponentMask MaskOf() {
+    return (ComponentMask(0) | ... | (ComponentMask(1) << ComponentRegistry::GetId<T>()));
+}
+
+struct ArchetypeChunk {
+    static constexpr size_t Bytes = 16 * 1024;
+    alignas(64) unsigned char Data[Bytes]; // Entity array, then one array per component
+    uint32_t Count = 0;
+};
+
+struct Archetype {
+    ComponentMask Mask = 0;
+    std::vector<uint32_t> ComponentIds;       // Ascending
+    std::vector<uint32_t> ComponentSizes;     // Per column
+    std::vector<uint32_t> Offsets;            // Byte offset of each column's array inside a chunk
+    std::array<int8_t, MaxComponentTypes> Column; // Component id -> column, -1 if absent
+    std::array<uint32_t, MaxComponentTypes> AddEdges;    // Archetype reached by adding a component id (~0u = not cached yet)
+    std::array<uint32_t, MaxComponentTypes> RemoveEdges;
+    uint32_t ChunkCapacity = 0;
+    size_t EntityCount = 0;
+    std::vector<std::unique_ptr<ArchetypeChunk>> Chunks; // All full except the last
+};
+
+// One chunk of a query result: Size() entities with their components as parallel arrays.
+class ChunkView {
+public:
+    ChunkView(const Archetype& archetype, ArchetypeChunk& chunk) : m_Archetype(&archetype), m_Chunk(&chunk) {}
+
+    size_t Size() const { return m_Chunk->Count; }
+    const Entity* GetEntities() const { return reinterpret_cast<const Entity*>(m_Chunk->Data); }
+
+    // nullptr if this archetype doesn't have T.
+    template <typename T>
+    T* Get() const {
+        int column = m_Archetype->Column[ComponentRegistry::GetId<T>()];
+        return column < 0 ? nullptr : reinterpret_cast<T*>(m_Chunk->Data + m_Archetype->Offsets[column]);
+    }
+    template <typename T>
+    bool Has() const { return m_Archetype->Column[ComponentRegistry::GetId<T>()] >= 0; }
+
+private:
+    const Archetype* m_Archetype;
+    ArchetypeChunk* m_Chunk;
+};
+
+// Handle to a cached query: the list of matching archetypes is kept up to date as archetypes appear.
+struct Query {
+    uint32_t Index = ~0u;
+    bool IsValid() const { return Index != ~0u; }
+};
+
+class World {
+public:
+    World();
+    ~World();
+
+    Entity CreateEntity();
+    // Creates the entity directly in the archetype of its components (no intermediate moves).
+    template <typename... T>
+    Entity CreateEntity(const T&... components);
+    void DestroyEntity(Entity entity);
+    bool IsAlive(Entity entity) const;
+    void Clear(); // Destroys every entity and archetype; queries stay valid (and empty)
+
+    // Overwrites the component if the entity already has it. Returns nullptr for dead entities.
+    template <typename T>
+    T* AddComponent(Entity entity, const T& value = T());
+    template <typename T>
+    bool RemoveComponent(Entity entity);
+    template <typename T>
+    T* GetComponent(Entity entity);
+    template <typename T>
+    const T* GetComponent(Entity entity) const;
+    template <typename T>
+    bool HasComponent(Entity entity) const;
+
+    // Entities having every component in 'all' and none in 'none'. Identical queries share one cache entry.
+    Query CreateQuery(ComponentMask all, ComponentMask none = 0);
+    template <typename... T>
+    Query CreateQuery() { return CreateQuery(MaskOf<T...>()); }
+
+    template <typename Fn>
+    void ForEachChunk(Query query, Fn&& fn);
+    // Chunks are spread across the pool (one chunk is the smallest unit); runs inline without a JobSystem.
+    void ForEachChunkParallel(Query query, JobSystem* jobs, const std::function<void(const ChunkView&)>& fn);
+    size_t CountEntities(Query query) const;
+
+    size_t GetEntityCount() const { return m_AliveCount; }
+    size_t GetArchetypeCount() const { return m_Archetypes.size(); }
+    size_t GetChunkCount() const;
+
+    World(const World&) = delete; World& operator=(const World&) = delete; World(World&&) = delete; World& operator=(World&&) = delete;
+
+private:
+    struct EntityRecord {
+        uint32_t ArchetypeIndex = ~0u; // ~0u while the index is free
+        uint32_t ChunkIndex = 0;
+        uint32_t Row = 0;
+        uint32_t Generation = 0;
+    };
+
+    struct QueryData {
+        ComponentMask All = 0;
+        ComponentMask None = 0;
+        std::vector<uint32_t> Archetypes;
+    };
+
+    uint32_t FindOrCreateArchetype(ComponentMask mask);
+    uint32_t GetAddTarget(uint32_t archetypeIndex, uint32_t componentId);
+    uint32_t GetRemoveTarget(uint32_t archetypeIndex, uint32_t componentId);
+    Entity AllocateEntity(uint32_t archetypeIndex);
+    void AllocateRow(uint32_t archetypeIndex, uint32_t entityIndex);
+    void RemoveRow(uint32_t archetypeIndex, uint32_t chunkIndex, uint32_t row);
+    void MoveEntity(uint32_t entityIndex, uint32_t targetArchetype);
+    void* GetComponentData(uint32_t entityIndex, uint32_t componentId) const;
+
+    std::vector<std::unique_ptr<Archetype>> m_Archetypes;
+    std::unordered_map<ComponentMask, uint32_t> m_ArchetypeByMask;
+    std::vector<EntityRecord> m_Records;
+    std::vector<uint32_t> m_FreeIndices;
+    size_t m_AliveCount = 0;
+    std::vector<QueryData> m_Queries;
+};
+
+// --- Template implementations ---
+
+template <typename... T>
+Entity World::CreateEntity(const T&... components) {
+    Entity entity = AllocateEntity(FindOrCreateArchetype(MaskOf<T...>()));
+    (std::memcpy(GetComponentData(entity.Index, ComponentRegistry::GetId<T>()), &components, sizeof(T)), ...);
+    return entity;
+}
+
+template <typename T>
+T* World::AddComponent(Entity entity, const T& value) {
+    const uint32_t id = ComponentRegistry::GetId<T>();
+    if (!IsAlive(entity)) return nullptr;
+    const uint32_t archetypeIndex = m_Records[entity.Index].ArchetypeIndex;
+    if (!(m_Archetypes[archetypeIndex]->Mask & (ComponentMask(1) << id))) MoveEntity(entity.Index, GetAddTarget(archetypeIndex, id));
+    T* component = static_cast<T*>(GetComponentData(entity.Index, id));
+    std::memcpy(component, &value, sizeof(T));
+    return component;
+}
+
+template <typename T>
+bool World::RemoveComponent(Entity entity) {
+    const uint32_t id = ComponentRegistry::GetId<T>();
+    if (!IsAlive(entity)) return false;
+    const uint32_t archetypeIndex = m_Records[entity.Index].ArchetypeIndex;
+    if (!(m_Archetypes[archetypeIndex]->Mask & (ComponentMask(1) << id))) return false;
+    MoveEntity(entity.Index, GetRemoveTarget(archetypeIndex, id));
+    return true;
+}
+
+template <typename T>
+T* World::GetComponent(Entity entity) {
+    return IsAlive(entity) ? static_cast<T*>(GetComponentData(entity.Index, ComponentRegistry::GetId<T>())) : nullptr;
+}
+
+template <typename T>
+const T* World::GetComponent(Entity entity) const {
+    return IsAlive(entity) ? static_cast<const T*>(GetComponentData(entity.Index, ComponentRegistry::GetId<T>())) : nullptr;
+}
+
+template <typename T>
+bool World::HasComponent(Entity entity) const {
+    return IsAlive(entity) && (m_Archetypes[m_Records[entity.Index].ArchetypeIndex]->Mask & (ComponentMask(1) << ComponentRegistry::GetId<T>()));
+}
+
+template <typename Fn>
+void World::ForEachChunk(Query query, Fn&& fn) {
+    if (query.Index >= m_Queries.size()) return;
+    for (uint32_t archetypeIndex : m_Queries[query.Index].Archetypes) {
+        const Archetype& archetype = *m_Archetypes[archetypeIndex];
+        for (const std::unique_ptr<ArchetypeChunk>& chunk : archetype.Chunks) {
+            ChunkView view(archetype, *chunk);
+            fn(view);
+        }
+    }
+}
+
+#endif // ECS_H
@@ -2,6 +2,7 @@
 #define FILEUTILS_H
 #include <string>
 #include <vector>
+#include <cstdint>
 #include "VertexArray.h" // <-- Include for Vertex struct
 
 namespace FileUtils { // Use namespace instead of static class
@@ -14,6 +15,12 @@ namespace FileUtils { // Use namespace instead of static class
                       std::vector<Vertex>& outVertices,
                       std::vector<unsigned int>& outIndices);
 
+    // Writes tightly packed RGBA pixels (bottom row first, as glReadPixels returns them) as binary PPM.
+    bool WritePPM(const std::string& filePath, int width, int height, const std::vector<uint8_t>& rgba);
+    // Same input, as an 8-bit RGB PNG. The zlib stream uses stored (uncompressed) blocks: no
+    // compression library is needed and writing stays cheap, at the cost of file size.
+    bool WritePNG(const std::string& filePath, int width, int height, const std::vector<uint8_t>& rgba);
+
     // Declare the static member if needed *within* the namespace scope?
     // Better to handle base path internally without exposing static member.
     // Remove: static std::string sBasePath;
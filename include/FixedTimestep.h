@@ -0,0 +1,42 @@
+// include/FixedTimestep.h
+#ifndef FIXEDTIMESTEP_H
+#define FIXEDTIMESTEP_H
+
+#include <cstdint>
+
+// Accumulator behind the fixed-rate simulation. Frames add however much real time passed, and the
+// simulation consumes it in whole steps, so its results don't depend on the frame rate. The
+// remainder (less than one step) is how far the frame falls between the last two simulated states,
+// which rendering interpolates between. A frame that would need more than the step limit to catch
+// up drops the excess instead: the simulation runs slow for that frame rather than spiralling,
+// with every catch-up making the next frame later still.
+class FixedTimestep {
+public:
+    struct Stats {
+        uint32_t Steps = 0;          // Run by the last Advance()
+        uint64_t TotalSteps = 0;
+        uint64_t CatchUpFrames = 0;  // Frames that needed more than one step
+        uint64_t DroppedSteps = 0;   // Discarded by the step limit
+    };
+
+    void Configure(int rateHz, int maxStepsPerFrame);
+    // Adds a frame's worth of real time; returns how many steps to simulate now.
+    uint32_t Advance(double seconds);
+    void Reset() { m_Accumulator = 0.0; }
+
+    int GetRate() const { return m_Rate; }
+    int GetMaxSteps() const { return m_MaxSteps; }
+    double GetStepSeconds() const { return m_StepSeconds; }
+    // [0, 1): position of the frame between the previous step's state and the latest one.
+    float GetAlpha() const { return static_cast<float>(m_Accumulator / m_StepSeconds); }
+    const Stats& GetStats() const { return m_Stats; }
+
+private:
+    int m_Rate = 60;
+    int m_MaxSteps = 6;
+    double m_StepSeconds = 1.0 / 60.0;
+    double m_Accumulator = 0.0;
+    Stats m_Stats;
+};
+
+#endif // FIXEDTIMESTEP_H
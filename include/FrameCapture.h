@@ -0,0 +1,72 @@
+// include/FrameCapture.h
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class CaptureWriter;
+
+// Asynchronous framebuffer readback. Capture() only queues a glReadPixels into the next pixel pack
+// buffer of a ring, followed by a fence, so the GPU copies the image while the CPU moves on. Once
+// the fence has signalled (usually a frame or two later) Collect() maps the buffer, copies the
+// pixels out and hands them to the CaptureWriter thread for encoding. The GL thread only ever
+// blocks when every buffer of the ring is still in flight.
+class FrameCapture {
+public:
+    static constexpr int DefaultRingSize = 3;
+
+    struct Stats {
+        uint64_t Captured = 0;           // Readbacks issued
+        uint64_t Collected = 0;          // Handed to the writer
+        uint64_t Stalls = 0;             // Capture() had to wait for the oldest readback
+        uint32_t InFlight = 0;
+        uint32_t LatencyFrames = 0;      // Capture-to-collect, last frame collected
+        double IssueMilliseconds = 0.0;  // CPU cost of the last Capture(), including any stall
+        double CollectMilliseconds = 0.0; // CPU cost of the last Collect(): map, copy, unmap
+    };
+
+    FrameCapture();
+    ~FrameCapture();
+
+    // Needs a current context. 'writer' must stay running until Flush().
+    bool Initialize(int width, int height, int ringSize, CaptureWriter& writer);
+    void Shutdown();
+    bool IsInitialized() const { return !m_Slots.empty(); }
+
+    // Reads the lower-left width x height of the bound draw framebuffer (the back buffer for the
+    // window) into the ring. Call after the frame is drawn and before it is presented.
+    void Capture(uint64_t frameIndex);
+    // Once per frame: passes every finished readback to the writer, oldest first, without waiting.
+    void Collect();
+    // Waits for and passes on every readback still in flight (before shutdown).
+    void Flush();
+
+    const Stats& GetStats() const { return m_Stats; }
+
+    FrameCapture(const FrameCapture&) = delete; FrameCapture& operator=(const FrameCapture&) = delete; FrameCapture(FrameCapture&&) = delete; FrameCapture& operator=(FrameCapture&&) = delete;
+
+private:
+    struct Slot {
+        GLuint Buffer = 0;
+        GLsync Fence = nullptr;  // Set while a readback is in flight
+        uint64_t FrameIndex = 0;
+        uint64_t IssuedAt = 0;   // m_Frames when issued, for the latency
+    };
+
+    // Returns false if 'wait' is false and the slot's readback isn't done yet.
+    bool CollectSlot(Slot& slot, bool wait);
+
+    std::vector<Slot> m_Slots;
+    int m_Next = 0;              // Slot the next Capture() writes; also the oldest one in flight
+    int m_Width = 0;
+    int m_Height = 0;
+    size_t m_Bytes = 0;
+    CaptureWriter* m_Writer = nullptr;
+    uint64_t m_Frames = 0;       // Collect() calls
+    Stats m_Stats;
+};
+
+#endif // FRAMECAPTURE_H
@@ -0,0 +1,64 @@
+// include/FramePacer.h
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include <cstdint>
+#include <string>
+
+// How finished frames are handed to the display.
+enum class PacingMode {
+    VSync,         // Swap interval 1: wait for every vblank
+    AdaptiveVSync, // Swap interval -1: wait for vblank, but tear instead of halving the rate on a late frame
+    Uncapped,      // Swap interval 0: present as soon as a frame is done
+    Limited        // Swap interval 0, with the main loop held to a fixed rate by the CPU
+};
+
+// Rolling statistics over the last HistorySize frame intervals (frame starts, or presents).
+class FrameIntervals {
+public:
+    static constexpr int HistorySize = 240;
+
+    struct Stats {
+        uint32_t Samples = 0;
+        double MeanMilliseconds = 0.0;
+        double StdDevMilliseconds = 0.0;  // Spread of the intervals around their mean
+        double JitterMilliseconds = 0.0;  // Mean change from one interval to the next
+        double MaxMilliseconds = 0.0;
+    };
+
+    void Add(double milliseconds);
+    void Clear() { m_Count = 0; m_Next = 0; }
+    Stats GetStats() const;
+
+private:
+    double m_Intervals[HistorySize] = {};
+    int m_Count = 0;
+    int m_Next = 0;
+};
+
+// Main-loop timing. Frame deltas come from the performance counter instead of the millisecond
+// tick count, and in PacingMode::Limited BeginFrame() holds each frame to its slot: it sleeps
+// while the OS scheduler can be trusted to wake it in time, then spins the rest of the way.
+class FramePacer {
+public:
+    static const char* GetModeName(PacingMode mode);
+    static bool ParseMode(const std::string& name, PacingMode& out); // "vsync", "adaptive", "uncapped", "limit"
+    static int GetSwapInterval(PacingMode mode);
+
+    // Call once at the top of every frame. Waits for the frame's slot when 'mode' is Limited,
+    // and returns the seconds since the previous call (0 on the first).
+    double BeginFrame(PacingMode mode, int fpsLimit);
+
+    const FrameIntervals& GetFrameIntervals() const { return m_Frames; }
+    double GetSleepOvershootMilliseconds() const { return m_SleepOvershoot; }
+
+private:
+    void WaitUntil(uint64_t deadline);
+
+    uint64_t m_LastFrame = 0;  // Performance counter at the previous BeginFrame
+    uint64_t m_NextSlot = 0;   // Limited: counter value the next frame may start at
+    double m_SleepOvershoot = 1.0; // Smoothed milliseconds a sleep runs past its request; spun instead
+    FrameIntervals m_Frames;
+};
+
+#endif // FRAMEPACER_H
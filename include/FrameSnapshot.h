@@ -0,0 +1,155 @@
+// include/FrameSnapshot.h
+#ifndef FRAMESNAPSHOT_H
+#define FRAMESNAPSHOT_H
+
+#include "Bounds.h"
+#include "CommandList.h"
+#include "Mesh.h"
+#include "LightGrid.h"
+#include "ShadowCascades.h"
+#include "OcclusionQueries.h"
+#include "ShaderVariants.h"
+#include "ResolutionScaler.h"
+#include "FramePacer.h"
+#include "FrameCapture.h"
+#include "RenderGraph.h"
+#include "RenderGraphExecutor.h"
+#include "imgui.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Owned copy of ImGui's draw data. ImGui rewrites its draw lists on the next NewFrame(), so a
+// frame handed to another thread has to carry its own commands, vertices and indices.
+// The copied lists keep their capacity from frame to frame.
+class UIDrawData {
+public:
+    UIDrawData() = default;
+    ~UIDrawData();
+
+    // Main thread, between ImGui::Render() and the next ImGui::NewFrame().
+    void CopyFrom(const ImDrawData& source);
+    // nullptr until something was copied.
+    ImDrawData* Get() { return m_Data.Valid ? &m_Data : nullptr; }
+
+    UIDrawData(const UIDrawData&) = delete; UIDrawData& operator=(const UIDrawData&) = delete; UIDrawData(UIDrawData&&) = delete; UIDrawData& operator=(UIDrawData&&) = delete;
+
+private:
+    ImDrawData m_Data;
+    std::vector<ImDrawList*> m_Lists; // Owned; m_Data.CmdLists points at the first CmdListsCount of them
+};
+
+// A GPU occlusion query box for the query pass.
+struct QueryBox {
+    uint32_t Query = 0;
+    AABB Bounds;
+};
+
+// A shadow caster drawn into one cascade.
+struct ShadowDraw {
+    const Mesh* MeshRef = nullptr;
+    glm::mat4 MVP = glm::mat4(1.0f); // Cascade view-projection * model
+};
+
+// One cascade's work for the shadow pass. A cached cascade starts from its static cache, unless
+// StoreStatic asks to redraw Static and refresh the cache first.
+struct ShadowCascadeDraws {
+    glm::mat4 ViewProjection = glm::mat4(1.0f);
+    bool Cached = false;
+    bool StoreStatic = false;
+    std::vector<ShadowDraw> Static;  // Only filled when StoreStatic
+    std::vector<ShadowDraw> Casters; // Drawn every frame
+};
+
+struct ShadowFrameStats {
+    uint32_t Draws = 0;           // Caster draws submitted this frame
+    uint32_t UncachedDraws = 0;   // What redrawing every caster in every cascade would have cost
+    uint32_t CachedCascades = 0;  // Reused their static cache
+    uint32_t StaticRefreshes = 0; // Cached cascades whose static casters were redrawn
+};
+
+struct ShadowFrame {
+    int CascadeCount = 0;         // 0 = no shadows this frame
+    ShadowCascadeDraws Cascades[ShadowCascades::MaxCascades];
+    glm::vec4 Splits = glm::vec4(0.0f);     // View depth where each cascade ends
+    glm::vec4 TexelSizes = glm::vec4(0.0f); // World units per texel, for the receiver's normal offset
+    ShadowFrameStats Stats;
+};
+
+// Everything the GL thread needs to draw one frame. Built on the main thread and not touched
+// by it again until the render thread releases the slot.
+struct FrameSnapshot {
+    uint64_t FrameIndex = 0;
+    double PoseTime = 0.0;          // Simulation time the frame's poses are interpolated to
+    glm::mat4 View = glm::mat4(1.0f);
+    glm::mat4 Projection = glm::mat4(1.0f);
+    glm::mat4 ViewProjection = glm::mat4(1.0f);
+    glm::vec3 CameraPos = glm::vec3(0.0f);
+    glm::vec3 SunDirection = glm::vec3(0.0f, -1.0f, 0.0f); // Directional light, pointing away from the sun
+    bool UseQueries = false;        // Run the query pass and predicate the predicated layer
+    bool DepthPrepass = false;      // Lay down opaque depth first, then shade with GL_EQUAL
+    bool DrawBatches = false;       // Replay packets as multi-draw-indirect batches (LitFeatures has DRAW_BATCH)
+    uint32_t LitFeatures = 0;       // ShaderVariants mask of the lit program to draw with
+    int SwapInterval = 1;           // From the pacing mode; applied by the GL thread when it changes
+    bool DynamicResolution = false; // Scene at a GPU-time-driven scale, upscaled under the UI
+    bool SharpenUpscale = true;
+    ResolutionScaler::Settings Resolution;
+    uint32_t VisibleCount = 0;
+    double FrameMilliseconds = 0.0; // Main thread: since the previous frame started building
+    double BuildMilliseconds = 0.0;
+    CommandQueue Commands;          // Visible draws, recorded and sorted
+    std::vector<QueryBox> Queries;  // Boxes for the query pass, in visible order
+    ClusteredLightData Lights;      // Point/spot lights binned for this frame's camera
+    ShadowFrame Shadows;            // Culled casters per cascade for the directional light
+    UIDrawData UI;
+};
+
+// One row of the per-frame stats log (--stats).
+struct FrameTiming {
+    uint64_t FrameIndex = 0;
+    double FrameMilliseconds = 0.0;
+    double BuildMilliseconds = 0.0;
+    double SubmitMilliseconds = 0.0;
+    double PresentMilliseconds = 0.0;
+    double GpuMilliseconds = -1.0;  // Filled in later from the GPU profiler; -1 if the frame was never resolved
+    std::vector<std::pair<const char*, double>> GpuPasses; // Profiler scope name and GPU milliseconds, same source
+    uint32_t Visible = 0;
+    uint32_t Packets = 0;
+    uint32_t ShadowDraws = 0;
+    uint32_t ShadowDrawsUncached = 0;
+    float ResolutionScale = 1.0f;
+    double PresentIntervalMilliseconds = 0.0; // Since the previous present finished
+    double CaptureMilliseconds = 0.0;         // GL thread time spent on --output readback this frame
+};
+
+// What the render thread reports back to the main thread's overlay, published once per frame.
+struct RenderThreadStats {
+    uint64_t FramesSubmitted = 0;
+    uint64_t LastFrameIndex = 0;
+    double WaitMilliseconds = 0.0;    // Idle, waiting for the main thread to publish a frame
+    double SubmitMilliseconds = 0.0;  // Packets, query pass and UI
+    double PresentMilliseconds = 0.0; // Buffer swap, including any vsync wait
+    OcclusionQueries::Stats Queries;
+    ShaderVariants::Stats LitVariants;
+    FrameIntervals::Stats Presents;   // Present-to-present intervals, recent frames
+    FrameCapture::Stats Capture;
+    RenderGraph::Stats Graph;
+    RenderGraphExecutor::Stats GraphPool;
+    Mesh::DynamicStats DeformingMesh; // --deforming-mesh uploads
+    int SwapInterval = 0;             // In effect, after any adaptive-vsync fallback
+    float ResolutionScale = 1.0f;     // Scene scale per axis, 1 without dynamic resolution
+    float ResolutionHeadroom = 0.0f;  // Share of the GPU budget left
+    double ScaledMilliseconds = 0.0;  // Smoothed cost the scale is steered by
+    int SceneWidth = 0;
+    int SceneHeight = 0;
+    uint32_t DrawBatches = 0;         // Multi-draw calls the renderer issued, last presented frame
+    uint32_t BatchedDraws = 0;        // Draws inside them
+    bool HasStream = false;
+    bool StreamPersistent = false;
+    uint64_t StreamWaitedFrames = 0;
+    int64_t StreamBytesUsed = 0;      // Written into the ring by the last presented frame
+    int64_t StreamBytesPerFrame = 0;
+};
+
+#endif // FRAMESNAPSHOT_H
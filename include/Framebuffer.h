@@ -0,0 +1,42 @@
+// include/Framebuffer.h
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <vector>
+
+// Offscreen render target: RGBA8 color texture plus a 24-bit depth renderbuffer.
+class Framebuffer {
+public:
+    Framebuffer();
+    ~Framebuffer();
+
+    // Needs a current context. Recreating with a new size replaces the attachments.
+    bool Create(int width, int height);
+    void Destroy();
+
+    // Binds for drawing and sets the viewport to the full target.
+    void Bind() const;
+    static void BindDefault(int width, int height);
+
+    // Synchronous readback of the color attachment, tightly packed RGBA, bottom row first.
+    bool ReadPixels(std::vector<uint8_t>& rgba) const;
+
+    bool IsValid() const { return m_FramebufferID != 0; }
+    GLuint GetID() const { return m_FramebufferID; }
+    GLuint GetColorTexture() const { return m_ColorTexture; }
+    int GetWidth() const { return m_Width; }
+    int GetHeight() const { return m_Height; }
+
+    Framebuffer(const Framebuffer&) = delete; Framebuffer& operator=(const Framebuffer&) = delete; Framebuffer(Framebuffer&&) = delete; Framebuffer& operator=(Framebuffer&&) = delete;
+
+private:
+    GLuint m_FramebufferID = 0;
+    GLuint m_ColorTexture = 0;
+    GLuint m_DepthRenderbuffer = 0;
+    int m_Width = 0;
+    int m_Height = 0;
+};
+
+#endif // FRAMEBUFFER_H
@@ -0,0 +1,60 @@
+// include/FrustumCuller.h
+#ifndef FRUSTUMCULLER_H
+#define FRUSTUMCULLER_H
+
+#include "Bounds.h"
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+// World-space bounds of every cullable object, stored structure-of-arrays so the plane
+// tests run 4 (SSE/NEON) or 8 (AVX2) objects per iteration. Each object is rejected if
+// either its box or its sphere is fully behind any frustum plane.
+class FrustumCuller {
+public:
+    enum class SimdPath { Scalar, SSE, NEON, AVX2 };
+
+    struct Stats {
+        uint32_t Tested = 0;
+        uint32_t Visible = 0;
+        double MillisecondsCPU = 0.0;
+        unsigned int SlicesUsed = 1;
+    };
+
+    // Returns the object's index; indices stay stable until RemoveSwap.
+    uint32_t Add(const AABB& worldBox, const BoundingSphere& worldSphere);
+    uint32_t Add(const AABB& worldBox);
+    void Set(uint32_t index, const AABB& worldBox, const BoundingSphere& worldSphere);
+    void Set(uint32_t index, const AABB& worldBox);
+    // Moves the last object into 'index'; returns the old index of the moved object (or index itself if it was last).
+    uint32_t RemoveSwap(uint32_t index);
+    void Clear();
+    void Reserve(size_t count);
+    size_t Size() const { return m_CenterX.size(); }
+
+    // Appends the indices of visible objects to outVisible (cleared first), in ascending order.
+    // With a JobSystem and enough objects, the work is split into slices across workers.
+    void Cull(const Frustum& frustum, std::vector<uint32_t>& outVisible, JobSystem* jobs = nullptr);
+
+    const Stats& GetLastStats() const { return m_LastStats; }
+    static SimdPath GetSimdPath();
+    static const char* GetSimdPathName();
+
+    // Objects below this count are culled on the calling thread even if a JobSystem is given.
+    static constexpr size_t ParallelThreshold = 16384;
+
+private:
+    void CullRange(const Frustum& frustum, size_t begin, size_t end, std::vector<uint32_t>& out) const;
+    void CullRangeScalar(const Frustum& frustum, size_t begin, size_t end, std::vector<uint32_t>& out) const;
+
+    // SoA storage: centre, half-extents and sphere radius
+    std::vector<float> m_CenterX, m_CenterY, m_CenterZ;
+    std::vector<float> m_ExtentX, m_ExtentY, m_ExtentZ;
+    std::vector<float> m_Radius;
+
+    std::vector<std::vector<uint32_t>> m_SliceResults; // Reused per-slice output for parallel culls
+    Stats m_LastStats;
+};
+
+#endif // FRUSTUMCULLER_H
@@ -0,0 +1,48 @@
+#ifndef GLEXTENSIONS_H
+#define GLEXTENSIONS_H
+
+#include <glad/glad.h>
+
+// glad was generated for the 4.1 core profile (the macOS ceiling), so anything newer
+// is declared here and loaded at runtime only when the driver actually exposes it.
+
+#ifndef GL_ARB_multi_draw_indirect
+#define GL_ARB_multi_draw_indirect 1
+typedef void (APIENTRYP PFNGLMULTIDRAWELEMENTSINDIRECTPROC)(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride);
+#endif
+
+#ifndef GL_ARB_buffer_storage
+#define GL_ARB_buffer_storage 1
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_COHERENT_BIT 0x0080
+#define GL_DYNAMIC_STORAGE_BIT 0x0100
+#define GL_CLIENT_STORAGE_BIT 0x0200
+typedef void (APIENTRYP PFNGLBUFFERSTORAGEPROC)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+#endif
+
+#ifndef GL_ARB_invalidate_subdata
+#define GL_ARB_invalidate_subdata 1
+typedef void (APIENTRYP PFNGLINVALIDATEFRAMEBUFFERPROC)(GLenum target, GLsizei numAttachments, const GLenum* attachments);
+#endif
+
+namespace GLExtensions {
+    // Call once after gladLoadGLLoader, with the same loader function.
+    bool Load(GLADloadproc loader);
+
+    // True if the context is at least major.minor or lists the named extension.
+    bool IsVersionAtLeast(int major, int minor);
+    bool IsSupported(const char* extensionName);
+
+    // Feature queries (valid after Load)
+    bool HasMultiDrawIndirect();
+    bool HasBaseInstance(); // Indirect commands' BaseInstance offsets instanced attributes
+    bool HasBufferStorage();
+    bool HasInvalidateSubdata();
+
+    // Entry points (nullptr when unsupported)
+    extern PFNGLMULTIDRAWELEMENTSINDIRECTPROC MultiDrawElementsIndirect;
+    extern PFNGLBUFFERSTORAGEPROC BufferStorage;
+    extern PFNGLINVALIDATEFRAMEBUFFERPROC InvalidateFramebuffer;
+}
+
+#endif // GLEXTENSIONS_H
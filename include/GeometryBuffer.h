@@ -0,0 +1,116 @@
+// include/GeometryBuffer.h
+#ifndef GEOMETRYBUFFER_H
+#define GEOMETRYBUFFER_H
+
+#include "VertexArray.h" // Vertex struct
+#include <glad/glad.h>
+#include <vector>
+#include <cstddef>
+
+// A sub-allocated slice of a GeometryBuffer. Indices are stored relative to the
+// mesh, so draws add BaseVertex instead of rewriting them.
+struct GeometryRange {
+    GLint BaseVertex = 0;
+    GLuint VertexCount = 0;
+    GLuint FirstIndex = 0;
+    GLsizei IndexCount = 0;
+
+    bool IsValid() const { return IndexCount > 0; }
+};
+
+// Layout mandated by glMultiDrawElementsIndirect / glDrawElementsIndirect.
+struct DrawElementsIndirectCommand {
+    GLuint Count = 0;
+    GLuint InstanceCount = 1;
+    GLuint FirstIndex = 0;
+    GLint BaseVertex = 0;
+    GLuint BaseInstance = 0;
+};
+
+// First-fit free-list over [0, capacity) in element units; neighbouring free blocks coalesce.
+class RangeAllocator {
+public:
+    static constexpr GLuint InvalidOffset = ~0u;
+
+    void Reset(GLuint capacity);
+    GLuint Allocate(GLuint count);
+    void Free(GLuint offset, GLuint count);
+    void Grow(GLuint newCapacity);
+
+    GLuint GetCapacity() const { return m_Capacity; }
+    GLuint GetUsed() const { return m_Used; }
+
+private:
+    struct Block { GLuint Offset; GLuint Count; };
+    std::vector<Block> m_FreeBlocks; // Sorted by offset
+    GLuint m_Capacity = 0;
+    GLuint m_Used = 0;
+};
+
+// Shared vertex/index storage for every mesh of one vertex format (currently only Vertex).
+// All ranges live behind a single VAO, so consecutive draws never rebind.
+// Positions are also kept in a second, tightly packed stream (12 instead of 32 bytes per
+// vertex) behind its own VAO, sharing the index buffer, for depth-only passes.
+class GeometryBuffer {
+public:
+    static constexpr GLsizei PositionStride = 3 * sizeof(float);
+
+    GeometryBuffer();
+    ~GeometryBuffer();
+
+    bool Initialize(GLuint vertexCapacity, GLuint indexCapacity);
+    void Shutdown();
+
+    // Copies the data into free space, growing the buffers if needed.
+    bool Allocate(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, GeometryRange& outRange);
+    // Same, without uploading anything; the contents stay undefined until written with Update*().
+    bool Reserve(GLuint vertexCount, GLuint indexCount, GeometryRange& outRange);
+    void Free(const GeometryRange& range);
+
+    // Overwrite part of a range; 'first' counts from the start of the range. With 'unsynchronized'
+    // the sub-range is mapped without waiting for the GPU, so the caller has to know no draw in
+    // flight still reads it; otherwise it goes through glBufferSubData and the driver synchronizes.
+    bool UpdateVertices(const GeometryRange& range, GLuint first, const Vertex* vertices, GLuint count, bool unsynchronized);
+    bool UpdateIndices(const GeometryRange& range, GLuint first, const unsigned int* indices, GLuint count, bool unsynchronized);
+
+    void Bind() const;
+    void BindPositionOnly() const; // Attribute 0 only, from the position stream
+    void Unbind() const;
+
+    // Assumes Bind() was called.
+    void Draw(const GeometryRange& range) const;
+    // One glMultiDrawElementsIndirect when available, otherwise a loop of base-vertex draws.
+    void DrawBatch(const std::vector<DrawElementsIndirectCommand>& commands);
+
+    static DrawElementsIndirectCommand MakeCommand(const GeometryRange& range, GLuint instanceCount = 1, GLuint baseInstance = 0);
+
+    GLuint GetVAO() const { return m_VAO; }
+    GLuint GetPositionVAO() const { return m_PositionVAO; }
+    bool SupportsMultiDrawIndirect() const;
+    GLuint GetVertexCapacity() const { return m_VertexAllocator.GetCapacity(); }
+    GLuint GetVerticesUsed() const { return m_VertexAllocator.GetUsed(); }
+    GLuint GetIndexCapacity() const { return m_IndexAllocator.GetCapacity(); }
+    GLuint GetIndicesUsed() const { return m_IndexAllocator.GetUsed(); }
+    // Changes whenever the buffers are replaced (grown or shut down). Fences placed before then
+    // don't cover the GPU copy into the new buffers, so unsynchronized writes must not trust them.
+    uint64_t GetGeneration() const { return m_Generation; }
+
+    GeometryBuffer(const GeometryBuffer&) = delete; GeometryBuffer& operator=(const GeometryBuffer&) = delete; GeometryBuffer(GeometryBuffer&&) = delete; GeometryBuffer& operator=(GeometryBuffer&&) = delete;
+
+private:
+    bool GrowVertexBuffer(GLuint minCapacity);
+    bool GrowIndexBuffer(GLuint minCapacity);
+    static GLuint ResizeBuffer(GLuint oldBuffer, GLsizeiptr oldSize, GLsizeiptr newSize);
+    static void Write(GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data, bool unsynchronized);
+    void SetupVertexAttributes() const;
+    void SetupPositionAttributes() const;
+
+    GLuint m_VAO = 0, m_VBO = 0, m_EBO = 0, m_IndirectBuffer = 0;
+    GLuint m_PositionVAO = 0, m_PositionVBO = 0; // Position stream, same vertex offsets as m_VBO
+    RangeAllocator m_VertexAllocator;
+    RangeAllocator m_IndexAllocator;
+    std::vector<float> m_PositionScratch; // Allocate() gathers positions here before uploading
+    uint64_t m_Generation = 0;
+};
+
+#endif // GEOMETRYBUFFER_H
@@ -0,0 +1,161 @@
+// include/GpuProfiler.h
+#ifndef GPUPROFILER_H
+#define GPUPROFILER_H
+
+#include <glad/glad.h>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// GPU timing of named scopes through GL_TIMESTAMP queries. Each scope writes a timestamp when
+// it begins and ends; a frame's queries are only read back once the driver reports them
+// available, FrameRingSize - 1 frames later at most, so the CPU never waits on the GPU.
+// Frames whose results are still missing when their query set is reused are dropped.
+//
+// BeginFrame/EndFrame/BeginScope/EndScope run on the thread that owns the GL context; the
+// stats and capture calls may come from any thread.
+class GpuProfiler {
+public:
+    static constexpr int FrameRingSize = 4;
+    static constexpr int MaxScopesPerFrame = 64;
+    static constexpr int HistorySize = 240; // Samples behind the averages and percentiles
+
+    struct ScopeStats {
+        const char* Name = nullptr;
+        int Depth = 0;                // Nesting level, 0 for top-level scopes
+        double GpuLast = 0.0;         // Milliseconds
+        double GpuAverage = 0.0;
+        double GpuP50 = 0.0;
+        double GpuP95 = 0.0;
+        double GpuP99 = 0.0;
+        double CpuLast = 0.0;         // Time between the scope's begin and end calls on the GL thread
+        double CpuAverage = 0.0;
+        double CpuP95 = 0.0;
+        double GpuStart = 0.0;        // Offset into the last resolved frame, for the timeline
+        double CpuStart = 0.0;
+    };
+
+    struct FrameStats {
+        uint64_t Resolved = 0;        // Frames whose timings were read back
+        uint64_t Dropped = 0;         // Frames whose query set was reused before the results arrived
+        uint32_t LatencyFrames = 0;   // Frames between issuing and reading back the last resolved frame
+        double GpuMilliseconds = 0.0; // First scope begin to last scope end, last resolved frame
+        double CpuMilliseconds = 0.0;
+    };
+
+    struct FrameTime {
+        uint64_t Frame = 0;           // Counts BeginFrame calls, from 1
+        double GpuMilliseconds = 0.0;
+        std::vector<std::pair<const char*, double>> Scopes; // Every scope's GPU milliseconds, in begin order
+    };
+
+    GpuProfiler();
+    ~GpuProfiler();
+
+    // Needs a current context; false when timer queries are unavailable.
+    bool Initialize();
+    void Shutdown();
+    bool IsInitialized() const { return !m_Frames.empty(); }
+
+    // Reads back finished frames (never blocks), then starts recording a new one.
+    void BeginFrame();
+    void EndFrame();
+
+    // 'name' must outlive the profiler (string literals). Scopes nest; unbalanced ends are ignored.
+    void BeginScope(const char* name);
+    void EndScope();
+
+    // Copies the per-scope statistics, ordered as first seen.
+    void GetStats(std::vector<ScopeStats>& scopes, FrameStats& frame) const;
+    FrameStats GetFrameStats() const;
+    // GPU milliseconds of the last resolved frame's top-level scopes, summed, leaving out the one
+    // named 'excludedScope' (if any). Unlike FrameStats::GpuMilliseconds, idle gaps between
+    // scopes don't count, so a CPU-bound frame doesn't look GPU-bound.
+    double GetLastBusyMilliseconds(const char* excludedScope = nullptr) const;
+
+    // Records the next 'frameCount' resolved frames and writes them as Chrome trace JSON
+    // (chrome://tracing, Perfetto) to 'path', with CPU and GPU scopes on one timeline.
+    void RequestCapture(int frameCount, const std::string& path);
+    bool IsCapturing() const;
+
+    // Keeps every resolved frame's GPU time until taken (benchmarks, per-frame stats). Off by default.
+    void SetKeepFrameTimes(bool keep);
+    void TakeFrameTimes(std::vector<FrameTime>& out);
+
+    GpuProfiler(const GpuProfiler&) = delete; GpuProfiler& operator=(const GpuProfiler&) = delete; GpuProfiler(GpuProfiler&&) = delete; GpuProfiler& operator=(GpuProfiler&&) = delete;
+
+private:
+    struct ScopeRecord {
+        const char* Name;
+        int Depth;
+        int BeginQuery;  // Index into the frame's query set, -1 while the scope is open
+        int EndQuery;
+        int64_t CpuBegin; // Nanoseconds, steady clock (the CPU profiler's timebase)
+        int64_t CpuEnd;
+    };
+
+    struct FrameRecord {
+        GLuint Queries[MaxScopesPerFrame * 2] = {};
+        int UsedQueries = 0;
+        std::vector<ScopeRecord> Scopes;
+        uint64_t FrameIndex = 0;
+        int64_t GpuToCpuOffset = 0; // Add to a GPU timestamp to get steady-clock nanoseconds
+        bool Pending = false;       // Ended, results not read back yet
+    };
+
+    struct ScopeHistory {
+        const char* Name = nullptr;
+        int Depth = 0;
+        float Gpu[HistorySize] = {};
+        float Cpu[HistorySize] = {};
+        int Count = 0;
+        int Next = 0;
+        double GpuStart = 0.0;
+        double CpuStart = 0.0;
+    };
+
+    struct TraceEvent {
+        const char* Name;
+        int64_t Start;    // Nanoseconds, steady clock
+        int64_t Duration;
+        int Track;        // 0 = GL thread (CPU), 1 = GPU
+    };
+
+    int64_t CpuNow() const;
+    void Calibrate();
+    bool Resolve(FrameRecord& frame);
+    ScopeHistory& FindHistory(const char* name, int depth); // Caller holds m_Mutex
+    void WriteCapture();                                  // Caller holds m_Mutex
+
+    std::vector<FrameRecord> m_Frames;
+    FrameRecord* m_Current = nullptr;
+    std::vector<int> m_OpenScopes; // Indices into m_Current->Scopes
+    uint64_t m_FrameIndex = 0;
+    int64_t m_GpuToCpuOffset = 0;
+
+    mutable std::mutex m_Mutex; // Guards everything below
+    std::vector<ScopeHistory> m_History;
+    FrameStats m_FrameStats;
+    std::vector<std::pair<const char*, double>> m_LastTopLevel; // Last resolved frame's depth-0 scopes, GPU milliseconds
+    std::vector<TraceEvent> m_Capture;
+    std::string m_CapturePath;
+    int m_CaptureRemaining = 0;
+    bool m_KeepFrameTimes = false;
+    std::vector<FrameTime> m_FrameTimes;
+};
+
+// Times the enclosing block; a null profiler makes it a no-op.
+class GpuProfileScope {
+public:
+    GpuProfileScope(GpuProfiler* profiler, const char* name) : m_Profiler(profiler) { if (m_Profiler) m_Profiler->BeginScope(name); }
+    ~GpuProfileScope() { if (m_Profiler) m_Profiler->EndScope(); }
+    GpuProfileScope(const GpuProfileScope&) = delete; GpuProfileScope& operator=(const GpuProfileScope&) = delete; GpuProfileScope(GpuProfileScope&&) = delete; GpuProfileScope& operator=(GpuProfileScope&&) = delete;
+
+private:
+    GpuProfiler* m_Profiler;
+};
+
+#endif // GPUPROFILER_H
@@ -0,0 +1,52 @@
+// include/JobSystem.h
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small fixed-size worker pool for data-parallel CPU work (culling, transforms, binning...).
+// The calling thread always takes part, so worker index 0 is "the thread that called
+// ParallelFor" and workers are 1..GetWorkerCount()-1.
+class JobSystem {
+public:
+    // 0 = hardware_concurrency - 1 background threads.
+    explicit JobSystem(unsigned int threadCount = 0);
+    ~JobSystem();
+
+    // Number of distinct worker indices a job can observe (background threads + caller).
+    unsigned int GetWorkerCount() const { return static_cast<unsigned int>(m_Threads.size()) + 1; }
+
+    // Index of the current thread inside this pool (0 for any thread that isn't a pool worker).
+    static unsigned int GetCurrentWorkerIndex();
+
+    // Splits [0, count) into chunks of at least minChunkSize and runs fn(begin, end, workerIndex)
+    // on them across the pool. Blocks until all chunks are done.
+    void ParallelFor(size_t count, size_t minChunkSize, const std::function<void(size_t, size_t, unsigned int)>& fn);
+
+    // Fire-and-forget; use Wait() or your own synchronization to join.
+    void Submit(std::function<void()> task);
+    // Runs queued tasks on the calling thread until the queue is empty and nothing is in flight.
+    void Wait();
+
+    JobSystem(const JobSystem&) = delete; JobSystem& operator=(const JobSystem&) = delete; JobSystem(JobSystem&&) = delete; JobSystem& operator=(JobSystem&&) = delete;
+
+private:
+    void WorkerLoop(unsigned int workerIndex);
+    bool TryRunOne();
+
+    std::vector<std::thread> m_Threads;
+    std::deque<std::function<void()>> m_Queue;
+    std::mutex m_QueueMutex;
+    std::condition_variable m_QueueCondition;
+    std::atomic<int> m_InFlight{ 0 }; // Queued + running tasks
+    bool m_Stopping = false;
+};
+
+#endif // JOBSYSTEM_H
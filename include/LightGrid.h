@@ -0,0 +1,82 @@
+// include/LightGrid.h
+#ifndef LIGHTGRID_H
+#define LIGHTGRID_H
+
+#include "Bounds.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+// A point light, or a spot light when SpotOuterCos > -1. Lighting falls to zero at Range.
+struct Light {
+    glm::vec3 Position = glm::vec3(0.0f);     // World space
+    float Range = 5.0f;
+    glm::vec3 Color = glm::vec3(1.0f);
+    float Intensity = 1.0f;
+    glm::vec3 Direction = glm::vec3(0.0f, -1.0f, 0.0f); // Spot lights: cone axis, pointing away from the light
+    float SpotOuterCos = -1.0f;               // Cosine of the cone's outer half-angle
+    float SpotInnerCos = -1.0f;               // Full intensity inside this cosine
+};
+
+// One frame's binned lights, packed the way the shader reads them from texture buffers.
+struct ClusteredLightData {
+    static constexpr int TexelsPerLight = 3;
+    std::vector<glm::vec4> Lights;   // Per light: position/range, color*intensity/outer cos, direction/inner cos
+    std::vector<uint32_t> Clusters;  // Per cluster: offset into Indices, light count
+    std::vector<uint32_t> Indices;   // Light indices, grouped by cluster
+    glm::uvec3 Dimensions = glm::uvec3(0);
+    float SliceScale = 0.0f;         // slice = log(view depth) * SliceScale + SliceBias
+    float SliceBias = 0.0f;
+
+    uint32_t GetLightCount() const { return static_cast<uint32_t>(Lights.size() / TexelsPerLight); }
+};
+
+// Clustered forward lighting, CPU side: the view frustum is split into froxels (screen tiles
+// x exponential depth slices) and every light is assigned to the froxels its sphere touches,
+// so a fragment only loops over the lights of its own cluster.
+class LightGrid {
+public:
+    struct Stats {
+        uint32_t Lights = 0;         // Lights passed in
+        uint32_t VisibleLights = 0;  // Overlapping the frustum's depth range
+        uint32_t Assignments = 0;    // Light/cluster pairs
+        uint32_t MaxPerCluster = 0;
+        uint32_t OccupiedClusters = 0;
+        double Milliseconds = 0.0;
+    };
+
+    explicit LightGrid(uint32_t tilesX = 16, uint32_t tilesY = 9, uint32_t slices = 24);
+
+    // Bins 'lights' for a symmetric perspective projection and fills 'out'. Parallel over depth
+    // slices when a job system is given.
+    void Build(const glm::mat4& view, const glm::mat4& projection, const std::vector<Light>& lights, ClusteredLightData& out, JobSystem* jobs = nullptr);
+
+    uint32_t GetClusterCount() const { return m_TilesX * m_TilesY * m_Slices; }
+    const Stats& GetLastStats() const { return m_Stats; }
+
+private:
+    // What binning needs per light, in view space (depth positive into the screen)
+    struct LightBounds {
+        glm::vec3 Center;
+        float Radius;
+        uint32_t Slice0, Slice1;
+        uint32_t TileX0, TileX1, TileY0, TileY1;
+        bool Visible;
+    };
+
+    void UpdateClusterBounds(float xScale, float yScale, float nearPlane, float farPlane);
+    uint32_t GetSlice(float depth) const;
+    void BinSlice(uint32_t slice, const std::vector<Light>& lights);
+
+    uint32_t m_TilesX, m_TilesY, m_Slices;
+    float m_XScale = 0.0f, m_YScale = 0.0f, m_Near = 0.0f, m_Far = 0.0f; // Projection the cluster bounds were built for
+    float m_SliceScale = 0.0f, m_SliceBias = 0.0f;
+    std::vector<AABB> m_ClusterBounds;                  // View space
+    std::vector<LightBounds> m_LightBounds;
+    std::vector<std::vector<uint32_t>> m_ClusterLights; // Per cluster; each slice's clusters are filled by one job
+    Stats m_Stats;
+};
+
+#endif // LIGHTGRID_H
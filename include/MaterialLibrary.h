@@ -0,0 +1,59 @@
+// include/MaterialLibrary.h
+#ifndef MATERIALLIBRARY_H
+#define MATERIALLIBRARY_H
+
+#include "TexturePacker.h"
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+class TextureArray;
+
+// A surface's diffuse texture: a layer of a texture array, and the entry's rect in that layer
+// when it sits in an atlas page.
+struct Material {
+    std::string Name;
+    const TextureArray* Array = nullptr; // Set by MaterialLibrary::Build
+    int Layer = 0;
+    glm::vec4 UVTransform = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f); // uv' = xy + fract(uv) * zw
+};
+
+// Owns every material and the texture arrays behind them. Materials are added at import and
+// laid out together by Build(), so textures of the same size share an array and odd sizes share
+// atlas pages; draws then only rebind when the array changes. Materials keep their address.
+class MaterialLibrary {
+public:
+    struct Stats {
+        uint32_t Materials = 0;
+        uint32_t Arrays = 0;
+        uint32_t ArrayLayers = 0; // Whole textures
+        uint32_t AtlasPages = 0;
+        size_t Bytes = 0;         // Level 0 of every array
+    };
+
+    MaterialLibrary();
+    ~MaterialLibrary();
+
+    // Reads an image file; nullptr if it can't be read. Usable once Build() has run.
+    const Material* AddTexture(const std::string& filePath);
+    // A flat color, for untextured geometry.
+    const Material* AddSolidColor(const std::string& name, uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255);
+
+    // Packs every material added since the last Build() and uploads their arrays.
+    bool Build(const TexturePacker::Settings& settings = TexturePacker::Settings{});
+
+    const Stats& GetStats() const { return m_Stats; }
+
+    MaterialLibrary(const MaterialLibrary&) = delete; MaterialLibrary& operator=(const MaterialLibrary&) = delete; MaterialLibrary(MaterialLibrary&&) = delete; MaterialLibrary& operator=(MaterialLibrary&&) = delete;
+
+private:
+    const Material* Add(const std::string& name, TexturePacker::Image image);
+
+    std::vector<std::unique_ptr<Material>> m_Materials;
+    std::vector<TexturePacker::Image> m_Pending; // Images of the last m_Pending.size() materials
+    std::vector<std::unique_ptr<TextureArray>> m_Arrays;
+    Stats m_Stats;
+};
+
+#endif // MATERIALLIBRARY_H
@@ -2,19 +2,100 @@
 #ifndef MESH_H
 #define MESH_H
 #include "VertexArray.h" // <-- Includes Vertex struct now
+#include "GeometryBuffer.h"
+#include "Bounds.h"
 #include <glad/glad.h>
+#include <cstdint>
 #include <vector>
 #include <cstddef>
+// Lightweight handle to a range inside a shared GeometryBuffer (which must outlive the mesh).
+// Movable, so meshes can live in containers by value; a moved-from mesh is empty.
+//
+// Dynamic meshes reserve room for a maximum vertex and index count and can change any sub-range
+// afterwards. Each keeps DynamicCopies ranges and a CPU copy of its data: updates only change
+// the CPU copy, and Commit() switches draws to the next range after bringing it up to date with
+// everything written since it was last drawn. The upload maps the range unsynchronized, never
+// waiting on a frame in flight, only once the fence placed when draws moved off it has passed.
+// Without such a fence (the first uploads into each range, or the GeometryBuffer reallocated its
+// buffers since) or if the GPU is further behind than that, the upload goes through
+// glBufferSubData instead. Updates and Commit() need the GL context, like construction.
 class Mesh {
 public:
-    Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    static constexpr int DynamicCopies = 2;
+
+    struct DynamicStats {
+        uint64_t Commits = 0;            // That uploaded something
+        uint64_t UploadedBytes = 0;
+        uint64_t SynchronizedUploads = 0; // The range had no fence from this buffer generation, or it hadn't passed yet
+    };
+
+    Mesh(GeometryBuffer& geometry, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    // Dynamic mesh with room for maxVertices/maxIndices, starting out with 'vertices' and 'indices'
+    // (committed already; both may be empty, the mesh then only becomes valid once it has indices).
+    Mesh(GeometryBuffer& geometry, GLuint maxVertices, GLuint maxIndices,
+         const std::vector<Vertex>& vertices = {}, const std::vector<unsigned int>& indices = {});
     ~Mesh();
+    Mesh(Mesh&& other) noexcept;
+    Mesh& operator=(Mesh&& other) noexcept;
     void Bind() const;
     void Unbind() const;
     void Draw() const;
-    Mesh(const Mesh&) = delete; Mesh& operator=(const Mesh&) = delete; Mesh(Mesh&&) = delete; Mesh& operator=(Mesh&&) = delete;
+    bool IsValid() const { return m_Range.IsValid(); }
+    bool IsDynamic() const { return !m_Copies.empty(); }
+    GLuint GetVAO() const { return m_Geometry ? m_Geometry->GetVAO() : 0; }
+    GLuint GetPositionVAO() const { return m_Geometry ? m_Geometry->GetPositionVAO() : 0; }
+    const GeometryRange& GetRange() const { return m_Range; }
+    GeometryBuffer* GetGeometry() const { return m_Geometry; }
+    const AABB& GetBounds() const { return m_Bounds; }                    // Object space, computed at load (dynamic: at Commit)
+    const BoundingSphere& GetBoundingSphere() const { return m_BoundingSphere; }
+
+    // Dynamic meshes only. Writes 'count' elements starting at 'first', which may be at most the
+    // current count (so the mesh grows without holes) while the end stays within the maximum.
+    bool UpdateVertices(GLuint first, const Vertex* vertices, GLuint count);
+    bool UpdateIndices(GLuint first, const unsigned int* indices, GLuint count);
+    // Changes the counts drawn; new elements are zeroed until written.
+    bool Resize(GLuint vertexCount, GLuint indexCount);
+    // Once per frame before the mesh is drawn: uploads pending changes into the next range and draws from it.
+    void Commit();
+    // Object-space bounds that hold every shape the mesh will take. Commit() then keeps them
+    // instead of recomputing them, so other threads (culling) may read them while it runs.
+    void SetFixedBounds(const AABB& bounds);
+    GLuint GetVertexCount() const { return static_cast<GLuint>(m_Vertices.size()); }
+    GLuint GetIndexCount() const { return static_cast<GLuint>(m_Indices.size()); }
+    const DynamicStats& GetDynamicStats() const { return m_Stats; }
+
+    Mesh(const Mesh&) = delete; Mesh& operator=(const Mesh&) = delete;
 private:
-    GLuint m_VAO = 0, m_VBO = 0, m_EBO = 0; GLsizei m_IndexCount = 0;
+    // Element interval [Begin, End) written since a range was last brought up to date
+    struct DirtyRange {
+        GLuint Begin = ~0u;
+        GLuint End = 0;
+        void Add(GLuint begin, GLuint end) { if (begin < Begin) Begin = begin; if (end > End) End = end; }
+        bool IsEmpty() const { return Begin >= End; }
+    };
+    struct Copy {
+        GeometryRange Allocation;        // Full capacity
+        GLsync Fence = nullptr;          // Placed when draws moved off this range
+        uint64_t FenceGeneration = 0;    // GeometryBuffer::GetGeneration() at the time
+        DirtyRange Vertices;
+        DirtyRange Indices;
+    };
+
+    GeometryBuffer* m_Geometry = nullptr; GeometryRange m_Range; // Dynamic: the current copy, drawn counts
+    AABB m_Bounds; BoundingSphere m_BoundingSphere;
+    std::vector<Copy> m_Copies;            // Dynamic meshes only, from here down
+    std::vector<Vertex> m_Vertices;        // CPU copy of what is drawn
+    std::vector<unsigned int> m_Indices;
+    GLuint m_MaxVertices = 0;
+    GLuint m_MaxIndices = 0;
+    int m_Current = 0;
+    bool m_Pending = false;                // Changes no range has yet
+    bool m_BoundsDirty = false;
+    bool m_FixedBounds = false;
+    DynamicStats m_Stats;
     void SetupMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    void MarkVertices(GLuint begin, GLuint end);
+    void MarkIndices(GLuint begin, GLuint end);
+    void Release();
 };
-#endif // MESH_H
\ No newline at end of file
+#endif // MESH_H
@@ -0,0 +1,104 @@
+// include/OcclusionCuller.h
+#ifndef OCCLUSIONCULLER_H
+#define OCCLUSIONCULLER_H
+
+#include "Bounds.h"
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+// Positions-only occluder geometry kept on the CPU (usually a simplified copy of a render mesh).
+struct OccluderMesh {
+    std::vector<glm::vec3> Positions;
+    std::vector<uint32_t> Indices;
+};
+
+// Software occlusion culling against a small masked depth buffer. Occluder triangles are
+// rasterized into 8x4-pixel tiles, each holding a coverage mask and two max-depth layers;
+// bands of tile rows are rasterized in parallel. A pixel only counts as covered when it lies
+// entirely inside a triangle, and stored depths are the farthest the triangle reaches in the
+// tile, so an occludee box is rejected only if it is behind occluders everywhere it projects.
+// Depth is NDC z remapped to [0, 1] (larger is farther).
+class OcclusionCuller {
+public:
+    struct Stats {
+        uint32_t OccluderTriangles = 0;   // Submitted this frame
+        uint32_t RasterizedTriangles = 0; // After near-plane clipping and off-screen/degenerate rejection
+        uint32_t Tested = 0;
+        uint32_t Rejected = 0;
+        double RasterMilliseconds = 0.0;
+        double TestMilliseconds = 0.0;
+
+        float GetRejectedPercent() const { return Tested > 0 ? 100.0f * Rejected / Tested : 0.0f; }
+    };
+
+    static constexpr int TileWidth = 8;
+    static constexpr int TileHeight = 4;
+
+    // Resolution is rounded up to whole tiles; a few hundred pixels wide is plenty.
+    bool Initialize(int width, int height);
+
+    // Vertex clustering on a uniform grid (cellSize in object units; 0 picks 1/32 of the largest extent).
+    // Averaged cluster positions stay inside convex regions, but occluders should still be authored
+    // or chosen so they don't extend past the visible surface they stand in for.
+    static OccluderMesh SimplifyOccluder(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, float cellSize = 0.0f);
+    // Returns the index to pass to SubmitOccluder.
+    uint32_t AddOccluderMesh(OccluderMesh mesh);
+    void ClearOccluderMeshes() { m_OccluderMeshes.clear(); }
+
+    // --- Per frame: BeginFrame, SubmitOccluder..., RasterizeOccluders, then CullOccludees/IsOccluded ---
+    void BeginFrame(const glm::mat4& viewProjection);
+    void SubmitOccluder(uint32_t meshIndex, const glm::mat4& model);
+    void RasterizeOccluders(JobSystem* jobs = nullptr);
+    // Removes occluded entries from 'visible' (indices into worldBounds), keeping the order of the rest.
+    void CullOccludees(const std::vector<AABB>& worldBounds, std::vector<uint32_t>& visible, JobSystem* jobs = nullptr);
+    bool IsOccluded(const AABB& worldBox) const;
+
+    const Stats& GetLastStats() const { return m_LastStats; }
+    int GetWidth() const { return m_Width; }
+    int GetHeight() const { return m_Height; }
+    // Per-pixel conservative depth (1 where nothing is known), for debugging/visualisation.
+    void ResolveDepth(std::vector<float>& outDepth) const;
+
+private:
+    struct Tile {
+        uint32_t Mask = 0;    // Pixels covered by the working layer (bit = row * 8 + column)
+        float ZMax0 = 1.0f;   // Whole tile is covered at or nearer than this
+        float ZMax1 = 0.0f;   // Masked pixels are covered at or nearer than this
+    };
+
+    struct ScreenVertex {
+        float X, Y, Z;
+    };
+
+    struct TriangleSetup {
+        float EdgeA[3], EdgeB[3], EdgeC[3]; // Inner-conservative edge functions, >= 0 inside
+        float ZA, ZB, ZC;                   // Depth plane z = ZA * x + ZB * y + ZC
+        float ZMax;
+        int TileMinX, TileMaxX, TileMinY, TileMaxY;
+        bool Valid;
+    };
+
+    ScreenVertex ToScreen(const glm::vec4& clip) const;
+    // Clips one submitted triangle against the near plane and sets up the (up to two) pieces.
+    void SetupClippedTriangle(size_t triangleIndex, TriangleSetup& first, TriangleSetup& second) const;
+    bool SetupTriangle(const ScreenVertex& v0, const ScreenVertex& v1, const ScreenVertex& v2, TriangleSetup& out) const;
+    void RasterizeBand(int tileRowBegin, int tileRowEnd);
+    static uint32_t ComputeCoverage(const TriangleSetup& tri, float tileX, float tileY);
+    static void UpdateTile(Tile& tile, uint32_t coverage, float triangleDepth);
+
+    int m_Width = 0, m_Height = 0;
+    int m_TilesX = 0, m_TilesY = 0;
+    std::vector<Tile> m_Tiles;
+    std::vector<OccluderMesh> m_OccluderMeshes;
+
+    glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+    std::vector<glm::vec4> m_ClipVertices;      // Submitted occluders in clip space
+    std::vector<uint32_t> m_Indices;            // Into m_ClipVertices
+    std::vector<TriangleSetup> m_Triangles;     // Two slots per submitted triangle (near-plane clipping can split it)
+    std::vector<uint8_t> m_OccludedFlags;       // Reused per-candidate results for parallel tests
+    Stats m_LastStats;
+};
+
+#endif // OCCLUSIONCULLER_H
@@ -0,0 +1,85 @@
+// include/OcclusionQueries.h
+#ifndef OCCLUSIONQUERIES_H
+#define OCCLUSIONQUERIES_H
+
+#include "Bounds.h"
+#include "GeometryBuffer.h"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Shader;
+
+// Hardware occlusion culling for heavy objects. Each frame an object's world box is drawn
+// (no color/depth writes) inside a GL_ANY_SAMPLES_PASSED query, and the real draw is wrapped
+// in glBeginConditionalRender on the query from the previous frame with GL_QUERY_NO_WAIT,
+// so the CPU never waits: if that result isn't ready yet the GPU simply draws.
+// Objects therefore appear one frame late when they come out from behind an occluder.
+class OcclusionQueries {
+public:
+    struct Stats {
+        uint32_t Issued = 0;          // Box queries drawn this frame
+        uint32_t Conditional = 0;     // Draws predicated on last frame's query
+        uint32_t Unconditional = 0;   // No usable query (first frame, camera inside the box...)
+        // Results read back this frame (from queries issued in earlier frames)
+        uint32_t Hits = 0;            // Samples passed: the object was drawn
+        uint32_t Misses = 0;          // Fully occluded: the GPU skipped the draw
+        uint32_t Late = 0;            // Query slots reused before their result came back
+        double AverageLatencyFrames = 0.0;
+        uint32_t MaxLatencyFrames = 0;
+    };
+
+    // Queries per object; a result may take up to QueryRingSize - 1 frames to arrive before its slot is reused.
+    static constexpr int QueryRingSize = 3;
+
+    OcclusionQueries();
+    ~OcclusionQueries();
+
+    // Loads the bounds shader and puts a unit cube into the shared geometry buffer (which must outlive this).
+    bool Initialize(GeometryBuffer& geometry);
+    void Shutdown();
+
+    // Returns a handle for an object that opts in to query-based culling.
+    uint32_t Register();
+
+    // Advances the frame and collects any results that have arrived (never blocks).
+    void BeginFrame();
+
+    // Draws box queries for this frame. Call after the regular occluders are drawn. EndQueryPass()
+    // rebinds the program and vertex array that were bound before BeginQueryPass().
+    void BeginQueryPass(const glm::mat4& viewProjection, const glm::vec3& cameraPosition);
+    void Query(uint32_t handle, const AABB& worldBox);
+    void EndQueryPass();
+
+    // Wraps the object's real draw; returns false (draw unconditionally) when last frame has no query for it.
+    bool BeginConditionalDraw(uint32_t handle);
+    void EndConditionalDraw();
+
+    const Stats& GetLastStats() const { return m_Stats; }
+    size_t GetRegisteredCount() const { return m_Entries.size(); }
+
+    OcclusionQueries(const OcclusionQueries&) = delete; OcclusionQueries& operator=(const OcclusionQueries&) = delete; OcclusionQueries(OcclusionQueries&&) = delete; OcclusionQueries& operator=(OcclusionQueries&&) = delete;
+
+private:
+    struct Entry {
+        GLuint Queries[QueryRingSize] = {};
+        uint64_t IssueFrame[QueryRingSize] = {}; // 0 = slot holds no query
+        bool Pending[QueryRingSize] = {};        // Issued, result not read back yet
+    };
+
+    GeometryBuffer* m_Geometry = nullptr;
+    GeometryRange m_CubeRange;
+    std::unique_ptr<Shader> m_BoundsShader;
+    std::vector<Entry> m_Entries;
+    uint64_t m_FrameIndex = 0;
+
+    glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+    glm::vec3 m_CameraPosition = glm::vec3(0.0f);
+    GLint m_PreviousProgram = 0;     // Bound outside the query pass
+    GLint m_PreviousVertexArray = 0;
+    Stats m_Stats;
+};
+
+#endif // OCCLUSIONQUERIES_H
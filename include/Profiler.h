@@ -0,0 +1,92 @@
+// include/Profiler.h
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// CPU instrumentation profiler. PROFILE_SCOPE("Name") times the enclosing block on the calling
+// thread; without ENGINE_ENABLE_PROFILER every macro expands to nothing and none of the code
+// below is compiled. Names must be string literals (or otherwise outlive the profiler).
+//
+// Each thread records into its own fixed-size ring of completed scopes, written only by that
+// thread and published with a release store, so recording never locks or allocates. Readers
+// copy from the rings and discard whatever was overwritten while they copied.
+
+#ifdef ENGINE_ENABLE_PROFILER
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Profiler {
+    const uint32_t RingSize = 1u << 14; // Completed scopes kept per track
+
+    struct Event {
+        const char* Name;
+        int64_t Begin;  // Nanoseconds, steady clock
+        int64_t End;
+        uint32_t Depth; // Nesting level on its track
+    };
+
+    // A timeline in the trace: one per thread that records, plus any created explicitly.
+    struct Track;
+
+    // Same clock for every track (and for GpuProfiler's calibrated GPU times).
+    inline int64_t Now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Names the calling thread's track ("Thread N" until then).
+    void SetThreadName(const char* name);
+
+    // A track fed through RecordEvent() instead of scopes, e.g. resolved GPU timings.
+    // Only one thread may record into it.
+    Track* CreateTrack(const char* name);
+    void RecordEvent(Track* track, const char* name, uint32_t depth, int64_t begin, int64_t end);
+
+    // Main thread, once per frame; frame boundaries for the timeline view.
+    void MarkFrame();
+    // Start and end of the frame 'framesAgo' frames before the current one (1 = last complete frame).
+    bool GetFrameRange(int framesAgo, int64_t& begin, int64_t& end);
+
+    struct TrackSnapshot {
+        std::string Name;
+        std::vector<Event> Events; // Overlapping [begin, end], in end order
+        uint32_t MaxDepth = 0;
+    };
+    // Copies every track's events that overlap [begin, end]. Tracks without events are skipped.
+    void Collect(int64_t begin, int64_t end, std::vector<TrackSnapshot>& tracks);
+
+    // Writes everything still in the rings as Chrome trace JSON (chrome://tracing, Perfetto).
+    bool WriteChromeTrace(const std::string& path);
+
+    // Scope bookkeeping behind PROFILE_SCOPE
+    void BeginScope();
+    void EndScope(const char* name, int64_t begin);
+
+    class ScopedEvent {
+    public:
+        explicit ScopedEvent(const char* name) : m_Name(name) { BeginScope(); m_Begin = Now(); }
+        ~ScopedEvent() { EndScope(m_Name, m_Begin); }
+        ScopedEvent(const ScopedEvent&) = delete; ScopedEvent& operator=(const ScopedEvent&) = delete; ScopedEvent(ScopedEvent&&) = delete; ScopedEvent& operator=(ScopedEvent&&) = delete;
+
+    private:
+        const char* m_Name;
+        int64_t m_Begin;
+    };
+}
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) Profiler::ScopedEvent PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_THREAD(name) Profiler::SetThreadName(name)
+#define PROFILE_FRAME() Profiler::MarkFrame()
+
+#else
+
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+
+#endif // ENGINE_ENABLE_PROFILER
+
+#endif // PROFILER_H
@@ -0,0 +1,138 @@
+// include/RenderGraph.h
+#ifndef RENDERGRAPH_H
+#define RENDERGRAPH_H
+
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+class RenderGraphExecutor;
+
+typedef uint32_t RenderResource;
+const RenderResource InvalidRenderResource = ~0u;
+
+enum class RenderFormat : uint8_t {
+    RGBA8,
+    RGBA16F,
+    Depth24
+};
+
+struct RenderTextureDesc {
+    int Width = 0;
+    int Height = 0;
+    RenderFormat Format = RenderFormat::RGBA8;
+
+    bool operator==(const RenderTextureDesc& other) const { return Width == other.Width && Height == other.Height && Format == other.Format; }
+    bool operator!=(const RenderTextureDesc& other) const { return !(*this == other); }
+};
+
+// Frame graph: the frame's passes are declared each frame together with the resources they read
+// and write, then compiled before anything is drawn. Compiling orders the passes by those
+// dependencies, culls every pass whose results nothing ends up using, works out how long each
+// transient texture lives, and lets transients whose lifetimes don't overlap share one physical
+// texture. It also marks where a transient's contents are undefined (its first write) or dead (its
+// last use), so the executor can invalidate them instead of loading or storing them. No GL calls;
+// RenderGraphExecutor runs the compiled graph.
+//
+// A pass that only reads a resource runs after every pass that writes it. Passes that write the
+// same resource keep their declaration order unless those reads require otherwise, and so do
+// passes that don't depend on each other at all; reads that depend on each other in a circle fail
+// to compile. So the shadow pass may be declared after the passes sampling the shadow maps, but
+// passes drawing into one target are declared in the order they draw. A pass renders into the
+// transients it writes (one color and one depth texture at most) and samples the ones it only
+// reads, so a depth-tested pass that leaves depth alone still declares the depth it tests against
+// as a write.
+class RenderGraph {
+public:
+    static constexpr uint32_t NoFramebuffer = ~0u;
+
+    typedef std::function<void(const RenderGraphExecutor&)> ExecuteFunction;
+
+    struct Resource {
+        const char* Name = nullptr;
+        RenderTextureDesc Desc;         // Imported framebuffers: only the size, for the viewport
+        bool Imported = false;
+        bool Output = false;            // Imported: read after the graph (display, next frame), so its writers stay
+        uint32_t Framebuffer = NoFramebuffer; // Imported: bound for the passes that use it
+        // Filled in by Compile(), transients only
+        int FirstPass = -1;             // Position in GetOrder() of the first and last kept pass using it, -1 if none does
+        int LastPass = -1;
+        int Physical = -1;              // Index into GetPhysicalTextures()
+    };
+
+    struct Pass {
+        const char* Name = nullptr;     // Also the GPU profiler scope, so a string literal
+        std::vector<RenderResource> Reads;
+        std::vector<RenderResource> Writes;
+        ExecuteFunction Execute;
+        bool SideEffects = false;       // Kept even when nothing reads what it writes
+        // Filled in by Compile()
+        bool Culled = false;
+        RenderResource Color = InvalidRenderResource;  // Transient attachments
+        RenderResource Depth = InvalidRenderResource;
+        RenderResource Target = InvalidRenderResource; // Imported framebuffer, when there are no attachments
+        std::vector<RenderResource> DiscardBefore;     // Attachments written here first: no need to load
+        std::vector<RenderResource> DiscardAfter;      // Attachments nothing uses later: no need to store
+    };
+
+    struct Stats {
+        uint32_t Passes = 0;
+        uint32_t CulledPasses = 0;
+        uint32_t Transients = 0;
+        uint32_t PhysicalTextures = 0;
+        uint32_t Discards = 0;
+        uint64_t TransientBytes = 0;    // Every transient in its own texture
+        uint64_t PhysicalBytes = 0;     // After aliasing: what the textures of the pool take
+        uint64_t PeakLiveBytes = 0;     // Most transient bytes alive at any one pass (the lower bound)
+    };
+
+    static uint64_t GetBytes(const RenderTextureDesc& desc);
+    static bool IsDepthFormat(RenderFormat format);
+
+    // Drops the previous frame's passes and resources (keeping their storage).
+    void Reset();
+
+    // A texture that only lives within the frame.
+    RenderResource CreateTexture(const char* name, const RenderTextureDesc& desc);
+    // Something the graph doesn't own: the back buffer, shadow maps, query objects. 'framebuffer'
+    // (0 for the window) is bound for passes that use it, sized width x height; leave it at
+    // NoFramebuffer for resources that only order the passes.
+    RenderResource Import(const char* name, bool output, uint32_t framebuffer = NoFramebuffer, int width = 0, int height = 0);
+    void AddPass(const char* name, std::initializer_list<RenderResource> reads, std::initializer_list<RenderResource> writes,
+                 ExecuteFunction execute, bool sideEffects = false);
+
+    // Orders and culls the passes, places the transients and plans the discards. False (with an
+    // error logged) when the declarations don't make sense; nothing should be executed then.
+    bool Compile();
+
+    const std::vector<Pass>& GetPasses() const { return m_Passes; } // Declaration order
+    const std::vector<uint32_t>& GetOrder() const { return m_Order; } // Execution order, indices into GetPasses(), culled ones included
+    const std::vector<Resource>& GetResources() const { return m_Resources; }
+    const std::vector<RenderTextureDesc>& GetPhysicalTextures() const { return m_Physical; }
+    const Stats& GetStats() const { return m_Stats; }
+    // "Shadows > Clear > Opaque > UI (culled: Query pass)" in execution order, for the log.
+    std::string Describe() const;
+
+private:
+    bool Validate() const;
+    bool Sort();
+    bool Reaches(uint32_t from, uint32_t to);
+    void Cull();
+    void PlaceTransients();
+
+    std::vector<Pass> m_Passes;
+    std::vector<Resource> m_Resources;
+    std::vector<RenderTextureDesc> m_Physical;
+    std::vector<int> m_PhysicalLastPass;
+    std::vector<uint32_t> m_Order;
+    std::vector<bool> m_Edges;          // Sort() scratch: [from * passes + to], from runs first
+    std::vector<uint32_t> m_Stack;      // Reaches() scratch
+    std::vector<bool> m_Visited;
+    std::vector<bool> m_Needed;         // Cull() scratch, per resource
+    std::vector<RenderResource> m_Transients; // PlaceTransients() scratch
+    Stats m_Stats;
+};
+
+#endif // RENDERGRAPH_H
@@ -0,0 +1,74 @@
+// include/RenderGraphExecutor.h
+#ifndef RENDERGRAPHEXECUTOR_H
+#define RENDERGRAPHEXECUTOR_H
+
+#include "RenderGraph.h"
+#include <glad/glad.h>
+#include <cstdint>
+#include <vector>
+
+class GpuProfiler;
+
+// Runs a compiled RenderGraph. Physical transient textures come from a pool that outlives the
+// frame: a texture of the right size and format is reused when one is free, created otherwise,
+// and freed once no graph has asked for it in EvictAfterFrames frames. Framebuffers are cached
+// per combination of attachments. Kept passes run in the graph's execution order; each gets its
+// target bound with a full-size viewport, runs inside a GPU profiler scope of its name, and has
+// the attachments the graph marked as discarded invalidated before or after it (GL 4.3 or
+// ARB_invalidate_subdata; skipped elsewhere).
+class RenderGraphExecutor {
+public:
+    static constexpr uint64_t EvictAfterFrames = 120;
+
+    struct Stats {
+        uint32_t Textures = 0;       // Held by the pool, used this frame or not
+        uint64_t Bytes = 0;
+        uint32_t Framebuffers = 0;
+        uint64_t Created = 0;        // Textures created so far; steady once the frame settles
+        uint32_t Invalidated = 0;    // Attachments invalidated last frame
+    };
+
+    RenderGraphExecutor();
+    ~RenderGraphExecutor();
+
+    // Needs a current context.
+    void Execute(const RenderGraph& graph, GpuProfiler* profiler);
+    void Shutdown();
+
+    // For pass callbacks: the texture behind a transient, and a framebuffer with only that texture
+    // attached (to blit from). 0 for imported or culled resources.
+    GLuint GetTexture(RenderResource resource) const;
+    GLuint GetFramebuffer(RenderResource resource) const;
+
+    const Stats& GetStats() const { return m_Stats; }
+
+    RenderGraphExecutor(const RenderGraphExecutor&) = delete; RenderGraphExecutor& operator=(const RenderGraphExecutor&) = delete; RenderGraphExecutor(RenderGraphExecutor&&) = delete; RenderGraphExecutor& operator=(RenderGraphExecutor&&) = delete;
+
+private:
+    struct PooledTexture {
+        RenderTextureDesc Desc;
+        GLuint Texture = 0;
+        uint64_t LastUsed = 0;   // m_Frame it was last handed out in
+    };
+
+    struct CachedFramebuffer {
+        GLuint Color = 0;
+        GLuint Depth = 0;
+        GLuint Framebuffer = 0;
+    };
+
+    GLuint AcquireTexture(const RenderTextureDesc& desc);
+    void Evict();
+    GLuint FindFramebuffer(GLuint color, GLuint depth) const;
+    void BindTarget(const RenderGraph::Pass& pass) const;
+    void Invalidate(const std::vector<RenderResource>& attachments);
+
+    const RenderGraph* m_Graph = nullptr; // While executing
+    std::vector<PooledTexture> m_Pool;
+    std::vector<GLuint> m_Physical;       // This frame's texture per physical index of the graph
+    mutable std::vector<CachedFramebuffer> m_Framebuffers;
+    uint64_t m_Frame = 0;
+    Stats m_Stats;
+};
+
+#endif // RENDERGRAPHEXECUTOR_H
@@ -4,25 +4,86 @@
 
 struct SDL_Window; typedef void* SDL_GLContext;
 #include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
 // Forward declare classes used by pointer/reference
 class Shader;
 class Mesh; // <-- Forward declare Mesh
+class StreamingBuffer;
+class TextureArray;
+class GeometryBuffer;
+struct GeometryRange;
+struct DrawElementsIndirectCommand;
+struct Material;
+class Framebuffer;
+struct DrawPacket;
+struct DrawUniforms;
 
 class Renderer {
 public:
     Renderer(); ~Renderer();
     bool Initialize(SDL_Window* window); void Shutdown();
-    void Clear() const;
+    void BeginFrame(); // Call before recording any draws for the frame
+    void Clear();
     // Change parameter type to Mesh
     void PrepareDraw(const Shader& shader, const Mesh& mesh, const glm::mat4& mvpMatrix); // <-- Change type
     void DrawPrepared() const;
-    void Present(SDL_Window* window);
+    // Replays one recorded packet: uModel/uMVP from its uniforms, diffuse texture on unit 0 (rebound only on change).
+    void SubmitPacket(const Shader& shader, const DrawPacket& packet, const DrawUniforms& uniforms);
+    // Depth pre-pass variant: uMVP only, positions from the geometry's position-only stream, no texture.
+    void SubmitDepthPacket(const Shader& shader, const DrawPacket& packet, const DrawUniforms& uniforms);
+    // Same, for draws that aren't recorded packets (shadow casters).
+    void SubmitDepthDraw(const Shader& shader, const Mesh& mesh, const glm::mat4& mvp);
+    // Batched replay for programs built with DRAW_BATCH: consecutive packets sharing the program, geometry
+    // buffer and texture array become one multi-draw-indirect call, each draw's model/MVP/material written
+    // to the frame stream and fetched per instance through BaseInstance. FlushBatch() after the last packet.
+    bool SupportsDrawBatches() const;
+    void SubmitBatched(const Shader& shader, const DrawPacket& packet, const DrawUniforms& uniforms);
+    void SubmitDepthBatched(const Shader& shader, const DrawPacket& packet, const DrawUniforms& uniforms);
+    void FlushBatch();
+    struct BatchStats { uint32_t Batches = 0; uint32_t Draws = 0; };
+    const BatchStats& GetBatchStats() const { return m_LastBatchStats; } // Last presented frame
+    void Present(SDL_Window* window); // Swaps, or only flushes when drawing offscreen
+    // Headless: every frame draws into a width x height offscreen target instead of the window.
+    bool SetOffscreenTarget(int width, int height);
+    const Framebuffer* GetOffscreenTarget() const { return m_Offscreen.get(); }
+    // 1 = vsync, 0 = off, -1 = adaptive (falls back to 1 where unsupported). Returns the interval in effect.
+    int SetSwapInterval(int interval);
     SDL_GLContext GetGLContext() const { return m_Context; }
+    StreamingBuffer* GetFrameStream() const { return m_FrameStream.get(); } // Draw batch data; null without batches
     Renderer(const Renderer&) = delete; Renderer& operator=(const Renderer&) = delete; Renderer(Renderer&&) = delete; Renderer& operator=(Renderer&&) = delete;
 private:
     SDL_GLContext m_Context = nullptr;
     const Shader* m_CurrentShader = nullptr;
     const Mesh* m_CurrentMesh = nullptr; // <-- Change type and name
+    unsigned int m_BoundVAO = 0; // Last VAO bound through PrepareDraw
+    const TextureArray* m_BoundArray = nullptr; // Last material array bound through SubmitPacket
+    const Material* m_BoundMaterial = nullptr;  // Material whose layer/rect uniforms m_MaterialShader holds
+    const Shader* m_MaterialShader = nullptr;
+    std::unique_ptr<StreamingBuffer> m_FrameStream;
+
+    // Layout of the DRAW_BATCH instance attributes, one per draw
+    struct BatchInstance {
+        glm::mat4 Model;
+        glm::mat4 MVP;
+        glm::vec4 MaterialUV;
+        float MaterialLayer = 0.0f;
+        float Padding[3] = {};
+    };
+    void Batch(const Shader& shader, const DrawPacket& packet, const DrawUniforms& uniforms, bool positionOnly);
+    static void SetBatchAttributes(unsigned int buffer, intptr_t offset); // On the bound VAO
+    static void SetBatchConstants(const BatchInstance& instance);         // Instead, with the arrays disabled
+    const Shader* m_BatchShader = nullptr;
+    GeometryBuffer* m_BatchGeometry = nullptr;
+    const TextureArray* m_BatchArray = nullptr;
+    bool m_BatchPositionOnly = false;
+    std::vector<BatchInstance> m_BatchInstances;
+    std::vector<GeometryRange> m_BatchRanges;
+    std::vector<DrawElementsIndirectCommand> m_BatchCommands; // Built from m_BatchRanges when flushed
+    BatchStats m_BatchStats;
+    BatchStats m_LastBatchStats;
+    std::unique_ptr<Framebuffer> m_Offscreen;
 };
 #endif // RENDERER_H
\ No newline at end of file
@@ -0,0 +1,42 @@
+// include/ResolutionScaler.h
+#ifndef RESOLUTIONSCALER_H
+#define RESOLUTIONSCALER_H
+
+#include <cstdint>
+
+// Feedback loop behind dynamic resolution: picks the render scale (per axis, relative to the
+// output) that keeps measured frame cost under a budget. Cost is modeled as proportional to the
+// pixel count, so every measurement gives an estimate of the scale that would just fit.
+// Measurements usually arrive a few frames late (GPU timer queries), so each one is paired with
+// the scale its frame was actually rendered at. No GL calls.
+class ResolutionScaler {
+public:
+    static constexpr int HistorySize = 16; // Scales remembered for late measurements
+
+    struct Settings {
+        float MinScale = 0.5f;
+        float MaxScale = 1.0f;
+        float BudgetMilliseconds = 16.0f;
+    };
+
+    // Call once per frame, before rendering it; returns the scale to render it at.
+    // 'milliseconds' is the cost of the frame rendered 'latencyFrames' calls ago (1 = the previous
+    // one), or <= 0 when no new measurement arrived since the last call.
+    float Update(double milliseconds, uint32_t latencyFrames, const Settings& settings);
+    void Reset(float scale);
+
+    float GetScale() const { return m_Scale; }
+    // Share of the budget left over by the smoothed cost; negative when over budget.
+    float GetHeadroom() const { return m_Headroom; }
+    double GetSmoothedMilliseconds() const { return m_SmoothedMilliseconds; }
+
+private:
+    float m_Scale = 1.0f;
+    float m_Headroom = 0.0f;
+    double m_SmoothedMilliseconds = 0.0;
+    double m_CostPerPixel = 0.0; // Smoothed milliseconds at scale 1
+    float m_History[HistorySize] = {};
+    uint32_t m_Frames = 0;       // Updates so far; m_History[m_Frames % HistorySize] is the next slot
+};
+
+#endif // RESOLUTIONSCALER_H
@@ -0,0 +1,58 @@
+// include/SceneComponents.h
+#ifndef SCENECOMPONENTS_H
+#define SCENECOMPONENTS_H
+
+#include "TransformSystem.h"
+#include "LightGrid.h" // Light, used directly as a component
+#include <glm/glm.hpp>
+#include <cstdint>
+
+class Mesh;
+struct Material;
+typedef struct Mix_Chunk Mix_Chunk;
+
+// Components used by the application's scene. Assets (meshes, textures, sound chunks) are owned
+// elsewhere; components only point at them.
+
+// Node in the TransformSystem; systems that change the hierarchy declare write access to this.
+struct TransformComponent {
+    TransformHandle Handle = InvalidTransform;
+};
+
+struct MeshRenderer {
+    const Mesh* MeshRef = nullptr;
+    const Material* MaterialRef = nullptr;
+    int OccluderIndex = -1;  // Simplified occluder mesh in the occlusion culler, -1 if it hides nothing
+    int OcclusionQuery = -1; // Handle in OcclusionQueries if this (heavy) object opts in to GPU queries
+    bool Static = false;     // Never moves; its shadow may be cached in the far cascades
+};
+
+// Constant spin around a local axis.
+struct Spin {
+    glm::vec3 Axis = glm::vec3(0.0f, 1.0f, 0.0f);
+    float Speed = 0.0f; // Radians per second
+    float Angle = 0.0f;
+    float PreviousAngle = 0.0f; // At the previous simulation step; rendering interpolates from it
+};
+
+// Moves a Light in a horizontal circle; spot lights keep pointing at the center.
+struct LightOrbit {
+    glm::vec3 Center = glm::vec3(0.0f);
+    float Radius = 1.0f;
+    float Height = 0.0f;  // Above Center
+    float Speed = 0.0f;   // Radians per second
+    float Angle = 0.0f;
+    float PreviousAngle = 0.0f; // At the previous simulation step
+};
+
+enum class AudioRequest : uint8_t { None, Play, Pause, Resume, Stop };
+
+// A sound played through SDL_mixer; gameplay code sets Request and the audio system applies it.
+struct AudioSource {
+    Mix_Chunk* Clip = nullptr;
+    int Loops = 0;       // As for Mix_PlayChannel (-1 = forever)
+    int Channel = -1;    // Mixer channel while playing or paused, -1 otherwise
+    AudioRequest Request = AudioRequest::None;
+};
+
+#endif // SCENECOMPONENTS_H
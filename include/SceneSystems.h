@@ -0,0 +1,51 @@
+// include/SceneSystems.h
+#ifndef SCENESYSTEMS_H
+#define SCENESYSTEMS_H
+
+#include "SceneComponents.h"
+#include "SystemScheduler.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+// A drawable extracted from the World for this frame; its index doubles as its slot in the frustum culler.
+struct SceneObject {
+    Entity Owner;
+    const Mesh* MeshRef = nullptr;
+    const Material* MaterialRef = nullptr;
+    TransformHandle Transform = InvalidTransform;
+    glm::mat4 Model = glm::mat4(1.0f); // World matrix from the transform hierarchy
+    int OccluderIndex = -1;
+    int OcclusionQuery = -1;
+    bool Static = false;
+};
+
+// Factories for the application's systems. Each creates its cached query on 'world';
+// the referenced objects must outlive the returned system.
+//
+// Simulation systems run at the fixed step and only advance component state, keeping the previous
+// step's value next to the current one. Pose systems run once per rendered frame and write the
+// state interpolated by 'alpha' (0 = previous step, 1 = latest) to what rendering reads.
+namespace SceneSystems {
+    // Simulation: advances Spin angles.
+    System CreateRotationSystem(World& world);
+
+    // Per frame: writes interpolated Spin angles into the transform hierarchy as local rotations.
+    System CreateSpinPoseSystem(World& world, TransformSystem& transforms, const float& alpha);
+
+    // Updates the transform hierarchy, then rebuilds the render list from every MeshRenderer.
+    System CreateRenderListSystem(World& world, TransformSystem& transforms, std::vector<SceneObject>& renderList);
+
+    // Simulation: advances LightOrbit angles.
+    System CreateLightOrbitSystem(World& world);
+
+    // Per frame: moves (and aims) orbiting lights to their interpolated angles.
+    System CreateLightPoseSystem(World& world, const float& alpha);
+
+    // Copies every Light into 'lights' for binning.
+    System CreateLightListSystem(World& world, std::vector<Light>& lights);
+
+    // Applies AudioSource requests through SDL_mixer and notices when sounds finish.
+    System CreateAudioSystem(World& world);
+}
+
+#endif // SCENESYSTEMS_H
@@ -10,6 +10,8 @@ class Shader {
 public:
     // Constructor: Reads and builds the shader
     Shader(const std::string& vertexPath, const std::string& fragmentPath);
+    // Takes ownership of an already linked program (see ShaderVariants)
+    explicit Shader(GLuint program);
     // Destructor: Deletes the shader program
     ~Shader();
 
@@ -21,11 +23,19 @@ public:
     void SetInt(const std::string& name, int value) const;
     void SetFloat(const std::string& name, float value) const;
     void SetMat4(const std::string& name, const glm::mat4& mat) const;
+    void SetVec2(const std::string& name, const glm::vec2& value) const;
     void SetVec3(const std::string& name, const glm::vec3& value) const;
+    void SetVec4(const std::string& name, const glm::vec4& value) const;
      // Add more setters as needed (Vec2, Vec4, Mat3 etc.)
 
     GLuint GetProgramID() const { return m_ProgramID; }
 
+    // Building blocks for programs assembled elsewhere; both return 0 and log on failure.
+    static GLuint CompileStage(GLenum type, const std::string& source, const std::string& name);
+    static GLuint LinkStages(GLuint vertexShader, GLuint fragmentShader);
+
+    Shader(const Shader&) = delete; Shader& operator=(const Shader&) = delete; Shader(Shader&&) = delete; Shader& operator=(Shader&&) = delete;
+
 private:
     GLuint m_ProgramID = 0; // Handle to the shader program
 
@@ -0,0 +1,30 @@
+// include/ShaderPreprocessor.h
+#ifndef SHADERPREPROCESSOR_H
+#define SHADERPREPROCESSOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Text-level GLSL preprocessing done before the driver sees a source: #include splicing and
+// feature #defines. No GL calls, so sources can be expanded on any thread.
+namespace ShaderPreprocessor {
+    // Reads 'filePath' and replaces every #include "file" line (path relative to the including
+    // file) with that file's expanded text. Each file is spliced in once; later includes of it
+    // are dropped. #line directives keep compiler messages pointing at the right line, with the
+    // source-string number being the index into 'outFiles'. Returns false on a missing file or
+    // a malformed #include.
+    bool Expand(const std::string& filePath, std::string& outSource, std::vector<std::string>& outFiles);
+
+    // Inserts "#define KEY 1" for every key right after the #version line (or at the top).
+    std::string AddDefines(const std::string& source, const std::vector<std::string>& defines);
+
+    // True if 'identifier' occurs in 'source' as a whole token, so defines a stage never tests
+    // can be left out and otherwise identical variants share one compiled stage.
+    bool References(const std::string& source, const std::string& identifier);
+
+    // 64-bit FNV-1a of the text; identical final sources compile once.
+    uint64_t Hash(const std::string& text);
+}
+
+#endif // SHADERPREPROCESSOR_H
@@ -0,0 +1,74 @@
+// include/ShaderVariants.h
+#ifndef SHADERVARIANTS_H
+#define SHADERVARIANTS_H
+
+#include "Shader.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Permutations of one vertex/fragment pair. Features are #define keys, each one a bit of the
+// variant mask; a variant is compiled on first use (or pre-warmed from a manifest) and then
+// looked up by mask. Compiled stages are shared by source hash: a stage only receives the
+// defines it actually mentions, so variants that differ in a fragment-only feature reuse the
+// same vertex shader, and variants whose sources come out identical reuse the same program.
+// GL calls only from the thread owning the context.
+class ShaderVariants {
+public:
+    static constexpr int MaxFeatures = 32;
+
+    struct Stats {
+        uint32_t Variants = 0;      // Masks resolved to a program (or to a failure)
+        uint32_t Programs = 0;      // Distinct linked programs
+        uint32_t StageCompiles = 0;
+        uint32_t StageReuses = 0;   // Stages found in the hash cache instead of compiled
+        double CompileMilliseconds = 0.0;
+    };
+
+    ShaderVariants(const std::string& vertexPath, const std::string& fragmentPath);
+    ~ShaderVariants();
+
+    // Declares the next feature; returns its bit. Declare every feature before the first Get().
+    uint32_t DeclareFeature(const std::string& define);
+    // 0 for an unknown define.
+    uint32_t GetFeatureMask(const std::string& define) const;
+
+    // Reads and expands both sources (#includes). No GL calls.
+    bool Load();
+
+    // The program for 'features', compiling it on first use. nullptr if it failed to build; the
+    // failure is remembered, so a broken variant is reported once, not every frame.
+    const Shader* Get(uint32_t features);
+
+    // Compiles every variant listed in 'manifestPath': one per line, the defines it enables
+    // separated by spaces, "-" for none, '#' starts a comment. Returns how many built.
+    int Prewarm(const std::string& manifestPath);
+
+    const Stats& GetStats() const { return m_Stats; }
+    void Clear(); // Deletes every program and stage; sources and features stay
+
+    ShaderVariants(const ShaderVariants&) = delete; ShaderVariants& operator=(const ShaderVariants&) = delete; ShaderVariants(ShaderVariants&&) = delete; ShaderVariants& operator=(ShaderVariants&&) = delete;
+
+private:
+    struct StageSource {
+        std::string Path;
+        std::string Text;                // Expanded, without feature defines
+        std::vector<std::string> Files;  // Source-string numbers in #line directives
+        std::vector<uint32_t> UsedFeatures; // Indices of the features this stage mentions
+    };
+
+    GLuint GetStage(GLenum type, const StageSource& stage, uint32_t features, uint64_t& outHash);
+    std::string DescribeVariant(uint32_t features) const;
+
+    StageSource m_Vertex;
+    StageSource m_Fragment;
+    std::vector<std::string> m_Features;                        // Define per bit
+    std::unordered_map<uint64_t, GLuint> m_Stages;              // Final stage source hash -> shader object
+    std::unordered_map<uint64_t, std::unique_ptr<Shader>> m_Programs; // Vertex and fragment hash -> program
+    std::unordered_map<uint32_t, const Shader*> m_Variants;     // Feature mask -> program (nullptr = failed)
+    Stats m_Stats;
+};
+
+#endif // SHADERVARIANTS_H
@@ -0,0 +1,59 @@
+// include/ShadowCascades.h
+#ifndef SHADOWCASCADES_H
+#define SHADOWCASCADES_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+
+// Cascaded shadow maps for one directional light, CPU side: splits the camera's shadow range into
+// cascades, fits a light-space orthographic projection to each and decides which cascades may
+// reuse their cached static casters.
+//
+// Fits are stable: a cascade's extent depends only on its split distances and the field of view,
+// and its origin is snapped to whole shadow-map texels, so edges do not shimmer as the camera
+// turns or moves. Cached cascades are fit with extra padding and keep their position until the
+// camera leaves it; only then (or when the light or the static set changes) are their static
+// casters rendered again.
+class ShadowCascades {
+public:
+    static constexpr int MaxCascades = 4;
+
+    struct Cascade {
+        glm::mat4 ViewProjection = glm::mat4(1.0f); // World to light clip space
+        float SplitFar = 0.0f;      // View depth where this cascade hands over to the next
+        float TexelSize = 0.0f;     // World units per shadow-map texel
+        bool Cached = false;        // Static casters come from the cache layer
+        bool StaticDirty = true;    // Cached: static casters must be rendered (and stored) this frame
+    };
+
+    // 'firstCachedCascade' == cascadeCount disables caching altogether.
+    ShadowCascades(int cascadeCount = MaxCascades, int resolution = 2048, float shadowDistance = 40.0f,
+                   float splitLambda = 0.75f, int firstCachedCascade = 2);
+
+    // Fits every cascade to the camera. 'staticVersion' changes whenever a static caster is added,
+    // removed or moved; with 'useCache' false no cascade is cached (and all caches are dropped).
+    void Update(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& lightDirection, uint32_t staticVersion, bool useCache);
+
+    int GetCascadeCount() const { return m_CascadeCount; }
+    int GetResolution() const { return m_Resolution; }
+    const Cascade& GetCascade(int index) const { return m_Cascades[index]; }
+
+private:
+    struct CacheState {
+        bool Valid = false;
+        glm::vec3 Center = glm::vec3(0.0f); // Light space, texel-snapped
+        float Radius = 0.0f;
+    };
+
+    int m_CascadeCount;
+    int m_Resolution;
+    float m_ShadowDistance;
+    float m_SplitLambda;
+    int m_FirstCachedCascade;
+    Cascade m_Cascades[MaxCascades];
+    CacheState m_Caches[MaxCascades];
+    glm::vec3 m_CachedLightDirection = glm::vec3(0.0f);
+    uint32_t m_CachedStaticVersion = 0;
+};
+
+#endif // SHADOWCASCADES_H
@@ -0,0 +1,57 @@
+// include/ShadowMaps.h
+#ifndef SHADOWMAPS_H
+#define SHADOWMAPS_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+class Shader;
+
+// GL side of the cascaded shadow maps: one depth texture array with a layer per cascade, read by
+// the lit shader through a sampler2DArrayShadow, plus a second array holding each cached
+// cascade's static casters. A cached layer starts the frame as a depth blit from its cache
+// instead of a clear, so only the dynamic casters are drawn into it.
+class ShadowMaps {
+public:
+    static constexpr int TextureUnit = 4; // After the clustered lighting buffers
+
+    ShadowMaps();
+    ~ShadowMaps();
+
+    bool Initialize(int resolution, int layers);
+    void Shutdown();
+
+    // Bracket all shadow rendering: saves the bound framebuffer and viewport, enables depth clamp
+    // and polygon offset; EndPass() restores them.
+    void BeginPass();
+    void EndPass();
+
+    // Targets 'layer' for the following draws, cleared (BeginLayer) or seeded from the cache (RestoreLayer).
+    void BeginLayer(int layer);
+    void RestoreLayer(int layer);
+    // Copies what was drawn into 'layer' so far into its cache.
+    void StoreLayer(int layer);
+
+    // Points the shader's uShadowMap at the array and sets the cascade uniforms; 'cascadeCount' 0 turns shadows off.
+    void Bind(const Shader& shader, int cascadeCount, const glm::mat4* viewProjections, const glm::vec4& splits, const glm::vec4& texelSizes) const;
+
+    bool IsValid() const { return m_Framebuffer != 0; }
+    int GetResolution() const { return m_Resolution; }
+    int GetLayerCount() const { return m_Layers; }
+
+    ShadowMaps(const ShadowMaps&) = delete; ShadowMaps& operator=(const ShadowMaps&) = delete; ShadowMaps(ShadowMaps&&) = delete; ShadowMaps& operator=(ShadowMaps&&) = delete;
+
+private:
+    void BlitLayer(GLuint source, GLuint destination, int layer);
+
+    GLuint m_DepthArray = 0;       // Sampled with depth comparison
+    GLuint m_CacheArray = 0;       // Static casters of cached cascades
+    GLuint m_Framebuffer = 0;      // Draws into m_DepthArray
+    GLuint m_CacheFramebuffer = 0; // Reads/writes m_CacheArray in blits
+    int m_Resolution = 0;
+    int m_Layers = 0;
+    GLint m_SavedFramebuffer = 0;
+    GLint m_SavedViewport[4] = { 0, 0, 0, 0 };
+};
+
+#endif // SHADOWMAPS_H
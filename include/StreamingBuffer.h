@@ -0,0 +1,66 @@
+// include/StreamingBuffer.h
+#ifndef STREAMINGBUFFER_H
+#define STREAMINGBUFFER_H
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <vector>
+
+// CPU-writable space handed out by StreamingBuffer::Allocate.
+struct StreamAllocation {
+    void* Data = nullptr;  // Write here
+    GLintptr Offset = 0;   // Byte offset into the GL buffer for attribute pointers / binds
+    GLsizeiptr Size = 0;
+
+    bool IsValid() const { return Data != nullptr; }
+};
+
+// Ring of per-frame regions for dynamic data (the renderer's per-draw batch attributes).
+// With glBufferStorage the whole buffer stays persistently and coherently mapped; on GL 3.3
+// each allocation is mapped with GL_MAP_UNSYNCHRONIZED_BIT instead. Either way a fence per
+// region makes the CPU wait only if it laps the GPU.
+class StreamingBuffer {
+public:
+    StreamingBuffer();
+    ~StreamingBuffer();
+
+    bool Initialize(GLenum target, GLsizeiptr bytesPerFrame, int frameCount = 3);
+    void Shutdown();
+
+    // Waits for the GPU to release this frame's region.
+    void BeginFrame();
+    // Returns invalid if the frame's region is exhausted.
+    StreamAllocation Allocate(GLsizeiptr size, GLsizeiptr alignment = 16);
+    // Must be called before GL reads the allocation and before the next Allocate
+    // (a no-op when persistently mapped).
+    void Commit(const StreamAllocation& allocation);
+    // Fences the region and advances the ring.
+    void EndFrame();
+
+    void Bind() const;
+    GLuint GetBufferID() const { return m_Buffer; }
+    GLenum GetTarget() const { return m_Target; }
+    bool IsPersistent() const { return m_PersistentData != nullptr; }
+
+    // Number of frames the CPU had to block on the GPU before reusing a region.
+    uint64_t GetWaitedFrameCount() const { return m_WaitedFrames; }
+    GLsizeiptr GetBytesUsedThisFrame() const { return m_FrameHead; }
+    GLsizeiptr GetBytesPerFrame() const { return m_BytesPerFrame; }
+
+    StreamingBuffer(const StreamingBuffer&) = delete; StreamingBuffer& operator=(const StreamingBuffer&) = delete; StreamingBuffer(StreamingBuffer&&) = delete; StreamingBuffer& operator=(StreamingBuffer&&) = delete;
+
+private:
+    GLuint m_Buffer = 0;
+    GLenum m_Target = GL_ARRAY_BUFFER;
+    GLsizeiptr m_BytesPerFrame = 0;
+    int m_FrameCount = 0;
+    int m_FrameIndex = 0;
+    GLsizeiptr m_FrameHead = 0;        // Bytes handed out in the current region
+    unsigned char* m_PersistentData = nullptr;
+    std::vector<GLsync> m_Fences;      // One per region
+    uint64_t m_WaitedFrames = 0;
+    bool m_InFrame = false;
+    bool m_OverflowReported = false;
+};
+
+#endif // STREAMINGBUFFER_H
@@ -0,0 +1,47 @@
+// include/SystemScheduler.h
+#ifndef SYSTEMSCHEDULER_H
+#define SYSTEMSCHEDULER_H
+
+#include "ECS.h"
+#include <functional>
+#include <vector>
+
+class JobSystem;
+
+// A unit of per-frame work over the World. Reads/Writes are the component types it touches;
+// two systems conflict when one writes something the other reads or writes.
+struct System {
+    const char* Name = ""; // Also the profiler scope, so a string literal
+    ComponentMask Reads = 0;
+    ComponentMask Writes = 0;
+    bool MainThreadOnly = false; // Talks to SDL/GL or other main-thread APIs
+    // 'jobs' is only passed when the system runs alone in its phase, so it may split its own work.
+    std::function<void(World&, float deltaTime, JobSystem* jobs)> Run;
+};
+
+// Runs systems in registration order, grouped into phases: a system goes into the phase after
+// the last one holding a system it conflicts with, so conflicting systems keep their relative
+// order while independent ones share a phase and run concurrently on the JobSystem.
+class SystemScheduler {
+public:
+    void Add(System system);
+    void Clear();
+
+    void Run(World& world, float deltaTime, JobSystem* jobs = nullptr);
+
+    size_t GetSystemCount() const { return m_Systems.size(); }
+    const System& GetSystem(size_t index) const { return m_Systems[index]; }
+    double GetSystemMilliseconds(size_t index) const { return m_Milliseconds[index]; }
+    const std::vector<std::vector<uint32_t>>& GetPhases() const { return m_Phases; }
+
+    static bool Conflicts(const System& a, const System& b);
+
+private:
+    void RunSystem(uint32_t index, World& world, float deltaTime, JobSystem* jobs);
+
+    std::vector<System> m_Systems;
+    std::vector<std::vector<uint32_t>> m_Phases; // Indices into m_Systems
+    std::vector<double> m_Milliseconds;          // Last run time per system
+};
+
+#endif // SYSTEMSCHEDULER_H
@@ -11,6 +11,8 @@ public:
 
     // Load texture from file
     bool Load(const std::string& filePath);
+    // 1x1 texture of a single color, for untextured geometry
+    bool CreateSolidColor(unsigned char r, unsigned char g, unsigned char b, unsigned char a = 255);
 
     // Bind texture to a specific texture unit (e.g., 0 for GL_TEXTURE0)
     void Bind(unsigned int unit = 0) const;
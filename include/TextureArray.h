@@ -0,0 +1,35 @@
+// include/TextureArray.h
+#ifndef TEXTUREARRAY_H
+#define TEXTUREARRAY_H
+
+#include <glad/glad.h>
+#include <cstdint>
+
+// GL_TEXTURE_2D_ARRAY of RGBA8 layers, mipmapped. One bind serves every material in it; the
+// shader picks the layer per draw.
+class TextureArray {
+public:
+    TextureArray();
+    ~TextureArray();
+
+    // 'pixels' holds 'layers' images of width x height RGBA8, one after another. 'repeat' wraps
+    // (whole textures), otherwise clamps (atlas pages, where the shader wraps inside the entry).
+    bool Create(int width, int height, int layers, const uint8_t* pixels, bool repeat);
+
+    void Bind(unsigned int unit = 0) const;
+
+    GLuint GetID() const { return m_TextureID; }
+    int GetWidth() const { return m_Width; }
+    int GetHeight() const { return m_Height; }
+    int GetLayerCount() const { return m_Layers; }
+
+    TextureArray(const TextureArray&) = delete; TextureArray& operator=(const TextureArray&) = delete; TextureArray(TextureArray&&) = delete; TextureArray& operator=(TextureArray&&) = delete;
+
+private:
+    GLuint m_TextureID = 0;
+    int m_Width = 0;
+    int m_Height = 0;
+    int m_Layers = 0;
+};
+
+#endif // TEXTUREARRAY_H
@@ -0,0 +1,52 @@
+// include/TexturePacker.h
+#ifndef TEXTUREPACKER_H
+#define TEXTUREPACKER_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// Import-time layout of material textures into texture-array layers, so draws with different
+// textures can share one binding. Textures of a size that repeats become layers of an array of
+// that size; the odd ones are packed into atlas pages (stb_rect_pack), which are layers of one
+// more array. No GL calls.
+namespace TexturePacker {
+    // RGBA8, rows in GL order (bottom row first), tightly packed.
+    struct Image {
+        int Width = 0;
+        int Height = 0;
+        std::vector<uint8_t> Pixels;
+    };
+
+    struct Settings {
+        int MaxAtlasSize = 2048; // Pages start smaller and grow to this; larger odd images get their own array
+        int Padding = 4;         // Edge texels repeated around atlas entries against filtering bleed
+        int MinArrayLayers = 2;  // Same-size textures needed to form an array instead of going to the atlas
+    };
+
+    // Where one input image ended up. In the shader: uv' = UVTransform.xy + fract(uv) * UVTransform.zw.
+    struct Placement {
+        int Group = -1;
+        int Layer = 0;
+        glm::vec4 UVTransform = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+    };
+
+    // One texture array to create: Layers images of Width x Height, one after another.
+    struct Group {
+        int Width = 0;
+        int Height = 0;
+        int Layers = 0;
+        bool Atlas = false; // Pages of packed entries (clamp), otherwise whole textures (repeat)
+        std::vector<uint8_t> Pixels;
+    };
+
+    struct Result {
+        std::vector<Group> Groups;
+        std::vector<Placement> Placements; // One per input image, same order
+    };
+
+    // False if an image is empty or its pixel data doesn't match its size.
+    bool Pack(const std::vector<Image>& images, const Settings& settings, Result& out);
+}
+
+#endif // TEXTUREPACKER_H
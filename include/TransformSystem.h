@@ -0,0 +1,79 @@
+// include/TransformSystem.h
+#ifndef TRANSFORMSYSTEM_H
+#define TRANSFORMSYSTEM_H
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+typedef uint32_t TransformHandle;
+const TransformHandle InvalidTransform = ~0u;
+
+// Scene hierarchy of local TRS transforms with cached world matrices. Everything is stored in
+// parallel arrays sorted by depth (all roots, then all depth-1 nodes, ...), so parents always
+// come before their children and one linear pass per level updates the whole tree. Setters only
+// mark a node dirty; Update() recomputes dirty nodes plus everything below them and skips the rest.
+// Handles stay valid while the arrays get re-sorted after hierarchy changes.
+class TransformSystem {
+public:
+    struct Stats {
+        uint32_t Recomputed = 0;
+        uint32_t Skipped = 0;
+        uint32_t Levels = 0;
+        bool Resorted = false;      // Hierarchy changed since the last update
+        double Milliseconds = 0.0;
+    };
+
+    TransformHandle Create(TransformHandle parent = InvalidTransform);
+    // Also destroys every descendant (their handles stay valid until the next Update()).
+    void Destroy(TransformHandle handle);
+    // Returns false (and changes nothing) if it would create a cycle.
+    bool SetParent(TransformHandle handle, TransformHandle parent);
+    TransformHandle GetParent(TransformHandle handle) const;
+    bool IsValid(TransformHandle handle) const;
+    void Clear();
+
+    void SetLocalPosition(TransformHandle handle, const glm::vec3& position);
+    void SetLocalRotation(TransformHandle handle, const glm::quat& rotation);
+    void SetLocalScale(TransformHandle handle, const glm::vec3& scale);
+    void SetLocal(TransformHandle handle, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale);
+    glm::vec3 GetLocalPosition(TransformHandle handle) const;
+    glm::quat GetLocalRotation(TransformHandle handle) const;
+    glm::vec3 GetLocalScale(TransformHandle handle) const;
+    // As of the last Update().
+    const glm::mat4& GetWorldMatrix(TransformHandle handle) const;
+
+    // Levels with at least ParallelThreshold nodes are split across the JobSystem.
+    void Update(JobSystem* jobs = nullptr);
+
+    size_t Size() const { return m_Parents.size(); }
+    const Stats& GetLastStats() const { return m_LastStats; }
+
+    static constexpr size_t ParallelThreshold = 4096;
+
+private:
+    void Rebuild(); // Drops destroyed nodes and re-sorts by depth
+    uint32_t UpdateRange(size_t begin, size_t end);
+    uint32_t IndexOf(TransformHandle handle) const;
+
+    // Dense storage, indexed by sorted position
+    std::vector<glm::vec3> m_LocalPositions;
+    std::vector<glm::quat> m_LocalRotations;
+    std::vector<glm::vec3> m_LocalScales;
+    std::vector<glm::mat4> m_WorldMatrices;
+    std::vector<uint32_t> m_Parents;           // Dense index of the parent, ~0u for roots
+    std::vector<uint8_t> m_Dirty;              // Set by setters, propagated to children during Update
+    std::vector<uint8_t> m_Alive;
+    std::vector<TransformHandle> m_IndexToHandle;
+
+    std::vector<uint32_t> m_HandleToIndex;     // ~0u for free handles
+    std::vector<TransformHandle> m_FreeHandles;
+    std::vector<uint32_t> m_LevelOffsets;      // Level L spans [m_LevelOffsets[L], m_LevelOffsets[L + 1])
+    bool m_NeedsRebuild = false;
+    Stats m_LastStats;
+};
+
+#endif // TRANSFORMSYSTEM_H
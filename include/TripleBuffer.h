@@ -0,0 +1,104 @@
+// include/TripleBuffer.h
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+// Three slots handed between one producer and one consumer thread. The producer fills a slot
+// while the consumer reads another and a third can sit ready in between, so neither side waits
+// unless it gets a whole frame ahead. Published slots are consumed in order (none are dropped);
+// the producer blocks when every slot is taken, which bounds the latency to two frames.
+// Slot contents keep their allocations, so steady-state frames don't allocate.
+template <typename T>
+class TripleBuffer {
+public:
+    static constexpr int SlotCount = 3;
+
+    // Producer: a free slot to fill, blocking until one exists. nullptr once stopped.
+    T* AcquireWrite() {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        int slot = -1;
+        m_Condition.wait(lock, [&] { return m_Stopped || (slot = FindSlot(SlotState::Free)) >= 0; });
+        if (m_Stopped) return nullptr;
+        m_States[slot] = SlotState::Writing;
+        return &m_Slots[slot];
+    }
+
+    // Producer: makes a slot from AcquireWrite() visible to the consumer.
+    void Publish(T* data) {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            const int slot = IndexOf(data);
+            m_States[slot] = SlotState::Ready;
+            m_Sequence[slot] = m_NextSequence++;
+        }
+        m_Condition.notify_all();
+    }
+
+    // Consumer: the oldest published slot, blocking until one exists. nullptr once stopped.
+    T* AcquireRead() {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        int slot = -1;
+        m_Condition.wait(lock, [&] { return m_Stopped || (slot = FindOldestReady()) >= 0; });
+        if (m_Stopped) return nullptr;
+        m_States[slot] = SlotState::Reading;
+        return &m_Slots[slot];
+    }
+
+    // Consumer: hands a slot from AcquireRead() back to the producer.
+    void Release(T* data) {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_States[IndexOf(data)] = SlotState::Free;
+        }
+        m_Condition.notify_all();
+    }
+
+    // Wakes both sides; every later Acquire returns nullptr until Reset().
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stopped = true;
+        }
+        m_Condition.notify_all();
+    }
+
+    // Marks every slot free again. Only call while neither thread holds a slot.
+    void Reset() {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for (int i = 0; i < SlotCount; ++i) m_States[i] = SlotState::Free;
+        m_Stopped = false;
+    }
+
+private:
+    enum class SlotState { Free, Writing, Ready, Reading };
+
+    int IndexOf(const T* data) const { return static_cast<int>(data - m_Slots); }
+
+    int FindSlot(SlotState state) const {
+        for (int i = 0; i < SlotCount; ++i) {
+            if (m_States[i] == state) return i;
+        }
+        return -1;
+    }
+
+    int FindOldestReady() const {
+        int oldest = -1;
+        for (int i = 0; i < SlotCount; ++i) {
+            if (m_States[i] == SlotState::Ready && (oldest < 0 || m_Sequence[i] < m_Sequence[oldest])) oldest = i;
+        }
+        return oldest;
+    }
+
+    T m_Slots[SlotCount];
+    SlotState m_States[SlotCount] = { SlotState::Free, SlotState::Free, SlotState::Free };
+    uint64_t m_Sequence[SlotCount] = {};
+    uint64_t m_NextSequence = 0;
+    bool m_Stopped = false;
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+};
+
+#endif // TRIPLEBUFFER_H
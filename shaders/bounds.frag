@@ -0,0 +1,8 @@
+#version 330 core
+out vec4 FragColor;
+
+// Only used for occlusion queries (color writes are masked off); the color helps when debugging boxes.
+void main()
+{
+    FragColor = vec4(1.0, 0.0, 1.0, 1.0);
+}
@@ -0,0 +1,9 @@
+#version 330 core
+layout (location = 0) in vec3 aPos; // Unit cube corner (-0.5..0.5)
+
+uniform mat4 uMVP; // View-projection * box transform
+
+void main()
+{
+    gl_Position = uMVP * vec4(aPos, 1.0);
+}
@@ -0,0 +1,21 @@
+#version 330 core
+layout (location = 0) in vec3 aPos; // Position-only stream
+
+#ifdef DRAW_BATCH
+layout (location = 7) in mat4 aMVP; // Per draw, same location as in lit_textured.vert
+#else
+uniform mat4 uMVP;
+#endif
+
+// Same expression as lit_textured.vert with the same DRAW_BATCH setting, so the main pass can test with GL_EQUAL
+invariant gl_Position;
+
+void main()
+{
+#ifdef DRAW_BATCH
+    mat4 mvp = aMVP;
+#else
+    mat4 mvp = uMVP;
+#endif
+    gl_Position = mvp * vec4(aPos, 1.0);
+}
@@ -0,0 +1,41 @@
+// Clustered point/spot lights for the lit shaders (see LightGrid / ClusteredLighting); expects
+// FragPos from the including shader. Spliced in by ShaderPreprocessor under CLUSTERED_LIGHTS.
+
+uniform int uLightCount;             // 0 skips the cluster lookup
+uniform samplerBuffer uLights;       // 3 texels per light: position/range, color/spot outer cos, direction/spot inner cos
+uniform usamplerBuffer uClusters;    // Per cluster: offset into uLightIndices, count
+uniform usamplerBuffer uLightIndices;
+uniform vec3 uClusterDims;           // Tiles x, tiles y, depth slices
+uniform vec2 uClusterScale;          // Tiles per pixel
+uniform vec2 uClusterSlice;          // slice = log(view depth) * x + y
+
+// Only the lights binned into this fragment's froxel are visited
+vec3 ClusterLighting(vec3 norm, float viewDepth)
+{
+    ivec3 dims = ivec3(uClusterDims);
+    ivec2 tile = min(ivec2(gl_FragCoord.xy * uClusterScale), dims.xy - 1);
+    int slice = clamp(int(floor(log(max(viewDepth, 1e-4)) * uClusterSlice.x + uClusterSlice.y)), 0, dims.z - 1);
+    uvec2 cluster = texelFetch(uClusters, (slice * dims.y + tile.y) * dims.x + tile.x).rg;
+
+    vec3 result = vec3(0.0);
+    for (uint i = 0u; i < cluster.y; ++i) {
+        int light = int(texelFetch(uLightIndices, int(cluster.x + i)).r) * 3;
+        vec4 positionRange = texelFetch(uLights, light);
+        vec4 colorOuter = texelFetch(uLights, light + 1);
+        vec4 directionInner = texelFetch(uLights, light + 2);
+
+        vec3 toLight = positionRange.xyz - FragPos;
+        float dist = length(toLight);
+        if (dist >= positionRange.w) continue;
+        vec3 lightDir = toLight / max(dist, 1e-4);
+
+        // Smooth window to zero at the range, inverse square inside it
+        float window = clamp(1.0 - pow(dist / positionRange.w, 4.0), 0.0, 1.0);
+        float attenuation = window * window / (dist * dist + 1.0);
+        if (colorOuter.w > -1.0) {
+            attenuation *= smoothstep(colorOuter.w, directionInner.w, dot(-lightDir, directionInner.xyz));
+        }
+        result += max(dot(norm, lightDir), 0.0) * attenuation * colorOuter.rgb;
+    }
+    return result;
+}
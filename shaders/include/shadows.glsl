@@ -0,0 +1,32 @@
+// Cascaded shadow lookup for the lit shaders; expects FragPos from the including shader.
+// Spliced in by ShaderPreprocessor under the SHADOWS feature.
+
+uniform sampler2DArrayShadow uShadowMap; // One layer per cascade
+uniform mat4 uCascadeMatrices[4];        // World to each cascade's light clip space
+uniform vec4 uCascadeSplits;             // View depth where each cascade ends
+uniform vec4 uCascadeTexelSizes;         // World units per texel, scales the normal offset
+uniform int uCascadeCount;               // 0 = unshadowed
+
+// 1 when lit, 0 when fully shadowed. 3x3 taps, each a hardware-filtered 2x2 comparison.
+float ShadowFactor(vec3 norm, vec3 lightDir, float viewDepth)
+{
+    int cascade = 0;
+    while (cascade < uCascadeCount && viewDepth > uCascadeSplits[cascade]) ++cascade;
+    if (cascade >= uCascadeCount) return 1.0;
+
+    // Push the lookup off the surface by about a texel, more at grazing angles, against acne
+    float texelSize = uCascadeTexelSizes[cascade];
+    vec3 offsetPos = FragPos + norm * texelSize * (1.0 + 2.0 * (1.0 - max(dot(norm, lightDir), 0.0)));
+    vec4 clip = uCascadeMatrices[cascade] * vec4(offsetPos, 1.0);
+    vec3 coords = clip.xyz / clip.w * 0.5 + 0.5;
+    if (coords.z >= 1.0) return 1.0;
+
+    vec2 texel = 1.0 / vec2(textureSize(uShadowMap, 0).xy);
+    float lit = 0.0;
+    for (int y = -1; y <= 1; ++y) {
+        for (int x = -1; x <= 1; ++x) {
+            lit += texture(uShadowMap, vec4(coords.xy + vec2(x, y) * texel, float(cascade), coords.z));
+        }
+    }
+    return lit / 9.0;
+}
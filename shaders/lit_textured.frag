@@ -5,11 +5,27 @@ in vec3 FragPos;   // Interpolated fragment position in World Space
 in vec3 Normal;    // Interpolated normal in World Space
 in vec2 TexCoords; // Interpolated texture coordinates
 
-uniform sampler2D uTextureDiffuse; // The texture sampler
+uniform sampler2DArray uTextureDiffuse; // Material textures: same-size arrays or atlas pages (see MaterialLibrary)
+#ifdef DRAW_BATCH
+flat in vec4 MaterialUV;                 // Per draw, from the vertex stage
+flat in float MaterialLayer;
+#else
+uniform float uMaterialLayer;            // The material's layer in it
+uniform vec4 uMaterialUV;                // The material's rect in that layer: offset xy, size zw
+#endif
 
 uniform vec3 uLightDir;    // Light direction (in World Space, pointing FROM light)
 uniform vec3 uLightColor;  // Light color
 uniform vec3 uViewPos;     // Camera position (World Space) - for specular later
+uniform mat4 uView;        // World to view space
+
+// Optional features, one variant each (see ShaderVariants and lit_textured.variants)
+#ifdef SHADOWS
+#include "include/shadows.glsl"
+#endif
+#ifdef CLUSTERED_LIGHTS
+#include "include/clustered_lights.glsl"
+#endif
 
 void main()
 {
@@ -21,6 +37,10 @@ void main()
     vec3 norm = normalize(Normal); // Ensure normal is unit length
     vec3 lightDir = normalize(-uLightDir); // Normalize light direction (ensure pointing TO light)
     float diff = max(dot(norm, lightDir), 0.0); // Calculate diffuse intensity (clamp negative)
+    float viewDepth = -(uView * vec4(FragPos, 1.0)).z;
+#ifdef SHADOWS
+    if (uCascadeCount > 0 && diff > 0.0) diff *= ShadowFactor(norm, lightDir, viewDepth);
+#endif
     vec3 diffuse = diff * uLightColor;
 
     // --- Specular (Basic Phong) --- Optional for now
@@ -33,7 +53,21 @@ void main()
     // --- Combine ---
     // vec3 lighting = ambient + diffuse + specular; // If using specular
     vec3 lighting = ambient + diffuse;
-    vec3 objectColor = texture(uTextureDiffuse, TexCoords).rgb; // Get color from texture
+#ifdef CLUSTERED_LIGHTS
+    if (uLightCount > 0) lighting += ClusterLighting(norm, viewDepth);
+#endif
+#ifdef DRAW_BATCH
+    vec4 materialRect = MaterialUV;
+    float materialLayer = MaterialLayer;
+#else
+    vec4 materialRect = uMaterialUV;
+    float materialLayer = uMaterialLayer;
+#endif
+    // Wrap inside the material's rect; gradients of the unwrapped coordinates keep the mip level steady across the wrap
+    vec2 materialUV = materialRect.xy + fract(TexCoords) * materialRect.zw;
+    vec2 uvDx = dFdx(TexCoords) * materialRect.zw;
+    vec2 uvDy = dFdy(TexCoords) * materialRect.zw;
+    vec3 objectColor = textureGrad(uTextureDiffuse, vec3(materialUV, materialLayer), uvDx, uvDy).rgb; // Get color from texture
 
     FragColor = vec4(lighting * objectColor, 1.0); // Combine lighting and texture color
 }
\ No newline at end of file
@@ -7,21 +7,43 @@ out vec3 FragPos;    // Output vertex position in World Space
 out vec3 Normal;     // Output normal in World Space
 out vec2 TexCoords;  // Pass through texture coordinates
 
+#ifdef DRAW_BATCH
+// Per-draw values from the renderer's frame stream, one instance per draw (see Renderer::FlushBatch)
+layout (location = 3) in mat4 aModel;
+layout (location = 7) in mat4 aMVP;
+layout (location = 11) in vec4 aMaterialUV;
+layout (location = 12) in float aMaterialLayer;
+
+flat out vec4 MaterialUV;    // Uniforms in the unbatched variant; constant across the draw
+flat out float MaterialLayer;
+#else
 uniform mat4 uModel; // Model matrix (transforms to world space)
 uniform mat4 uMVP;   // Combined Model-View-Projection matrix
+#endif
+
+invariant gl_Position; // Must match depth_only.vert bit for bit for the GL_EQUAL test after a depth pre-pass
 
 void main()
 {
-    gl_Position = uMVP * vec4(aPos, 1.0); // Calculate final clip space position
+#ifdef DRAW_BATCH
+    mat4 model = aModel;
+    mat4 mvp = aMVP;
+    MaterialUV = aMaterialUV;
+    MaterialLayer = aMaterialLayer;
+#else
+    mat4 model = uModel;
+    mat4 mvp = uMVP;
+#endif
+    gl_Position = mvp * vec4(aPos, 1.0); // Calculate final clip space position
 
     // Calculate world space position for lighting calculation
-    FragPos = vec3(uModel * vec4(aPos, 1.0));
+    FragPos = vec3(model * vec4(aPos, 1.0));
 
     // Transform normal to world space (assuming no non-uniform scaling for now)
     // Using the normal matrix (inverse transpose of model's upper 3x3) is more robust
-    mat3 normalMatrix = transpose(inverse(mat3(uModel)));
+    mat3 normalMatrix = transpose(inverse(mat3(model)));
     Normal = normalize(normalMatrix * aNormal);
-    // Simplified (less robust) if only rotation/uniform scale: Normal = normalize(mat3(uModel) * aNormal);
+    // Simplified (less robust) if only rotation/uniform scale: Normal = normalize(mat3(model) * aNormal);
 
     TexCoords = aTexCoords; // Pass through UVs
 }
\ No newline at end of file
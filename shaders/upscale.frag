@@ -0,0 +1,30 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 UV;
+
+uniform sampler2D uScene;  // Scaled scene target; only its lower-left uSceneSize texels are this frame's
+uniform vec2 uSceneSize;   // Rendered size in texels
+uniform float uSharpness;  // 0 = plain bilinear upscale
+
+void main()
+{
+    vec2 texel = 1.0 / vec2(textureSize(uScene, 0));
+    vec2 uv = UV * uSceneSize * texel;
+    // Keep every tap inside the rendered region; the rest of the target is stale
+    vec2 lo = 0.5 * texel;
+    vec2 hi = (uSceneSize - 0.5) * texel;
+
+    vec3 center = texture(uScene, clamp(uv, lo, hi)).rgb;
+    vec3 north = texture(uScene, clamp(uv + vec2(0.0, texel.y), lo, hi)).rgb;
+    vec3 south = texture(uScene, clamp(uv - vec2(0.0, texel.y), lo, hi)).rgb;
+    vec3 east = texture(uScene, clamp(uv + vec2(texel.x, 0.0), lo, hi)).rgb;
+    vec3 west = texture(uScene, clamp(uv - vec2(texel.x, 0.0), lo, hi)).rgb;
+
+    // Unsharp mask against the cross neighborhood, clamped to its range so edges don't ring
+    vec3 blurred = (north + south + east + west) * 0.25;
+    vec3 sharpened = center + (center - blurred) * uSharpness;
+    vec3 low = min(center, min(min(north, south), min(east, west)));
+    vec3 high = max(center, max(max(north, south), max(east, west)));
+    FragColor = vec4(clamp(sharpened, low, high), 1.0);
+}
@@ -0,0 +1,9 @@
+#version 330 core
+// Fullscreen triangle generated from gl_VertexID; drawn without a vertex buffer
+out vec2 UV; // 0..1 across the output
+
+void main()
+{
+    UV = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    gl_Position = vec4(UV * 2.0 - 1.0, 0.0, 1.0);
+}
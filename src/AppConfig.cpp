@@ -0,0 +1,150 @@
+// src/AppConfig.cpp
+
+#include "AppConfig.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    void PrintUsage(const char* program) {
+        std::cout << "Usage: " << program << " [options]\n"
+                  << "  --render-thread     Submit GL from a dedicated render thread\n"
+                  << "  --headless          Render offscreen with no visible window\n"
+                  << "  --size WxH          Framebuffer size (default 800x600)\n"
+                  << "  --frames N          Quit after N frames\n"
+                  << "  --output DIR        Write rendered frames to DIR\n"
+                  << "  --capture-every N   With --output, write every Nth frame only\n"
+                  << "  --capture-format F  ppm, png (one file per frame) or y4m (one video) (default ppm)\n"
+                  << "  --stats FILE        Write per-frame timings to FILE as CSV\n"
+                  << "  --depth-prepass     Start with the depth pre-pass enabled\n"
+                  << "  --no-shadows        Start with shadows disabled\n"
+                  << "  --no-shadow-cache   Redraw far shadow cascades every frame\n"
+                  << "  --lights N          Start with N clustered point/spot lights\n"
+                  << "  --pacing MODE       vsync, adaptive, uncapped or limit (default vsync)\n"
+                  << "  --fps-limit N       Hold frames to N per second (implies --pacing limit, default 60)\n"
+                  << "  --sim-rate HZ       Fixed simulation rate (default 60)\n"
+                  << "  --max-sim-steps N   Simulation steps a slow frame may catch up (default 6)\n"
+                  << "  --deforming-mesh    Add a rippling sheet that is re-uploaded every frame\n"
+                  << "  --dynamic-resolution MS  Scale the scene resolution to keep GPU time under MS\n"
+                  << "  --resolution-scale MIN:MAX  Dynamic resolution bounds, per axis (default 0.5:1)\n"
+                  << "  --upscale MODE      bilinear or sharpen (default sharpen)\n"
+                  << "  --benchmark N       Replay a camera path at a fixed timestep and measure N frames\n"
+                  << "  --warmup N          Benchmark frames to run before measuring (default 120)\n"
+                  << "  --fixed-fps N       Benchmark simulation rate (default 60)\n"
+                  << "  --camera-path FILE  Camera path to replay (default: orbit)\n"
+                  << "  --report NAME       Benchmark results to NAME.json and NAME.csv (default benchmark)\n"
+                  << "  --record-path FILE  Record the camera to FILE for later --camera-path runs\n"
+                  << "  --help              Show this message" << std::endl;
+    }
+
+    // Positive integer argument following argv[i]
+    bool ParseCount(int argc, char* argv[], int& i, int& out) {
+        if (i + 1 >= argc || std::sscanf(argv[i + 1], "%d", &out) != 1 || out <= 0) {
+            std::cerr << "ERROR::CONFIG::" << argv[i] << " expects a positive number." << std::endl;
+            return false;
+        }
+        ++i;
+        return true;
+    }
+
+    bool ParseString(int argc, char* argv[], int& i, std::string& out) {
+        if (i + 1 >= argc) {
+            std::cerr << "ERROR::CONFIG::" << argv[i] << " expects a value." << std::endl;
+            return false;
+        }
+        out = argv[++i];
+        return true;
+    }
+}
+
+bool AppConfig::Parse(int argc, char* argv[], AppConfig& out) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool ok = true;
+        if (std::strcmp(arg, "--render-thread") == 0) {
+            out.RenderThread = true;
+        } else if (std::strcmp(arg, "--headless") == 0) {
+            out.Headless = true;
+        } else if (std::strcmp(arg, "--size") == 0) {
+            ok = i + 1 < argc && std::sscanf(argv[i + 1], "%dx%d", &out.Width, &out.Height) == 2 && out.Width > 0 && out.Height > 0;
+            if (ok) ++i;
+            else std::cerr << "ERROR::CONFIG::--size expects WIDTHxHEIGHT." << std::endl;
+        } else if (std::strcmp(arg, "--frames") == 0) {
+            ok = ParseCount(argc, argv, i, out.FrameCount);
+        } else if (std::strcmp(arg, "--output") == 0) {
+            ok = ParseString(argc, argv, i, out.OutputDir);
+        } else if (std::strcmp(arg, "--capture-every") == 0) {
+            ok = ParseCount(argc, argv, i, out.CaptureInterval);
+        } else if (std::strcmp(arg, "--capture-format") == 0) {
+            std::string format;
+            ok = ParseString(argc, argv, i, format) && CaptureWriter::ParseFormat(format, out.OutputFormat);
+            if (!ok) std::cerr << "ERROR::CONFIG::--capture-format expects ppm, png or y4m." << std::endl;
+        } else if (std::strcmp(arg, "--stats") == 0) {
+            ok = ParseString(argc, argv, i, out.StatsPath);
+        } else if (std::strcmp(arg, "--depth-prepass") == 0) {
+            out.DepthPrepass = true;
+        } else if (std::strcmp(arg, "--no-shadows") == 0) {
+            out.Shadows = false;
+        } else if (std::strcmp(arg, "--no-shadow-cache") == 0) {
+            out.ShadowCache = false;
+        } else if (std::strcmp(arg, "--lights") == 0) {
+            ok = ParseCount(argc, argv, i, out.LightCount);
+        } else if (std::strcmp(arg, "--pacing") == 0) {
+            std::string mode;
+            ok = ParseString(argc, argv, i, mode) && FramePacer::ParseMode(mode, out.Pacing);
+            if (!ok) std::cerr << "ERROR::CONFIG::--pacing expects vsync, adaptive, uncapped or limit." << std::endl;
+        } else if (std::strcmp(arg, "--fps-limit") == 0) {
+            ok = ParseCount(argc, argv, i, out.FpsLimit);
+            out.Pacing = PacingMode::Limited;
+        } else if (std::strcmp(arg, "--sim-rate") == 0) {
+            ok = ParseCount(argc, argv, i, out.SimulationRate);
+        } else if (std::strcmp(arg, "--max-sim-steps") == 0) {
+            ok = ParseCount(argc, argv, i, out.MaxSimulationSteps);
+        } else if (std::strcmp(arg, "--deforming-mesh") == 0) {
+            out.DeformingMesh = true;
+        } else if (std::strcmp(arg, "--dynamic-resolution") == 0) {
+            ok = i + 1 < argc && std::sscanf(argv[i + 1], "%f", &out.GpuBudgetMilliseconds) == 1 && out.GpuBudgetMilliseconds > 0.0f;
+            if (ok) ++i;
+            else std::cerr << "ERROR::CONFIG::--dynamic-resolution expects a GPU budget in milliseconds." << std::endl;
+            out.DynamicResolution = ok;
+        } else if (std::strcmp(arg, "--resolution-scale") == 0) {
+            ok = i + 1 < argc && std::sscanf(argv[i + 1], "%f:%f", &out.MinResolutionScale, &out.MaxResolutionScale) == 2 &&
+                 out.MinResolutionScale > 0.0f && out.MinResolutionScale <= out.MaxResolutionScale && out.MaxResolutionScale <= 2.0f;
+            if (ok) ++i;
+            else std::cerr << "ERROR::CONFIG::--resolution-scale expects MIN:MAX with 0 < MIN <= MAX <= 2." << std::endl;
+        } else if (std::strcmp(arg, "--upscale") == 0) {
+            std::string mode;
+            ok = ParseString(argc, argv, i, mode) && (mode == "bilinear" || mode == "sharpen");
+            if (ok) out.SharpenUpscale = mode == "sharpen";
+            else std::cerr << "ERROR::CONFIG::--upscale expects bilinear or sharpen." << std::endl;
+        } else if (std::strcmp(arg, "--benchmark") == 0) {
+            ok = ParseCount(argc, argv, i, out.BenchmarkFrames);
+        } else if (std::strcmp(arg, "--warmup") == 0) {
+            ok = ParseCount(argc, argv, i, out.WarmupFrames);
+        } else if (std::strcmp(arg, "--fixed-fps") == 0) {
+            ok = ParseCount(argc, argv, i, out.FixedFps);
+        } else if (std::strcmp(arg, "--camera-path") == 0) {
+            ok = ParseString(argc, argv, i, out.CameraPathFile);
+        } else if (std::strcmp(arg, "--report") == 0) {
+            ok = ParseString(argc, argv, i, out.ReportPath);
+        } else if (std::strcmp(arg, "--record-path") == 0) {
+            ok = ParseString(argc, argv, i, out.RecordPathFile);
+        } else if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            PrintUsage(argv[0]);
+            return false;
+        } else {
+            std::cerr << "ERROR::CONFIG::Unknown argument: " << arg << std::endl;
+            ok = false;
+        }
+        if (!ok) {
+            PrintUsage(argv[0]);
+            return false;
+        }
+    }
+    if (out.BenchmarkFrames > 0 && !out.RecordPathFile.empty()) {
+        std::cerr << "ERROR::CONFIG::--record-path needs live input and can't be combined with --benchmark." << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -2,9 +2,27 @@
 #include "Application.h" // Includes forward declarations
 #include "Renderer.h"    // <-- ADD/ENSURE THIS (Provides full Renderer definition)
 #include "Shader.h"
+#include "ShaderVariants.h"
 #include "FileUtils.h"
 #include "Mesh.h"        // <-- ADD/ENSURE THIS (Provides full Mesh definition)
-#include "Texture.h"
+#include "GeometryBuffer.h"
+#include "JobSystem.h"
+#include "StreamingBuffer.h"
+#include "OcclusionQueries.h"
+#include "GpuProfiler.h"
+#include "Profiler.h"
+#include "CommandList.h"
+#include "Bounds.h"
+#include "MaterialLibrary.h"
+#include "TextureArray.h"
+#include "Framebuffer.h"
+#include "BenchmarkReport.h"
+#include "ClusteredLighting.h"
+#include "DynamicResolution.h"
+#include "FrameCapture.h"
+#include "CaptureWriter.h"
+#include "ShadowMaps.h"
+#include "RenderGraphExecutor.h"
 #include "VertexArray.h" // For Vertex struct definition
 
 // ImGui Includes
@@ -21,32 +39,66 @@
 #include <memory>
 #include <vector>
 #include <cmath>
+#include <chrono>
+#include <algorithm>
+#include <cctype>
+#include <unordered_map>
+#include <cstdio>
+#include <filesystem>
+#include <random>
 
 // GLM
 #define GLM_FORCE_RADIANS
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 // --- Constants ---
-const int SCREEN_WIDTH = 800;
-const int SCREEN_HEIGHT = 600;
 const char* WINDOW_TITLE = "Model Viewer!";
 const float OBJECT_ROTATION_SPEED = 0.5f; // Radians per second
+const GLuint GEOMETRY_INITIAL_VERTICES = 1 << 16; // Shared buffer grows on demand
+const GLuint GEOMETRY_INITIAL_INDICES = 1 << 18;
+const int OCCLUSION_BUFFER_WIDTH = 320; // Software depth buffer for occlusion culling
+const int OCCLUSION_BUFFER_HEIGHT = 240;
+const float BVH_REBUILD_DEGRADATION = 1.5f; // Rebuild once refits make the tree this much worse than fresh
+const float CAMERA_FAR_PLANE = 100.0f;
+const uint32_t DRAW_LAYER_OPAQUE = 0;      // Plain draws; also the occluders for GPU query boxes
+const uint32_t DRAW_LAYER_PREDICATED = 1;  // Draws wrapped in conditional rendering, after the query pass
+const size_t COMMAND_RECORD_CHUNK = 256;   // Visible objects per recording job
+const int GPU_TRACE_FRAMES = 120;          // Frames per Chrome trace capture
+const char* GPU_TRACE_PATH = "gpu_trace.json";
+const char* CPU_TRACE_PATH = "cpu_trace.json";
+const float BENCHMARK_ORBIT_RADIUS = 4.0f;    // Default benchmark path: one orbit around the origin
+const float BENCHMARK_ORBIT_HEIGHT = 1.5f;
+const float BENCHMARK_ORBIT_SECONDS = 10.0f;
+const double CAMERA_RECORD_INTERVAL = 0.1;   // Seconds between keyframes with --record-path
+const float MAX_CAMERA_DELTA = 0.1f;         // Free-fly camera moves at most this many seconds' worth per frame
+const int MAX_LIGHTS = 1024;                 // Overlay slider range
+const float UPSCALE_SHARPNESS = 0.5f;        // Unsharp-mask strength of the dynamic resolution upscale
+const uint32_t LIGHT_SEED = 1234;            // Light i is generated from LIGHT_SEED + i
+const float LIGHT_SPOT_FRACTION = 0.25f;
+const float GROUND_SIZE = 40.0f;             // Static ground plane, centered under the origin
+const float GROUND_HEIGHT = -1.5f;
+const int STATIC_PROP_COUNT = 8;             // Static copies of the model in a ring around the origin
+const float STATIC_PROP_RADIUS = 5.0f;
+const int DEFORMING_GRID = 48;               // --deforming-mesh: quads per side of the rippling sheet
+const float DEFORMING_SIZE = 4.0f;
+const float DEFORMING_HEIGHT = -1.2f;        // Between the ground and the model
+const float DEFORMING_AMPLITUDE = 0.15f;
+const float DEFORMING_WAVELENGTH = 1.5f;
+const float DEFORMING_SPEED = 3.0f;          // Radians of phase per second
 
 Application::Application() :
     m_Window(nullptr),
     m_Renderer(nullptr),
-    m_LitTexturedShader(nullptr), // Renamed from m_SimpleShader
-    m_LoadedMesh(nullptr),        // Initialize new pointers
-    m_DiffuseTexture(nullptr),
+    m_GeometryBuffer(nullptr),
+    m_JobSystem(nullptr),
+    m_LitShaders(nullptr),
     m_IsRunning(false),
-    m_TickCountLast(0),
-    m_RotationAngle(0.0f),
     m_TestSound(nullptr),
     m_MixerInitialized(false),
     m_SoundLoaded(false),
-    m_MusicChannel(-1), // <-- ADD THIS
     m_CurrentState(GameState::Playing)
 {}
 
@@ -54,19 +106,41 @@ Application::~Application() {
     Shutdown();
 }
 
-bool Application::Initialize() {
+bool Application::Initialize(const AppConfig& config) {
+    m_Config = config;
+    if (m_Config.Headless) {
+#ifdef __linux__
+        // No display server (CI, render farms): SDL's offscreen driver gives us an EGL pbuffer context
+        const char* x11 = SDL_getenv("DISPLAY");
+        const char* wayland = SDL_getenv("WAYLAND_DISPLAY");
+        if (!SDL_getenv("SDL_VIDEODRIVER") && !(x11 && *x11) && !(wayland && *wayland)) SDL_SetHint(SDL_HINT_VIDEODRIVER, "offscreen");
+#endif
+        if (!SDL_getenv("SDL_AUDIODRIVER")) SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+    }
+    const bool benchmark = m_Config.BenchmarkFrames > 0;
+    if (benchmark) {
+        if (!m_Config.CameraPathFile.empty()) {
+            if (!m_CameraPath.Load(m_Config.CameraPathFile)) return false;
+        } else {
+            m_CameraPath = CameraPath::MakeOrbit(glm::vec3(0.0f), BENCHMARK_ORBIT_RADIUS, BENCHMARK_ORBIT_HEIGHT, BENCHMARK_ORBIT_SECONDS);
+        }
+        // Extra frames at the end so the GPU timings of every measured frame get read back
+        m_Config.FrameCount = m_Config.WarmupFrames + m_Config.BenchmarkFrames + GpuProfiler::FrameRingSize;
+        std::cout << "INFO::APP::Benchmark: " << m_Config.WarmupFrames << " warm-up + " << m_Config.BenchmarkFrames << " measured frames at a fixed 1/" << m_Config.FixedFps << " s step." << std::endl;
+    }
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0) {
         std::cerr << "ERROR::APP::SDL_Init failed: " << SDL_GetError() << std::endl;
         return false;
     }
     std::cout << "INFO::APP::SDL initialized." << std::endl;
 
-    m_Window = SDL_CreateWindow(WINDOW_TITLE, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN);
+    const Uint32 windowFlags = SDL_WINDOW_OPENGL | (m_Config.Headless ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN);
+    m_Window = SDL_CreateWindow(WINDOW_TITLE, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, m_Config.Width, m_Config.Height, windowFlags);
     if (!m_Window) { std::cerr << "ERROR::APP::Window creation failed: " << SDL_GetError() << std::endl; SDL_Quit(); return false; }
     std::cout << "INFO::APP::Window created." << std::endl;
 
     // --- Mouse Setup ---
-    if (m_CurrentState == GameState::Playing) { SDL_SetRelativeMouseMode(SDL_TRUE); }
+    if (m_CurrentState == GameState::Playing && !m_Config.Headless && !benchmark) { SDL_SetRelativeMouseMode(SDL_TRUE); }
     int initialMouseX, initialMouseY;
     SDL_GetMouseState(&initialMouseX, &initialMouseY);
     m_LastMouseX = (float)initialMouseX;
@@ -76,6 +150,49 @@ bool Application::Initialize() {
     m_Renderer = std::make_unique<Renderer>();
     if (!m_Renderer->Initialize(m_Window)) { std::cerr << "ERROR::APP::Renderer init failed." << std::endl; SDL_DestroyWindow(m_Window); SDL_Quit(); return false; }
     std::cout << "INFO::APP::Renderer initialized." << std::endl;
+    if (m_Config.Headless) {
+        // Same passes as on screen, into an FBO; no vsync so frames run as fast as the GPU allows
+        if (!m_Renderer->SetOffscreenTarget(m_Config.Width, m_Config.Height)) { std::cerr << "ERROR::APP::Offscreen target creation failed." << std::endl; return false; }
+        std::cout << "INFO::APP::Headless: " << m_Config.Width << "x" << m_Config.Height << " offscreen." << std::endl;
+    }
+    // Frame pacing. Offscreen there is no display to sync to, and a benchmark measures the frame, not the refresh rate
+    m_Pacing = m_Config.Pacing;
+    m_FpsLimit = m_Config.FpsLimit;
+    if (benchmark || (m_Config.Headless && m_Pacing != PacingMode::Limited)) m_Pacing = PacingMode::Uncapped;
+    m_RequestedSwapInterval = FramePacer::GetSwapInterval(m_Pacing);
+    m_SwapInterval = m_Renderer->SetSwapInterval(m_RequestedSwapInterval);
+    std::cout << "INFO::APP::Pacing: " << FramePacer::GetModeName(m_Pacing) << " (swap interval " << m_SwapInterval << ")." << std::endl;
+    if (!m_Config.OutputDir.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(m_Config.OutputDir, error);
+        if (error) { std::cerr << "ERROR::APP::Could not create output directory " << m_Config.OutputDir << ": " << error.message() << std::endl; return false; }
+        // Read back the offscreen target, or the window's back buffer before each swap
+        int captureWidth = m_Config.Width, captureHeight = m_Config.Height;
+        if (!m_Config.Headless) SDL_GL_GetDrawableSize(m_Window, &captureWidth, &captureHeight);
+        const int videoFps = benchmark ? m_Config.FixedFps : (m_Pacing == PacingMode::Limited ? m_FpsLimit : 60);
+        m_CaptureWriter = std::make_unique<CaptureWriter>();
+        if (!m_CaptureWriter->Start(m_Config.OutputDir, m_Config.OutputFormat, captureWidth, captureHeight, videoFps, m_Config.CaptureInterval)) return false;
+        m_FrameCapture = std::make_unique<FrameCapture>();
+        if (!m_FrameCapture->Initialize(captureWidth, captureHeight, FrameCapture::DefaultRingSize, *m_CaptureWriter)) return false;
+    }
+
+    m_JobSystem = std::make_unique<JobSystem>();
+
+    m_GpuProfiler = std::make_unique<GpuProfiler>();
+    if (!m_GpuProfiler->Initialize()) {
+        std::cout << "WARN::APP::GPU profiler unavailable." << std::endl;
+        m_GpuProfiler.reset();
+    }
+    if (m_GpuProfiler) m_GpuProfiler->SetKeepFrameTimes(IsCollectingFrameTimings());
+
+    // --- Shared Geometry Storage (all meshes sub-allocate from it) ---
+    m_GeometryBuffer = std::make_unique<GeometryBuffer>();
+    if (!m_GeometryBuffer->Initialize(GEOMETRY_INITIAL_VERTICES, GEOMETRY_INITIAL_INDICES)) {
+        std::cerr << "ERROR::APP::Geometry buffer init failed." << std::endl;
+        return false;
+    }
+
+    m_OcclusionCuller.Initialize(OCCLUSION_BUFFER_WIDTH, OCCLUSION_BUFFER_HEIGHT);
 
     // --- Initialize ImGui ---
     IMGUI_CHECKVERSION(); ImGui::CreateContext(); ImGuiIO& io = ImGui::GetIO(); (void)io;
@@ -83,6 +200,8 @@ bool Application::Initialize() {
     if (!m_Renderer || !m_Renderer->GetGLContext()) { std::cerr << "ERROR::APP::ImGui init failed - no renderer/context." << std::endl; return false; }
     ImGui_ImplSDL2_InitForOpenGL(m_Window, m_Renderer->GetGLContext());
     ImGui_ImplOpenGL3_Init("#version 330 core");
+    // Create the backend's GL objects now, while this thread owns the context; NewFrame() would otherwise do it lazily
+    ImGui_ImplOpenGL3_CreateDeviceObjects();
     std::cout << "INFO::APP::Dear ImGui initialized." << std::endl;
 
     // --- Load Shader ---
@@ -98,25 +217,94 @@ bool Application::Initialize() {
         return false;
     }
 
-    // Create the shader using the full paths
-    m_LitTexturedShader = std::make_unique<Shader>(vertPath, fragPath);
-    if (!m_LitTexturedShader || m_LitTexturedShader->GetProgramID() == 0) {
+    // Lit shader permutations: the plain variant must build, the rest compile from the manifest now
+    // (or on first use if they are missing from it) so toggling a feature doesn't hitch
+    m_LitShaders = std::make_unique<ShaderVariants>(vertPath, fragPath);
+    m_LitShadowsFeature = m_LitShaders->DeclareFeature("SHADOWS");
+    m_LitLightsFeature = m_LitShaders->DeclareFeature("CLUSTERED_LIGHTS");
+    m_LitBatchFeature = m_LitShaders->DeclareFeature("DRAW_BATCH");
+    if (!m_LitShaders->Load() || !m_LitShaders->Get(0)) {
         std::cerr << "ERROR::APP::Failed to load or link lit_textured shader." << std::endl;
-        // Shader constructor likely printed details already
+        // ShaderVariants printed details already
         return false;
     }
+    std::string manifestPath = FileUtils::GetResourcePath("shaders/lit_textured.variants");
+    if (!manifestPath.empty()) m_LitShaders->Prewarm(manifestPath);
     std::cout << "INFO::APP::Lit Textured Shader loaded." << std::endl;
 
+    // --- Depth pre-pass program (optional) ---
+    std::string depthVertPath = FileUtils::GetResourcePath("shaders/depth_only.vert");
+    std::string depthFragPath = FileUtils::GetResourcePath("shaders/depth_only.frag");
+    if (!depthVertPath.empty() && !depthFragPath.empty()) m_DepthOnlyShader = std::make_unique<Shader>(depthVertPath, depthFragPath);
+    if (!m_DepthOnlyShader || m_DepthOnlyShader->GetProgramID() == 0) {
+        std::cout << "WARN::APP::Depth-only shader unavailable, depth pre-pass disabled." << std::endl;
+        m_DepthOnlyShader.reset();
+    }
+    m_UseDepthPrepass = m_Config.DepthPrepass && m_DepthOnlyShader;
+
+    // --- Draw batches: per-draw data comes from instance attributes, so the pre-pass needs its own build ---
+    if (m_Renderer->SupportsDrawBatches() && m_DepthOnlyShader) {
+        m_DepthShaders = std::make_unique<ShaderVariants>(depthVertPath, depthFragPath);
+        const uint32_t batchFeature = m_DepthShaders->DeclareFeature("DRAW_BATCH");
+        if (m_DepthShaders->Load()) m_DepthBatchShader = m_DepthShaders->Get(batchFeature);
+    }
+    m_UseDrawBatches = m_DepthBatchShader != nullptr;
+    if (!m_UseDrawBatches) std::cout << "WARN::APP::Draw batches unavailable, packets are drawn one at a time." << std::endl;
+
+    // --- Dynamic resolution (scene target sized for the largest scale, sharpening upscale optional) ---
+    std::string upscaleVertPath = FileUtils::GetResourcePath("shaders/upscale.vert");
+    std::string upscaleFragPath = FileUtils::GetResourcePath("shaders/upscale.frag");
+    if (!upscaleVertPath.empty() && !upscaleFragPath.empty()) m_UpscaleShader = std::make_unique<Shader>(upscaleVertPath, upscaleFragPath);
+    if (!m_UpscaleShader || m_UpscaleShader->GetProgramID() == 0) {
+        std::cout << "WARN::APP::Upscale shader unavailable, dynamic resolution upscales bilinearly." << std::endl;
+        m_UpscaleShader.reset();
+    }
+    m_DynamicResolution = std::make_unique<DynamicResolution>();
+    if (!m_DynamicResolution->Initialize(m_Config.Width, m_Config.Height, m_Config.MaxResolutionScale)) {
+        std::cout << "WARN::APP::Dynamic resolution unavailable." << std::endl;
+        m_DynamicResolution.reset();
+    }
+    m_UseDynamicResolution = m_Config.DynamicResolution && m_DynamicResolution;
+    m_GraphExecutor = std::make_unique<RenderGraphExecutor>(); // Transient targets are created on first use
+    m_SharpenUpscale = m_Config.SharpenUpscale;
+    m_GpuBudgetMilliseconds = m_Config.GpuBudgetMilliseconds;
+    m_MinResolutionScale = m_Config.MinResolutionScale;
+    m_MaxResolutionScale = m_Config.MaxResolutionScale;
+
+    // --- Cascaded shadow maps (casters go through the depth-only program) ---
+    if (m_DepthOnlyShader) {
+        m_ShadowMaps = std::make_unique<ShadowMaps>();
+        if (!m_ShadowMaps->Initialize(m_ShadowCascades.GetResolution(), m_ShadowCascades.GetCascadeCount())) m_ShadowMaps.reset();
+    }
+    if (!m_ShadowMaps) std::cout << "WARN::APP::Shadow maps unavailable, shadows disabled." << std::endl;
+    m_UseShadows = m_Config.Shadows && m_ShadowMaps;
+    m_UseShadowCache = m_Config.ShadowCache;
+
+    // --- Clustered point/spot lights (texture buffers read by the lit shader) ---
+    m_ClusteredLighting = std::make_unique<ClusteredLighting>();
+    if (!m_ClusteredLighting->Initialize()) {
+        std::cout << "WARN::APP::Clustered lighting unavailable, point/spot lights disabled." << std::endl;
+        m_ClusteredLighting.reset();
+    }
+
+    // --- GPU Occlusion Queries (optional, for heavy objects that opt in) ---
+    m_OcclusionQueries = std::make_unique<OcclusionQueries>();
+    if (!m_OcclusionQueries->Initialize(*m_GeometryBuffer)) {
+        std::cout << "WARN::APP::GPU occlusion queries unavailable." << std::endl;
+        m_OcclusionQueries.reset();
+    }
+
     // --- Load Texture ---
+    // Materials are only queued here; Build() below lays them all out in texture arrays at once
+    m_Materials = std::make_unique<MaterialLibrary>();
     std::string textureFilename = "your_texture.png"; // <-- Ensure this file exists in assets/textures
     // Pass the full relative path to GetResourcePath
     std::string texturePath = FileUtils::GetResourcePath("assets/textures/" + textureFilename); // <-- CORRECT PATH CONSTRUCTION
     if (texturePath.empty()) { std::cerr << "ERROR::APP::Could not get texture path for: " << textureFilename << std::endl; return false; } // Improved error message
-    m_DiffuseTexture = std::make_unique<Texture>();
-    if (!m_DiffuseTexture->Load(texturePath)) {
+    const Material* monkeyMaterial = m_Materials->AddTexture(texturePath);
+    if (!monkeyMaterial) {
         std::cerr << "ERROR::APP::Failed to load texture: " << texturePath << std::endl;
-        m_DiffuseTexture.reset(); // Release if failed
-        // return false; // Decide if texture is mandatory
+        monkeyMaterial = m_Materials->AddSolidColor("untextured", 255, 255, 255); // Texture isn't mandatory
     } else {
         std::cout << "INFO::APP::Texture loaded: " << textureFilename << std::endl;
     }
@@ -131,12 +319,29 @@ bool Application::Initialize() {
     std::vector<Vertex> loadedVertices;
     std::vector<unsigned int> loadedIndices;
     if (FileUtils::LoadObjModel(modelPath, loadedVertices, loadedIndices)) {
-        m_LoadedMesh = std::make_unique<Mesh>(loadedVertices, loadedIndices);
-        if (!m_LoadedMesh) {
+        std::unique_ptr<Mesh> mesh = std::make_unique<Mesh>(*m_GeometryBuffer, loadedVertices, loadedIndices);
+        if (!mesh || !mesh->IsValid()) {
              std::cerr << "ERROR::APP::Failed to create Mesh object from loaded data." << std::endl;
              return false;
         }
          std::cout << "INFO::APP::Model loaded and mesh created: " << modelFilename << std::endl;
+        MeshRenderer renderer;
+        renderer.MeshRef = mesh.get();
+        renderer.MaterialRef = monkeyMaterial;
+        OccluderMesh occluder = OcclusionCuller::SimplifyOccluder(loadedVertices, loadedIndices);
+        std::cout << "INFO::APP::Occluder simplified from " << loadedIndices.size() / 3 << " to " << occluder.Indices.size() / 3 << " triangles." << std::endl;
+        renderer.OccluderIndex = static_cast<int>(m_OcclusionCuller.AddOccluderMesh(std::move(occluder)));
+        if (m_OcclusionQueries) renderer.OcclusionQuery = static_cast<int>(m_OcclusionQueries->Register()); // Heaviest mesh we have
+        Spin spin;
+        spin.Speed = OBJECT_ROTATION_SPEED;
+        m_World.CreateEntity(TransformComponent{ m_Transforms.Create() }, renderer, spin);
+        m_Meshes.push_back(std::move(mesh));
+        if (!CreateStaticScene(renderer)) return false;
+        if (m_Config.DeformingMesh && !CreateDeformingMesh()) return false;
+        if (!m_Materials->Build()) {
+            std::cerr << "ERROR::APP::Failed to build the material texture arrays." << std::endl;
+            return false;
+        }
     } else {
         // Error message from LoadObjModel is already printed
         // std::cerr << "ERROR::APP::Failed to load model: " << modelPath << std::endl; // Redundant
@@ -146,31 +351,63 @@ bool Application::Initialize() {
     // --- Initialize Audio (Optional) ---
     if (!LoadAudio()) { std::cout << "WARN::APP::Audio failed to load." << std::endl; } else { PlaySound(); }
 
+    // --- Systems (phases are derived from their component reads/writes) ---
+    // The simulation steps at a fixed rate; the per-frame systems pose its last two states for rendering
+    m_Timestep.Configure(m_Config.SimulationRate, m_Config.MaxSimulationSteps);
+    m_SimulationRateSetting = m_Timestep.GetRate();
+    m_Simulation.Add(SceneSystems::CreateRotationSystem(m_World));
+    m_Simulation.Add(SceneSystems::CreateLightOrbitSystem(m_World));
+    m_Systems.Add(SceneSystems::CreateSpinPoseSystem(m_World, m_Transforms, m_InterpolationAlpha));
+    m_Systems.Add(SceneSystems::CreateAudioSystem(m_World));
+    m_Systems.Add(SceneSystems::CreateRenderListSystem(m_World, m_Transforms, m_SceneObjects));
+    m_Systems.Add(SceneSystems::CreateLightPoseSystem(m_World, m_InterpolationAlpha));
+    m_Systems.Add(SceneSystems::CreateLightListSystem(m_World, m_Lights));
+    if (m_ClusteredLighting) SetLightCount(m_Config.LightCount);
+    std::cout << "INFO::APP::" << m_Systems.GetSystemCount() << " systems in " << m_Systems.GetPhases().size() << " phase(s), "
+              << m_Simulation.GetSystemCount() << " simulated at " << m_Timestep.GetRate() << " Hz." << std::endl;
+
     m_IsRunning = true;
-    m_TickCountLast = SDL_GetTicks64();
     return true;
 }
 
 void Application::Run() {
     // ... (Run loop logic remains the same) ...
      std::cout << "INFO::APP::Entering main loop..." << std::endl;
+    PROFILE_THREAD("Main");
+    if (m_Config.RenderThread && !StartRenderThread()) {
+        std::cout << "WARN::APP::Render thread unavailable, drawing on the main thread." << std::endl;
+    }
     while (m_IsRunning) {
-        Uint64 tickCountNow = SDL_GetTicks64();
-        float deltaTime = (tickCountNow - m_TickCountLast) / 1000.0f;
-        m_TickCountLast = tickCountNow;
-        deltaTime = (deltaTime > 0.1f) ? 0.1f : deltaTime; // Cap deltaTime
+        PROFILE_FRAME();
+        // The limiter waits here, before input is read, so a held frame doesn't add input latency
+        float deltaTime = static_cast<float>(m_FramePacer.BeginFrame(m_Pacing, m_FpsLimit));
+        if (m_Config.BenchmarkFrames > 0) deltaTime = 1.0f / m_Config.FixedFps; // Same simulation every run, however fast frames go
 
         ProcessEvents();
-        // Only update game logic if playing
-        if (m_CurrentState == GameState::Playing) {
-            Update(deltaTime);
-        }
+        Update(deltaTime); // Systems still run while paused (audio, render list), with the simulation frozen
         Render();
+        if (m_Config.FrameCount > 0 && m_FrameIndex >= static_cast<uint64_t>(m_Config.FrameCount)) m_IsRunning = false;
     }
+    StopRenderThread();
      std::cout << "INFO::APP::Exited main loop." << std::endl;
+    if (m_GpuProfiler && IsCollectingFrameTimings()) {
+        // One timing row per SubmitFrame call, and one profiler frame per call too
+        std::vector<GpuProfiler::FrameTime> gpuTimes;
+        m_GpuProfiler->TakeFrameTimes(gpuTimes);
+        for (GpuProfiler::FrameTime& time : gpuTimes) {
+            if (time.Frame < 1 || time.Frame > m_FrameTimings.size()) continue;
+            FrameTiming& timing = m_FrameTimings[time.Frame - 1];
+            timing.GpuMilliseconds = time.GpuMilliseconds;
+            timing.GpuPasses = std::move(time.Scopes);
+        }
+    }
+    if (!m_Config.StatsPath.empty()) WriteFrameStats();
+    if (m_Config.BenchmarkFrames > 0) WriteBenchmarkReport();
+    if (!m_Config.RecordPathFile.empty()) m_CameraPath.Save(m_Config.RecordPathFile);
 }
 
 void Application::ProcessEvents() {
+    PROFILE_SCOPE("ProcessEvents");
     // ... (ProcessEvents logic remains the same, handling ImGui and state) ...
     SDL_PumpEvents();
     const Uint8* keyboardState = SDL_GetKeyboardState(NULL); // Get state for Update
@@ -178,6 +415,10 @@ void Application::ProcessEvents() {
 
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
+        if (m_Config.BenchmarkFrames > 0) { // No input while replaying; only quitting early
+            if (event.type == SDL_QUIT) m_IsRunning = false;
+            continue;
+        }
         ImGui_ImplSDL2_ProcessEvent(&event);
         if (event.type == SDL_QUIT) m_IsRunning = false;
         // src/Application.cpp -> ProcessEvents() -> SDLK_ESCAPE block
@@ -185,12 +426,12 @@ void Application::ProcessEvents() {
             if (m_CurrentState == GameState::Playing) {
                 m_CurrentState = GameState::Paused;
                 SDL_SetRelativeMouseMode(SDL_FALSE); // Free mouse
-                if (m_MusicChannel != -1) Mix_Pause(m_MusicChannel); // <-- PAUSE MUSIC
+                RequestMusic(AudioRequest::Pause);
             } else if (m_CurrentState == GameState::Paused) {
                 m_CurrentState = GameState::Playing;
                 SDL_SetRelativeMouseMode(SDL_TRUE); // Capture mouse
                 m_FirstMouse = true; // Reset first mouse flag
-                if (m_MusicChannel != -1) Mix_Resume(m_MusicChannel); // <-- RESUME MUSIC
+                RequestMusic(AudioRequest::Resume);
             } else if (m_CurrentState == GameState::ShowingHelp) {
                 m_CurrentState = GameState::Paused; // Go back to pause menu
                 // Music remains paused from when we entered Paused state before Help
@@ -205,6 +446,9 @@ void Application::ProcessEvents() {
              float xoffset = (float)event.motion.xrel; float yoffset = -(float)event.motion.yrel;
              HandleMouseInput(xoffset, yoffset);
         }
+        else if (m_CurrentState == GameState::Paused && !io.WantCaptureMouse && event.type == SDL_MOUSEBUTTONDOWN && event.button.button == SDL_BUTTON_LEFT) {
+            PickObject(event.button.x, event.button.y);
+        }
     }
 }
 
@@ -226,6 +470,10 @@ void Application::HandleMouseInput(float xoffset, float yoffset) {
     xoffset *= m_MouseSensitivity; yoffset *= m_MouseSensitivity;
     m_CameraYaw += xoffset; m_CameraPitch += yoffset;
     if (m_CameraPitch > 89.0f) m_CameraPitch = 89.0f; if (m_CameraPitch < -89.0f) m_CameraPitch = -89.0f;
+    UpdateCameraFront();
+}
+
+void Application::UpdateCameraFront() {
     glm::vec3 front;
     front.x = cos(glm::radians(m_CameraYaw)) * cos(glm::radians(m_CameraPitch));
     front.y = sin(glm::radians(m_CameraPitch));
@@ -235,88 +483,650 @@ void Application::HandleMouseInput(float xoffset, float yoffset) {
 
 
 void Application::Update(float deltaTime) {
-    // Only update rotation if not paused
-    if (m_CurrentState == GameState::Playing) {
-        m_RotationAngle += OBJECT_ROTATION_SPEED * deltaTime;
-        m_RotationAngle = fmod(m_RotationAngle, 2.0f * M_PI);
+    PROFILE_SCOPE("Update");
+    // Only advance the simulation (and camera) if not paused
+    const bool playing = (m_CurrentState == GameState::Playing);
 
+    // Fixed-rate simulation: whole steps of the elapsed time, the remainder is interpolated. A frame
+    // that needed more than one step shows up as catch-up steps in the profiler.
+    const uint32_t steps = m_Timestep.Advance(playing ? deltaTime : 0.0);
+    const double step = m_Timestep.GetStepSeconds();
+    for (uint32_t i = 0; i < steps; ++i) {
+        PROFILE_SCOPE(i == 0 ? "Simulation step" : "Catch-up step");
+        auto stepStart = std::chrono::steady_clock::now();
+        m_Simulation.Run(m_World, static_cast<float>(step), m_JobSystem.get());
+        m_SimulationTime += step;
+        m_SimulationStepMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - stepStart).count();
+    }
+    m_InterpolationAlpha = m_Timestep.GetAlpha();
+    // Rendered state trails the latest step by the part of a step not yet simulated
+    const double renderTime = std::max(m_SimulationTime - (1.0 - m_InterpolationAlpha) * step, 0.0);
+    m_PoseTime = renderTime;
+
+    if (m_Config.BenchmarkFrames > 0) {
+        const CameraPath::Keyframe camera = m_CameraPath.Sample(static_cast<float>(renderTime));
+        m_CameraPos = camera.Position;
+        m_CameraYaw = camera.Yaw;
+        m_CameraPitch = camera.Pitch;
+        UpdateCameraFront();
+    } else if (playing) {
         const Uint8* keyboardState = SDL_GetKeyboardState(NULL);
-        HandleKeyboardInput(keyboardState, deltaTime);
+        // The camera follows input every frame rather than every step, so it never lags the mouse
+        HandleKeyboardInput(keyboardState, std::min(deltaTime, MAX_CAMERA_DELTA));
+        if (!m_Config.RecordPathFile.empty() && (m_LastPathKeyframe < 0.0 || renderTime - m_LastPathKeyframe >= CAMERA_RECORD_INTERVAL)) {
+            CameraPath::Keyframe keyframe;
+            keyframe.Time = static_cast<float>(renderTime);
+            keyframe.Position = m_CameraPos;
+            keyframe.Yaw = m_CameraYaw;
+            keyframe.Pitch = m_CameraPitch;
+            m_CameraPath.AddKeyframe(keyframe);
+            m_LastPathKeyframe = renderTime;
+        }
     }
+    m_Systems.Run(m_World, playing ? deltaTime : 0.0f, m_JobSystem.get());
 }
 
 
+// Builds this frame's snapshot on the main thread. With a render thread it is drawn there while
+// the next frame simulates; otherwise it is drawn right away, on this thread.
 void Application::Render() {
-    // Start ImGui Frame
+    PROFILE_SCOPE("Render");
+    auto waitStart = std::chrono::steady_clock::now();
+    FrameSnapshot* frame = nullptr;
+    {
+        PROFILE_SCOPE("Wait for free frame");
+        frame = m_Frames.AcquireWrite(); // Blocks only when the GL thread is two frames behind
+    }
+    if (!frame) {
+        std::cerr << "ERROR::APP::Render thread stopped, leaving main loop." << std::endl;
+        m_IsRunning = false;
+        return;
+    }
+    auto buildStart = std::chrono::steady_clock::now();
+    m_FrameWaitMilliseconds = std::chrono::duration<double, std::milli>(buildStart - waitStart).count();
+    BuildFrame(*frame);
+    m_BuildMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count();
+    frame->BuildMilliseconds = m_BuildMilliseconds;
+    frame->FrameMilliseconds = m_LastFrameStart.time_since_epoch().count() ? std::chrono::duration<double, std::milli>(waitStart - m_LastFrameStart).count() : 0.0;
+    m_LastFrameStart = waitStart;
+    m_Frames.Publish(frame);
+
+    if (!m_RenderThread.joinable()) {
+        FrameSnapshot* ready = m_Frames.AcquireRead(); // The frame just published
+        SubmitFrame(*ready, 0.0);
+        m_Frames.Release(ready);
+    }
+}
+
+void Application::BuildFrame(FrameSnapshot& frame) {
+    PROFILE_SCOPE("BuildFrame");
+    // Start ImGui Frame (the GL backend's device objects were created in Initialize, so no GL calls here)
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplSDL2_NewFrame();
     ImGui::NewFrame();
 
-    // Render 3D Scene
-    m_Renderer->Clear();
-
     // Calculate View/Projection
-    glm::vec3 worldUp = glm::vec3(0.0f, 1.0f, 0.0f);
-    glm::vec3 cameraRight = glm::normalize(glm::cross(m_CameraFront, worldUp));
-    glm::vec3 cameraActualUp = glm::normalize(glm::cross(cameraRight, m_CameraFront));
-    glm::mat4 view = glm::lookAt(m_CameraPos, m_CameraPos + m_CameraFront, cameraActualUp);
-    glm::mat4 projection = glm::perspective(glm::radians(45.0f), (float)SCREEN_WIDTH / (float)SCREEN_HEIGHT, 0.1f, 100.0f);
+    frame.FrameIndex = m_FrameIndex++;
+    frame.PoseTime = m_PoseTime;
+    frame.View = GetViewMatrix();
+    frame.Projection = GetProjectionMatrix();
+    frame.ViewProjection = frame.Projection * frame.View;
+    frame.CameraPos = m_CameraPos;
+    frame.SunDirection = GetSunDirection();
+    const glm::mat4& viewProjection = frame.ViewProjection;
+
+    // Refresh bounds of the render list built by the systems, then cull against the camera frustum
+    UpdateSceneBounds();
+    {
+        PROFILE_SCOPE("Culling");
+        Frustum frustum = Frustum::FromMatrix(viewProjection);
+        if (m_UseBVHCulling) {
+            m_VisibleObjects.clear();
+            m_SceneBVH.QueryFrustum(frustum, m_VisibleObjects);
+        } else {
+            m_FrustumCuller.Cull(frustum, m_VisibleObjects, m_JobSystem.get());
+            m_CullStats = m_FrustumCuller.GetLastStats();
+        }
+        if (m_UseOcclusionCulling) {
+            // Only occluders that survived frustum culling can cover anything on screen
+            m_OcclusionCuller.BeginFrame(viewProjection);
+            for (uint32_t index : m_VisibleObjects) {
+                const SceneObject& object = m_SceneObjects[index];
+                if (object.OccluderIndex >= 0) m_OcclusionCuller.SubmitOccluder(static_cast<uint32_t>(object.OccluderIndex), object.Model);
+            }
+            m_OcclusionCuller.RasterizeOccluders(m_JobSystem.get());
+            m_OcclusionCuller.CullOccludees(m_ObjectWorldBounds, m_VisibleObjects, m_JobSystem.get());
+        }
+    }
 
-    // Draw the Loaded Model// Draw the Loaded Model
-    if (m_LitTexturedShader && m_LoadedMesh && m_Renderer) {
-        m_LitTexturedShader->Use(); // Activate the shader
+    // Record draw packets for the visible objects on the workers (no GL calls), then sort them by key
+    frame.UseQueries = m_UseOcclusionQueries && m_OcclusionQueries;
+    frame.DepthPrepass = m_UseDepthPrepass && m_DepthOnlyShader;
+    frame.DrawBatches = m_UseDrawBatches && m_DepthBatchShader;
+    frame.SwapInterval = FramePacer::GetSwapInterval(m_Pacing);
+    frame.DynamicResolution = m_UseDynamicResolution && m_DynamicResolution;
+    frame.SharpenUpscale = m_SharpenUpscale;
+    frame.Resolution.MinScale = m_MinResolutionScale;
+    frame.Resolution.MaxScale = m_MaxResolutionScale;
+    frame.Resolution.BudgetMilliseconds = m_GpuBudgetMilliseconds;
+    const bool useQueries = frame.UseQueries;
+    JobSystem* jobs = m_JobSystem.get();
+    CommandQueue& commands = frame.Commands;
+    {
+        PROFILE_SCOPE("Record commands");
+        commands.BeginFrame(jobs ? jobs->GetWorkerCount() : 1);
+        auto recordRange = [&](size_t begin, size_t end, unsigned int workerIndex) {
+            CommandList& list = commands.GetList(workerIndex);
+            for (size_t i = begin; i < end; ++i) {
+                const uint32_t index = m_VisibleObjects[i];
+                const SceneObject& object = m_SceneObjects[index];
+                const bool predicated = useQueries && object.OcclusionQuery >= 0;
+                const float depth = glm::length(m_ObjectWorldBounds[index].GetCenter() - m_CameraPos) / CAMERA_FAR_PLANE;
+                const uint32_t material = object.MaterialRef && object.MaterialRef->Array ? object.MaterialRef->Array->GetID() : 0;
+                const uint64_t key = SortKey::Make(predicated ? DRAW_LAYER_PREDICATED : DRAW_LAYER_OPAQUE, material, depth, index);
+                list.Draw(key, object.MeshRef, object.MaterialRef, DrawUniforms{ object.Model, viewProjection * object.Model },
+                          predicated ? object.OcclusionQuery : -1);
+            }
+        };
+        if (jobs) jobs->ParallelFor(m_VisibleObjects.size(), COMMAND_RECORD_CHUNK, recordRange);
+        else recordRange(0, m_VisibleObjects.size(), 0);
+        commands.Merge();
+    }
+    m_CommandStats = commands.GetLastStats();
+    frame.VisibleCount = static_cast<uint32_t>(m_VisibleObjects.size());
 
-        // Calculate model matrix (still rotating)
-        glm::mat4 model = glm::rotate(glm::mat4(1.0f), m_RotationAngle, glm::vec3(0.0f, 1.0f, 0.0f));
-        glm::mat4 mvp = projection * view * model;
+    // Bin the point/spot lights into this camera's froxels
+    if (m_ClusteredLighting) m_LightGrid.Build(frame.View, frame.Projection, m_Lights, frame.Lights, jobs);
 
-        // Set common shader uniforms
-        m_LitTexturedShader->SetMat4("uMVP", mvp);
-        m_LitTexturedShader->SetMat4("uModel", model);
-        m_LitTexturedShader->SetVec3("uViewPos", m_CameraPos);
+    // Shadow casters per cascade, culled against each cascade's light-space box
+    BuildShadowDraws(frame);
 
-        // Set lighting uniforms (example values)
-        m_LitTexturedShader->SetVec3("uLightDir", glm::vec3(0.5f, -1.0f, -0.5f));
-        m_LitTexturedShader->SetVec3("uLightColor", glm::vec3(1.0f, 1.0f, 1.0f));
+    // Only the features this frame uses go into the lit program
+    frame.LitFeatures = 0;
+    if (frame.Shadows.CascadeCount > 0) frame.LitFeatures |= m_LitShadowsFeature;
+    if (frame.Lights.GetLightCount() > 0) frame.LitFeatures |= m_LitLightsFeature;
+    if (frame.DrawBatches) frame.LitFeatures |= m_LitBatchFeature;
 
-        // Bind Texture (if loaded) to texture unit 0
-        if (m_DiffuseTexture) {
-            m_DiffuseTexture->Bind(0);
-            m_LitTexturedShader->SetInt("uTextureDiffuse", 0);
+    // Boxes for this frame's GPU queries, drawn between the two layers
+    frame.Queries.clear();
+    if (useQueries) {
+        for (uint32_t index : m_VisibleObjects) {
+            const SceneObject& object = m_SceneObjects[index];
+            if (object.OcclusionQuery >= 0) frame.Queries.push_back(QueryBox{ static_cast<uint32_t>(object.OcclusionQuery), m_ObjectWorldBounds[index] });
         }
+    }
+
+    // Render UI, then keep a copy of its draw data (ImGui reuses its own on the next NewFrame)
+    RenderUI();
+    PROFILE_SCOPE("UI draw data");
+    ImGui::Render();
+    frame.UI.CopyFrom(*ImGui::GetDrawData());
+}
 
-        // --- CORRECTED MESH DRAWING ---
-        m_LoadedMesh->Bind();   // Bind the mesh's VAO
-        m_LoadedMesh->Draw();   // Draw using the mesh's EBO
-        m_LoadedMesh->Unbind(); // Unbind the mesh's VAO
-        // --- END CORRECTION ---
+// Runs on whichever thread currently owns the GL context.
+void Application::SubmitFrame(FrameSnapshot& frame, double waitMilliseconds) {
+    PROFILE_SCOPE("SubmitFrame");
+    auto submitStart = std::chrono::steady_clock::now();
 
+    GpuProfiler* profiler = m_GpuProfiler.get();
+    if (profiler) profiler->BeginFrame(); // Reads back timings of earlier frames
+    if (m_FrameCapture) m_FrameCapture->Collect(); // Readbacks of earlier frames that have finished
+    double captureMilliseconds = m_FrameCapture ? m_FrameCapture->GetStats().CollectMilliseconds : 0.0;
 
-        // Unbind texture (optional, good practice)
-        if (m_DiffuseTexture) {
-            m_DiffuseTexture->Unbind();
+    // Scene scale from the newest GPU timings, paired with the scale that frame was drawn at. Present is
+    // left out: with vsync its time is mostly waiting for the display, not work the scale could remove.
+    // Without the profiler, the main thread's frame time is the only signal (one frame old)
+    float resolutionScale = 1.0f;
+    if (frame.DynamicResolution) {
+        double measured = 0.0;
+        uint32_t latency = 1;
+        if (profiler) {
+            const GpuProfiler::FrameStats gpuStats = profiler->GetFrameStats();
+            if (gpuStats.Resolved != m_ResolvedGpuFrames) measured = profiler->GetLastBusyMilliseconds("Present");
+            m_ResolvedGpuFrames = gpuStats.Resolved;
+            latency = gpuStats.LatencyFrames;
+        } else {
+            measured = frame.FrameMilliseconds;
+        }
+        resolutionScale = m_ResolutionScaler.Update(measured, latency, frame.Resolution);
+    } else {
+        m_ResolutionScaler.Reset(1.0f);
+    }
+
+    // Render 3D Scene
+    m_Renderer->BeginFrame();
+    if (m_DeformingMesh) UpdateDeformingMesh(frame.PoseTime);
+    if (m_OcclusionQueries) m_OcclusionQueries->BeginFrame(); // Collects results that are already back
+    int sceneWidth = m_Config.Width;
+    int sceneHeight = m_Config.Height;
+    if (frame.DynamicResolution) {
+        m_DynamicResolution->SetScale(resolutionScale);
+        sceneWidth = m_DynamicResolution->GetSceneWidth();
+        sceneHeight = m_DynamicResolution->GetSceneHeight();
+    }
+
+    // The frame as a render graph: passes declare what they read and write, compiling orders them by
+    // those dependencies, culls the ones nothing uses and places the transient targets, and the
+    // executor runs the rest
+    RenderGraph& graph = m_RenderGraph;
+    graph.Reset();
+    const Framebuffer* offscreen = m_Renderer->GetOffscreenTarget();
+    const RenderResource backBuffer = graph.Import("Back buffer", true, offscreen ? offscreen->GetID() : 0, m_Config.Width, m_Config.Height);
+    const RenderResource shadowMaps = graph.Import("Shadow maps", false);
+    const RenderResource queries = graph.Import("Occlusion queries", true); // Predicate next frame's draws
+    RenderResource sceneColor = backBuffer;
+    RenderResource sceneDepth = backBuffer;
+    if (frame.DynamicResolution) {
+        // Sized for the largest scale; the scene only covers the lower-left sceneWidth x sceneHeight
+        RenderTextureDesc desc;
+        desc.Width = m_DynamicResolution->GetTargetWidth();
+        desc.Height = m_DynamicResolution->GetTargetHeight();
+        sceneColor = graph.CreateTexture("Scene color", desc);
+        desc.Format = RenderFormat::Depth24;
+        sceneDepth = graph.CreateTexture("Scene depth", desc);
+    }
+    auto sceneViewport = [sceneWidth, sceneHeight]() { glViewport(0, 0, sceneWidth, sceneHeight); };
+
+    if (m_ShadowMaps && m_DepthOnlyShader && frame.Shadows.CascadeCount > 0) {
+        graph.AddPass("Shadows", {}, {shadowMaps}, [&](const RenderGraphExecutor&) { RenderShadowPass(frame); });
+    }
+    graph.AddPass("Clear", {}, {sceneColor, sceneDepth}, [&](const RenderGraphExecutor&) { m_Renderer->Clear(); });
+
+    // Replay the sorted packets; a variant that failed to build falls back to the plain, unbatched one
+    const Shader* litShader = m_LitShaders ? m_LitShaders->Get(frame.LitFeatures) : nullptr;
+    const bool batched = frame.DrawBatches && litShader;
+    if (!litShader && m_LitShaders) litShader = m_LitShaders->Get(0);
+    const Shader* depthShader = batched ? m_DepthBatchShader : m_DepthOnlyShader.get();
+    // Batched: consecutive packets with the same texture array become one multi-draw, flushed by the pass
+    auto submit = [&](const DrawPacket& packet, const DrawUniforms& uniforms) {
+        if (batched) m_Renderer->SubmitBatched(*litShader, packet, uniforms);
+        else m_Renderer->SubmitPacket(*litShader, packet, uniforms);
+    };
+    if (litShader && m_Renderer) {
+        if (frame.DepthPrepass) {
+            // Opaque depth only, from the 12-byte position stream; the opaque pass then shades each pixel once
+            graph.AddPass("Depth prepass", {sceneDepth}, {sceneDepth}, [&](const RenderGraphExecutor&) {
+                sceneViewport();
+                glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+                frame.Commands.Replay(DRAW_LAYER_OPAQUE, [&](const DrawPacket& packet, const DrawUniforms& uniforms) {
+                    if (batched) m_Renderer->SubmitDepthBatched(*depthShader, packet, uniforms);
+                    else m_Renderer->SubmitDepthPacket(*depthShader, packet, uniforms);
+                });
+                m_Renderer->FlushBatch();
+                glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            });
+        }
+
+        // Regular objects first: they are the occluders the query boxes are tested against
+        graph.AddPass("Opaque", {shadowMaps, sceneDepth}, {sceneColor, sceneDepth}, [&](const RenderGraphExecutor&) {
+            sceneViewport();
+            if (frame.DepthPrepass) {
+                glDepthFunc(GL_EQUAL);
+                glDepthMask(GL_FALSE);
+            }
+            litShader->Use(); // Activate the shader
+
+            // Per-frame uniforms
+            litShader->SetVec3("uViewPos", frame.CameraPos);
+            litShader->SetMat4("uView", frame.View);
+
+            // Directional light (the sun), shadowed by the cascades
+            litShader->SetVec3("uLightDir", frame.SunDirection);
+            litShader->SetVec3("uLightColor", glm::vec3(1.0f, 1.0f, 1.0f));
+            if (m_ShadowMaps) {
+                glm::mat4 cascadeMatrices[ShadowCascades::MaxCascades];
+                for (int i = 0; i < frame.Shadows.CascadeCount; ++i) cascadeMatrices[i] = frame.Shadows.Cascades[i].ViewProjection;
+                m_ShadowMaps->Bind(*litShader, frame.Shadows.CascadeCount, cascadeMatrices, frame.Shadows.Splits, frame.Shadows.TexelSizes);
+            }
+
+            // Material texture arrays go to unit 0; the renderer rebinds only when the array changes between packets
+            litShader->SetInt("uTextureDiffuse", 0);
+            if (m_ClusteredLighting) {
+                GpuProfileScope scope(profiler, "Light upload");
+                m_ClusteredLighting->Upload(frame.Lights);
+                m_ClusteredLighting->Bind(*litShader, sceneWidth, sceneHeight);
+            }
+            frame.Commands.Replay(DRAW_LAYER_OPAQUE, submit);
+            m_Renderer->FlushBatch();
+            if (frame.DepthPrepass) {
+                glDepthFunc(GL_LESS);
+                glDepthMask(GL_TRUE);
+            }
+        });
+
+        if (frame.UseQueries) {
+            // This frame's box queries (depth-tested only), then the real draws predicated on last frame's results
+            graph.AddPass("Query pass", {sceneDepth}, {sceneDepth, queries}, [&](const RenderGraphExecutor&) {
+                sceneViewport();
+                m_OcclusionQueries->BeginQueryPass(frame.ViewProjection, frame.CameraPos);
+                for (const QueryBox& box : frame.Queries) m_OcclusionQueries->Query(box.Query, box.Bounds);
+                m_OcclusionQueries->EndQueryPass();
+            });
+            graph.AddPass("Predicated", {queries, sceneDepth}, {sceneColor, sceneDepth}, [&](const RenderGraphExecutor&) {
+                sceneViewport();
+                frame.Commands.Replay(DRAW_LAYER_PREDICATED, [&](const DrawPacket& packet, const DrawUniforms& uniforms) {
+                    bool conditional = m_OcclusionQueries->BeginConditionalDraw(static_cast<uint32_t>(packet.OcclusionQuery));
+                    submit(packet, uniforms);
+                    m_Renderer->FlushBatch(); // A batch of one: each draw has its own predicate
+                    if (conditional) m_OcclusionQueries->EndConditionalDraw();
+                });
+            });
         }
 
     } else {
         // Handle case where shader or mesh isn't loaded
-        if (!m_LitTexturedShader) std::cerr << "WARN::RENDER::Shader not loaded!" << std::endl;
-        if (!m_LoadedMesh) std::cerr << "WARN::RENDER::Mesh not loaded!" << std::endl;
+        if (!litShader) std::cerr << "WARN::RENDER::Shader not loaded!" << std::endl;
     }
 
+    // Back to the native target; the UI below stays at full resolution
+    if (frame.DynamicResolution) {
+        graph.AddPass("Upscale", {sceneColor}, {backBuffer}, [&](const RenderGraphExecutor& executor) {
+            m_DynamicResolution->Upscale(executor.GetTexture(sceneColor), executor.GetFramebuffer(sceneColor),
+                                         frame.SharpenUpscale ? m_UpscaleShader.get() : nullptr, UPSCALE_SHARPNESS);
+        });
+    }
 
-    // Render UI
-    RenderUI();
+    // UI from the snapshot
+    if (ImDrawData* drawData = frame.UI.Get()) {
+        graph.AddPass("UI", {}, {backBuffer}, [drawData](const RenderGraphExecutor&) { ImGui_ImplOpenGL3_RenderDrawData(drawData); });
+    }
 
-    // End ImGui Frame & Render
-    ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    // Queue this frame's readback behind everything drawn so far, UI included; mapped a few frames later
+    if (m_FrameCapture && frame.FrameIndex % m_Config.CaptureInterval == 0) {
+        graph.AddPass("Capture", {backBuffer}, {}, [&](const RenderGraphExecutor&) {
+            m_FrameCapture->Capture(frame.FrameIndex);
+            captureMilliseconds += m_FrameCapture->GetStats().IssueMilliseconds;
+        }, true);
+    }
+
+    if (graph.Compile()) {
+        const std::string layout = graph.Describe();
+        if (layout != m_RenderGraphLayout) {
+            const RenderGraph::Stats& stats = graph.GetStats();
+            std::cout << "INFO::RENDER_GRAPH::" << layout << "; " << stats.Transients << " transient(s) in " << stats.PhysicalTextures
+                      << " texture(s), " << stats.PhysicalBytes / 1024 << " KB." << std::endl;
+            m_RenderGraphLayout = layout;
+        }
+        m_GraphExecutor->Execute(graph, profiler);
+    }
+
+    // Present final frame; a pacing change from the overlay applies here, on the thread that owns the context
+    if (frame.SwapInterval != m_RequestedSwapInterval) {
+        m_RequestedSwapInterval = frame.SwapInterval;
+        m_SwapInterval = m_Renderer->SetSwapInterval(frame.SwapInterval);
+        m_PresentIntervals.Clear();
+    }
+    auto presentStart = std::chrono::steady_clock::now();
+    {
+        PROFILE_SCOPE("Present");
+        GpuProfileScope scope(profiler, "Present");
+        m_Renderer->Present(m_Window);
+    }
+    auto presentEnd = std::chrono::steady_clock::now();
+    double presentInterval = 0.0;
+    if (m_LastPresentEnd.time_since_epoch().count()) {
+        presentInterval = std::chrono::duration<double, std::milli>(presentEnd - m_LastPresentEnd).count();
+        m_PresentIntervals.Add(presentInterval);
+    }
+    m_LastPresentEnd = presentEnd;
+    if (profiler) profiler->EndFrame();
+    if (IsCollectingFrameTimings()) {
+        FrameTiming timing;
+        timing.FrameIndex = frame.FrameIndex;
+        timing.FrameMilliseconds = frame.FrameMilliseconds;
+        timing.BuildMilliseconds = frame.BuildMilliseconds;
+        timing.SubmitMilliseconds = std::chrono::duration<double, std::milli>(presentStart - submitStart).count();
+        timing.PresentMilliseconds = std::chrono::duration<double, std::milli>(presentEnd - presentStart).count();
+        timing.Visible = frame.VisibleCount;
+        timing.Packets = static_cast<uint32_t>(frame.Commands.GetPacketCount());
+        timing.ShadowDraws = frame.Shadows.Stats.Draws;
+        timing.ShadowDrawsUncached = frame.Shadows.Stats.UncachedDraws;
+        timing.ResolutionScale = resolutionScale;
+        timing.PresentIntervalMilliseconds = presentInterval;
+        timing.CaptureMilliseconds = captureMilliseconds;
+        m_FrameTimings.push_back(timing);
+    }
+
+    // Publish what the overlay shows; the main thread never reads GL-side objects directly
+    std::lock_guard<std::mutex> lock(m_RenderStatsMutex);
+    m_RenderStats.FramesSubmitted++;
+    m_RenderStats.LastFrameIndex = frame.FrameIndex;
+    m_RenderStats.WaitMilliseconds = waitMilliseconds;
+    m_RenderStats.SubmitMilliseconds = std::chrono::duration<double, std::milli>(presentStart - submitStart).count();
+    m_RenderStats.PresentMilliseconds = std::chrono::duration<double, std::milli>(presentEnd - presentStart).count();
+    if (m_OcclusionQueries) m_RenderStats.Queries = m_OcclusionQueries->GetLastStats();
+    if (m_LitShaders) m_RenderStats.LitVariants = m_LitShaders->GetStats();
+    m_RenderStats.Presents = m_PresentIntervals.GetStats();
+    m_RenderStats.SwapInterval = m_SwapInterval;
+    if (m_FrameCapture) m_RenderStats.Capture = m_FrameCapture->GetStats();
+    m_RenderStats.Graph = graph.GetStats();
+    m_RenderStats.GraphPool = m_GraphExecutor->GetStats();
+    if (m_DeformingMesh) m_RenderStats.DeformingMesh = m_DeformingMesh->GetDynamicStats();
+    m_RenderStats.ResolutionScale = resolutionScale;
+    m_RenderStats.ResolutionHeadroom = m_ResolutionScaler.GetHeadroom();
+    m_RenderStats.ScaledMilliseconds = m_ResolutionScaler.GetSmoothedMilliseconds();
+    m_RenderStats.SceneWidth = sceneWidth;
+    m_RenderStats.SceneHeight = sceneHeight;
+    m_RenderStats.DrawBatches = m_Renderer->GetBatchStats().Batches;
+    m_RenderStats.BatchedDraws = m_Renderer->GetBatchStats().Draws;
+    const StreamingBuffer* stream = m_Renderer->GetFrameStream();
+    m_RenderStats.HasStream = stream != nullptr;
+    m_RenderStats.StreamPersistent = stream && stream->IsPersistent();
+    m_RenderStats.StreamWaitedFrames = stream ? stream->GetWaitedFrameCount() : 0;
+    m_RenderStats.StreamBytesUsed = stream ? stream->GetBytesUsedThisFrame() : 0; // Until the next BeginFrame
+    m_RenderStats.StreamBytesPerFrame = stream ? stream->GetBytesPerFrame() : 0;
+}
+
+// Hands the GL context to a new render thread. Window events stay on the main thread.
+bool Application::StartRenderThread() {
+    if (m_RenderThread.joinable()) return true;
+    // A context can only be current on one thread at a time
+    if (SDL_GL_MakeCurrent(m_Window, nullptr) != 0) {
+        std::cerr << "ERROR::APP::Could not release GL context for the render thread: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    m_Frames.Reset();
+    m_RenderThread = std::thread(&Application::RenderThreadMain, this);
+    std::cout << "INFO::APP::Render thread started." << std::endl;
+    return true;
+}
+
+// Stops and joins the render thread (dropping frames it had not drawn yet) and takes the context back.
+void Application::StopRenderThread() {
+    if (!m_RenderThread.joinable()) return;
+    m_Frames.Stop();
+    m_RenderThread.join();
+    m_Frames.Reset();
+    if (m_Renderer && SDL_GL_MakeCurrent(m_Window, m_Renderer->GetGLContext()) != 0) {
+        std::cerr << "ERROR::APP::Could not reclaim GL context: " << SDL_GetError() << std::endl;
+    }
+    std::cout << "INFO::APP::Render thread stopped." << std::endl;
+}
 
-    // Present final frame
-    m_Renderer->Present(m_Window);
+void Application::RenderThreadMain() {
+    PROFILE_THREAD("Render");
+    if (SDL_GL_MakeCurrent(m_Window, m_Renderer->GetGLContext()) != 0) {
+        std::cerr << "ERROR::APP::Render thread could not make GL context current: " << SDL_GetError() << std::endl;
+        m_Frames.Stop(); // Main loop sees no free slot and exits
+        return;
+    }
+    for (;;) {
+        auto waitStart = std::chrono::steady_clock::now();
+        FrameSnapshot* frame = nullptr;
+        {
+            PROFILE_SCOPE("Wait for frame");
+            frame = m_Frames.AcquireRead();
+        }
+        if (!frame) break;
+        double waited = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - waitStart).count();
+        SubmitFrame(*frame, waited);
+        m_Frames.Release(frame);
+    }
+    SDL_GL_MakeCurrent(m_Window, nullptr);
+}
+
+bool Application::WriteFrameStats() const {
+    std::ofstream file(m_Config.StatsPath);
+    if (!file) {
+        std::cerr << "ERROR::APP::Could not open stats file: " << m_Config.StatsPath << std::endl;
+        return false;
+    }
+    file << "frame,frame_ms,build_ms,submit_ms,present_ms,gpu_ms,visible,packets,shadow_draws,shadow_draws_uncached,resolution_scale,present_interval_ms,capture_ms\n";
+    for (const FrameTiming& timing : m_FrameTimings) {
+        file << timing.FrameIndex << ',' << timing.FrameMilliseconds << ',' << timing.BuildMilliseconds << ',' << timing.SubmitMilliseconds << ','
+             << timing.PresentMilliseconds << ',';
+        if (timing.GpuMilliseconds >= 0.0) file << timing.GpuMilliseconds;
+        file << ',' << timing.Visible << ',' << timing.Packets << ',' << timing.ShadowDraws << ',' << timing.ShadowDrawsUncached << ','
+             << timing.ResolutionScale << ',' << timing.PresentIntervalMilliseconds << ',' << timing.CaptureMilliseconds << '\n';
+    }
+    std::cout << "INFO::APP::Wrote " << m_FrameTimings.size() << " frame(s) of stats to " << m_Config.StatsPath << std::endl;
+    return true;
+}
+
+// Summarizes the measured frames (after the warm-up, before the read-back tail) as <report>.json/.csv.
+bool Application::WriteBenchmarkReport() const {
+    const uint64_t first = static_cast<uint64_t>(m_Config.WarmupFrames);
+    const uint64_t end = first + static_cast<uint64_t>(m_Config.BenchmarkFrames);
+    std::vector<double> frame, build, submit, present, gpu, shadowDraws, shadowDrawsUncached, resolutionScale, presentInterval, capture;
+    std::vector<std::string> passNames; // First-seen order
+    std::unordered_map<std::string, std::vector<double>> passes;
+    for (const FrameTiming& timing : m_FrameTimings) {
+        if (timing.FrameIndex < first || timing.FrameIndex >= end) continue;
+        frame.push_back(timing.FrameMilliseconds);
+        build.push_back(timing.BuildMilliseconds);
+        submit.push_back(timing.SubmitMilliseconds);
+        present.push_back(timing.PresentMilliseconds);
+        shadowDraws.push_back(timing.ShadowDraws);
+        shadowDrawsUncached.push_back(timing.ShadowDrawsUncached);
+        resolutionScale.push_back(timing.ResolutionScale);
+        presentInterval.push_back(timing.PresentIntervalMilliseconds);
+        capture.push_back(timing.CaptureMilliseconds);
+        if (timing.GpuMilliseconds >= 0.0) gpu.push_back(timing.GpuMilliseconds);
+        for (const auto& pass : timing.GpuPasses) {
+            std::string name = pass.first;
+            for (char& c : name) c = (c == ' ') ? '_' : static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            auto found = passes.find(name);
+            if (found == passes.end()) {
+                passNames.push_back(name);
+                found = passes.emplace(name, std::vector<double>()).first;
+            }
+            found->second.push_back(pass.second);
+        }
+    }
+    if (frame.size() < static_cast<size_t>(m_Config.BenchmarkFrames)) {
+        std::cout << "WARN::APP::Benchmark ended early: " << frame.size() << " of " << m_Config.BenchmarkFrames << " frames measured." << std::endl;
+    }
+
+    BenchmarkReport report;
+    report.SetInfo("frames", std::to_string(m_Config.BenchmarkFrames));
+    report.SetInfo("warmup", std::to_string(m_Config.WarmupFrames));
+    report.SetInfo("fixed_fps", std::to_string(m_Config.FixedFps));
+    report.SetInfo("camera_path", m_Config.CameraPathFile.empty() ? "orbit" : m_Config.CameraPathFile);
+    report.SetInfo("size", std::to_string(m_Config.Width) + "x" + std::to_string(m_Config.Height));
+    report.SetInfo("headless", m_Config.Headless ? "true" : "false");
+    report.SetInfo("render_thread", m_Config.RenderThread ? "true" : "false");
+    report.SetInfo("depth_prepass", m_UseDepthPrepass ? "true" : "false");
+    report.SetInfo("pacing", FramePacer::GetModeName(m_Pacing));
+    report.SetInfo("dynamic_resolution", m_UseDynamicResolution ? std::to_string(m_GpuBudgetMilliseconds) + " ms" : "false");
+    report.SetInfo("lights", std::to_string(m_Lights.size()));
+    report.SetInfo("shadows", m_UseShadows ? "true" : "false");
+    report.SetInfo("shadow_cache", m_UseShadows && m_UseShadowCache ? "true" : "false");
+    const RenderGraph::Stats& graph = m_RenderStats.Graph; // The render thread has stopped by now
+    report.SetInfo("render_graph", std::to_string(graph.Passes) + " passes, " + std::to_string(graph.CulledPasses) + " culled, " +
+                                   std::to_string(graph.Transients) + " transients in " + std::to_string(graph.PhysicalTextures) + " textures");
+    report.SetInfo("transient_kb", std::to_string(graph.PhysicalBytes / 1024) + " (" + std::to_string(graph.TransientBytes / 1024) + " unaliased)");
+    if (m_DeformingMesh) {
+        const Mesh::DynamicStats& dynamic = m_RenderStats.DeformingMesh;
+        report.SetInfo("deforming_mesh", std::to_string(dynamic.Commits) + " commits, " + std::to_string(dynamic.UploadedBytes / 1024) + " KB, " +
+                                         std::to_string(dynamic.SynchronizedUploads) + " synchronized");
+    }
+    if (const GLubyte* renderer = glGetString(GL_RENDERER)) report.SetInfo("gl_renderer", reinterpret_cast<const char*>(renderer));
+    report.AddMetric("cpu_frame_ms", frame);
+    report.AddMetric("cpu_build_ms", build);
+    report.AddMetric("gl_submit_ms", submit);
+    report.AddMetric("present_ms", present);
+    report.AddMetric("present_interval_ms", presentInterval);
+    if (m_FrameCapture) report.AddMetric("capture_ms", capture);
+    report.AddMetric("gpu_frame_ms", gpu);
+    report.AddMetric("shadow_draws", shadowDraws);
+    report.AddMetric("shadow_draws_uncached", shadowDrawsUncached);
+    report.AddMetric("resolution_scale", resolutionScale);
+    // Per pass, to see what a feature costs or saves (e.g. depth prepass against opaque)
+    for (const std::string& name : passNames) {
+        std::vector<double>& samples = passes[name];
+        report.AddMetric("gpu_" + name + "_ms", samples);
+    }
+
+    std::cout << "INFO::APP::Benchmark results:" << std::endl;
+    report.Print();
+    const bool written = report.WriteJson(m_Config.ReportPath + ".json") && report.WriteCsv(m_Config.ReportPath + ".csv");
+    if (written) std::cout << "INFO::APP::Wrote " << m_Config.ReportPath << ".json and " << m_Config.ReportPath << ".csv" << std::endl;
+    return written;
+}
+
+glm::mat4 Application::GetViewMatrix() const {
+    glm::vec3 worldUp = glm::vec3(0.0f, 1.0f, 0.0f);
+    glm::vec3 cameraRight = glm::normalize(glm::cross(m_CameraFront, worldUp));
+    glm::vec3 cameraActualUp = glm::normalize(glm::cross(cameraRight, m_CameraFront));
+    return glm::lookAt(m_CameraPos, m_CameraPos + m_CameraFront, cameraActualUp);
+}
+
+glm::mat4 Application::GetProjectionMatrix() const {
+    return glm::perspective(glm::radians(45.0f), (float)m_Config.Width / (float)m_Config.Height, 0.1f, CAMERA_FAR_PLANE);
+}
+
+// Pushes every object's world bounds into the SoA culler and refits the BVH over the same boxes.
+void Application::UpdateSceneBounds() {
+    if (m_FrustumCuller.Size() != m_SceneObjects.size()) {
+        // The render list changed size (entities created/destroyed); culler slots follow its order
+        m_FrustumCuller.Clear();
+        for (size_t i = 0; i < m_SceneObjects.size(); ++i) m_FrustumCuller.Add(AABB());
+    }
+    m_ObjectWorldBounds.resize(m_SceneObjects.size());
+    for (size_t i = 0; i < m_SceneObjects.size(); ++i) {
+        const SceneObject& object = m_SceneObjects[i];
+        BoundingSphere worldSphere = object.MeshRef->GetBoundingSphere();
+        worldSphere.Center = glm::vec3(object.Model * glm::vec4(worldSphere.Center, 1.0f)); // Rigid transforms only for now
+        m_ObjectWorldBounds[i] = Bounds::Transform(object.MeshRef->GetBounds(), object.Model);
+        m_FrustumCuller.Set(static_cast<uint32_t>(i), m_ObjectWorldBounds[i], worldSphere);
+    }
+
+    // Swap in a finished background rebuild, otherwise refit; start a new rebuild once the tree has degraded
+    if (m_SceneBVH.GetObjectCount() != m_ObjectWorldBounds.size()) {
+        m_SceneBVH.Build(m_ObjectWorldBounds);
+    } else if (!m_SceneBVH.PollRebuild(m_ObjectWorldBounds)) {
+        m_SceneBVH.Refit(m_ObjectWorldBounds);
+        if (!m_SceneBVH.IsRebuildPending() && m_SceneBVH.GetDegradation() > BVH_REBUILD_DEGRADATION) {
+            m_SceneBVH.BeginRebuildAsync(m_ObjectWorldBounds);
+        }
+    }
+}
+
+// Unprojects the cursor into a world-space ray and picks the closest object box along it.
+void Application::PickObject(int mouseX, int mouseY) {
+    float ndcX = (2.0f * mouseX) / m_Config.Width - 1.0f;
+    float ndcY = 1.0f - (2.0f * mouseY) / m_Config.Height;
+    glm::mat4 inverseViewProjection = glm::inverse(GetProjectionMatrix() * GetViewMatrix());
+    glm::vec4 nearPoint = inverseViewProjection * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+    glm::vec4 farPoint = inverseViewProjection * glm::vec4(ndcX, ndcY, 1.0f, 1.0f);
+    glm::vec3 origin = glm::vec3(nearPoint) / nearPoint.w;
+    glm::vec3 direction = glm::vec3(farPoint) / farPoint.w - origin;
+
+    RayHit hit = m_SceneBVH.Raycast(origin, direction);
+    m_PickedObject = hit.IsValid() ? static_cast<int>(hit.ObjectIndex) : -1;
+    if (hit.IsValid()) {
+        std::cout << "INFO::APP::Picked object " << hit.ObjectIndex << " at distance " << hit.Distance << std::endl;
+    }
 }
 
 void Application::RenderUI() {
-    // ... (RenderUI logic remains the same) ...
+    PROFILE_SCOPE("RenderUI");
+    RenderStatsOverlay();
+    if (m_ShowGpuProfiler) RenderGpuProfilerPanel();
+#ifdef ENGINE_ENABLE_PROFILER
+    if (m_ShowProfiler) RenderProfilerPanel();
+#endif
+
      if (m_CurrentState == GameState::Paused) {
         ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x * 0.5f, ImGui::GetIO().DisplaySize.y * 0.5f), ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
         ImGui::Begin("Pause Menu", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoMove);
@@ -324,7 +1134,7 @@ void Application::RenderUI() {
             m_CurrentState = GameState::Playing;
             SDL_SetRelativeMouseMode(SDL_TRUE);
             m_FirstMouse = true;
-            if (m_MusicChannel != -1) Mix_Resume(m_MusicChannel); // <-- RESUME MUSIC
+            RequestMusic(AudioRequest::Resume);
         }
         if (ImGui::Button("Help", ImVec2(120, 0))) {
             m_CurrentState = GameState::ShowingHelp;
@@ -332,17 +1142,14 @@ void Application::RenderUI() {
     
         // --- Add Pause/Resume Music Button ---
         if (m_MixerInitialized && m_SoundLoaded) { // Only show if sound system is ready
-            bool isMusicPaused = (m_MusicChannel != -1) && Mix_Paused(m_MusicChannel);
-            // Check if actually playing OR paused (channel might be -1 if stopped)
-            bool isMusicActive = (m_MusicChannel != -1) && (Mix_Playing(m_MusicChannel) || isMusicPaused);
+            const AudioSource* music = m_World.GetComponent<AudioSource>(m_MusicEntity);
+            bool isMusicPaused = music && (music->Channel != -1) && Mix_Paused(music->Channel);
+            // Check if actually playing OR paused (channel is -1 once the sound has finished)
+            bool isMusicActive = music && (music->Channel != -1) && (Mix_Playing(music->Channel) || isMusicPaused);
     
             if (isMusicActive) { // Only show pause/resume if channel is valid
                  if (ImGui::Button(isMusicPaused ? "Resume Music" : "Pause Music", ImVec2(120, 0))) {
-                     if (isMusicPaused) {
-                         Mix_Resume(m_MusicChannel);
-                     } else {
-                         Mix_Pause(m_MusicChannel);
-                     }
+                     RequestMusic(isMusicPaused ? AudioRequest::Resume : AudioRequest::Pause);
                  }
              } else {
                  // Optional: Show a disabled button or nothing if music isn't active
@@ -369,11 +1176,270 @@ void Application::RenderUI() {
         ImGui::End();
     }
 }
+void Application::RenderStatsOverlay() {
+    ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f), ImGuiCond_Always);
+    ImGui::SetNextWindowBgAlpha(0.35f);
+    ImGui::Begin("Stats", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoMove);
+    ImGui::Text("%.1f FPS (%.2f ms)", ImGui::GetIO().Framerate, 1000.0f / ImGui::GetIO().Framerate);
+    RenderThreadStats render;
+    {
+        std::lock_guard<std::mutex> lock(m_RenderStatsMutex);
+        render = m_RenderStats;
+    }
+    // With a render thread the frame costs roughly max(main, render) instead of their sum
+    ImGui::Text("Main thread: build %.3f ms, waited %.3f ms for a free frame", m_BuildMilliseconds, m_FrameWaitMilliseconds);
+    ImGui::Text("%s: submit %.3f ms, present %.3f ms, idle %.3f ms, %llu frame(s) behind",
+                m_RenderThread.joinable() ? "Render thread" : "GL (main thread)", render.SubmitMilliseconds, render.PresentMilliseconds,
+                render.WaitMilliseconds, (unsigned long long)(m_FrameIndex - 1 - render.LastFrameIndex));
+
+    // Pacing: pick the mode with the lowest latency whose frame times and presents stay even
+    int pacing = static_cast<int>(m_Pacing);
+    if (ImGui::Combo("Pacing", &pacing, "VSync\0Adaptive VSync\0Uncapped\0Frame limiter\0")) m_Pacing = static_cast<PacingMode>(pacing);
+    if (m_Pacing == PacingMode::Limited) {
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(120.0f);
+        ImGui::SliderInt("FPS", &m_FpsLimit, 20, 360);
+    }
+    const FrameIntervals::Stats frames = m_FramePacer.GetFrameIntervals().GetStats();
+    const FrameIntervals::Stats& presents = render.Presents;
+    ImGui::Text("Frame time: %.2f +/- %.2f ms (max %.2f), jitter %.3f ms", frames.MeanMilliseconds, frames.StdDevMilliseconds,
+                frames.MaxMilliseconds, frames.JitterMilliseconds);
+    ImGui::Text("Present interval: %.2f +/- %.2f ms (max %.2f), jitter %.3f ms, swap interval %d", presents.MeanMilliseconds,
+                presents.StdDevMilliseconds, presents.MaxMilliseconds, presents.JitterMilliseconds, render.SwapInterval);
+    if (m_CaptureWriter) {
+        const FrameCapture::Stats& capture = render.Capture;
+        const CaptureWriter::Stats writer = m_CaptureWriter->GetStats();
+        ImGui::Text("Capture: %llu read back, %u in flight (%u frame(s) late), %llu stall(s), issue %.3f ms, copy %.3f ms",
+                    (unsigned long long)capture.Captured, capture.InFlight, capture.LatencyFrames, (unsigned long long)capture.Stalls,
+                    capture.IssueMilliseconds, capture.CollectMilliseconds);
+        ImGui::Text("  writer: %llu written, %u queued, %llu blocked, %.2f ms per frame (%s)", (unsigned long long)writer.Written,
+                    writer.Queued, (unsigned long long)writer.Blocked, writer.EncodeMilliseconds, CaptureWriter::GetFormatName(m_Config.OutputFormat));
+    }
+    const FrustumCuller::Stats& cull = m_CullStats;
+    ImGui::Checkbox("BVH culling", &m_UseBVHCulling);
+    if (m_UseBVHCulling) {
+        const BVH::Stats& bvh = m_SceneBVH.GetStats();
+        ImGui::Text("BVH: %zu / %zu visible, %u nodes, depth %u, SAH x%.2f%s", m_VisibleObjects.size(), m_SceneBVH.GetObjectCount(),
+                    bvh.NodeCount, bvh.MaxDepth, m_SceneBVH.GetDegradation(), m_SceneBVH.IsRebuildPending() ? " (rebuilding)" : "");
+    } else {
+        ImGui::Text("Frustum: %u / %u visible (%.3f ms, %s, %u slice(s))", cull.Visible, cull.Tested, cull.MillisecondsCPU, FrustumCuller::GetSimdPathName(), cull.SlicesUsed);
+    }
+    ImGui::Checkbox("Occlusion culling", &m_UseOcclusionCulling);
+    if (m_UseOcclusionCulling) {
+        const OcclusionCuller::Stats& occlusion = m_OcclusionCuller.GetLastStats();
+        ImGui::Text("Occlusion: %u / %u draws rejected (%.1f%%), %u occluder tris, raster %.3f ms, test %.3f ms",
+                    occlusion.Rejected, occlusion.Tested, occlusion.GetRejectedPercent(), occlusion.RasterizedTriangles,
+                    occlusion.RasterMilliseconds, occlusion.TestMilliseconds);
+    }
+    if (m_DepthOnlyShader) ImGui::Checkbox("Depth pre-pass", &m_UseDepthPrepass);
+    if (m_DepthBatchShader) ImGui::Checkbox("Draw batches", &m_UseDrawBatches);
+    if (m_DynamicResolution) {
+        ImGui::Checkbox("Dynamic resolution", &m_UseDynamicResolution);
+        if (m_UseDynamicResolution) {
+            if (m_UpscaleShader) {
+                ImGui::SameLine();
+                ImGui::Checkbox("Sharpen", &m_SharpenUpscale);
+            }
+            ImGui::SliderFloat("GPU budget", &m_GpuBudgetMilliseconds, 2.0f, 50.0f, "%.1f ms");
+            ImGui::DragFloatRange2("Scale range", &m_MinResolutionScale, &m_MaxResolutionScale, 0.01f, 0.25f, 2.0f, "min %.2f", "max %.2f");
+            ImGui::Text("Resolution: %dx%d (scale %.2f), %.2f ms GPU, %.0f%% headroom", render.SceneWidth, render.SceneHeight,
+                        render.ResolutionScale, render.ScaledMilliseconds, render.ResolutionHeadroom * 100.0f);
+        }
+    }
+    if (m_ShadowMaps) {
+        ImGui::Checkbox("Shadows", &m_UseShadows);
+        if (m_UseShadows) {
+            ImGui::SameLine();
+            ImGui::Checkbox("Cache static cascades", &m_UseShadowCache);
+            ImGui::SliderFloat("Sun azimuth", &m_SunAzimuth, -180.0f, 180.0f, "%.0f deg");
+            ImGui::SliderFloat("Sun elevation", &m_SunElevation, 5.0f, 90.0f, "%.0f deg");
+            const ShadowFrameStats& shadows = m_ShadowStats;
+            ImGui::Text("Shadows: %u caster draws (%u without caching), %u cascade(s) cached, %u refreshed",
+                        shadows.Draws, shadows.UncachedDraws, shadows.CachedCascades, shadows.StaticRefreshes);
+        }
+    }
+    if (m_ClusteredLighting) {
+        if (ImGui::SliderInt("Lights", &m_LightCountSetting, 0, MAX_LIGHTS)) SetLightCount(m_LightCountSetting);
+        const LightGrid::Stats& lights = m_LightGrid.GetLastStats();
+        ImGui::Text("Clusters: %u / %u lights in view, %u assignments, max %u per cluster, %u / %u used, bin %.3f ms",
+                    lights.VisibleLights, lights.Lights, lights.Assignments, lights.MaxPerCluster, lights.OccupiedClusters,
+                    m_LightGrid.GetClusterCount(), lights.Milliseconds);
+    }
+    const ShaderVariants::Stats& variants = render.LitVariants;
+    ImGui::Text("Lit shader: %u variant(s), %u program(s), %u stage compile(s), %u reused, %.1f ms compiling",
+                variants.Variants, variants.Programs, variants.StageCompiles, variants.StageReuses, variants.CompileMilliseconds);
+    if (m_Materials) {
+        const MaterialLibrary::Stats& materials = m_Materials->GetStats();
+        ImGui::Text("Materials: %u in %u texture array(s), %u whole-texture layer(s), %u atlas page(s)",
+                    materials.Materials, materials.Arrays, materials.ArrayLayers, materials.AtlasPages);
+    }
+    const RenderGraph::Stats& graph = render.Graph;
+    const RenderGraphExecutor::Stats& pool = render.GraphPool;
+    ImGui::Text("Render graph: %u pass(es), %u culled, %u transient(s) in %u texture(s), %u discard(s), %u invalidated",
+                graph.Passes, graph.CulledPasses, graph.Transients, graph.PhysicalTextures, graph.Discards, pool.Invalidated);
+    ImGui::Text("  transient memory: %.1f MB aliased (%.1f MB unaliased, %.1f MB peak live), pool %u texture(s) %.1f MB, %u framebuffer(s)",
+                graph.PhysicalBytes / (1024.0 * 1024.0), graph.TransientBytes / (1024.0 * 1024.0), graph.PeakLiveBytes / (1024.0 * 1024.0),
+                pool.Textures, pool.Bytes / (1024.0 * 1024.0), pool.Framebuffers);
+    if (m_DeformingMesh) {
+        const Mesh::DynamicStats& dynamic = render.DeformingMesh;
+        ImGui::Text("Deforming mesh: %llu commit(s), %.1f MB uploaded, %llu synchronized upload(s)", static_cast<unsigned long long>(dynamic.Commits),
+                    dynamic.UploadedBytes / (1024.0 * 1024.0), static_cast<unsigned long long>(dynamic.SynchronizedUploads));
+    }
+    if (m_OcclusionQueries) {
+        ImGui::Checkbox("GPU occlusion queries", &m_UseOcclusionQueries);
+        if (m_UseOcclusionQueries) {
+            const OcclusionQueries::Stats& queries = render.Queries;
+            ImGui::Text("GPU queries: %u issued, %u conditional / %u unconditional draws", queries.Issued, queries.Conditional, queries.Unconditional);
+            ImGui::Text("  results: %u hit / %u miss, latency avg %.2f max %u frame(s), %u late",
+                        queries.Hits, queries.Misses, queries.AverageLatencyFrames, queries.MaxLatencyFrames, queries.Late);
+        }
+    }
+    const TransformSystem::Stats& transforms = m_Transforms.GetLastStats();
+    ImGui::Text("ECS: %zu entities, %zu archetypes, %zu systems in %zu phase(s)", m_World.GetEntityCount(), m_World.GetArchetypeCount(),
+                m_Systems.GetSystemCount(), m_Systems.GetPhases().size());
+    for (size_t i = 0; i < m_Systems.GetSystemCount(); ++i) {
+        ImGui::Text("  %s: %.3f ms", m_Systems.GetSystem(i).Name, m_Systems.GetSystemMilliseconds(i));
+    }
+    if (ImGui::SliderInt("Simulation rate", &m_SimulationRateSetting, 10, 240, "%d Hz")) m_Timestep.Configure(m_SimulationRateSetting, m_Timestep.GetMaxSteps());
+    const FixedTimestep::Stats& timestep = m_Timestep.GetStats();
+    ImGui::Text("Simulation: %u step(s) this frame, %.3f ms per step, alpha %.2f, %llu catch-up frame(s), %llu step(s) dropped",
+                timestep.Steps, m_SimulationStepMilliseconds, m_InterpolationAlpha, (unsigned long long)timestep.CatchUpFrames,
+                (unsigned long long)timestep.DroppedSteps);
+    for (size_t i = 0; i < m_Simulation.GetSystemCount(); ++i) {
+        ImGui::Text("  %s: %.3f ms", m_Simulation.GetSystem(i).Name, m_Simulation.GetSystemMilliseconds(i));
+    }
+    const CommandQueue::Stats& commands = m_CommandStats;
+    ImGui::Text("Commands: %u packets from %u list(s), record %.3f ms, sort %.3f ms", commands.Packets, commands.ListsUsed,
+                commands.RecordMilliseconds, commands.SortMilliseconds);
+    ImGui::Text("Transforms: %u recomputed / %u skipped (%u levels, %.3f ms)", transforms.Recomputed, transforms.Skipped, transforms.Levels, transforms.Milliseconds);
+    if (m_PickedObject >= 0) ImGui::Text("Picked: object %d", m_PickedObject);
+    if (render.DrawBatches > 0) ImGui::Text("Draw batches: %u multi-draws for %u draws", render.DrawBatches, render.BatchedDraws);
+    if (render.HasStream) {
+        ImGui::Text("Stream: %s, %.1f / %.0f KB used, CPU waited %llu frame(s)", render.StreamPersistent ? "persistent" : "mapped",
+                    render.StreamBytesUsed / 1024.0, render.StreamBytesPerFrame / 1024.0, (unsigned long long)render.StreamWaitedFrames);
+    }
+    if (m_GpuProfiler) ImGui::Checkbox("GPU profiler", &m_ShowGpuProfiler);
+#ifdef ENGINE_ENABLE_PROFILER
+    ImGui::Checkbox("CPU profiler", &m_ShowProfiler);
+#endif
+    ImGui::End();
+}
+
+// GPU time per pass next to the GL thread's CPU time for the same scopes, plus a timeline of the last resolved frame.
+void Application::RenderGpuProfilerPanel() {
+    std::vector<GpuProfiler::ScopeStats> scopes;
+    GpuProfiler::FrameStats frame;
+    m_GpuProfiler->GetStats(scopes, frame);
+
+    ImGui::SetNextWindowPos(ImVec2(10.0f, 340.0f), ImGuiCond_FirstUseEver);
+    ImGui::Begin("GPU Profiler", &m_ShowGpuProfiler, ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::Text("Frame: GPU %.3f ms, GL thread CPU %.3f ms", frame.GpuMilliseconds, frame.CpuMilliseconds);
+    ImGui::Text("Read back %u frame(s) later, %llu resolved, %llu dropped", frame.LatencyFrames,
+                (unsigned long long)frame.Resolved, (unsigned long long)frame.Dropped);
+
+    if (ImGui::BeginTable("GpuScopes", 8, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+        const char* headers[] = { "Scope", "GPU ms", "avg", "p50", "p95", "p99", "CPU avg", "CPU p95" };
+        for (const char* header : headers) ImGui::TableSetupColumn(header);
+        ImGui::TableHeadersRow();
+        for (const GpuProfiler::ScopeStats& scope : scopes) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::Text("%*s%s", scope.Depth * 2, "", scope.Name);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", scope.GpuLast);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", scope.GpuAverage);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", scope.GpuP50);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", scope.GpuP95);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", scope.GpuP99);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", scope.CpuAverage);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", scope.CpuP95);
+        }
+        ImGui::EndTable();
+    }
+
+    // Timeline: one CPU and one GPU lane per nesting level, both scaled to the longer of the two
+    int maxDepth = 0;
+    for (const GpuProfiler::ScopeStats& scope : scopes) maxDepth = std::max(maxDepth, scope.Depth);
+    const float labelWidth = 40.0f;
+    const float timelineWidth = 420.0f;
+    const float laneHeight = ImGui::GetTextLineHeight() + 4.0f;
+    const double span = std::max(std::max(frame.GpuMilliseconds, frame.CpuMilliseconds), 0.001);
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    for (int track = 0; track < 2; ++track) {
+        const float trackTop = origin.y + track * (maxDepth + 1) * laneHeight;
+        drawList->AddText(ImVec2(origin.x, trackTop + 2.0f), IM_COL32(255, 255, 255, 255), track == 0 ? "CPU" : "GPU");
+        for (size_t i = 0; i < scopes.size(); ++i) {
+            const GpuProfiler::ScopeStats& scope = scopes[i];
+            const double start = track == 0 ? scope.CpuStart : scope.GpuStart;
+            const double duration = track == 0 ? scope.CpuLast : scope.GpuLast;
+            const float x0 = origin.x + labelWidth + static_cast<float>(start / span) * timelineWidth;
+            const float x1 = x0 + std::max(static_cast<float>(duration / span) * timelineWidth, 1.0f);
+            const float y0 = trackTop + scope.Depth * laneHeight;
+            drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y0 + laneHeight - 1.0f), ImColor::HSV(std::fmod(i * 0.13f, 1.0f), 0.6f, 0.7f));
+            if (ImGui::CalcTextSize(scope.Name).x + 4.0f < x1 - x0) drawList->AddText(ImVec2(x0 + 2.0f, y0 + 2.0f), IM_COL32(255, 255, 255, 255), scope.Name);
+        }
+    }
+    ImGui::Dummy(ImVec2(labelWidth + timelineWidth, 2 * (maxDepth + 1) * laneHeight));
+
+    if (m_GpuProfiler->IsCapturing()) {
+        ImGui::Text("Capturing %d frames to %s...", GPU_TRACE_FRAMES, GPU_TRACE_PATH);
+    } else if (ImGui::Button("Capture Chrome trace")) {
+        m_GpuProfiler->RequestCapture(GPU_TRACE_FRAMES, GPU_TRACE_PATH);
+    }
+    ImGui::End();
+}
+
+#ifdef ENGINE_ENABLE_PROFILER
+// Flame chart of the last complete frame: one block per thread (plus the GPU), one lane per nesting level.
+void Application::RenderProfilerPanel() {
+    if (!m_ProfilerPaused && Profiler::GetFrameRange(1, m_ProfilerFrameBegin, m_ProfilerFrameEnd)) {
+        Profiler::Collect(m_ProfilerFrameBegin, m_ProfilerFrameEnd, m_ProfilerTracks);
+    }
+    const double frameMilliseconds = (m_ProfilerFrameEnd - m_ProfilerFrameBegin) * 1e-6;
+
+    ImGui::SetNextWindowPos(ImVec2(10.0f, 340.0f), ImGuiCond_FirstUseEver);
+    ImGui::Begin("CPU Profiler", &m_ShowProfiler, ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::Text("Frame: %.3f ms, %zu track(s)", frameMilliseconds, m_ProfilerTracks.size());
+    ImGui::SameLine();
+    ImGui::Checkbox("Pause", &m_ProfilerPaused);
+    ImGui::SameLine();
+    if (ImGui::Button("Export Chrome trace")) Profiler::WriteChromeTrace(CPU_TRACE_PATH);
+
+    const float labelWidth = 80.0f;
+    const float timelineWidth = 560.0f;
+    const float laneHeight = ImGui::GetTextLineHeight() + 4.0f;
+    const double span = std::max<double>(static_cast<double>(m_ProfilerFrameEnd - m_ProfilerFrameBegin), 1.0);
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    float height = 0.0f;
+    for (const Profiler::TrackSnapshot& track : m_ProfilerTracks) {
+        const float trackTop = origin.y + height;
+        drawList->AddText(ImVec2(origin.x, trackTop + 2.0f), IM_COL32(255, 255, 255, 255), track.Name.c_str());
+        for (const Profiler::Event& event : track.Events) {
+            // Clip to the frame; scopes that started in the previous frame begin at the left edge
+            const double begin = std::max<double>(static_cast<double>(event.Begin - m_ProfilerFrameBegin), 0.0);
+            const double end = std::min<double>(static_cast<double>(event.End - m_ProfilerFrameBegin), span);
+            const float x0 = origin.x + labelWidth + static_cast<float>(begin / span) * timelineWidth;
+            const float x1 = std::max(origin.x + labelWidth + static_cast<float>(end / span) * timelineWidth, x0 + 1.0f);
+            const float y0 = trackTop + event.Depth * laneHeight;
+            const ImVec2 min(x0, y0), max(x1, y0 + laneHeight - 1.0f);
+            const ImU32 hash = static_cast<ImU32>(reinterpret_cast<uintptr_t>(event.Name) >> 4);
+            drawList->AddRectFilled(min, max, ImColor::HSV((hash % 97) / 97.0f, 0.55f, 0.7f));
+            if (ImGui::CalcTextSize(event.Name).x + 4.0f < x1 - x0) drawList->AddText(ImVec2(x0 + 2.0f, y0 + 2.0f), IM_COL32(255, 255, 255, 255), event.Name);
+            if (ImGui::IsMouseHoveringRect(min, max)) ImGui::SetTooltip("%s (%s): %.3f ms", event.Name, track.Name.c_str(), (event.End - event.Begin) * 1e-6);
+        }
+        height += (track.MaxDepth + 1) * laneHeight + 4.0f;
+    }
+    ImGui::Dummy(ImVec2(labelWidth + timelineWidth, std::max(height, laneHeight)));
+    ImGui::End();
+}
+#endif
+
 void Application::Shutdown() {
     // ... (Shutdown logic with idempotency checks remains the same) ...
      // Check if already shut down partially or fully
     if (!m_IsRunning && !m_Window && !m_Renderer) { return; } // Avoid redundant shutdowns if possible
     std::cout << "INFO::APP::Shutting down..." << std::endl;
+    StopRenderThread(); // GL resources below are destroyed on this thread
 
     // Shutdown ImGui
     if (ImGui::GetCurrentContext() != nullptr) {
@@ -390,10 +1456,37 @@ void Application::Shutdown() {
     CloseAudio();
 
     // Reset resources (safe to reset null pointers)
-    m_LoadedMesh.reset();
-    m_DiffuseTexture.reset();
-    m_LitTexturedShader.reset(); // Renamed from m_SimpleShader
+    m_Systems.Clear();
+    m_Simulation.Clear();
+    m_World.Clear();
+    m_SceneObjects.clear();
+    m_Transforms.Clear();
+    m_FrustumCuller.Clear();
+    m_ObjectWorldBounds.clear();
+    m_SceneBVH.Clear();
+    m_OcclusionCuller.ClearOccluderMeshes();
+    m_DeformingMesh = nullptr;
+    m_Meshes.clear();
+    m_OcclusionQueries.reset(); // Frees its cube range and query objects
+    m_ClusteredLighting.reset();
+    m_ShadowMaps.reset();
+    m_LightEntities.clear();
+    m_Lights.clear();
+    m_GpuProfiler.reset();
+    m_GeometryBuffer.reset(); // After every Mesh that references it
+    m_Materials.reset();
+    m_LitShaders.reset(); // Programs and compiled stages
+    m_DepthOnlyShader.reset();
+    m_DepthBatchShader = nullptr;
+    m_DepthShaders.reset();
+    m_DynamicResolution.reset();
+    m_UpscaleShader.reset();
+    m_GraphExecutor.reset(); // Pooled targets and their framebuffers
+    if (m_FrameCapture) m_FrameCapture->Flush(); // Frames still in flight reach the writer before it stops
+    m_FrameCapture.reset();
+    m_CaptureWriter.reset(); // Writes out its queue, then joins
 
+    m_JobSystem.reset();
     if (m_Renderer) { m_Renderer->Shutdown(); m_Renderer.reset(); }
     if (m_Window) { SDL_DestroyWindow(m_Window); m_Window = nullptr; std::cout << "INFO::APP::Window destroyed." << std::endl; }
     SDL_Quit();
@@ -407,12 +1500,7 @@ void Application::Shutdown() {
 void Application::RestartAudio() {
     if (m_SoundLoaded && m_TestSound && m_MixerInitialized) {
         std::cout << "INFO:APP: Attempting to restart audio." << std::endl;
-        if (m_MusicChannel != -1) { // Check if we have a valid channel playing/paused
-            Mix_HaltChannel(m_MusicChannel); // Stop playback on that channel
-            std::cout << "DEBUG::APP: Halted channel " << m_MusicChannel << std::endl;
-            m_MusicChannel = -1; // Reset our tracker
-        }
-        // Now play it again (PlaySound will find a new channel and update m_MusicChannel)
+        // A Play request halts whatever the source is playing and starts again on a new channel
         PlaySound();
     } else {
          std::cout << "INFO:APP: Audio not loaded or mixer not initialized, cannot restart." << std::endl;
@@ -425,6 +1513,7 @@ void Application::RestartAudio() {
 // ... (Ensure these are using m_MixerInitialized flag correctly) ...
 // src/Application.cpp -> LoadAudio()
 bool Application::LoadAudio() {
+    PROFILE_SCOPE("LoadAudio");
     if (!m_MixerInitialized) {
          if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
              std::cerr << "ERROR::APP::SDL_mixer could not initialize! Error: " << Mix_GetError() << std::endl;
@@ -471,22 +1560,232 @@ bool Application::LoadAudio() {
 }
 // src/Application.cpp -> CloseAudio()
 void Application::CloseAudio() {
+    m_World.DestroyEntity(m_MusicEntity); // Before the chunk it points at is freed
+    m_MusicEntity = NullEntity;
     if (m_SoundLoaded && m_TestSound) { Mix_FreeChunk(m_TestSound); m_TestSound = NULL; std::cout << "INFO::APP::Sound chunk freed." << std::endl; }
     if (m_MixerInitialized) { Mix_Quit(); m_MixerInitialized = false; m_SoundLoaded = false; std::cout << "INFO::APP::SDL_mixer quit." << std::endl; }
-    m_MusicChannel = -1; // <-- ENSURE THIS IS RESET
 }
 // src/Application.cpp -> PlaySound()
 void Application::PlaySound() {
     if (m_SoundLoaded && m_TestSound && m_MixerInitialized) {
-        // Play on first available channel, loops 0 times (play once)
-        m_MusicChannel = Mix_PlayChannel(-1, m_TestSound, 0); // <-- Store channel ID
-        if (m_MusicChannel == -1) { // Check if playback failed
-             std::cerr << "ERROR::APP::Mix_PlayChannel failed: " << Mix_GetError() << std::endl;
-        } else {
-             std::cout << "INFO::APP::Played sound once on channel " << m_MusicChannel << std::endl;
+        // The audio system plays it on the first available channel, once (Loops = 0)
+        if (!m_World.IsAlive(m_MusicEntity)) {
+            AudioSource source;
+            source.Clip = m_TestSound;
+            m_MusicEntity = m_World.CreateEntity(source);
         }
+        RequestMusic(AudioRequest::Play);
     }
     // ... existing error messages for not initialized/loaded ...
     else if (!m_MixerInitialized) { std::cerr << "ERROR::APP::Cannot play sound, mixer not initialized." << std::endl;}
     else if (!m_SoundLoaded) { std::cerr << "ERROR::APP::Cannot play sound, not loaded." << std::endl;}
-}
\ No newline at end of file
+}
+void Application::RequestMusic(AudioRequest request) {
+    if (AudioSource* music = m_World.GetComponent<AudioSource>(m_MusicEntity)) music->Request = request;
+}
+
+// Light i comes from its own seed, so a given count always yields the same lights in any build order.
+void Application::SetLightCount(int count) {
+    count = std::min(std::max(count, 0), MAX_LIGHTS);
+    m_LightCountSetting = count;
+    while (m_LightEntities.size() > static_cast<size_t>(count)) {
+        m_World.DestroyEntity(m_LightEntities.back());
+        m_LightEntities.pop_back();
+    }
+    while (m_LightEntities.size() < static_cast<size_t>(count)) {
+        std::mt19937 rng(LIGHT_SEED + static_cast<uint32_t>(m_LightEntities.size()));
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        LightOrbit orbit;
+        orbit.Radius = 1.0f + 5.0f * unit(rng);
+        orbit.Height = -1.5f + 3.0f * unit(rng);
+        orbit.Speed = (unit(rng) < 0.5f ? -1.0f : 1.0f) * (0.2f + 0.8f * unit(rng));
+        orbit.Angle = glm::radians(360.0f * unit(rng));
+        orbit.PreviousAngle = orbit.Angle;
+        Light light;
+        light.Range = 1.0f + 2.0f * unit(rng);
+        light.Color = glm::vec3(0.2f + 0.8f * unit(rng), 0.2f + 0.8f * unit(rng), 0.2f + 0.8f * unit(rng));
+        light.Intensity = 0.5f + unit(rng);
+        if (unit(rng) < LIGHT_SPOT_FRACTION) {
+            const float outer = glm::radians(20.0f + 25.0f * unit(rng));
+            light.SpotOuterCos = std::cos(outer);
+            light.SpotInnerCos = std::cos(outer * 0.7f);
+            light.Range *= 2.0f; // Narrow cones reach further
+        }
+        light.Position = orbit.Center + glm::vec3(orbit.Radius * std::cos(orbit.Angle), orbit.Height, orbit.Radius * std::sin(orbit.Angle));
+        light.Direction = glm::normalize(orbit.Center - light.Position);
+        m_LightEntities.push_back(m_World.CreateEntity(light, orbit));
+    }
+}
+
+// A ground plane to receive shadows and a ring of static props around the origin. Everything here
+// is marked static, so the far shadow cascades can keep it in their cache.
+bool Application::CreateStaticScene(const MeshRenderer& prop) {
+    const float half = GROUND_SIZE * 0.5f;
+    const float tiling = GROUND_SIZE * 0.25f;
+    const std::vector<Vertex> groundVertices = {
+        { { -half, 0.0f, -half }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f } },
+        { {  half, 0.0f, -half }, { 0.0f, 1.0f, 0.0f }, { tiling, 0.0f } },
+        { {  half, 0.0f,  half }, { 0.0f, 1.0f, 0.0f }, { tiling, tiling } },
+        { { -half, 0.0f,  half }, { 0.0f, 1.0f, 0.0f }, { 0.0f, tiling } },
+    };
+    const std::vector<unsigned int> groundIndices = { 0, 2, 1, 0, 3, 2 };
+    std::unique_ptr<Mesh> ground = std::make_unique<Mesh>(*m_GeometryBuffer, groundVertices, groundIndices);
+    const Material* groundMaterial = m_Materials->AddSolidColor("ground", 180, 180, 180);
+    if (!ground->IsValid()) {
+        std::cerr << "ERROR::APP::Failed to create the ground plane." << std::endl;
+        return false;
+    }
+
+    MeshRenderer groundRenderer;
+    groundRenderer.MeshRef = ground.get();
+    groundRenderer.MaterialRef = groundMaterial;
+    groundRenderer.Static = true;
+    TransformHandle groundNode = m_Transforms.Create();
+    m_Transforms.SetLocalPosition(groundNode, glm::vec3(0.0f, GROUND_HEIGHT, 0.0f));
+    m_World.CreateEntity(TransformComponent{ groundNode }, groundRenderer);
+    m_Meshes.push_back(std::move(ground));
+
+    MeshRenderer propRenderer = prop;
+    propRenderer.OcclusionQuery = -1; // Queries stay on the one animated object
+    propRenderer.Static = true;
+    for (int i = 0; i < STATIC_PROP_COUNT; ++i) {
+        const float angle = glm::radians(360.0f * i / STATIC_PROP_COUNT);
+        TransformHandle node = m_Transforms.Create();
+        m_Transforms.SetLocalPosition(node, glm::vec3(STATIC_PROP_RADIUS * std::cos(angle), GROUND_HEIGHT + 1.0f, STATIC_PROP_RADIUS * std::sin(angle)));
+        m_World.CreateEntity(TransformComponent{ node }, propRenderer);
+    }
+    m_StaticVersion++;
+    std::cout << "INFO::APP::Static scene: ground plane and " << STATIC_PROP_COUNT << " props." << std::endl;
+    return true;
+}
+
+// A flat grid under the model whose surface ripples outwards from its center. It is a dynamic mesh:
+// the GL thread rewrites its vertices and commits them every frame, while its fixed bounds keep
+// culling on the main thread away from the commits.
+bool Application::CreateDeformingMesh() {
+    const unsigned int side = DEFORMING_GRID + 1;
+    std::vector<unsigned int> indices;
+    indices.reserve(DEFORMING_GRID * DEFORMING_GRID * 6);
+    for (unsigned int z = 0; z < DEFORMING_GRID; ++z) {
+        for (unsigned int x = 0; x < DEFORMING_GRID; ++x) {
+            const unsigned int corner = z * side + x;
+            indices.insert(indices.end(), { corner, corner + side, corner + 1, corner + 1, corner + side, corner + side + 1 });
+        }
+    }
+    DeformSheet(0.0);
+    std::unique_ptr<Mesh> sheet = std::make_unique<Mesh>(*m_GeometryBuffer, static_cast<GLuint>(m_DeformingVertices.size()),
+                                                         static_cast<GLuint>(indices.size()), m_DeformingVertices, indices);
+    if (!sheet->IsValid()) {
+        std::cerr << "ERROR::APP::Failed to create the deforming mesh." << std::endl;
+        return false;
+    }
+    const float half = DEFORMING_SIZE * 0.5f;
+    AABB bounds;
+    bounds.Min = glm::vec3(-half, -DEFORMING_AMPLITUDE, -half);
+    bounds.Max = glm::vec3(half, DEFORMING_AMPLITUDE, half);
+    sheet->SetFixedBounds(bounds);
+
+    MeshRenderer renderer;
+    renderer.MeshRef = sheet.get();
+    renderer.MaterialRef = m_Materials->AddSolidColor("deforming", 90, 140, 200);
+    TransformHandle node = m_Transforms.Create();
+    m_Transforms.SetLocalPosition(node, glm::vec3(0.0f, DEFORMING_HEIGHT, 0.0f));
+    m_World.CreateEntity(TransformComponent{ node }, renderer);
+    m_DeformingMesh = sheet.get();
+    m_Meshes.push_back(std::move(sheet));
+    std::cout << "INFO::APP::Deforming mesh: " << m_DeformingVertices.size() << " vertices rewritten every frame." << std::endl;
+    return true;
+}
+
+void Application::DeformSheet(double time) {
+    const int side = DEFORMING_GRID + 1;
+    const float half = DEFORMING_SIZE * 0.5f;
+    const float fullTurn = glm::radians(360.0f);
+    const float waveNumber = fullTurn / DEFORMING_WAVELENGTH;
+    const float phase = static_cast<float>(std::fmod(time * DEFORMING_SPEED, static_cast<double>(fullTurn))); // Stays precise in long runs
+    m_DeformingVertices.resize(static_cast<size_t>(side) * side);
+    for (int z = 0; z < side; ++z) {
+        for (int x = 0; x < side; ++x) {
+            const float u = static_cast<float>(x) / DEFORMING_GRID;
+            const float v = static_cast<float>(z) / DEFORMING_GRID;
+            const float px = -half + u * DEFORMING_SIZE;
+            const float pz = -half + v * DEFORMING_SIZE;
+            const float radius = std::sqrt(px * px + pz * pz);
+            const float height = DEFORMING_AMPLITUDE * std::sin(waveNumber * radius - phase);
+            // Normal from the height's gradient, which points away from the center
+            const float slope = DEFORMING_AMPLITUDE * waveNumber * std::cos(waveNumber * radius - phase);
+            const float dx = radius > 0.0f ? slope * px / radius : 0.0f;
+            const float dz = radius > 0.0f ? slope * pz / radius : 0.0f;
+            const glm::vec3 normal = glm::normalize(glm::vec3(-dx, 1.0f, -dz));
+            Vertex& vertex = m_DeformingVertices[static_cast<size_t>(z) * side + x];
+            vertex = Vertex{ { px, height, pz }, { normal.x, normal.y, normal.z }, { u, v } };
+        }
+    }
+}
+
+void Application::UpdateDeformingMesh(double time) {
+    PROFILE_SCOPE("Deforming mesh");
+    DeformSheet(time);
+    m_DeformingMesh->UpdateVertices(0, m_DeformingVertices.data(), static_cast<GLuint>(m_DeformingVertices.size()));
+    m_DeformingMesh->Commit();
+}
+
+glm::vec3 Application::GetSunDirection() const {
+    const float azimuth = glm::radians(m_SunAzimuth);
+    const float elevation = glm::radians(m_SunElevation);
+    return glm::vec3(std::cos(elevation) * std::cos(azimuth), -std::sin(elevation), std::cos(elevation) * std::sin(azimuth));
+}
+
+void Application::BuildShadowDraws(FrameSnapshot& frame) {
+    ShadowFrame& shadows = frame.Shadows;
+    shadows.CascadeCount = 0;
+    shadows.Stats = ShadowFrameStats{};
+    if (m_UseShadows && m_ShadowMaps) {
+        PROFILE_SCOPE("Shadow casters");
+        m_ShadowCascades.Update(frame.View, frame.Projection, frame.SunDirection, m_StaticVersion, m_UseShadowCache);
+        shadows.CascadeCount = m_ShadowCascades.GetCascadeCount();
+        for (int i = 0; i < shadows.CascadeCount; ++i) {
+            const ShadowCascades::Cascade& cascade = m_ShadowCascades.GetCascade(i);
+            ShadowCascadeDraws& draws = shadows.Cascades[i];
+            draws.ViewProjection = cascade.ViewProjection;
+            draws.Cached = cascade.Cached;
+            draws.StoreStatic = cascade.Cached && cascade.StaticDirty;
+            draws.Static.clear();
+            draws.Casters.clear();
+            shadows.Splits[i] = cascade.SplitFar;
+            shadows.TexelSizes[i] = cascade.TexelSize;
+
+            // The cascade's box reaches back towards the sun, so off-screen casters are kept
+            m_FrustumCuller.Cull(Frustum::FromMatrix(cascade.ViewProjection), m_ShadowCasters, m_JobSystem.get());
+            for (uint32_t index : m_ShadowCasters) {
+                const SceneObject& object = m_SceneObjects[index];
+                ShadowDraw draw;
+                draw.MeshRef = object.MeshRef;
+                draw.MVP = cascade.ViewProjection * object.Model;
+                if (!draws.Cached || !object.Static) draws.Casters.push_back(draw);
+                else if (draws.StoreStatic) draws.Static.push_back(draw);
+            }
+            shadows.Stats.Draws += static_cast<uint32_t>(draws.Static.size() + draws.Casters.size());
+            shadows.Stats.UncachedDraws += static_cast<uint32_t>(m_ShadowCasters.size());
+            if (draws.Cached) (draws.StoreStatic ? shadows.Stats.StaticRefreshes : shadows.Stats.CachedCascades)++;
+        }
+    }
+    m_ShadowStats = shadows.Stats;
+}
+
+// Cached cascades start from their static cache (or refresh it first); every cascade then gets its dynamic casters.
+void Application::RenderShadowPass(const FrameSnapshot& frame) {
+    if (!m_ShadowMaps || !m_DepthOnlyShader || frame.Shadows.CascadeCount == 0) return;
+    m_ShadowMaps->BeginPass();
+    for (int i = 0; i < frame.Shadows.CascadeCount; ++i) {
+        const ShadowCascadeDraws& cascade = frame.Shadows.Cascades[i];
+        if (cascade.Cached && !cascade.StoreStatic) m_ShadowMaps->RestoreLayer(i);
+        else m_ShadowMaps->BeginLayer(i);
+        if (cascade.StoreStatic) {
+            for (const ShadowDraw& draw : cascade.Static) m_Renderer->SubmitDepthDraw(*m_DepthOnlyShader, *draw.MeshRef, draw.MVP);
+            m_ShadowMaps->StoreLayer(i);
+        }
+        for (const ShadowDraw& draw : cascade.Casters) m_Renderer->SubmitDepthDraw(*m_DepthOnlyShader, *draw.MeshRef, draw.MVP);
+    }
+    m_ShadowMaps->EndPass();
+}
@@ -0,0 +1,358 @@
+// src/BVH.cpp
+
+#include "BVH.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    const int SAH_BIN_COUNT = 12;
+    const uint32_t MAX_LEAF_SIZE = 8;   // Leaves never hold more than this...
+    const uint32_t MIN_SPLIT_SIZE = 3;  // ...and ranges smaller than this are never split
+    const float TRAVERSAL_COST = 1.0f;  // Relative to one box test
+
+    inline void SetBounds(BVHNode& node, const AABB& box) {
+        node.BoundsMin[0] = box.Min.x; node.BoundsMin[1] = box.Min.y; node.BoundsMin[2] = box.Min.z;
+        node.BoundsMax[0] = box.Max.x; node.BoundsMax[1] = box.Max.y; node.BoundsMax[2] = box.Max.z;
+    }
+
+    inline AABB GetBounds(const BVHNode& node) {
+        AABB box;
+        box.Min = glm::vec3(node.BoundsMin[0], node.BoundsMin[1], node.BoundsMin[2]);
+        box.Max = glm::vec3(node.BoundsMax[0], node.BoundsMax[1], node.BoundsMax[2]);
+        return box;
+    }
+
+    // -1 = outside, 0 = intersecting, 1 = inside (for the planes still in 'planeMask')
+    inline int ClassifyBox(const Frustum& frustum, const AABB& box, unsigned int& planeMask) {
+        glm::vec3 center = box.GetCenter();
+        glm::vec3 extents = box.GetExtents();
+        for (int p = 0; p < 6; ++p) {
+            if (!(planeMask & (1u << p))) continue;
+            const glm::vec4& plane = frustum.Planes[p];
+            glm::vec3 normal(plane);
+            float dist = glm::dot(normal, center) + plane.w;
+            float radius = glm::dot(extents, glm::abs(normal));
+            if (dist < -radius) return -1;
+            if (dist > radius) planeMask &= ~(1u << p); // Fully in front; children needn't test it again
+        }
+        return planeMask == 0 ? 1 : 0;
+    }
+
+    inline bool SphereOverlapsBox(const glm::vec3& center, float radiusSq, const AABB& box) {
+        glm::vec3 closest = glm::clamp(center, box.Min, box.Max);
+        glm::vec3 d = closest - center;
+        return glm::dot(d, d) <= radiusSq;
+    }
+
+    // Slab test; returns entry distance or a negative value on miss
+    inline float IntersectRay(const glm::vec3& origin, const glm::vec3& invDir, float maxDistance, const AABB& box) {
+        glm::vec3 t0 = (box.Min - origin) * invDir;
+        glm::vec3 t1 = (box.Max - origin) * invDir;
+        glm::vec3 tMin = glm::min(t0, t1);
+        glm::vec3 tMax = glm::max(t0, t1);
+        float enter = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+        float exit = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxDistance));
+        return enter <= exit ? enter : -1.0f;
+    }
+}
+
+BVH::BVH() {}
+
+BVH::~BVH() {
+    if (m_PendingRebuild.valid()) m_PendingRebuild.wait();
+}
+
+// --- Build ---
+
+BVH::Tree BVH::BuildTree(const std::vector<AABB>& objectBounds) {
+    auto start = std::chrono::steady_clock::now();
+    Tree tree;
+    const uint32_t count = static_cast<uint32_t>(objectBounds.size());
+    if (count == 0) return tree;
+
+    std::vector<glm::vec3> centroids(count);
+    tree.PrimitiveIndices.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        centroids[i] = objectBounds[i].GetCenter();
+        tree.PrimitiveIndices[i] = i;
+    }
+
+    std::vector<BVHNode>& nodes = tree.Nodes;
+    nodes.reserve(static_cast<size_t>(count) * 2);
+    nodes.push_back(BVHNode{});
+    nodes[0].LeftFirst = 0;
+    nodes[0].Count = count;
+
+    // Nodes on the stack hold their primitive range in LeftFirst/Count until they are split
+    struct StackEntry { uint32_t Node; uint32_t Depth; };
+    std::vector<StackEntry> stack;
+    stack.push_back({ 0, 1 });
+
+    struct Bin { AABB Bounds; uint32_t Count = 0; };
+    Bin bins[SAH_BIN_COUNT];
+    float rightCosts[SAH_BIN_COUNT];
+
+    while (!stack.empty()) {
+        StackEntry entry = stack.back();
+        stack.pop_back();
+        tree.TreeStats.MaxDepth = std::max(tree.TreeStats.MaxDepth, entry.Depth);
+
+        const uint32_t first = nodes[entry.Node].LeftFirst;
+        const uint32_t primCount = nodes[entry.Node].Count;
+
+        AABB nodeBounds, centroidBounds;
+        for (uint32_t i = first; i < first + primCount; ++i) {
+            uint32_t object = tree.PrimitiveIndices[i];
+            nodeBounds.Expand(objectBounds[object]);
+            centroidBounds.Expand(centroids[object]);
+        }
+        SetBounds(nodes[entry.Node], nodeBounds);
+        if (primCount < MIN_SPLIT_SIZE) continue; // Stays a leaf
+
+        // --- Binned SAH over all three axes ---
+        int bestAxis = -1, bestSplit = 0;
+        float bestCost = 1e30f;
+        glm::vec3 centroidExtent = centroidBounds.Max - centroidBounds.Min;
+        for (int axis = 0; axis < 3; ++axis) {
+            if (centroidExtent[axis] <= 1e-6f) continue;
+            const float scale = SAH_BIN_COUNT / centroidExtent[axis];
+            for (Bin& bin : bins) bin = Bin{};
+            for (uint32_t i = first; i < first + primCount; ++i) {
+                uint32_t object = tree.PrimitiveIndices[i];
+                int b = std::min(SAH_BIN_COUNT - 1, static_cast<int>((centroids[object][axis] - centroidBounds.Min[axis]) * scale));
+                bins[b].Count++;
+                bins[b].Bounds.Expand(objectBounds[object]);
+            }
+            // Right-to-left sweep stores the cost of everything right of each split plane
+            AABB rightBox; uint32_t rightCount = 0;
+            for (int b = SAH_BIN_COUNT - 1; b > 0; --b) {
+                rightBox.Expand(bins[b].Bounds);
+                rightCount += bins[b].Count;
+                rightCosts[b] = rightCount ? rightBox.GetSurfaceArea() * rightCount : 0.0f;
+            }
+            AABB leftBox; uint32_t leftCount = 0;
+            for (int b = 0; b < SAH_BIN_COUNT - 1; ++b) {
+                leftBox.Expand(bins[b].Bounds);
+                leftCount += bins[b].Count;
+                if (leftCount == 0 || leftCount == primCount) continue;
+                float cost = leftBox.GetSurfaceArea() * leftCount + rightCosts[b + 1];
+                if (cost < bestCost) { bestCost = cost; bestAxis = axis; bestSplit = b + 1; }
+            }
+        }
+
+        const float leafCost = nodeBounds.GetSurfaceArea() * primCount;
+        const float splitCost = TRAVERSAL_COST * nodeBounds.GetSurfaceArea() + bestCost;
+        uint32_t mid = first;
+        if (bestAxis >= 0 && (splitCost < leafCost || primCount > MAX_LEAF_SIZE)) {
+            const float scale = SAH_BIN_COUNT / centroidExtent[bestAxis];
+            const float minCentroid = centroidBounds.Min[bestAxis];
+            auto it = std::partition(tree.PrimitiveIndices.begin() + first, tree.PrimitiveIndices.begin() + first + primCount,
+                [&](uint32_t object) {
+                    int b = std::min(SAH_BIN_COUNT - 1, static_cast<int>((centroids[object][bestAxis] - minCentroid) * scale));
+                    return b < bestSplit;
+                });
+            mid = static_cast<uint32_t>(it - tree.PrimitiveIndices.begin());
+        } else if (primCount > MAX_LEAF_SIZE) {
+            mid = first + primCount / 2; // Coincident centroids: split by count
+        } else {
+            continue; // Cheaper as a leaf
+        }
+
+        uint32_t left = static_cast<uint32_t>(nodes.size());
+        nodes.push_back(BVHNode{});
+        nodes.push_back(BVHNode{});
+        nodes[left].LeftFirst = first;    nodes[left].Count = mid - first;
+        nodes[left + 1].LeftFirst = mid;  nodes[left + 1].Count = first + primCount - mid;
+        nodes[entry.Node].LeftFirst = left;
+        nodes[entry.Node].Count = 0;
+        stack.push_back({ left + 1, entry.Depth + 1 });
+        stack.push_back({ left, entry.Depth + 1 });
+    }
+
+    tree.TreeStats.NodeCount = static_cast<uint32_t>(nodes.size());
+    for (const BVHNode& node : nodes) if (node.IsLeaf()) tree.TreeStats.LeafCount++;
+    tree.TreeStats.BuildCost = ComputeCost(nodes);
+    tree.TreeStats.CurrentCost = tree.TreeStats.BuildCost;
+    tree.TreeStats.BuildMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return tree;
+}
+
+float BVH::ComputeCost(const std::vector<BVHNode>& nodes) {
+    if (nodes.empty()) return 0.0f;
+    float rootArea = GetBounds(nodes[0]).GetSurfaceArea();
+    if (rootArea <= 0.0f) return 0.0f;
+    float cost = 0.0f;
+    for (const BVHNode& node : nodes) {
+        float area = GetBounds(node).GetSurfaceArea();
+        cost += node.IsLeaf() ? area * node.Count : TRAVERSAL_COST * area;
+    }
+    return cost / rootArea;
+}
+
+void BVH::Adopt(Tree&& tree) {
+    m_Nodes = std::move(tree.Nodes);
+    m_PrimitiveIndices = std::move(tree.PrimitiveIndices);
+    m_ObjectCount = m_PrimitiveIndices.size();
+    m_Stats = tree.TreeStats;
+}
+
+void BVH::Build(const std::vector<AABB>& objectBounds) {
+    Adopt(BuildTree(objectBounds));
+    m_ObjectBounds = objectBounds;
+}
+
+void BVH::Refit(const std::vector<AABB>& objectBounds) {
+    if (objectBounds.size() != m_ObjectCount) {
+        std::cerr << "WARN::BVH::Refit with " << objectBounds.size() << " objects (built with " << m_ObjectCount << "), rebuilding." << std::endl;
+        Build(objectBounds);
+        return;
+    }
+    m_ObjectBounds = objectBounds;
+    for (size_t i = m_Nodes.size(); i-- > 0;) {
+        BVHNode& node = m_Nodes[i];
+        AABB box;
+        if (node.IsLeaf()) {
+            for (uint32_t p = node.LeftFirst; p < node.LeftFirst + node.Count; ++p) box.Expand(objectBounds[m_PrimitiveIndices[p]]);
+        } else {
+            box = GetBounds(m_Nodes[node.LeftFirst]);
+            box.Expand(GetBounds(m_Nodes[node.LeftFirst + 1]));
+        }
+        SetBounds(node, box);
+    }
+    m_Stats.CurrentCost = ComputeCost(m_Nodes);
+}
+
+void BVH::Clear() {
+    if (m_PendingRebuild.valid()) m_PendingRebuild.wait();
+    m_PendingRebuild = std::future<Tree>();
+    Adopt(Tree());
+    m_ObjectBounds.clear();
+}
+
+void BVH::BeginRebuildAsync(const std::vector<AABB>& objectBounds) {
+    if (m_PendingRebuild.valid()) return; // One at a time
+    m_PendingRebuild = std::async(std::launch::async, [bounds = objectBounds]() { return BuildTree(bounds); });
+}
+
+bool BVH::PollRebuild(const std::vector<AABB>& currentBounds) {
+    if (!m_PendingRebuild.valid()) return false;
+    if (m_PendingRebuild.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return false;
+    Tree tree = m_PendingRebuild.get();
+    if (tree.PrimitiveIndices.size() != currentBounds.size()) return false; // Object set changed meanwhile; stale
+    Adopt(std::move(tree));
+    // Objects kept moving while the build ran
+    Refit(currentBounds);
+    m_Stats.BuildCost = m_Stats.CurrentCost;
+    return true;
+}
+
+float BVH::GetDegradation() const {
+    return m_Stats.BuildCost > 0.0f ? m_Stats.CurrentCost / m_Stats.BuildCost : 1.0f;
+}
+
+// --- Queries ---
+
+void BVH::QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& outObjects) const {
+    if (m_Nodes.empty()) return;
+    struct StackEntry { uint32_t Node; unsigned int PlaneMask; };
+    std::vector<StackEntry> stack;
+    stack.reserve(64);
+    stack.push_back({ 0, 0x3Fu });
+    std::vector<uint32_t> insideStack; // Subtrees fully inside: gather without tests
+
+    while (!stack.empty()) {
+        StackEntry entry = stack.back();
+        stack.pop_back();
+        const BVHNode& node = m_Nodes[entry.Node];
+        unsigned int mask = entry.PlaneMask;
+        int classification = ClassifyBox(frustum, GetBounds(node), mask);
+        if (classification < 0) continue;
+
+        if (classification > 0) {
+            insideStack.push_back(entry.Node);
+            while (!insideStack.empty()) {
+                const BVHNode& inner = m_Nodes[insideStack.back()];
+                insideStack.pop_back();
+                if (inner.IsLeaf()) {
+                    outObjects.insert(outObjects.end(), m_PrimitiveIndices.begin() + inner.LeftFirst,
+                                      m_PrimitiveIndices.begin() + inner.LeftFirst + inner.Count);
+                } else {
+                    insideStack.push_back(inner.LeftFirst);
+                    insideStack.push_back(inner.LeftFirst + 1);
+                }
+            }
+            continue;
+        }
+
+        if (node.IsLeaf()) {
+            for (uint32_t p = node.LeftFirst; p < node.LeftFirst + node.Count; ++p) {
+                uint32_t object = m_PrimitiveIndices[p];
+                unsigned int objectMask = mask;
+                if (ClassifyBox(frustum, m_ObjectBounds[object], objectMask) >= 0) outObjects.push_back(object);
+            }
+        } else {
+            stack.push_back({ node.LeftFirst + 1, mask });
+            stack.push_back({ node.LeftFirst, mask });
+        }
+    }
+}
+
+void BVH::QuerySphere(const glm::vec3& center, float radius, std::vector<uint32_t>& outObjects) const {
+    if (m_Nodes.empty()) return;
+    const float radiusSq = radius * radius;
+    std::vector<uint32_t> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const BVHNode& node = m_Nodes[stack.back()];
+        stack.pop_back();
+        if (!SphereOverlapsBox(center, radiusSq, GetBounds(node))) continue;
+        if (node.IsLeaf()) {
+            for (uint32_t p = node.LeftFirst; p < node.LeftFirst + node.Count; ++p) {
+                uint32_t object = m_PrimitiveIndices[p];
+                if (SphereOverlapsBox(center, radiusSq, m_ObjectBounds[object])) outObjects.push_back(object);
+            }
+        } else {
+            stack.push_back(node.LeftFirst + 1);
+            stack.push_back(node.LeftFirst);
+        }
+    }
+}
+
+RayHit BVH::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const {
+    RayHit hit;
+    if (m_Nodes.empty()) return hit;
+    float length = glm::length(direction);
+    if (length <= 0.0f) return hit;
+    glm::vec3 dir = direction / length;
+    glm::vec3 invDir(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z); // IEEE infinities keep the slab test valid
+
+    float closest = maxDistance;
+    std::vector<uint32_t> stack;
+    stack.reserve(64);
+    if (IntersectRay(origin, invDir, closest, GetBounds(m_Nodes[0])) >= 0.0f) stack.push_back(0);
+
+    while (!stack.empty()) {
+        const BVHNode& node = m_Nodes[stack.back()];
+        stack.pop_back();
+        if (node.IsLeaf()) {
+            for (uint32_t p = node.LeftFirst; p < node.LeftFirst + node.Count; ++p) {
+                uint32_t object = m_PrimitiveIndices[p];
+                float t = IntersectRay(origin, invDir, closest, m_ObjectBounds[object]);
+                if (t >= 0.0f && (t < closest || !hit.IsValid())) { closest = t; hit.ObjectIndex = object; hit.Distance = t; }
+            }
+            continue;
+        }
+        // Visit the nearer child first so 'closest' shrinks early
+        uint32_t a = node.LeftFirst, b = node.LeftFirst + 1;
+        float ta = IntersectRay(origin, invDir, closest, GetBounds(m_Nodes[a]));
+        float tb = IntersectRay(origin, invDir, closest, GetBounds(m_Nodes[b]));
+        if (ta >= 0.0f && tb >= 0.0f && tb < ta) { std::swap(a, b); std::swap(ta, tb); }
+        if (tb >= 0.0f) stack.push_back(b);
+        if (ta >= 0.0f) stack.push_back(a);
+    }
+    return hit;
+}
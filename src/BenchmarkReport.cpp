@@ -0,0 +1,103 @@
+// src/BenchmarkReport.cpp
+
+#include "BenchmarkReport.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    // Nearest-rank percentile of sorted samples
+    double Percentile(const std::vector<double>& sorted, double fraction) {
+        if (sorted.empty()) return 0.0;
+        size_t index = static_cast<size_t>(fraction * double(sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+
+    void WriteJsonString(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') out << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20) out << ' ';
+            else out << c;
+        }
+        out << '"';
+    }
+}
+
+void BenchmarkReport::SetInfo(const std::string& key, const std::string& value) {
+    for (auto& entry : m_Info) {
+        if (entry.first == key) { entry.second = value; return; }
+    }
+    m_Info.emplace_back(key, value);
+}
+
+void BenchmarkReport::AddMetric(const std::string& name, std::vector<double>& samples) {
+    Metric metric;
+    metric.Name = name;
+    metric.Samples = samples.size();
+    if (!samples.empty()) {
+        std::sort(samples.begin(), samples.end());
+        double sum = 0.0;
+        for (double sample : samples) sum += sample;
+        metric.Mean = sum / samples.size();
+        double variance = 0.0;
+        for (double sample : samples) variance += (sample - metric.Mean) * (sample - metric.Mean);
+        metric.StdDev = std::sqrt(variance / samples.size());
+        metric.P50 = Percentile(samples, 0.50);
+        metric.P95 = Percentile(samples, 0.95);
+        metric.P99 = Percentile(samples, 0.99);
+        metric.Max = samples.back();
+    }
+    m_Metrics.push_back(metric);
+}
+
+bool BenchmarkReport::WriteJson(const std::string& filePath) const {
+    std::ofstream file(filePath);
+    if (!file) {
+        std::cerr << "ERROR::BENCHMARK::Could not open " << filePath << std::endl;
+        return false;
+    }
+    file << "{\n  \"info\": {";
+    for (size_t i = 0; i < m_Info.size(); ++i) {
+        file << (i ? ",\n    " : "\n    ");
+        WriteJsonString(file, m_Info[i].first);
+        file << ": ";
+        WriteJsonString(file, m_Info[i].second);
+    }
+    file << "\n  },\n  \"metrics\": {";
+    for (size_t i = 0; i < m_Metrics.size(); ++i) {
+        const Metric& metric = m_Metrics[i];
+        file << (i ? ",\n    " : "\n    ");
+        WriteJsonString(file, metric.Name);
+        file << ": { \"samples\": " << metric.Samples << ", \"mean\": " << metric.Mean << ", \"stddev\": " << metric.StdDev << ", \"p50\": " << metric.P50
+             << ", \"p95\": " << metric.P95 << ", \"p99\": " << metric.P99 << ", \"max\": " << metric.Max << " }";
+    }
+    file << "\n  }\n}\n";
+    return true;
+}
+
+bool BenchmarkReport::WriteCsv(const std::string& filePath) const {
+    std::ofstream file(filePath);
+    if (!file) {
+        std::cerr << "ERROR::BENCHMARK::Could not open " << filePath << std::endl;
+        return false;
+    }
+    file << "metric,samples,mean,stddev,p50,p95,p99,max\n";
+    for (const Metric& metric : m_Metrics) {
+        file << metric.Name << ',' << metric.Samples << ',' << metric.Mean << ',' << metric.StdDev << ',' << metric.P50 << ','
+             << metric.P95 << ',' << metric.P99 << ',' << metric.Max << '\n';
+    }
+    return true;
+}
+
+void BenchmarkReport::Print() const {
+    std::printf("%-16s %8s %9s %9s %9s %9s %9s %9s\n", "metric", "samples", "mean", "stddev", "p50", "p95", "p99", "max");
+    for (const Metric& metric : m_Metrics) {
+        std::printf("%-16s %8zu %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f\n", metric.Name.c_str(), metric.Samples,
+                    metric.Mean, metric.StdDev, metric.P50, metric.P95, metric.P99, metric.Max);
+    }
+    std::fflush(stdout);
+}
@@ -0,0 +1,83 @@
+// src/Bounds.cpp
+
+#include "Bounds.h"
+
+#include <algorithm>
+#include <cmath>
+
+Frustum Frustum::FromMatrix(const glm::mat4& m) {
+    // glm is column-major: m[col][row]. Row i of the matrix is (m[0][i], m[1][i], m[2][i], m[3][i]).
+    glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    Frustum frustum;
+    frustum.Planes[0] = row3 + row0; // Left
+    frustum.Planes[1] = row3 - row0; // Right
+    frustum.Planes[2] = row3 + row1; // Bottom
+    frustum.Planes[3] = row3 - row1; // Top
+    frustum.Planes[4] = row3 + row2; // Near (GL clip space, z in [-w, w])
+    frustum.Planes[5] = row3 - row2; // Far
+
+    // Normalize so plane distances are in world units (needed for sphere tests)
+    for (glm::vec4& plane : frustum.Planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) plane = plane / length;
+    }
+    return frustum;
+}
+
+bool Frustum::IntersectsAABB(const AABB& box) const {
+    glm::vec3 center = box.GetCenter();
+    glm::vec3 extents = box.GetExtents();
+    for (const glm::vec4& plane : Planes) {
+        glm::vec3 normal(plane);
+        float radius = glm::dot(extents, glm::abs(normal));
+        if (glm::dot(normal, center) + plane.w < -radius) return false;
+    }
+    return true;
+}
+
+bool Frustum::IntersectsSphere(const glm::vec3& center, float radius) const {
+    for (const glm::vec4& plane : Planes) {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) return false;
+    }
+    return true;
+}
+
+namespace Bounds {
+
+    void Compute(const std::vector<Vertex>& vertices, AABB& outBox, BoundingSphere& outSphere) {
+        outBox = AABB{};
+        outSphere = BoundingSphere{};
+        if (vertices.empty()) return;
+
+        for (const Vertex& v : vertices) {
+            outBox.Expand(glm::vec3(v.Position[0], v.Position[1], v.Position[2]));
+        }
+        outSphere.Center = outBox.GetCenter();
+        float maxDistanceSq = 0.0f;
+        for (const Vertex& v : vertices) {
+            glm::vec3 d = glm::vec3(v.Position[0], v.Position[1], v.Position[2]) - outSphere.Center;
+            maxDistanceSq = std::max(maxDistanceSq, glm::dot(d, d));
+        }
+        outSphere.Radius = std::sqrt(maxDistanceSq);
+    }
+
+    AABB Transform(const AABB& box, const glm::mat4& matrix) {
+        if (box.IsEmpty()) return box;
+        // Each output axis is the translation plus the sum of the |matrix| * extents contributions
+        glm::vec3 center = glm::vec3(matrix * glm::vec4(box.GetCenter(), 1.0f));
+        glm::vec3 extents = box.GetExtents();
+        glm::vec3 worldExtents(
+            std::fabs(matrix[0][0]) * extents.x + std::fabs(matrix[1][0]) * extents.y + std::fabs(matrix[2][0]) * extents.z,
+            std::fabs(matrix[0][1]) * extents.x + std::fabs(matrix[1][1]) * extents.y + std::fabs(matrix[2][1]) * extents.z,
+            std::fabs(matrix[0][2]) * extents.x + std::fabs(matrix[1][2]) * extents.y + std::fabs(matrix[2][2]) * extents.z);
+        AABB result;
+        result.Min = center - worldExtents;
+        result.Max = center + worldExtents;
+        return result;
+    }
+
+} // namespace Bounds
@@ -0,0 +1,114 @@
+// src/CameraPath.cpp
+
+#include "CameraPath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    glm::vec3 CatmullRom(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& p3, float t) {
+        const float t2 = t * t;
+        const float t3 = t2 * t;
+        return 0.5f * ((2.0f * p1) + (p2 - p0) * t + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 + (3.0f * p1 - p0 - 3.0f * p2 + p3) * t3);
+    }
+}
+
+bool CameraPath::Load(const std::string& filePath) {
+    std::ifstream file(filePath);
+    if (!file) {
+        std::cerr << "ERROR::CAMERAPATH::Could not open " << filePath << std::endl;
+        return false;
+    }
+    m_Keyframes.clear();
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        const size_t comment = line.find('#');
+        if (comment != std::string::npos) line.resize(comment);
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        std::istringstream stream(line);
+        Keyframe keyframe;
+        if (!(stream >> keyframe.Time >> keyframe.Position.x >> keyframe.Position.y >> keyframe.Position.z >> keyframe.Yaw >> keyframe.Pitch)) {
+            std::cerr << "ERROR::CAMERAPATH::" << filePath << ":" << lineNumber << ": expected 'time x y z yaw pitch'." << std::endl;
+            m_Keyframes.clear();
+            return false;
+        }
+        if (!m_Keyframes.empty() && keyframe.Time < m_Keyframes.back().Time) {
+            std::cerr << "ERROR::CAMERAPATH::" << filePath << ":" << lineNumber << ": keyframe times must not decrease." << std::endl;
+            m_Keyframes.clear();
+            return false;
+        }
+        m_Keyframes.push_back(keyframe);
+    }
+    if (m_Keyframes.empty()) {
+        std::cerr << "ERROR::CAMERAPATH::" << filePath << " has no keyframes." << std::endl;
+        return false;
+    }
+    std::cout << "INFO::CAMERAPATH::Loaded " << m_Keyframes.size() << " keyframes (" << GetDuration() << " s) from " << filePath << std::endl;
+    return true;
+}
+
+bool CameraPath::Save(const std::string& filePath) const {
+    std::ofstream file(filePath);
+    if (!file) {
+        std::cerr << "ERROR::CAMERAPATH::Could not write " << filePath << std::endl;
+        return false;
+    }
+    file << "# time x y z yaw pitch\n";
+    for (const Keyframe& keyframe : m_Keyframes) {
+        file << keyframe.Time << ' ' << keyframe.Position.x << ' ' << keyframe.Position.y << ' ' << keyframe.Position.z << ' '
+             << keyframe.Yaw << ' ' << keyframe.Pitch << '\n';
+    }
+    std::cout << "INFO::CAMERAPATH::Saved " << m_Keyframes.size() << " keyframes to " << filePath << std::endl;
+    return true;
+}
+
+void CameraPath::AddKeyframe(const Keyframe& keyframe) {
+    m_Keyframes.push_back(keyframe);
+}
+
+CameraPath::Keyframe CameraPath::Sample(float time) const {
+    if (m_Keyframes.empty()) return Keyframe();
+    if (time <= m_Keyframes.front().Time) return m_Keyframes.front();
+    if (time >= m_Keyframes.back().Time) return m_Keyframes.back();
+
+    // First keyframe after 'time'; the segment runs from the one before it
+    auto next = std::upper_bound(m_Keyframes.begin(), m_Keyframes.end(), time, [](float t, const Keyframe& keyframe) { return t < keyframe.Time; });
+    const size_t i1 = static_cast<size_t>(next - m_Keyframes.begin());
+    const size_t i0 = i1 - 1;
+    const Keyframe& a = m_Keyframes[i0];
+    const Keyframe& b = m_Keyframes[i1];
+    const float span = b.Time - a.Time;
+    const float t = span > 0.0f ? (time - a.Time) / span : 1.0f;
+
+    const glm::vec3& before = m_Keyframes[i0 > 0 ? i0 - 1 : i0].Position;
+    const glm::vec3& after = m_Keyframes[std::min(i1 + 1, m_Keyframes.size() - 1)].Position;
+    Keyframe result;
+    result.Time = time;
+    result.Position = CatmullRom(before, a.Position, b.Position, after, t);
+    result.Yaw = a.Yaw + (b.Yaw - a.Yaw) * t;
+    result.Pitch = a.Pitch + (b.Pitch - a.Pitch) * t;
+    return result;
+}
+
+CameraPath CameraPath::MakeOrbit(const glm::vec3& center, float radius, float height, float duration, int keyframes) {
+    CameraPath path;
+    keyframes = std::max(keyframes, 2);
+    const float pitch = -glm::degrees(std::atan2(height, radius));
+    for (int i = 0; i <= keyframes; ++i) {
+        const float fraction = static_cast<float>(i) / keyframes;
+        const float angle = glm::radians(360.0f * fraction);
+        Keyframe keyframe;
+        keyframe.Time = fraction * duration;
+        keyframe.Position = center + glm::vec3(radius * std::cos(angle), height, radius * std::sin(angle));
+        keyframe.Yaw = glm::degrees(angle) + 180.0f; // Keeps increasing, so interpolation never wraps the wrong way
+        keyframe.Pitch = pitch;
+        path.AddKeyframe(keyframe);
+    }
+    return path;
+}
@@ -0,0 +1,184 @@
+// src/CaptureWriter.cpp
+
+#include "CaptureWriter.h"
+#include "FileUtils.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+namespace {
+    uint8_t ClampByte(float value) {
+        return static_cast<uint8_t>(std::min(std::max(value + 0.5f, 0.0f), 255.0f));
+    }
+}
+
+const char* CaptureWriter::GetFormatName(CaptureFormat format) {
+    switch (format) {
+        case CaptureFormat::PPM: return "ppm";
+        case CaptureFormat::PNG: return "png";
+        case CaptureFormat::Y4M: return "y4m";
+    }
+    return "unknown";
+}
+
+bool CaptureWriter::ParseFormat(const std::string& name, CaptureFormat& out) {
+    for (CaptureFormat format : {CaptureFormat::PPM, CaptureFormat::PNG, CaptureFormat::Y4M}) {
+        if (name == GetFormatName(format)) { out = format; return true; }
+    }
+    return false;
+}
+
+CaptureWriter::CaptureWriter() {}
+
+CaptureWriter::~CaptureWriter() {
+    Stop();
+}
+
+bool CaptureWriter::Start(const std::string& directory, CaptureFormat format, int width, int height, int fps, int fpsDivisor) {
+    Stop();
+    m_Directory = directory;
+    m_Format = format;
+    m_Width = width;
+    m_Height = height;
+    m_Stats = Stats{};
+    if (format == CaptureFormat::Y4M) {
+        const std::string path = (std::filesystem::path(directory) / "capture.y4m").string();
+        m_Video.open(path, std::ios::binary);
+        if (!m_Video) {
+            std::cerr << "ERROR::CAPTURE::Could not open " << path << std::endl;
+            return false;
+        }
+        // C420jpeg: full-range BT.601, chroma at half resolution in both directions
+        m_Video << "YUV4MPEG2 W" << width << " H" << height << " F" << std::max(fps, 1) << ":" << std::max(fpsDivisor, 1)
+                << " Ip A1:1 C420jpeg\n";
+    }
+    m_Stopping = false;
+    m_Thread = std::thread(&CaptureWriter::ThreadMain, this);
+    std::cout << "INFO::CAPTURE::Writing " << width << "x" << height << " " << GetFormatName(format) << " to " << directory << std::endl;
+    return true;
+}
+
+void CaptureWriter::Stop() {
+    if (!m_Thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stopping = true;
+    }
+    m_Ready.notify_all();
+    m_Thread.join();
+    if (m_Video.is_open()) m_Video.close();
+    std::cout << "INFO::CAPTURE::" << m_Stats.Written << " frame(s) written, " << m_Stats.Failed << " failed." << std::endl;
+}
+
+std::vector<uint8_t> CaptureWriter::AcquireBuffer(size_t bytes) {
+    std::vector<uint8_t> buffer;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!m_FreeBuffers.empty()) {
+            buffer = std::move(m_FreeBuffers.back());
+            m_FreeBuffers.pop_back();
+        }
+    }
+    buffer.resize(bytes);
+    return buffer;
+}
+
+void CaptureWriter::Submit(uint64_t frameIndex, std::vector<uint8_t>&& rgba) {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    if (m_Queue.size() >= MaxQueued) {
+        PROFILE_SCOPE("Wait for capture writer");
+        m_Stats.Blocked++;
+        m_Room.wait(lock, [this]() { return m_Queue.size() < MaxQueued; });
+    }
+    Frame frame;
+    frame.Index = frameIndex;
+    frame.Pixels = std::move(rgba);
+    m_Queue.push_back(std::move(frame));
+    m_Stats.Queued = static_cast<uint32_t>(m_Queue.size());
+    lock.unlock();
+    m_Ready.notify_one();
+}
+
+CaptureWriter::Stats CaptureWriter::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Stats;
+}
+
+void CaptureWriter::ThreadMain() {
+    PROFILE_THREAD("Capture writer");
+    for (;;) {
+        Frame frame;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Ready.wait(lock, [this]() { return m_Stopping || !m_Queue.empty(); });
+            if (m_Queue.empty()) return; // Stopping, and everything is written
+            frame = std::move(m_Queue.front());
+            m_Queue.pop_front();
+            m_Stats.Queued = static_cast<uint32_t>(m_Queue.size());
+        }
+        m_Room.notify_one();
+
+        auto start = std::chrono::steady_clock::now();
+        const bool written = Write(frame);
+        const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (written) m_Stats.Written++;
+        else m_Stats.Failed++;
+        m_Stats.EncodeMilliseconds = milliseconds;
+        m_FreeBuffers.push_back(std::move(frame.Pixels));
+    }
+}
+
+bool CaptureWriter::Write(const Frame& frame) {
+    PROFILE_SCOPE("Write capture");
+    if (m_Format == CaptureFormat::Y4M) return WriteY4MFrame(frame.Pixels);
+    char fileName[32];
+    std::snprintf(fileName, sizeof(fileName), "frame_%05llu.%s", (unsigned long long)frame.Index, GetFormatName(m_Format));
+    const std::string path = (std::filesystem::path(m_Directory) / fileName).string();
+    if (m_Format == CaptureFormat::PNG) return FileUtils::WritePNG(path, m_Width, m_Height, frame.Pixels);
+    return FileUtils::WritePPM(path, m_Width, m_Height, frame.Pixels);
+}
+
+// RGBA (bottom row first) to full-range BT.601 Y'CbCr 4:2:0, top row first. Chroma averages each 2x2 block.
+bool CaptureWriter::WriteY4MFrame(const std::vector<uint8_t>& rgba) {
+    const size_t width = static_cast<size_t>(m_Width);
+    const size_t height = static_cast<size_t>(m_Height);
+    const size_t chromaWidth = (width + 1) / 2;
+    const size_t chromaHeight = (height + 1) / 2;
+    if (rgba.size() < width * height * 4) return false;
+    m_Planes.resize(width * height + chromaWidth * chromaHeight * 2);
+    uint8_t* planeY = m_Planes.data();
+    uint8_t* planeU = planeY + width * height;
+    uint8_t* planeV = planeU + chromaWidth * chromaHeight;
+
+    for (size_t y = 0; y < height; ++y) {
+        const uint8_t* source = rgba.data() + (height - 1 - y) * width * 4;
+        for (size_t x = 0; x < width; ++x) {
+            const float r = source[x * 4 + 0], g = source[x * 4 + 1], b = source[x * 4 + 2];
+            planeY[y * width + x] = ClampByte(0.299f * r + 0.587f * g + 0.114f * b);
+        }
+    }
+    for (size_t cy = 0; cy < chromaHeight; ++cy) {
+        for (size_t cx = 0; cx < chromaWidth; ++cx) {
+            float r = 0.0f, g = 0.0f, b = 0.0f, count = 0.0f;
+            for (size_t y = cy * 2; y < std::min(cy * 2 + 2, height); ++y) {
+                const uint8_t* source = rgba.data() + (height - 1 - y) * width * 4;
+                for (size_t x = cx * 2; x < std::min(cx * 2 + 2, width); ++x) {
+                    r += source[x * 4 + 0]; g += source[x * 4 + 1]; b += source[x * 4 + 2];
+                    count += 1.0f;
+                }
+            }
+            r /= count; g /= count; b /= count;
+            planeU[cy * chromaWidth + cx] = ClampByte(128.0f - 0.168736f * r - 0.331264f * g + 0.5f * b);
+            planeV[cy * chromaWidth + cx] = ClampByte(128.0f + 0.5f * r - 0.418688f * g - 0.081312f * b);
+        }
+    }
+    m_Video << "FRAME\n";
+    m_Video.write(reinterpret_cast<const char*>(m_Planes.data()), static_cast<std::streamsize>(m_Planes.size()));
+    return m_Video.good();
+}
@@ -0,0 +1,84 @@
+// src/ClusteredLighting.cpp
+
+#include "ClusteredLighting.h"
+#include "Shader.h"
+
+#include <iostream>
+
+ClusteredLighting::ClusteredLighting() {}
+
+ClusteredLighting::~ClusteredLighting() {
+    Shutdown();
+}
+
+bool ClusteredLighting::Initialize() {
+    if (m_Lights.Buffer != 0) return true;
+    TextureBuffer* targets[] = { &m_Lights, &m_Clusters, &m_Indices };
+    const GLenum formats[] = { GL_RGBA32F, GL_RG32UI, GL_R32UI };
+    for (int i = 0; i < 3; ++i) {
+        glGenBuffers(1, &targets[i]->Buffer);
+        glGenTextures(1, &targets[i]->Texture);
+        // A buffer texture needs a data store; start with one zeroed element
+        const uint32_t zero[4] = { 0, 0, 0, 0 };
+        UploadBuffer(*targets[i], zero, sizeof(zero));
+        glBindTexture(GL_TEXTURE_BUFFER, targets[i]->Texture);
+        glTexBuffer(GL_TEXTURE_BUFFER, formats[i], targets[i]->Buffer);
+    }
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    if (glGetError() != GL_NO_ERROR) {
+        std::cerr << "ERROR::CLUSTERED_LIGHTING::Texture buffer setup failed." << std::endl;
+        Shutdown();
+        return false;
+    }
+    std::cout << "INFO::CLUSTERED_LIGHTING::Initialized." << std::endl;
+    return true;
+}
+
+void ClusteredLighting::Shutdown() {
+    for (TextureBuffer* target : { &m_Lights, &m_Clusters, &m_Indices }) {
+        if (target->Texture != 0) glDeleteTextures(1, &target->Texture);
+        if (target->Buffer != 0) glDeleteBuffers(1, &target->Buffer);
+        *target = TextureBuffer{};
+    }
+    m_LightCount = 0;
+}
+
+void ClusteredLighting::UploadBuffer(const TextureBuffer& target, const void* data, size_t bytes) {
+    glBindBuffer(GL_TEXTURE_BUFFER, target.Buffer);
+    glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(bytes), data, GL_STREAM_DRAW); // Respecifying orphans the old store
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void ClusteredLighting::Upload(const ClusteredLightData& data) {
+    if (m_Lights.Buffer == 0) return;
+    m_LightCount = static_cast<int>(data.GetLightCount());
+    m_Dimensions = data.Dimensions;
+    m_SliceScale = data.SliceScale;
+    m_SliceBias = data.SliceBias;
+    if (m_LightCount == 0) return; // The shader skips the lookup; keep the old contents
+
+    UploadBuffer(m_Lights, data.Lights.data(), data.Lights.size() * sizeof(glm::vec4));
+    UploadBuffer(m_Clusters, data.Clusters.data(), data.Clusters.size() * sizeof(uint32_t));
+    if (!data.Indices.empty()) UploadBuffer(m_Indices, data.Indices.data(), data.Indices.size() * sizeof(uint32_t));
+}
+
+void ClusteredLighting::Bind(const Shader& shader, int viewportWidth, int viewportHeight) const {
+    // Samplers of different types may not share a unit, even unused ones, so these are always set
+    shader.SetInt("uLights", LightsUnit);
+    shader.SetInt("uClusters", ClustersUnit);
+    shader.SetInt("uLightIndices", IndicesUnit);
+    const bool active = m_LightCount > 0 && viewportWidth > 0 && viewportHeight > 0;
+    shader.SetInt("uLightCount", active ? m_LightCount : 0);
+    if (!active) return;
+
+    glActiveTexture(GL_TEXTURE0 + LightsUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, m_Lights.Texture);
+    glActiveTexture(GL_TEXTURE0 + ClustersUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, m_Clusters.Texture);
+    glActiveTexture(GL_TEXTURE0 + IndicesUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, m_Indices.Texture);
+    glActiveTexture(GL_TEXTURE0);
+    shader.SetVec3("uClusterDims", glm::vec3(m_Dimensions));
+    shader.SetVec2("uClusterScale", glm::vec2(float(m_Dimensions.x) / viewportWidth, float(m_Dimensions.y) / viewportHeight));
+    shader.SetVec2("uClusterSlice", glm::vec2(m_SliceScale, m_SliceBias));
+}
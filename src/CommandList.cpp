@@ -0,0 +1,87 @@
+// src/CommandList.cpp
+
+#include "CommandList.h"
+
+#include <algorithm>
+
+// --- CommandList ---
+
+void CommandList::Reset() {
+    m_Packets.clear();
+    m_Uniforms.clear();
+}
+
+void CommandList::Reserve(size_t packets) {
+    m_Packets.reserve(packets);
+    m_Uniforms.reserve(packets);
+}
+
+void CommandList::Draw(uint64_t sortKey, const Mesh* mesh, const Material* material, const DrawUniforms& uniforms, int32_t occlusionQuery) {
+    DrawPacket packet;
+    packet.SortKey = sortKey;
+    packet.MeshRef = mesh;
+    packet.MaterialRef = material;
+    packet.UniformIndex = static_cast<uint32_t>(m_Uniforms.size());
+    packet.OcclusionQuery = occlusionQuery;
+    m_Uniforms.push_back(uniforms);
+    m_Packets.push_back(packet);
+}
+
+// --- CommandQueue ---
+
+void CommandQueue::BeginFrame(unsigned int listCount) {
+    listCount = std::max(listCount, 1u);
+    while (m_Lists.size() < listCount) m_Lists.push_back(std::make_unique<CommandList>());
+    for (std::unique_ptr<CommandList>& list : m_Lists) list->Reset();
+    m_Sorted.clear();
+    m_FrameStart = std::chrono::steady_clock::now();
+}
+
+void CommandQueue::Merge() {
+    auto start = std::chrono::steady_clock::now();
+    m_LastStats = Stats{};
+    m_LastStats.RecordMilliseconds = std::chrono::duration<double, std::milli>(start - m_FrameStart).count();
+    m_Sorted.clear();
+    for (size_t l = 0; l < m_Lists.size(); ++l) {
+        const CommandList& list = *m_Lists[l];
+        if (list.Size() > 0) m_LastStats.ListsUsed++;
+        for (size_t i = 0; i < list.Size(); ++i) {
+            m_Sorted.push_back(SortEntry{ list.GetPacket(i).SortKey, static_cast<uint32_t>(l), static_cast<uint32_t>(i) });
+        }
+    }
+
+    // LSD radix sort, one byte per pass; passes where every key has the same byte are skipped.
+    // Stable, so equal keys keep list order (and recording order within a list).
+    const size_t count = m_Sorted.size();
+    uint32_t histograms[8][256] = {};
+    for (const SortEntry& entry : m_Sorted) {
+        for (int pass = 0; pass < 8; ++pass) histograms[pass][(entry.Key >> (pass * 8)) & 0xFF]++;
+    }
+    m_SortScratch.resize(count);
+    for (int pass = 0; pass < 8; ++pass) {
+        uint32_t* histogram = histograms[pass];
+        if (count == 0 || histogram[(m_Sorted[0].Key >> (pass * 8)) & 0xFF] == count) continue;
+        uint32_t offset = 0;
+        for (int bucket = 0; bucket < 256; ++bucket) {
+            uint32_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+        for (const SortEntry& entry : m_Sorted) m_SortScratch[histogram[(entry.Key >> (pass * 8)) & 0xFF]++] = entry;
+        m_Sorted.swap(m_SortScratch);
+    }
+
+    m_LastStats.Packets = static_cast<uint32_t>(count);
+    m_LastStats.SortMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void CommandQueue::Replay(uint32_t layer, const std::function<void(const DrawPacket&, const DrawUniforms&)>& fn) const {
+    // Layers are the top bits of the key, so each one is a contiguous run
+    auto first = std::lower_bound(m_Sorted.begin(), m_Sorted.end(), uint64_t(layer) << 60,
+                                  [](const SortEntry& entry, uint64_t key) { return entry.Key < key; });
+    for (auto it = first; it != m_Sorted.end() && SortKey::GetLayer(it->Key) == layer; ++it) {
+        const CommandList& list = *m_Lists[it->List];
+        const DrawPacket& packet = list.GetPacket(it->Index);
+        fn(packet, list.GetUniforms(packet));
+    }
+}
@@ -0,0 +1,71 @@
+// src/DynamicResolution.cpp
+
+#include "DynamicResolution.h"
+#include "Shader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    int ScaledSize(int size, float scale) {
+        return std::max(1, static_cast<int>(std::lround(size * scale)));
+    }
+}
+
+DynamicResolution::DynamicResolution() {}
+
+DynamicResolution::~DynamicResolution() {
+    Shutdown();
+}
+
+bool DynamicResolution::Initialize(int outputWidth, int outputHeight, float maxScale) {
+    Shutdown();
+    if (outputWidth <= 0 || outputHeight <= 0) {
+        std::cerr << "ERROR::DYNAMIC_RESOLUTION::Invalid output size " << outputWidth << "x" << outputHeight << std::endl;
+        return false;
+    }
+    m_OutputWidth = outputWidth;
+    m_OutputHeight = outputHeight;
+    m_TargetWidth = m_SceneWidth = ScaledSize(outputWidth, maxScale);
+    m_TargetHeight = m_SceneHeight = ScaledSize(outputHeight, maxScale);
+    glGenVertexArrays(1, &m_EmptyVAO);
+    std::cout << "INFO::DYNAMIC_RESOLUTION::Scene target " << m_TargetWidth << "x" << m_TargetHeight << " for "
+              << outputWidth << "x" << outputHeight << " output." << std::endl;
+    return true;
+}
+
+void DynamicResolution::Shutdown() {
+    if (m_EmptyVAO) glDeleteVertexArrays(1, &m_EmptyVAO);
+    m_EmptyVAO = 0;
+}
+
+void DynamicResolution::SetScale(float scale) {
+    m_SceneWidth = ScaledSize(m_OutputWidth, scale);
+    m_SceneHeight = ScaledSize(m_OutputHeight, scale);
+    m_TargetWidth = std::max(m_TargetWidth, m_SceneWidth);
+    m_TargetHeight = std::max(m_TargetHeight, m_SceneHeight);
+}
+
+void DynamicResolution::Upscale(GLuint sceneTexture, GLuint sceneFramebuffer, const Shader* sharpenShader, float sharpness) const {
+    if (!sharpenShader || sharpenShader->GetProgramID() == 0) {
+        GLint outputFramebuffer = 0;
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &outputFramebuffer);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, sceneFramebuffer);
+        glBlitFramebuffer(0, 0, m_SceneWidth, m_SceneHeight, 0, 0, m_OutputWidth, m_OutputHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(outputFramebuffer));
+        return;
+    }
+    glDisable(GL_DEPTH_TEST);
+    sharpenShader->Use();
+    sharpenShader->SetInt("uScene", 0);
+    sharpenShader->SetVec2("uSceneSize", glm::vec2(static_cast<float>(m_SceneWidth), static_cast<float>(m_SceneHeight)));
+    sharpenShader->SetFloat("uSharpness", sharpness);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, sceneTexture);
+    glBindVertexArray(m_EmptyVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glEnable(GL_DEPTH_TEST);
+}
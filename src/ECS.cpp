@@ -0,0 +1,275 @@
+// src/ECS.cpp
+
+#include "ECS.h"
+#include "JobSystem.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+
+namespace {
+    const uint32_t NO_INDEX = ~0u;
+
+    std::mutex g_RegistryMutex;
+    std::vector<ComponentRegistry::Info> g_ComponentInfos;
+
+    size_t AlignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+// --- ComponentRegistry ---
+
+uint32_t ComponentRegistry::Register(size_t size, size_t alignment) {
+    std::lock_guard<std::mutex> lock(g_RegistryMutex);
+    if (g_ComponentInfos.size() >= MaxComponentTypes) {
+        // Masks are 64-bit; running out is a programming error, not a runtime condition
+        std::cerr << "ERROR::ECS::More than " << MaxComponentTypes << " component types registered." << std::endl;
+        std::abort();
+    }
+    g_ComponentInfos.push_back(Info{ size, alignment });
+    return static_cast<uint32_t>(g_ComponentInfos.size() - 1);
+}
+
+ComponentRegistry::Info ComponentRegistry::GetInfo(uint32_t id) {
+    std::lock_guard<std::mutex> lock(g_RegistryMutex);
+    return id < g_ComponentInfos.size() ? g_ComponentInfos[id] : Info{};
+}
+
+// --- World ---
+
+World::World() {
+    FindOrCreateArchetype(0); // Archetype 0: entities without components
+}
+
+World::~World() {}
+
+uint32_t World::FindOrCreateArchetype(ComponentMask mask) {
+    auto found = m_ArchetypeByMask.find(mask);
+    if (found != m_ArchetypeByMask.end()) return found->second;
+
+    std::unique_ptr<Archetype> archetype = std::make_unique<Archetype>();
+    archetype->Mask = mask;
+    archetype->Column.fill(-1);
+    archetype->AddEdges.fill(NO_INDEX);
+    archetype->RemoveEdges.fill(NO_INDEX);
+    size_t rowBytes = sizeof(Entity);
+    std::vector<ComponentRegistry::Info> infos;
+    for (uint32_t id = 0; id < MaxComponentTypes; ++id) {
+        if (!(mask & (ComponentMask(1) << id))) continue;
+        ComponentRegistry::Info info = ComponentRegistry::GetInfo(id);
+        archetype->Column[id] = static_cast<int8_t>(archetype->ComponentIds.size());
+        archetype->ComponentIds.push_back(id);
+        archetype->ComponentSizes.push_back(static_cast<uint32_t>(info.Size));
+        infos.push_back(info);
+        rowBytes += info.Size;
+    }
+
+    // Largest capacity whose aligned column arrays still fit in the chunk
+    archetype->Offsets.resize(infos.size());
+    for (size_t capacity = ArchetypeChunk::Bytes / rowBytes; capacity > 0; --capacity) {
+        size_t offset = capacity * sizeof(Entity);
+        for (size_t column = 0; column < infos.size(); ++column) {
+            offset = AlignUp(offset, infos[column].Alignment);
+            archetype->Offsets[column] = static_cast<uint32_t>(offset);
+            offset += infos[column].Size * capacity;
+        }
+        if (offset <= ArchetypeChunk::Bytes) {
+            archetype->ChunkCapacity = static_cast<uint32_t>(capacity);
+            break;
+        }
+    }
+    if (archetype->ChunkCapacity == 0) {
+        // Not even one row fits: AllocateRow would write past the chunk. Like running out of
+        // component types, this is a programming error (too many large components on one entity)
+        std::cerr << "ERROR::ECS::An entity with " << infos.size() << " components needs " << rowBytes
+                  << " bytes or more, larger than a " << ArchetypeChunk::Bytes << "-byte chunk." << std::endl;
+        std::abort();
+    }
+
+    const uint32_t index = static_cast<uint32_t>(m_Archetypes.size());
+    m_Archetypes.push_back(std::move(archetype));
+    m_ArchetypeByMask[mask] = index;
+    for (QueryData& query : m_Queries) {
+        if ((mask & query.All) == query.All && !(mask & query.None)) query.Archetypes.push_back(index);
+    }
+    return index;
+}
+
+uint32_t World::GetAddTarget(uint32_t archetypeIndex, uint32_t componentId) {
+    uint32_t target = m_Archetypes[archetypeIndex]->AddEdges[componentId];
+    if (target == NO_INDEX) {
+        target = FindOrCreateArchetype(m_Archetypes[archetypeIndex]->Mask | (ComponentMask(1) << componentId));
+        m_Archetypes[archetypeIndex]->AddEdges[componentId] = target;
+        m_Archetypes[target]->RemoveEdges[componentId] = archetypeIndex;
+    }
+    return target;
+}
+
+uint32_t World::GetRemoveTarget(uint32_t archetypeIndex, uint32_t componentId) {
+    uint32_t target = m_Archetypes[archetypeIndex]->RemoveEdges[componentId];
+    if (target == NO_INDEX) {
+        target = FindOrCreateArchetype(m_Archetypes[archetypeIndex]->Mask & ~(ComponentMask(1) << componentId));
+        m_Archetypes[archetypeIndex]->RemoveEdges[componentId] = target;
+        m_Archetypes[target]->AddEdges[componentId] = archetypeIndex;
+    }
+    return target;
+}
+
+Entity World::CreateEntity() {
+    return AllocateEntity(0);
+}
+
+Entity World::AllocateEntity(uint32_t archetypeIndex) {
+    uint32_t index;
+    if (!m_FreeIndices.empty()) {
+        index = m_FreeIndices.back();
+        m_FreeIndices.pop_back();
+    } else {
+        index = static_cast<uint32_t>(m_Records.size());
+        m_Records.push_back(EntityRecord{});
+    }
+    AllocateRow(archetypeIndex, index);
+    ++m_AliveCount;
+    return Entity{ index, m_Records[index].Generation };
+}
+
+// Appends a row for the entity to the archetype's last chunk and points its record there.
+void World::AllocateRow(uint32_t archetypeIndex, uint32_t entityIndex) {
+    Archetype& archetype = *m_Archetypes[archetypeIndex];
+    if (archetype.Chunks.empty() || archetype.Chunks.back()->Count == archetype.ChunkCapacity) {
+        archetype.Chunks.push_back(std::unique_ptr<ArchetypeChunk>(new ArchetypeChunk)); // Rows are written before they are read
+    }
+    ArchetypeChunk& chunk = *archetype.Chunks.back();
+    const uint32_t row = chunk.Count++;
+    reinterpret_cast<Entity*>(chunk.Data)[row] = Entity{ entityIndex, m_Records[entityIndex].Generation };
+    archetype.EntityCount++;
+
+    EntityRecord& record = m_Records[entityIndex];
+    record.ArchetypeIndex = archetypeIndex;
+    record.ChunkIndex = static_cast<uint32_t>(archetype.Chunks.size() - 1);
+    record.Row = row;
+}
+
+// Fills the hole with the archetype's very last row so every chunk but the last stays full.
+void World::RemoveRow(uint32_t archetypeIndex, uint32_t chunkIndex, uint32_t row) {
+    Archetype& archetype = *m_Archetypes[archetypeIndex];
+    ArchetypeChunk& last = *archetype.Chunks.back();
+    const uint32_t lastChunkIndex = static_cast<uint32_t>(archetype.Chunks.size() - 1);
+    const uint32_t lastRow = last.Count - 1;
+    if (chunkIndex != lastChunkIndex || row != lastRow) {
+        ArchetypeChunk& hole = *archetype.Chunks[chunkIndex];
+        Entity moved = reinterpret_cast<Entity*>(last.Data)[lastRow];
+        reinterpret_cast<Entity*>(hole.Data)[row] = moved;
+        for (size_t column = 0; column < archetype.ComponentIds.size(); ++column) {
+            const size_t size = archetype.ComponentSizes[column];
+            std::memcpy(hole.Data + archetype.Offsets[column] + row * size, last.Data + archetype.Offsets[column] + lastRow * size, size);
+        }
+        m_Records[moved.Index].ChunkIndex = chunkIndex;
+        m_Records[moved.Index].Row = row;
+    }
+    last.Count--;
+    if (last.Count == 0) archetype.Chunks.pop_back();
+    archetype.EntityCount--;
+}
+
+void World::MoveEntity(uint32_t entityIndex, uint32_t targetArchetype) {
+    const EntityRecord source = m_Records[entityIndex];
+    if (source.ArchetypeIndex == targetArchetype) return;
+    AllocateRow(targetArchetype, entityIndex);
+
+    // Copy the components both archetypes share; new ones are written by the caller
+    const Archetype& from = *m_Archetypes[source.ArchetypeIndex];
+    const Archetype& to = *m_Archetypes[targetArchetype];
+    const EntityRecord& destination = m_Records[entityIndex];
+    const ArchetypeChunk& fromChunk = *from.Chunks[source.ChunkIndex];
+    ArchetypeChunk& toChunk = *to.Chunks[destination.ChunkIndex];
+    for (size_t column = 0; column < to.ComponentIds.size(); ++column) {
+        const int fromColumn = from.Column[to.ComponentIds[column]];
+        if (fromColumn < 0) continue;
+        const size_t size = to.ComponentSizes[column];
+        std::memcpy(toChunk.Data + to.Offsets[column] + destination.Row * size, fromChunk.Data + from.Offsets[fromColumn] + source.Row * size, size);
+    }
+    RemoveRow(source.ArchetypeIndex, source.ChunkIndex, source.Row);
+}
+
+void World::DestroyEntity(Entity entity) {
+    if (!IsAlive(entity)) return;
+    EntityRecord& record = m_Records[entity.Index];
+    RemoveRow(record.ArchetypeIndex, record.ChunkIndex, record.Row);
+    record.ArchetypeIndex = NO_INDEX;
+    record.Generation++; // Invalidates every outstanding handle to this entity
+    m_FreeIndices.push_back(entity.Index);
+    --m_AliveCount;
+}
+
+bool World::IsAlive(Entity entity) const {
+    return entity.Index < m_Records.size() && m_Records[entity.Index].ArchetypeIndex != NO_INDEX &&
+           m_Records[entity.Index].Generation == entity.Generation;
+}
+
+void World::Clear() {
+    m_Archetypes.clear();
+    m_ArchetypeByMask.clear();
+    for (QueryData& query : m_Queries) query.Archetypes.clear();
+    // Keep the records so stale handles from before the clear stay dead
+    m_FreeIndices.clear();
+    for (uint32_t index = static_cast<uint32_t>(m_Records.size()); index-- > 0;) {
+        EntityRecord& record = m_Records[index];
+        if (record.ArchetypeIndex != NO_INDEX) record.Generation++;
+        record.ArchetypeIndex = NO_INDEX;
+        m_FreeIndices.push_back(index);
+    }
+    m_AliveCount = 0;
+    FindOrCreateArchetype(0);
+}
+
+void* World::GetComponentData(uint32_t entityIndex, uint32_t componentId) const {
+    const EntityRecord& record = m_Records[entityIndex];
+    const Archetype& archetype = *m_Archetypes[record.ArchetypeIndex];
+    const int column = archetype.Column[componentId];
+    if (column < 0) return nullptr;
+    return archetype.Chunks[record.ChunkIndex]->Data + archetype.Offsets[column] + size_t(record.Row) * archetype.ComponentSizes[column];
+}
+
+// --- Queries ---
+
+Query World::CreateQuery(ComponentMask all, ComponentMask none) {
+    for (size_t i = 0; i < m_Queries.size(); ++i) {
+        if (m_Queries[i].All == all && m_Queries[i].None == none) return Query{ static_cast<uint32_t>(i) };
+    }
+    QueryData query;
+    query.All = all;
+    query.None = none;
+    for (size_t i = 0; i < m_Archetypes.size(); ++i) {
+        const ComponentMask mask = m_Archetypes[i]->Mask;
+        if ((mask & all) == all && !(mask & none)) query.Archetypes.push_back(static_cast<uint32_t>(i));
+    }
+    m_Queries.push_back(std::move(query));
+    return Query{ static_cast<uint32_t>(m_Queries.size() - 1) };
+}
+
+void World::ForEachChunkParallel(Query query, JobSystem* jobs, const std::function<void(const ChunkView&)>& fn) {
+    if (!jobs) {
+        ForEachChunk(query, fn);
+        return;
+    }
+    std::vector<ChunkView> views;
+    ForEachChunk(query, [&](const ChunkView& view) { views.push_back(view); });
+    jobs->ParallelFor(views.size(), 1, [&](size_t begin, size_t end, unsigned int) {
+        for (size_t i = begin; i < end; ++i) fn(views[i]);
+    });
+}
+
+size_t World::CountEntities(Query query) const {
+    if (query.Index >= m_Queries.size()) return 0;
+    size_t count = 0;
+    for (uint32_t archetypeIndex : m_Queries[query.Index].Archetypes) count += m_Archetypes[archetypeIndex]->EntityCount;
+    return count;
+}
+
+size_t World::GetChunkCount() const {
+    size_t count = 0;
+    for (const std::unique_ptr<Archetype>& archetype : m_Archetypes) count += archetype->Chunks.size();
+    return count;
+}
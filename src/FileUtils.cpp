@@ -5,7 +5,9 @@
 
 #include "FileUtils.h"
 #include "VertexArray.h" // For Vertex struct
+#include "Profiler.h"
 #include <unordered_map>
+#include <algorithm>
 #include <SDL2/SDL.h> // For SDL_GetBasePath, SDL_free, SDL_GetError
 #include <iostream>
 #include <glm/gtc/type_ptr.hpp>
@@ -73,6 +75,7 @@ namespace FileUtils {
     }
 
     bool LoadObjModel(const std::string& filePath, std::vector<Vertex>& outVertices, std::vector<unsigned int>& outIndices) {
+        PROFILE_SCOPE("FileUtils::LoadObjModel");
         tinyobj::attrib_t attrib; std::vector<tinyobj::shape_t> shapes; std::vector<tinyobj::material_t> materials;
         std::string warn, err; std::cout << "INFO::MODEL::Loading OBJ file: " << filePath << std::endl;
         std::filesystem::path pathObj(filePath); std::string mtlBaseDir = pathObj.parent_path().string() + "/";
@@ -98,4 +101,123 @@ namespace FileUtils {
         return true;
     }
 
+    bool WritePPM(const std::string& filePath, int width, int height, const std::vector<uint8_t>& rgba) {
+        if (rgba.size() < static_cast<size_t>(width) * height * 4) {
+            std::cerr << "ERROR::FILEUTILS::Pixel buffer too small for " << width << "x" << height << " image." << std::endl;
+            return false;
+        }
+        std::ofstream file(filePath, std::ios::binary);
+        if (!file) {
+            std::cerr << "ERROR::FILEUTILS::Could not open for writing: " << filePath << std::endl;
+            return false;
+        }
+        file << "P6\n" << width << " " << height << "\n255\n";
+        std::vector<uint8_t> row(static_cast<size_t>(width) * 3);
+        for (int y = height - 1; y >= 0; --y) { // PPM is top row first
+            const uint8_t* source = rgba.data() + static_cast<size_t>(y) * width * 4;
+            for (int x = 0; x < width; ++x) {
+                row[x * 3 + 0] = source[x * 4 + 0];
+                row[x * 3 + 1] = source[x * 4 + 1];
+                row[x * 3 + 2] = source[x * 4 + 2];
+            }
+            file.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size()));
+        }
+        return file.good();
+    }
+
+    namespace {
+        uint32_t Crc32(uint32_t crc, const uint8_t* data, size_t size) {
+            static uint32_t table[256] = {};
+            static bool tableReady = false;
+            if (!tableReady) {
+                for (uint32_t n = 0; n < 256; ++n) {
+                    uint32_t c = n;
+                    for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                    table[n] = c;
+                }
+                tableReady = true;
+            }
+            crc = ~crc;
+            for (size_t i = 0; i < size; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+            return ~crc;
+        }
+
+        void AppendBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+            out.push_back(static_cast<uint8_t>(value >> 24));
+            out.push_back(static_cast<uint8_t>(value >> 16));
+            out.push_back(static_cast<uint8_t>(value >> 8));
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        void WritePNGChunk(std::ofstream& file, const char* type, const std::vector<uint8_t>& data) {
+            std::vector<uint8_t> chunk;
+            chunk.reserve(data.size() + 12);
+            AppendBigEndian(chunk, static_cast<uint32_t>(data.size()));
+            chunk.insert(chunk.end(), type, type + 4);
+            chunk.insert(chunk.end(), data.begin(), data.end());
+            AppendBigEndian(chunk, Crc32(0, chunk.data() + 4, data.size() + 4)); // Type and data
+            file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+        }
+    }
+
+    bool WritePNG(const std::string& filePath, int width, int height, const std::vector<uint8_t>& rgba) {
+        if (rgba.size() < static_cast<size_t>(width) * height * 4) {
+            std::cerr << "ERROR::FILEUTILS::Pixel buffer too small for " << width << "x" << height << " image." << std::endl;
+            return false;
+        }
+        std::ofstream file(filePath, std::ios::binary);
+        if (!file) {
+            std::cerr << "ERROR::FILEUTILS::Could not open for writing: " << filePath << std::endl;
+            return false;
+        }
+        static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+        std::vector<uint8_t> header;
+        AppendBigEndian(header, static_cast<uint32_t>(width));
+        AppendBigEndian(header, static_cast<uint32_t>(height));
+        header.insert(header.end(), { 8, 2, 0, 0, 0 }); // 8 bits, RGB, deflate, adaptive filtering (method 0), no interlace
+        WritePNGChunk(file, "IHDR", header);
+
+        // Scanlines top row first, each with filter byte 0
+        const size_t rowBytes = static_cast<size_t>(width) * 3 + 1;
+        std::vector<uint8_t> raw(rowBytes * height);
+        for (int y = 0; y < height; ++y) {
+            const uint8_t* source = rgba.data() + static_cast<size_t>(height - 1 - y) * width * 4;
+            uint8_t* row = raw.data() + static_cast<size_t>(y) * rowBytes;
+            row[0] = 0;
+            for (int x = 0; x < width; ++x) {
+                row[1 + x * 3 + 0] = source[x * 4 + 0];
+                row[1 + x * 3 + 1] = source[x * 4 + 1];
+                row[1 + x * 3 + 2] = source[x * 4 + 2];
+            }
+        }
+
+        // zlib stream of stored deflate blocks (at most 65535 bytes each), then the Adler-32 of the raw data
+        const size_t maxBlock = 65535;
+        std::vector<uint8_t> zlib;
+        zlib.reserve(raw.size() + raw.size() / maxBlock * 5 + 16);
+        zlib.push_back(0x78);
+        zlib.push_back(0x01);
+        uint32_t adlerA = 1, adlerB = 0;
+        for (size_t offset = 0; offset < raw.size() || offset == 0; offset += maxBlock) {
+            const size_t size = std::min(maxBlock, raw.size() - offset);
+            zlib.push_back(offset + size >= raw.size() ? 1 : 0); // BFINAL on the last block, BTYPE 00
+            zlib.push_back(static_cast<uint8_t>(size));
+            zlib.push_back(static_cast<uint8_t>(size >> 8));
+            zlib.push_back(static_cast<uint8_t>(~size));
+            zlib.push_back(static_cast<uint8_t>(~size >> 8));
+            zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + size);
+            for (size_t i = offset; i < offset + size; ++i) {
+                adlerA = (adlerA + raw[i]) % 65521;
+                adlerB = (adlerB + adlerA) % 65521;
+            }
+            if (size == 0) break;
+        }
+        AppendBigEndian(zlib, (adlerB << 16) | adlerA);
+        WritePNGChunk(file, "IDAT", zlib);
+        WritePNGChunk(file, "IEND", {});
+        return file.good();
+    }
+
 } // namespace FileUtils
\ No newline at end of file
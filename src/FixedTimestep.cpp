@@ -0,0 +1,41 @@
+// src/FixedTimestep.cpp
+
+#include "FixedTimestep.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Slack when comparing against a whole step, so a frame delta that equals the step (benchmarks
+    // at --fixed-fps matching the rate, passed as a float) doesn't alternate between zero and two
+    // steps on rounding
+    const double STEP_EPSILON = 1e-6;
+}
+
+void FixedTimestep::Configure(int rateHz, int maxStepsPerFrame) {
+    m_Rate = std::max(rateHz, 1);
+    m_MaxSteps = std::max(maxStepsPerFrame, 1);
+    const double previousStep = m_StepSeconds;
+    m_StepSeconds = 1.0 / m_Rate;
+    // Keep the frame's position between states across a rate change. Stay clearly short of a whole
+    // step: GetAlpha() must stay below 1, and a paused Advance(0) must not step
+    m_Accumulator = std::min(m_Accumulator / previousStep * m_StepSeconds, std::max(m_StepSeconds - 2.0 * STEP_EPSILON, 0.0));
+}
+
+uint32_t FixedTimestep::Advance(double seconds) {
+    m_Accumulator += std::max(seconds, 0.0);
+    uint32_t steps = 0;
+    while (m_Accumulator + STEP_EPSILON >= m_StepSeconds && steps < static_cast<uint32_t>(m_MaxSteps)) {
+        m_Accumulator = std::max(m_Accumulator - m_StepSeconds, 0.0);
+        steps++;
+    }
+    if (m_Accumulator + STEP_EPSILON >= m_StepSeconds) {
+        const double dropped = std::floor((m_Accumulator + STEP_EPSILON) / m_StepSeconds);
+        m_Stats.DroppedSteps += static_cast<uint64_t>(dropped);
+        m_Accumulator = std::max(m_Accumulator - dropped * m_StepSeconds, 0.0);
+    }
+    m_Stats.Steps = steps;
+    m_Stats.TotalSteps += steps;
+    if (steps > 1) m_Stats.CatchUpFrames++;
+    return steps;
+}
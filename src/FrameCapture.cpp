@@ -0,0 +1,134 @@
+// src/FrameCapture.cpp
+
+#include "FrameCapture.h"
+#include "CaptureWriter.h"
+#include "Profiler.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    const GLuint64 FENCE_TIMEOUT_NS = 1000000000ull; // Re-poll once a second rather than hang forever
+}
+
+FrameCapture::FrameCapture() {}
+
+FrameCapture::~FrameCapture() {
+    Shutdown();
+}
+
+bool FrameCapture::Initialize(int width, int height, int ringSize, CaptureWriter& writer) {
+    Shutdown();
+    if (width <= 0 || height <= 0 || ringSize <= 0) return false;
+    m_Width = width;
+    m_Height = height;
+    m_Bytes = static_cast<size_t>(width) * height * 4;
+    m_Writer = &writer;
+    m_Slots.resize(static_cast<size_t>(ringSize));
+    for (Slot& slot : m_Slots) {
+        glGenBuffers(1, &slot.Buffer);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.Buffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(m_Bytes), nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    if (glGetError() != GL_NO_ERROR) {
+        std::cerr << "ERROR::CAPTURE::Could not allocate " << ringSize << " pixel pack buffer(s) of " << m_Bytes << " bytes." << std::endl;
+        Shutdown();
+        return false;
+    }
+    m_Next = 0;
+    m_Frames = 0;
+    m_Stats = Stats{};
+    std::cout << "INFO::CAPTURE::" << ringSize << " pixel pack buffer(s) for " << width << "x" << height << " readback." << std::endl;
+    return true;
+}
+
+void FrameCapture::Shutdown() {
+    for (Slot& slot : m_Slots) {
+        if (slot.Fence) glDeleteSync(slot.Fence);
+        if (slot.Buffer) glDeleteBuffers(1, &slot.Buffer);
+    }
+    m_Slots.clear();
+    m_Writer = nullptr;
+}
+
+void FrameCapture::Capture(uint64_t frameIndex) {
+    if (m_Slots.empty()) return;
+    PROFILE_SCOPE("Capture readback");
+    auto start = std::chrono::steady_clock::now();
+    Slot& slot = m_Slots[m_Next];
+    if (slot.Fence) {
+        // Ring full: the oldest readback has to leave before its buffer can be reused
+        m_Stats.Stalls++;
+        CollectSlot(slot, true);
+    }
+    GLint drawFramebuffer = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFramebuffer);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(drawFramebuffer));
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.Buffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, m_Width, m_Height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr); // Into the bound buffer, returns at once
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.FrameIndex = frameIndex;
+    slot.IssuedAt = m_Frames;
+    m_Next = (m_Next + 1) % static_cast<int>(m_Slots.size());
+    m_Stats.Captured++;
+    m_Stats.InFlight++;
+    m_Stats.IssueMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void FrameCapture::Collect() {
+    m_Frames++;
+    if (m_Slots.empty() || m_Stats.InFlight == 0) {
+        m_Stats.CollectMilliseconds = 0.0;
+        return;
+    }
+    PROFILE_SCOPE("Capture collect");
+    auto start = std::chrono::steady_clock::now();
+    // Oldest first, and stop at the first unfinished one so frames reach the writer in order
+    const int count = static_cast<int>(m_Slots.size());
+    for (int i = 0; i < count; ++i) {
+        Slot& slot = m_Slots[(m_Next + i) % count];
+        if (slot.Fence && !CollectSlot(slot, false)) break;
+    }
+    m_Stats.CollectMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void FrameCapture::Flush() {
+    const int count = static_cast<int>(m_Slots.size());
+    for (int i = 0; i < count; ++i) {
+        Slot& slot = m_Slots[(m_Next + i) % count];
+        if (slot.Fence) CollectSlot(slot, true);
+    }
+}
+
+bool FrameCapture::CollectSlot(Slot& slot, bool wait) {
+    GLenum result = glClientWaitSync(slot.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (result == GL_TIMEOUT_EXPIRED) {
+        if (!wait) return false;
+        do {
+            result = glClientWaitSync(slot.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NS);
+        } while (result == GL_TIMEOUT_EXPIRED);
+    }
+    if (result == GL_WAIT_FAILED) std::cerr << "ERROR::CAPTURE::glClientWaitSync failed." << std::endl;
+    glDeleteSync(slot.Fence);
+    slot.Fence = nullptr;
+    m_Stats.InFlight--;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.Buffer);
+    const void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(m_Bytes), GL_MAP_READ_BIT);
+    if (pixels) {
+        std::vector<uint8_t> frame = m_Writer->AcquireBuffer(m_Bytes);
+        std::memcpy(frame.data(), pixels, m_Bytes);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        m_Writer->Submit(slot.FrameIndex, std::move(frame));
+        m_Stats.Collected++;
+        m_Stats.LatencyFrames = static_cast<uint32_t>(m_Frames - slot.IssuedAt);
+    } else {
+        std::cerr << "ERROR::CAPTURE::Could not map the readback of frame " << slot.FrameIndex << "." << std::endl;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return true;
+}
@@ -0,0 +1,112 @@
+// src/FramePacer.cpp
+
+#include "FramePacer.h"
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const double SPIN_MARGIN_MILLISECONDS = 0.5;  // Spun on top of the expected oversleep
+    const double MAX_SLEEP_OVERSHOOT = 4.0;       // Cap, so one descheduled sleep doesn't turn into spinning for good
+    const double OVERSHOOT_DECAY = 0.05;          // Weight of a shorter overshoot; longer ones are taken at once
+}
+
+void FrameIntervals::Add(double milliseconds) {
+    m_Intervals[m_Next] = milliseconds;
+    m_Next = (m_Next + 1) % HistorySize;
+    m_Count = std::min(m_Count + 1, HistorySize);
+}
+
+FrameIntervals::Stats FrameIntervals::GetStats() const {
+    Stats stats;
+    if (m_Count == 0) return stats;
+    const int first = (m_Next - m_Count + HistorySize) % HistorySize;
+    double sum = 0.0, change = 0.0;
+    for (int i = 0; i < m_Count; ++i) {
+        const double interval = m_Intervals[(first + i) % HistorySize];
+        sum += interval;
+        stats.MaxMilliseconds = std::max(stats.MaxMilliseconds, interval);
+        if (i > 0) change += std::fabs(interval - m_Intervals[(first + i - 1) % HistorySize]);
+    }
+    stats.Samples = static_cast<uint32_t>(m_Count);
+    stats.MeanMilliseconds = sum / m_Count;
+    double variance = 0.0;
+    for (int i = 0; i < m_Count; ++i) {
+        const double deviation = m_Intervals[(first + i) % HistorySize] - stats.MeanMilliseconds;
+        variance += deviation * deviation;
+    }
+    stats.StdDevMilliseconds = std::sqrt(variance / m_Count);
+    stats.JitterMilliseconds = m_Count > 1 ? change / (m_Count - 1) : 0.0;
+    return stats;
+}
+
+const char* FramePacer::GetModeName(PacingMode mode) {
+    switch (mode) {
+        case PacingMode::VSync: return "vsync";
+        case PacingMode::AdaptiveVSync: return "adaptive";
+        case PacingMode::Uncapped: return "uncapped";
+        case PacingMode::Limited: return "limit";
+    }
+    return "unknown";
+}
+
+bool FramePacer::ParseMode(const std::string& name, PacingMode& out) {
+    for (PacingMode mode : {PacingMode::VSync, PacingMode::AdaptiveVSync, PacingMode::Uncapped, PacingMode::Limited}) {
+        if (name == GetModeName(mode)) { out = mode; return true; }
+    }
+    return false;
+}
+
+int FramePacer::GetSwapInterval(PacingMode mode) {
+    switch (mode) {
+        case PacingMode::VSync: return 1;
+        case PacingMode::AdaptiveVSync: return -1;
+        default: return 0;
+    }
+}
+
+double FramePacer::BeginFrame(PacingMode mode, int fpsLimit) {
+    const uint64_t frequency = SDL_GetPerformanceFrequency();
+    if (mode == PacingMode::Limited && fpsLimit > 0 && m_LastFrame != 0) {
+        const uint64_t period = frequency / static_cast<uint64_t>(fpsLimit);
+        const uint64_t now = SDL_GetPerformanceCounter();
+        // Slots are spaced a period apart rather than a period after each frame ends, so the rate
+        // holds exactly. After a hitch (or on entering the mode) the schedule restarts instead of
+        // rushing frames out to catch up.
+        if (m_NextSlot == 0) m_NextSlot = m_LastFrame + period;
+        else if (now > m_NextSlot + period) m_NextSlot = now;
+        WaitUntil(m_NextSlot);
+        m_NextSlot += period;
+    } else {
+        m_NextSlot = 0;
+    }
+
+    const uint64_t now = SDL_GetPerformanceCounter();
+    double seconds = 0.0;
+    if (m_LastFrame != 0) {
+        seconds = static_cast<double>(now - m_LastFrame) / frequency;
+        m_Frames.Add(seconds * 1000.0);
+    }
+    m_LastFrame = now;
+    return seconds;
+}
+
+// Sleeps in whole milliseconds while that can't overshoot the deadline, then spins.
+void FramePacer::WaitUntil(uint64_t deadline) {
+    const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    for (;;) {
+        const uint64_t now = SDL_GetPerformanceCounter();
+        if (now >= deadline) return;
+        const double sleepable = (deadline - now) * 1000.0 / frequency - m_SleepOvershoot - SPIN_MARGIN_MILLISECONDS;
+        if (sleepable < 1.0) break;
+        const Uint32 requested = static_cast<Uint32>(sleepable);
+        SDL_Delay(requested);
+        const double overshoot = std::max(0.0, (SDL_GetPerformanceCounter() - now) * 1000.0 / frequency - requested);
+        if (overshoot > m_SleepOvershoot) m_SleepOvershoot = std::min(overshoot, MAX_SLEEP_OVERSHOOT);
+        else m_SleepOvershoot += (overshoot - m_SleepOvershoot) * OVERSHOOT_DECAY;
+    }
+    while (SDL_GetPerformanceCounter() < deadline) {
+        // Spin; the remaining wait is shorter than the scheduler's wake-up granularity
+    }
+}
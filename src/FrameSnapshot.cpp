@@ -0,0 +1,44 @@
+// src/FrameSnapshot.cpp
+
+#include "FrameSnapshot.h"
+
+#include <cstring>
+
+namespace {
+    // Resize keeps capacity, so steady-state copies don't allocate.
+    template <typename T>
+    void CopyVector(ImVector<T>& destination, const ImVector<T>& source) {
+        destination.resize(source.Size);
+        if (source.Size > 0) std::memcpy(destination.Data, source.Data, source.size_in_bytes());
+    }
+}
+
+UIDrawData::~UIDrawData() {
+    m_Data.Clear(); // Only points at m_Lists
+    for (ImDrawList* list : m_Lists) IM_DELETE(list);
+}
+
+void UIDrawData::CopyFrom(const ImDrawData& source) {
+    while (m_Lists.size() < static_cast<size_t>(source.CmdListsCount)) {
+        m_Lists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+    }
+
+    m_Data.Clear();
+    for (int i = 0; i < source.CmdListsCount; ++i) {
+        const ImDrawList* from = source.CmdLists[i];
+        ImDrawList* to = m_Lists[i];
+        CopyVector(to->CmdBuffer, from->CmdBuffer);
+        CopyVector(to->IdxBuffer, from->IdxBuffer);
+        CopyVector(to->VtxBuffer, from->VtxBuffer);
+        to->Flags = from->Flags;
+        m_Data.CmdLists.push_back(to);
+    }
+    m_Data.Valid = source.Valid;
+    m_Data.CmdListsCount = source.CmdListsCount;
+    m_Data.TotalIdxCount = source.TotalIdxCount;
+    m_Data.TotalVtxCount = source.TotalVtxCount;
+    m_Data.DisplayPos = source.DisplayPos;
+    m_Data.DisplaySize = source.DisplaySize;
+    m_Data.FramebufferScale = source.FramebufferScale;
+    m_Data.OwnerViewport = nullptr; // Belongs to the ImGui context, which keeps changing on the main thread
+}
@@ -0,0 +1,81 @@
+// src/Framebuffer.cpp
+
+#include "Framebuffer.h"
+
+#include <iostream>
+
+Framebuffer::Framebuffer() {}
+
+Framebuffer::~Framebuffer() {
+    Destroy();
+}
+
+bool Framebuffer::Create(int width, int height) {
+    Destroy();
+    if (width <= 0 || height <= 0) {
+        std::cerr << "ERROR::FRAMEBUFFER::Invalid size " << width << "x" << height << std::endl;
+        return false;
+    }
+
+    glGenTextures(1, &m_ColorTexture);
+    glBindTexture(GL_TEXTURE_2D, m_ColorTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenRenderbuffers(1, &m_DepthRenderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_DepthRenderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &m_FramebufferID);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_FramebufferID);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_ColorTexture, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_DepthRenderbuffer);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "ERROR::FRAMEBUFFER::Incomplete framebuffer (status 0x" << std::hex << status << std::dec << ")." << std::endl;
+        Destroy();
+        return false;
+    }
+
+    m_Width = width;
+    m_Height = height;
+    std::cout << "INFO::FRAMEBUFFER::Created " << width << "x" << height << " offscreen target." << std::endl;
+    return true;
+}
+
+void Framebuffer::Destroy() {
+    if (m_FramebufferID) glDeleteFramebuffers(1, &m_FramebufferID);
+    if (m_ColorTexture) glDeleteTextures(1, &m_ColorTexture);
+    if (m_DepthRenderbuffer) glDeleteRenderbuffers(1, &m_DepthRenderbuffer);
+    m_FramebufferID = 0;
+    m_ColorTexture = 0;
+    m_DepthRenderbuffer = 0;
+    m_Width = 0;
+    m_Height = 0;
+}
+
+void Framebuffer::Bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, m_FramebufferID);
+    glViewport(0, 0, m_Width, m_Height);
+}
+
+void Framebuffer::BindDefault(int width, int height) {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, width, height);
+}
+
+bool Framebuffer::ReadPixels(std::vector<uint8_t>& rgba) const {
+    if (!IsValid()) return false;
+    rgba.resize(static_cast<size_t>(m_Width) * m_Height * 4);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_FramebufferID);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, m_Width, m_Height, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    return true;
+}
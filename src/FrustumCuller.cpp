@@ -0,0 +1,235 @@
+// src/FrustumCuller.cpp
+
+#include "FrustumCuller.h"
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define FRUSTUM_CULLER_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define FRUSTUM_CULLER_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define FRUSTUM_CULLER_NEON 1
+#endif
+
+// --- Storage ---
+
+uint32_t FrustumCuller::Add(const AABB& worldBox, const BoundingSphere& worldSphere) {
+    uint32_t index = static_cast<uint32_t>(Size());
+    m_CenterX.push_back(0.0f); m_CenterY.push_back(0.0f); m_CenterZ.push_back(0.0f);
+    m_ExtentX.push_back(0.0f); m_ExtentY.push_back(0.0f); m_ExtentZ.push_back(0.0f);
+    m_Radius.push_back(0.0f);
+    Set(index, worldBox, worldSphere);
+    return index;
+}
+
+uint32_t FrustumCuller::Add(const AABB& worldBox) {
+    BoundingSphere sphere;
+    sphere.Center = worldBox.GetCenter();
+    sphere.Radius = glm::length(worldBox.GetExtents());
+    return Add(worldBox, sphere);
+}
+
+void FrustumCuller::Set(uint32_t index, const AABB& worldBox, const BoundingSphere& worldSphere) {
+    if (index >= Size()) return;
+    glm::vec3 center = worldBox.GetCenter();
+    glm::vec3 extents = worldBox.GetExtents();
+    m_CenterX[index] = center.x; m_CenterY[index] = center.y; m_CenterZ[index] = center.z;
+    m_ExtentX[index] = extents.x; m_ExtentY[index] = extents.y; m_ExtentZ[index] = extents.z;
+    // The plane test uses one centre; fold any sphere offset into the radius so it stays conservative
+    m_Radius[index] = worldSphere.Radius + glm::length(worldSphere.Center - center);
+}
+
+void FrustumCuller::Set(uint32_t index, const AABB& worldBox) {
+    BoundingSphere sphere;
+    sphere.Center = worldBox.GetCenter();
+    sphere.Radius = glm::length(worldBox.GetExtents());
+    Set(index, worldBox, sphere);
+}
+
+uint32_t FrustumCuller::RemoveSwap(uint32_t index) {
+    if (index >= Size()) return index;
+    uint32_t last = static_cast<uint32_t>(Size() - 1);
+    m_CenterX[index] = m_CenterX[last]; m_CenterY[index] = m_CenterY[last]; m_CenterZ[index] = m_CenterZ[last];
+    m_ExtentX[index] = m_ExtentX[last]; m_ExtentY[index] = m_ExtentY[last]; m_ExtentZ[index] = m_ExtentZ[last];
+    m_Radius[index] = m_Radius[last];
+    m_CenterX.pop_back(); m_CenterY.pop_back(); m_CenterZ.pop_back();
+    m_ExtentX.pop_back(); m_ExtentY.pop_back(); m_ExtentZ.pop_back();
+    m_Radius.pop_back();
+    return last;
+}
+
+void FrustumCuller::Clear() {
+    m_CenterX.clear(); m_CenterY.clear(); m_CenterZ.clear();
+    m_ExtentX.clear(); m_ExtentY.clear(); m_ExtentZ.clear();
+    m_Radius.clear();
+}
+
+void FrustumCuller::Reserve(size_t count) {
+    m_CenterX.reserve(count); m_CenterY.reserve(count); m_CenterZ.reserve(count);
+    m_ExtentX.reserve(count); m_ExtentY.reserve(count); m_ExtentZ.reserve(count);
+    m_Radius.reserve(count);
+}
+
+// --- Path info ---
+
+FrustumCuller::SimdPath FrustumCuller::GetSimdPath() {
+#if defined(FRUSTUM_CULLER_AVX2)
+    return SimdPath::AVX2;
+#elif defined(FRUSTUM_CULLER_SSE)
+    return SimdPath::SSE;
+#elif defined(FRUSTUM_CULLER_NEON)
+    return SimdPath::NEON;
+#else
+    return SimdPath::Scalar;
+#endif
+}
+
+const char* FrustumCuller::GetSimdPathName() {
+    switch (GetSimdPath()) {
+        case SimdPath::AVX2: return "AVX2 (8-wide)";
+        case SimdPath::SSE: return "SSE2 (4-wide)";
+        case SimdPath::NEON: return "NEON (4-wide)";
+        default: return "Scalar";
+    }
+}
+
+// --- Culling ---
+
+void FrustumCuller::CullRangeScalar(const Frustum& frustum, size_t begin, size_t end, std::vector<uint32_t>& out) const {
+    for (size_t i = begin; i < end; ++i) {
+        bool visible = true;
+        for (const glm::vec4& plane : frustum.Planes) {
+            float dist = plane.x * m_CenterX[i] + plane.y * m_CenterY[i] + plane.z * m_CenterZ[i] + plane.w;
+            float boxRadius = std::fabs(plane.x) * m_ExtentX[i] + std::fabs(plane.y) * m_ExtentY[i] + std::fabs(plane.z) * m_ExtentZ[i];
+            if (dist < -std::min(boxRadius, m_Radius[i])) { visible = false; break; }
+        }
+        if (visible) out.push_back(static_cast<uint32_t>(i));
+    }
+}
+
+void FrustumCuller::CullRange(const Frustum& frustum, size_t begin, size_t end, std::vector<uint32_t>& out) const {
+    size_t i = begin;
+#if defined(FRUSTUM_CULLER_AVX2)
+    __m256 px[6], py[6], pz[6], pw[6], ax[6], ay[6], az[6];
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    for (int p = 0; p < 6; ++p) {
+        px[p] = _mm256_set1_ps(frustum.Planes[p].x); py[p] = _mm256_set1_ps(frustum.Planes[p].y);
+        pz[p] = _mm256_set1_ps(frustum.Planes[p].z); pw[p] = _mm256_set1_ps(frustum.Planes[p].w);
+        ax[p] = _mm256_andnot_ps(signMask, px[p]); ay[p] = _mm256_andnot_ps(signMask, py[p]); az[p] = _mm256_andnot_ps(signMask, pz[p]);
+    }
+    for (; i + 8 <= end; i += 8) {
+        __m256 cx = _mm256_loadu_ps(&m_CenterX[i]), cy = _mm256_loadu_ps(&m_CenterY[i]), cz = _mm256_loadu_ps(&m_CenterZ[i]);
+        __m256 ex = _mm256_loadu_ps(&m_ExtentX[i]), ey = _mm256_loadu_ps(&m_ExtentY[i]), ez = _mm256_loadu_ps(&m_ExtentZ[i]);
+        __m256 radius = _mm256_loadu_ps(&m_Radius[i]);
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            __m256 dist = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(cx, px[p]), _mm256_mul_ps(cy, py[p])),
+                                        _mm256_add_ps(_mm256_mul_ps(cz, pz[p]), pw[p]));
+            __m256 boxRadius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ex, ax[p]), _mm256_mul_ps(ey, ay[p])), _mm256_mul_ps(ez, az[p]));
+            __m256 r = _mm256_min_ps(boxRadius, radius);
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(dist, r), _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+        int mask = _mm256_movemask_ps(inside);
+        for (int bit = 0; mask != 0; ++bit, mask >>= 1) {
+            if (mask & 1) out.push_back(static_cast<uint32_t>(i + bit));
+        }
+    }
+#elif defined(FRUSTUM_CULLER_SSE)
+    __m128 px[6], py[6], pz[6], pw[6], ax[6], ay[6], az[6];
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    for (int p = 0; p < 6; ++p) {
+        px[p] = _mm_set1_ps(frustum.Planes[p].x); py[p] = _mm_set1_ps(frustum.Planes[p].y);
+        pz[p] = _mm_set1_ps(frustum.Planes[p].z); pw[p] = _mm_set1_ps(frustum.Planes[p].w);
+        ax[p] = _mm_andnot_ps(signMask, px[p]); ay[p] = _mm_andnot_ps(signMask, py[p]); az[p] = _mm_andnot_ps(signMask, pz[p]);
+    }
+    for (; i + 4 <= end; i += 4) {
+        __m128 cx = _mm_loadu_ps(&m_CenterX[i]), cy = _mm_loadu_ps(&m_CenterY[i]), cz = _mm_loadu_ps(&m_CenterZ[i]);
+        __m128 ex = _mm_loadu_ps(&m_ExtentX[i]), ey = _mm_loadu_ps(&m_ExtentY[i]), ez = _mm_loadu_ps(&m_ExtentZ[i]);
+        __m128 radius = _mm_loadu_ps(&m_Radius[i]);
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, px[p]), _mm_mul_ps(cy, py[p])),
+                                     _mm_add_ps(_mm_mul_ps(cz, pz[p]), pw[p]));
+            __m128 boxRadius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ex, ax[p]), _mm_mul_ps(ey, ay[p])), _mm_mul_ps(ez, az[p]));
+            __m128 r = _mm_min_ps(boxRadius, radius);
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(dist, r), _mm_setzero_ps()));
+        }
+        int mask = _mm_movemask_ps(inside);
+        if (mask & 1) out.push_back(static_cast<uint32_t>(i));
+        if (mask & 2) out.push_back(static_cast<uint32_t>(i + 1));
+        if (mask & 4) out.push_back(static_cast<uint32_t>(i + 2));
+        if (mask & 8) out.push_back(static_cast<uint32_t>(i + 3));
+    }
+#elif defined(FRUSTUM_CULLER_NEON)
+    float32x4_t px[6], py[6], pz[6], pw[6], ax[6], ay[6], az[6];
+    for (int p = 0; p < 6; ++p) {
+        px[p] = vdupq_n_f32(frustum.Planes[p].x); py[p] = vdupq_n_f32(frustum.Planes[p].y);
+        pz[p] = vdupq_n_f32(frustum.Planes[p].z); pw[p] = vdupq_n_f32(frustum.Planes[p].w);
+        ax[p] = vabsq_f32(px[p]); ay[p] = vabsq_f32(py[p]); az[p] = vabsq_f32(pz[p]);
+    }
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    for (; i + 4 <= end; i += 4) {
+        float32x4_t cx = vld1q_f32(&m_CenterX[i]), cy = vld1q_f32(&m_CenterY[i]), cz = vld1q_f32(&m_CenterZ[i]);
+        float32x4_t ex = vld1q_f32(&m_ExtentX[i]), ey = vld1q_f32(&m_ExtentY[i]), ez = vld1q_f32(&m_ExtentZ[i]);
+        float32x4_t radius = vld1q_f32(&m_Radius[i]);
+        uint32x4_t inside = vdupq_n_u32(0xFFFFFFFFu);
+        for (int p = 0; p < 6; ++p) {
+            float32x4_t dist = vmlaq_f32(vmlaq_f32(vmlaq_f32(pw[p], cx, px[p]), cy, py[p]), cz, pz[p]);
+            float32x4_t boxRadius = vmlaq_f32(vmlaq_f32(vmulq_f32(ex, ax[p]), ey, ay[p]), ez, az[p]);
+            float32x4_t r = vminq_f32(boxRadius, radius);
+            inside = vandq_u32(inside, vcgeq_f32(vaddq_f32(dist, r), zero));
+        }
+        if (vgetq_lane_u32(inside, 0)) out.push_back(static_cast<uint32_t>(i));
+        if (vgetq_lane_u32(inside, 1)) out.push_back(static_cast<uint32_t>(i + 1));
+        if (vgetq_lane_u32(inside, 2)) out.push_back(static_cast<uint32_t>(i + 2));
+        if (vgetq_lane_u32(inside, 3)) out.push_back(static_cast<uint32_t>(i + 3));
+    }
+#endif
+    // Tail (and the whole range when no SIMD path is compiled in)
+    CullRangeScalar(frustum, i, end, out);
+}
+
+void FrustumCuller::Cull(const Frustum& frustum, std::vector<uint32_t>& outVisible, JobSystem* jobs) {
+    auto start = std::chrono::steady_clock::now();
+    outVisible.clear();
+    const size_t count = Size();
+    unsigned int slices = 1;
+
+    if (jobs && jobs->GetWorkerCount() > 1 && count >= ParallelThreshold) {
+        // Fixed slices (multiples of 8 so SIMD blocks never straddle) with one output list each,
+        // concatenated in order afterwards so results are identical to the serial path
+        slices = jobs->GetWorkerCount() * 2;
+        size_t sliceSize = ((count + slices - 1) / slices + 7) & ~size_t(7);
+        slices = static_cast<unsigned int>((count + sliceSize - 1) / sliceSize);
+        if (m_SliceResults.size() < slices) m_SliceResults.resize(slices);
+
+        jobs->ParallelFor(slices, 1, [&](size_t first, size_t last, unsigned int) {
+            for (size_t s = first; s < last; ++s) {
+                std::vector<uint32_t>& sliceOut = m_SliceResults[s];
+                sliceOut.clear();
+                CullRange(frustum, s * sliceSize, std::min(count, (s + 1) * sliceSize), sliceOut);
+            }
+        });
+
+        size_t total = 0;
+        for (unsigned int s = 0; s < slices; ++s) total += m_SliceResults[s].size();
+        outVisible.reserve(total);
+        for (unsigned int s = 0; s < slices; ++s) {
+            outVisible.insert(outVisible.end(), m_SliceResults[s].begin(), m_SliceResults[s].end());
+        }
+    } else {
+        CullRange(frustum, 0, count, outVisible);
+    }
+
+    m_LastStats.Tested = static_cast<uint32_t>(count);
+    m_LastStats.Visible = static_cast<uint32_t>(outVisible.size());
+    m_LastStats.SlicesUsed = slices;
+    m_LastStats.MillisecondsCPU = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
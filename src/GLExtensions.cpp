@@ -0,0 +1,70 @@
+#include "GLExtensions.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace GLExtensions {
+
+    PFNGLMULTIDRAWELEMENTSINDIRECTPROC MultiDrawElementsIndirect = nullptr;
+    PFNGLBUFFERSTORAGEPROC BufferStorage = nullptr;
+    PFNGLINVALIDATEFRAMEBUFFERPROC InvalidateFramebuffer = nullptr;
+
+    // Internal cached feature flags
+    static bool sHasMultiDrawIndirect = false;
+    static bool sHasBaseInstance = false;
+    static bool sHasBufferStorage = false;
+    static bool sHasInvalidateSubdata = false;
+
+    bool IsVersionAtLeast(int major, int minor) {
+        return GLVersion.major > major || (GLVersion.major == major && GLVersion.minor >= minor);
+    }
+
+    bool IsSupported(const char* extensionName) {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i) {
+            const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+            if (name && std::strcmp(name, extensionName) == 0) return true;
+        }
+        return false;
+    }
+
+    bool Load(GLADloadproc loader) {
+        if (!loader) {
+            std::cerr << "ERROR::GLEXT::Loader function is null." << std::endl;
+            return false;
+        }
+
+        // --- Multi-draw indirect (core in 4.3) ---
+        if (IsVersionAtLeast(4, 3) || IsSupported("GL_ARB_multi_draw_indirect")) {
+            MultiDrawElementsIndirect = reinterpret_cast<PFNGLMULTIDRAWELEMENTSINDIRECTPROC>(loader("glMultiDrawElementsIndirect"));
+        }
+        sHasMultiDrawIndirect = (MultiDrawElementsIndirect != nullptr);
+        // Before 4.2 an indirect command's BaseInstance is reserved unless this extension is present
+        sHasBaseInstance = IsVersionAtLeast(4, 2) || IsSupported("GL_ARB_base_instance");
+
+        // --- Immutable buffer storage / persistent mapping (core in 4.4) ---
+        if (IsVersionAtLeast(4, 4) || IsSupported("GL_ARB_buffer_storage")) {
+            BufferStorage = reinterpret_cast<PFNGLBUFFERSTORAGEPROC>(loader("glBufferStorage"));
+        }
+        sHasBufferStorage = (BufferStorage != nullptr);
+
+        // --- Framebuffer invalidation (core in 4.3) ---
+        if (IsVersionAtLeast(4, 3) || IsSupported("GL_ARB_invalidate_subdata")) {
+            InvalidateFramebuffer = reinterpret_cast<PFNGLINVALIDATEFRAMEBUFFERPROC>(loader("glInvalidateFramebuffer"));
+        }
+        sHasInvalidateSubdata = (InvalidateFramebuffer != nullptr);
+
+        std::cout << "INFO::GLEXT::Multi-draw indirect: " << (sHasMultiDrawIndirect ? "yes" : "no")
+                  << ", Base instance: " << (sHasBaseInstance ? "yes" : "no")
+                  << ", Buffer storage: " << (sHasBufferStorage ? "yes" : "no")
+                  << ", Invalidate subdata: " << (sHasInvalidateSubdata ? "yes" : "no") << std::endl;
+        return true;
+    }
+
+    bool HasMultiDrawIndirect() { return sHasMultiDrawIndirect; }
+    bool HasBaseInstance() { return sHasBaseInstance; }
+    bool HasBufferStorage() { return sHasBufferStorage; }
+    bool HasInvalidateSubdata() { return sHasInvalidateSubdata; }
+
+} // namespace GLExtensions
@@ -0,0 +1,342 @@
+// src/GeometryBuffer.cpp
+
+#include "GeometryBuffer.h"
+#include "GLExtensions.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+// --- RangeAllocator ---
+
+void RangeAllocator::Reset(GLuint capacity) {
+    m_FreeBlocks.clear();
+    if (capacity > 0) m_FreeBlocks.push_back({ 0, capacity });
+    m_Capacity = capacity;
+    m_Used = 0;
+}
+
+GLuint RangeAllocator::Allocate(GLuint count) {
+    if (count == 0) return InvalidOffset;
+    for (size_t i = 0; i < m_FreeBlocks.size(); ++i) {
+        Block& block = m_FreeBlocks[i];
+        if (block.Count < count) continue;
+        GLuint offset = block.Offset;
+        block.Offset += count;
+        block.Count -= count;
+        if (block.Count == 0) m_FreeBlocks.erase(m_FreeBlocks.begin() + i);
+        m_Used += count;
+        return offset;
+    }
+    return InvalidOffset;
+}
+
+void RangeAllocator::Free(GLuint offset, GLuint count) {
+    if (count == 0) return;
+    auto it = std::lower_bound(m_FreeBlocks.begin(), m_FreeBlocks.end(), offset,
+                               [](const Block& b, GLuint o) { return b.Offset < o; });
+    it = m_FreeBlocks.insert(it, { offset, count });
+    m_Used -= count;
+
+    // Coalesce with the next block, then with the previous one
+    auto next = it + 1;
+    if (next != m_FreeBlocks.end() && it->Offset + it->Count == next->Offset) {
+        it->Count += next->Count;
+        m_FreeBlocks.erase(next);
+    }
+    if (it != m_FreeBlocks.begin()) {
+        auto prev = it - 1;
+        if (prev->Offset + prev->Count == it->Offset) {
+            prev->Count += it->Count;
+            m_FreeBlocks.erase(it);
+        }
+    }
+}
+
+void RangeAllocator::Grow(GLuint newCapacity) {
+    if (newCapacity <= m_Capacity) return;
+    GLuint added = newCapacity - m_Capacity;
+    GLuint oldCapacity = m_Capacity;
+    m_Capacity = newCapacity;
+    m_Used += added; // Free() subtracts it again
+    Free(oldCapacity, added);
+}
+
+// --- GeometryBuffer ---
+
+GeometryBuffer::GeometryBuffer() {}
+
+GeometryBuffer::~GeometryBuffer() {
+    Shutdown();
+}
+
+bool GeometryBuffer::Initialize(GLuint vertexCapacity, GLuint indexCapacity) {
+    if (m_VAO != 0) {
+        std::cerr << "WARN::GEOMETRY::Buffer already initialized." << std::endl;
+        return true;
+    }
+    if (vertexCapacity == 0 || indexCapacity == 0) {
+        std::cerr << "ERROR::GEOMETRY::Capacities must be non-zero." << std::endl;
+        return false;
+    }
+
+    glGenVertexArrays(1, &m_VAO);
+    glGenBuffers(1, &m_VBO);
+    glGenBuffers(1, &m_EBO);
+    glGenBuffers(1, &m_IndirectBuffer);
+    glGenVertexArrays(1, &m_PositionVAO);
+    glGenBuffers(1, &m_PositionVBO);
+
+    glBindVertexArray(m_VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexCapacity) * sizeof(Vertex), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indexCapacity) * sizeof(unsigned int), nullptr, GL_STATIC_DRAW);
+    SetupVertexAttributes();
+
+    glBindVertexArray(m_PositionVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_PositionVBO);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexCapacity) * PositionStride, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    SetupPositionAttributes();
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_VertexAllocator.Reset(vertexCapacity);
+    m_IndexAllocator.Reset(indexCapacity);
+
+    std::cout << "INFO::GEOMETRY::Shared buffer created (VAO: " << m_VAO << ", Verts: " << vertexCapacity
+              << ", Indices: " << indexCapacity << ", MDI: " << (SupportsMultiDrawIndirect() ? "yes" : "no") << ")" << std::endl;
+    return true;
+}
+
+void GeometryBuffer::Shutdown() {
+    if (m_IndirectBuffer != 0) { glDeleteBuffers(1, &m_IndirectBuffer); m_IndirectBuffer = 0; }
+    if (m_VBO != 0) { glDeleteBuffers(1, &m_VBO); m_VBO = 0; }
+    if (m_EBO != 0) { glDeleteBuffers(1, &m_EBO); m_EBO = 0; }
+    if (m_VAO != 0) { glDeleteVertexArrays(1, &m_VAO); m_VAO = 0; }
+    if (m_PositionVBO != 0) { glDeleteBuffers(1, &m_PositionVBO); m_PositionVBO = 0; }
+    if (m_PositionVAO != 0) { glDeleteVertexArrays(1, &m_PositionVAO); m_PositionVAO = 0; }
+    m_VertexAllocator.Reset(0);
+    m_IndexAllocator.Reset(0);
+    m_Generation++;
+}
+
+// Same layout Mesh::SetupMesh used to configure per mesh; expects the VAO and VBO bound.
+void GeometryBuffer::SetupVertexAttributes() const {
+    // Position attribute (location = 0)
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Position));
+    // Normal attribute (location = 1)
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
+    // Texture coordinate attribute (location = 2)
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
+}
+
+// Expects the position VAO and position VBO bound.
+void GeometryBuffer::SetupPositionAttributes() const {
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, PositionStride, (void*)0);
+}
+
+bool GeometryBuffer::Allocate(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, GeometryRange& outRange) {
+    if (!Reserve(static_cast<GLuint>(vertices.size()), static_cast<GLuint>(indices.size()), outRange)) return false;
+    UpdateVertices(outRange, 0, vertices.data(), outRange.VertexCount, false);
+    UpdateIndices(outRange, 0, indices.data(), static_cast<GLuint>(outRange.IndexCount), false);
+    return true;
+}
+
+bool GeometryBuffer::Reserve(GLuint vertexCount, GLuint indexCount, GeometryRange& outRange) {
+    outRange = GeometryRange{};
+    if (m_VAO == 0) { std::cerr << "ERROR::GEOMETRY::Allocate called before Initialize." << std::endl; return false; }
+    if (vertexCount == 0 || indexCount == 0) { std::cerr << "ERROR::GEOMETRY::Cannot allocate empty geometry." << std::endl; return false; }
+
+    GLuint vertexOffset = m_VertexAllocator.Allocate(vertexCount);
+    if (vertexOffset == RangeAllocator::InvalidOffset) {
+        if (!GrowVertexBuffer(m_VertexAllocator.GetCapacity() + vertexCount)) return false;
+        vertexOffset = m_VertexAllocator.Allocate(vertexCount);
+    }
+    GLuint indexOffset = m_IndexAllocator.Allocate(indexCount);
+    if (indexOffset == RangeAllocator::InvalidOffset) {
+        if (!GrowIndexBuffer(m_IndexAllocator.GetCapacity() + indexCount)) { m_VertexAllocator.Free(vertexOffset, vertexCount); return false; }
+        indexOffset = m_IndexAllocator.Allocate(indexCount);
+    }
+
+    outRange.BaseVertex = static_cast<GLint>(vertexOffset);
+    outRange.VertexCount = vertexCount;
+    outRange.FirstIndex = indexOffset;
+    outRange.IndexCount = static_cast<GLsizei>(indexCount);
+    return true;
+}
+
+void GeometryBuffer::Free(const GeometryRange& range) {
+    if (!range.IsValid() || m_VAO == 0) return;
+    m_VertexAllocator.Free(static_cast<GLuint>(range.BaseVertex), range.VertexCount);
+    m_IndexAllocator.Free(range.FirstIndex, static_cast<GLuint>(range.IndexCount));
+}
+
+bool GeometryBuffer::UpdateVertices(const GeometryRange& range, GLuint first, const Vertex* vertices, GLuint count, bool unsynchronized) {
+    if (count == 0) return true;
+    if (m_VAO == 0 || !vertices || first + count > range.VertexCount) {
+        std::cerr << "ERROR::GEOMETRY::Vertex update outside its range." << std::endl;
+        return false;
+    }
+    const GLintptr vertex = static_cast<GLintptr>(range.BaseVertex) + first;
+    Write(m_VBO, vertex * sizeof(Vertex), static_cast<GLsizeiptr>(count) * sizeof(Vertex), vertices, unsynchronized);
+    m_PositionScratch.resize(static_cast<size_t>(count) * 3);
+    for (GLuint i = 0; i < count; ++i) std::memcpy(&m_PositionScratch[static_cast<size_t>(i) * 3], vertices[i].Position, PositionStride);
+    Write(m_PositionVBO, vertex * PositionStride, static_cast<GLsizeiptr>(count) * PositionStride, m_PositionScratch.data(), unsynchronized);
+    return true;
+}
+
+bool GeometryBuffer::UpdateIndices(const GeometryRange& range, GLuint first, const unsigned int* indices, GLuint count, bool unsynchronized) {
+    if (count == 0) return true;
+    if (m_VAO == 0 || !indices || first + count > static_cast<GLuint>(range.IndexCount)) {
+        std::cerr << "ERROR::GEOMETRY::Index update outside its range." << std::endl;
+        return false;
+    }
+    const GLintptr index = static_cast<GLintptr>(range.FirstIndex) + first;
+    Write(m_EBO, index * sizeof(unsigned int), static_cast<GLsizeiptr>(count) * sizeof(unsigned int), indices, unsynchronized);
+    return true;
+}
+
+// Through the copy-write target, so the currently bound VAO's element binding is left alone.
+void GeometryBuffer::Write(GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data, bool unsynchronized) {
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    void* mapped = nullptr;
+    if (unsynchronized) {
+        mapped = glMapBufferRange(GL_COPY_WRITE_BUFFER, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    }
+    if (mapped) {
+        std::memcpy(mapped, data, static_cast<size_t>(size));
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    } else {
+        glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+GLuint GeometryBuffer::ResizeBuffer(GLuint oldBuffer, GLsizeiptr oldSize, GLsizeiptr newSize) {
+    GLuint newBuffer = 0;
+    glGenBuffers(1, &newBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, newSize, nullptr, GL_STATIC_DRAW);
+    if (oldSize > 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, oldBuffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, oldSize);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glDeleteBuffers(1, &oldBuffer);
+    return newBuffer;
+}
+
+bool GeometryBuffer::GrowVertexBuffer(GLuint minCapacity) {
+    GLuint oldCapacity = m_VertexAllocator.GetCapacity();
+    GLuint newCapacity = std::max(minCapacity, oldCapacity * 2);
+    m_VBO = ResizeBuffer(m_VBO, static_cast<GLsizeiptr>(oldCapacity) * sizeof(Vertex), static_cast<GLsizeiptr>(newCapacity) * sizeof(Vertex));
+    m_PositionVBO = ResizeBuffer(m_PositionVBO, static_cast<GLsizeiptr>(oldCapacity) * PositionStride, static_cast<GLsizeiptr>(newCapacity) * PositionStride);
+
+    // Attribute pointers capture the buffer, so repoint them (restoring whatever VAO was bound)
+    GLint previousVAO = 0;
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &previousVAO);
+    glBindVertexArray(m_VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    SetupVertexAttributes();
+    glBindVertexArray(m_PositionVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_PositionVBO);
+    SetupPositionAttributes();
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(static_cast<GLuint>(previousVAO));
+
+    m_VertexAllocator.Grow(newCapacity);
+    m_Generation++;
+    std::cout << "INFO::GEOMETRY::Vertex buffer grown to " << newCapacity << " vertices." << std::endl;
+    return m_VBO != 0 && m_PositionVBO != 0;
+}
+
+bool GeometryBuffer::GrowIndexBuffer(GLuint minCapacity) {
+    GLuint oldCapacity = m_IndexAllocator.GetCapacity();
+    GLuint newCapacity = std::max(minCapacity, oldCapacity * 2);
+    m_EBO = ResizeBuffer(m_EBO, static_cast<GLsizeiptr>(oldCapacity) * sizeof(unsigned int), static_cast<GLsizeiptr>(newCapacity) * sizeof(unsigned int));
+
+    GLint previousVAO = 0;
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &previousVAO);
+    glBindVertexArray(m_VAO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    glBindVertexArray(m_PositionVAO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    glBindVertexArray(static_cast<GLuint>(previousVAO));
+
+    m_IndexAllocator.Grow(newCapacity);
+    m_Generation++;
+    std::cout << "INFO::GEOMETRY::Index buffer grown to " << newCapacity << " indices." << std::endl;
+    return m_EBO != 0;
+}
+
+void GeometryBuffer::Bind() const {
+    if (m_VAO != 0) {
+        glBindVertexArray(m_VAO);
+    } else {
+        std::cerr << "WARN::GEOMETRY::Attempting to bind uninitialized geometry buffer." << std::endl;
+    }
+}
+
+void GeometryBuffer::BindPositionOnly() const {
+    if (m_PositionVAO != 0) {
+        glBindVertexArray(m_PositionVAO);
+    } else {
+        std::cerr << "WARN::GEOMETRY::Attempting to bind uninitialized geometry buffer." << std::endl;
+    }
+}
+
+void GeometryBuffer::Unbind() const {
+    glBindVertexArray(0);
+}
+
+void GeometryBuffer::Draw(const GeometryRange& range) const {
+    if (!range.IsValid()) {
+        std::cerr << "WARN::GEOMETRY::Attempting to draw an empty range." << std::endl;
+        return;
+    }
+    glDrawElementsBaseVertex(GL_TRIANGLES, range.IndexCount, GL_UNSIGNED_INT,
+                             (void*)(static_cast<size_t>(range.FirstIndex) * sizeof(unsigned int)),
+                             range.BaseVertex);
+}
+
+bool GeometryBuffer::SupportsMultiDrawIndirect() const {
+    return GLExtensions::HasMultiDrawIndirect();
+}
+
+void GeometryBuffer::DrawBatch(const std::vector<DrawElementsIndirectCommand>& commands) {
+    if (commands.empty()) return;
+
+    if (SupportsMultiDrawIndirect()) {
+        // Orphan and refill; the batch is consumed by this single call
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_IndirectBuffer);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, commands.size() * sizeof(DrawElementsIndirectCommand), commands.data(), GL_STREAM_DRAW);
+        GLExtensions::MultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr,
+                                                static_cast<GLsizei>(commands.size()), 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        return;
+    }
+
+    // GL 3.3/4.1 fallback: same VAO, one base-vertex draw per command (BaseInstance is not honoured)
+    for (const DrawElementsIndirectCommand& cmd : commands) {
+        glDrawElementsInstancedBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(cmd.Count), GL_UNSIGNED_INT,
+                                          (void*)(static_cast<size_t>(cmd.FirstIndex) * sizeof(unsigned int)),
+                                          static_cast<GLsizei>(cmd.InstanceCount), cmd.BaseVertex);
+    }
+}
+
+DrawElementsIndirectCommand GeometryBuffer::MakeCommand(const GeometryRange& range, GLuint instanceCount, GLuint baseInstance) {
+    DrawElementsIndirectCommand cmd;
+    cmd.Count = static_cast<GLuint>(range.IndexCount);
+    cmd.InstanceCount = instanceCount;
+    cmd.FirstIndex = range.FirstIndex;
+    cmd.BaseVertex = range.BaseVertex;
+    cmd.BaseInstance = baseInstance;
+    return cmd;
+}
@@ -0,0 +1,303 @@
+// src/GpuProfiler.cpp
+
+#include "GpuProfiler.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+    // GPU and CPU clocks drift apart slowly; re-measure their offset every this many frames
+    const uint64_t CALIBRATION_INTERVAL = 256;
+
+    double Percentile(std::vector<float>& sorted, double fraction) {
+        if (sorted.empty()) return 0.0;
+        size_t index = static_cast<size_t>(fraction * double(sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+}
+
+GpuProfiler::GpuProfiler() {}
+
+GpuProfiler::~GpuProfiler() {
+    Shutdown();
+}
+
+bool GpuProfiler::Initialize() {
+    GLint counterBits = 0;
+    glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &counterBits);
+    if (counterBits == 0) {
+        std::cerr << "ERROR::GPU_PROFILER::GL_TIMESTAMP queries are not supported." << std::endl;
+        return false;
+    }
+    m_Frames.resize(FrameRingSize);
+    for (FrameRecord& frame : m_Frames) {
+        glGenQueries(MaxScopesPerFrame * 2, frame.Queries);
+        frame.Scopes.reserve(MaxScopesPerFrame);
+    }
+    Calibrate();
+    std::cout << "INFO::GPU_PROFILER::Initialized (" << FrameRingSize << " frames in flight, " << counterBits << "-bit timestamps)." << std::endl;
+    return true;
+}
+
+void GpuProfiler::Shutdown() {
+    for (FrameRecord& frame : m_Frames) glDeleteQueries(MaxScopesPerFrame * 2, frame.Queries);
+    m_Frames.clear();
+    m_Current = nullptr;
+    m_OpenScopes.clear();
+}
+
+int64_t GpuProfiler::CpuNow() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void GpuProfiler::Calibrate() {
+    GLint64 gpuNow = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    m_GpuToCpuOffset = CpuNow() - static_cast<int64_t>(gpuNow);
+}
+
+void GpuProfiler::BeginFrame() {
+    if (!IsInitialized()) return;
+    if (m_Current) EndFrame();
+    ++m_FrameIndex;
+    if (m_FrameIndex % CALIBRATION_INTERVAL == 1) Calibrate();
+
+    // Timestamps complete in submission order, so resolve oldest first and stop at the first miss
+    for (uint64_t age = FrameRingSize - 1; age >= 1; --age) {
+        if (m_FrameIndex <= age) continue;
+        FrameRecord& older = m_Frames[(m_FrameIndex - age) % FrameRingSize];
+        if (older.Pending && older.FrameIndex == m_FrameIndex - age && !Resolve(older)) break;
+    }
+
+    FrameRecord& frame = m_Frames[m_FrameIndex % FrameRingSize];
+    if (frame.Pending) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_FrameStats.Dropped++;
+    }
+    frame.Pending = false;
+    frame.UsedQueries = 0;
+    frame.Scopes.clear();
+    frame.FrameIndex = m_FrameIndex;
+    frame.GpuToCpuOffset = m_GpuToCpuOffset;
+    m_Current = &frame;
+    m_OpenScopes.clear();
+}
+
+void GpuProfiler::EndFrame() {
+    if (!m_Current) return;
+    while (!m_OpenScopes.empty()) EndScope();
+    m_Current->Pending = m_Current->UsedQueries > 0;
+    m_Current = nullptr;
+}
+
+void GpuProfiler::BeginScope(const char* name) {
+    if (!m_Current) return;
+    int reservedEnds = 0; // Open scopes still need their end query
+    for (int open : m_OpenScopes) reservedEnds += (open >= 0) ? 1 : 0;
+    if (m_Current->UsedQueries + reservedEnds + 2 > MaxScopesPerFrame * 2) {
+        m_OpenScopes.push_back(-1); // Keeps EndScope balanced; the scope just isn't timed
+        return;
+    }
+    ScopeRecord scope;
+    scope.Name = name;
+    scope.Depth = static_cast<int>(m_OpenScopes.size());
+    scope.BeginQuery = m_Current->UsedQueries++;
+    scope.EndQuery = -1;
+    scope.CpuBegin = CpuNow();
+    scope.CpuEnd = scope.CpuBegin;
+    glQueryCounter(m_Current->Queries[scope.BeginQuery], GL_TIMESTAMP);
+    m_OpenScopes.push_back(static_cast<int>(m_Current->Scopes.size()));
+    m_Current->Scopes.push_back(scope);
+}
+
+void GpuProfiler::EndScope() {
+    if (!m_Current || m_OpenScopes.empty()) return;
+    const int index = m_OpenScopes.back();
+    m_OpenScopes.pop_back();
+    if (index < 0) return;
+    ScopeRecord& scope = m_Current->Scopes[index];
+    scope.EndQuery = m_Current->UsedQueries++;
+    glQueryCounter(m_Current->Queries[scope.EndQuery], GL_TIMESTAMP);
+    scope.CpuEnd = CpuNow();
+}
+
+bool GpuProfiler::Resolve(FrameRecord& frame) {
+    GLint available = 0;
+    glGetQueryObjectiv(frame.Queries[frame.UsedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return false;
+
+    GLuint64 timestamps[MaxScopesPerFrame * 2];
+    for (int i = 0; i < frame.UsedQueries; ++i) glGetQueryObjectui64v(frame.Queries[i], GL_QUERY_RESULT, &timestamps[i]);
+    frame.Pending = false;
+
+    GLuint64 gpuFirst = ~GLuint64(0), gpuLast = 0;
+    int64_t cpuFirst = INT64_MAX, cpuLast = 0;
+    for (const ScopeRecord& scope : frame.Scopes) {
+        gpuFirst = std::min(gpuFirst, timestamps[scope.BeginQuery]);
+        gpuLast = std::max(gpuLast, timestamps[scope.EndQuery]);
+        cpuFirst = std::min(cpuFirst, scope.CpuBegin);
+        cpuLast = std::max(cpuLast, scope.CpuEnd);
+    }
+
+#ifdef ENGINE_ENABLE_PROFILER
+    // Feed the CPU profiler's timeline too, in end order like its other tracks
+    static Profiler::Track* gpuTrack = Profiler::CreateTrack("GPU");
+    int order[MaxScopesPerFrame];
+    const int scopeCount = static_cast<int>(frame.Scopes.size());
+    for (int i = 0; i < scopeCount; ++i) order[i] = i;
+    std::sort(order, order + scopeCount, [&](int a, int b) { return frame.Scopes[a].EndQuery < frame.Scopes[b].EndQuery; });
+    for (int i = 0; i < scopeCount; ++i) {
+        const ScopeRecord& scope = frame.Scopes[order[i]];
+        const int64_t begin = static_cast<int64_t>(timestamps[scope.BeginQuery]) + frame.GpuToCpuOffset;
+        const int64_t end = static_cast<int64_t>(std::max(timestamps[scope.EndQuery], timestamps[scope.BeginQuery])) + frame.GpuToCpuOffset;
+        Profiler::RecordEvent(gpuTrack, scope.Name, static_cast<uint32_t>(scope.Depth), begin, end);
+    }
+#endif
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_LastTopLevel.clear();
+    for (const ScopeRecord& scope : frame.Scopes) {
+        const GLuint64 gpuBegin = timestamps[scope.BeginQuery];
+        const GLuint64 gpuEnd = std::max(timestamps[scope.EndQuery], gpuBegin);
+        if (scope.Depth == 0) m_LastTopLevel.emplace_back(scope.Name, (gpuEnd - gpuBegin) * 1e-6);
+        ScopeHistory& history = FindHistory(scope.Name, scope.Depth);
+        history.Gpu[history.Next] = static_cast<float>((gpuEnd - gpuBegin) * 1e-6);
+        history.Cpu[history.Next] = static_cast<float>((scope.CpuEnd - scope.CpuBegin) * 1e-6);
+        history.Next = (history.Next + 1) % HistorySize;
+        history.Count = std::min(history.Count + 1, HistorySize);
+        history.GpuStart = (gpuBegin - gpuFirst) * 1e-6;
+        history.CpuStart = (scope.CpuBegin - cpuFirst) * 1e-6;
+
+        if (m_CaptureRemaining > 0) {
+            m_Capture.push_back(TraceEvent{ scope.Name, scope.CpuBegin, scope.CpuEnd - scope.CpuBegin, 0 });
+            m_Capture.push_back(TraceEvent{ scope.Name, static_cast<int64_t>(gpuBegin) + frame.GpuToCpuOffset, static_cast<int64_t>(gpuEnd - gpuBegin), 1 });
+        }
+    }
+    m_FrameStats.Resolved++;
+    m_FrameStats.LatencyFrames = static_cast<uint32_t>(m_FrameIndex - frame.FrameIndex);
+    m_FrameStats.GpuMilliseconds = (gpuLast - gpuFirst) * 1e-6;
+    m_FrameStats.CpuMilliseconds = (cpuLast - cpuFirst) * 1e-6;
+    if (m_KeepFrameTimes) {
+        FrameTime time;
+        time.Frame = frame.FrameIndex;
+        time.GpuMilliseconds = m_FrameStats.GpuMilliseconds;
+        for (const ScopeRecord& scope : frame.Scopes) {
+            const GLuint64 gpuBegin = timestamps[scope.BeginQuery];
+            time.Scopes.emplace_back(scope.Name, (std::max(timestamps[scope.EndQuery], gpuBegin) - gpuBegin) * 1e-6);
+        }
+        m_FrameTimes.push_back(std::move(time));
+    }
+    if (m_CaptureRemaining > 0 && --m_CaptureRemaining == 0) WriteCapture();
+    return true;
+}
+
+GpuProfiler::ScopeHistory& GpuProfiler::FindHistory(const char* name, int depth) {
+    for (ScopeHistory& history : m_History) {
+        if (history.Name == name && history.Depth == depth) return history;
+    }
+    m_History.emplace_back();
+    m_History.back().Name = name;
+    m_History.back().Depth = depth;
+    return m_History.back();
+}
+
+void GpuProfiler::GetStats(std::vector<ScopeStats>& scopes, FrameStats& frame) const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    scopes.clear();
+    std::vector<float> samples;
+    for (const ScopeHistory& history : m_History) {
+        ScopeStats stats;
+        stats.Name = history.Name;
+        stats.Depth = history.Depth;
+        stats.GpuStart = history.GpuStart;
+        stats.CpuStart = history.CpuStart;
+        if (history.Count > 0) {
+            const int last = (history.Next + HistorySize - 1) % HistorySize;
+            stats.GpuLast = history.Gpu[last];
+            stats.CpuLast = history.Cpu[last];
+
+            samples.assign(history.Gpu, history.Gpu + history.Count); // Order doesn't matter past this point
+            double sum = 0.0;
+            for (float sample : samples) sum += sample;
+            stats.GpuAverage = sum / history.Count;
+            std::sort(samples.begin(), samples.end());
+            stats.GpuP50 = Percentile(samples, 0.50);
+            stats.GpuP95 = Percentile(samples, 0.95);
+            stats.GpuP99 = Percentile(samples, 0.99);
+
+            samples.assign(history.Cpu, history.Cpu + history.Count);
+            sum = 0.0;
+            for (float sample : samples) sum += sample;
+            stats.CpuAverage = sum / history.Count;
+            std::sort(samples.begin(), samples.end());
+            stats.CpuP95 = Percentile(samples, 0.95);
+        }
+        scopes.push_back(stats);
+    }
+    frame = m_FrameStats;
+}
+
+GpuProfiler::FrameStats GpuProfiler::GetFrameStats() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_FrameStats;
+}
+
+double GpuProfiler::GetLastBusyMilliseconds(const char* excludedScope) const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    double busy = 0.0;
+    for (const auto& scope : m_LastTopLevel) {
+        if (!excludedScope || std::strcmp(scope.first, excludedScope) != 0) busy += scope.second;
+    }
+    return busy;
+}
+
+void GpuProfiler::SetKeepFrameTimes(bool keep) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_KeepFrameTimes = keep;
+    if (!keep) m_FrameTimes.clear();
+}
+
+void GpuProfiler::TakeFrameTimes(std::vector<FrameTime>& out) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    out.insert(out.end(), std::make_move_iterator(m_FrameTimes.begin()), std::make_move_iterator(m_FrameTimes.end()));
+    m_FrameTimes.clear();
+}
+
+void GpuProfiler::RequestCapture(int frameCount, const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Capture.clear();
+    m_CapturePath = path;
+    m_CaptureRemaining = std::max(frameCount, 1);
+}
+
+bool GpuProfiler::IsCapturing() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_CaptureRemaining > 0;
+}
+
+void GpuProfiler::WriteCapture() {
+    std::ofstream file(m_CapturePath);
+    if (!file) {
+        std::cerr << "ERROR::GPU_PROFILER::Could not open trace file: " << m_CapturePath << std::endl;
+        m_Capture.clear();
+        return;
+    }
+    // Chrome trace event format: complete ("X") events, timestamps and durations in microseconds
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"GL thread (CPU)\"}},\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+    file.setf(std::ios::fixed);
+    file.precision(3);
+    for (const TraceEvent& event : m_Capture) {
+        file << ",\n{\"name\":\"" << event.Name << "\",\"cat\":\"" << (event.Track == 0 ? "cpu" : "gpu")
+             << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << (event.Track + 1)
+             << ",\"ts\":" << event.Start / 1000.0 << ",\"dur\":" << event.Duration / 1000.0 << "}";
+    }
+    file << "\n]}\n";
+    std::cout << "INFO::GPU_PROFILER::Wrote " << m_Capture.size() << " trace events to " << m_CapturePath << std::endl;
+    m_Capture.clear();
+}
@@ -0,0 +1,130 @@
+// src/JobSystem.cpp
+
+#include "JobSystem.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+namespace {
+    thread_local unsigned int tWorkerIndex = 0;
+}
+
+JobSystem::JobSystem(unsigned int threadCount) {
+    if (threadCount == 0) {
+        unsigned int hw = std::thread::hardware_concurrency();
+        threadCount = hw > 1 ? hw - 1 : 0;
+    }
+    m_Threads.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        m_Threads.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+    }
+    std::cout << "INFO::JOBS::Started " << threadCount << " worker thread(s)." << std::endl;
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
+        m_Stopping = true;
+    }
+    m_QueueCondition.notify_all();
+    for (std::thread& thread : m_Threads) {
+        if (thread.joinable()) thread.join();
+    }
+}
+
+unsigned int JobSystem::GetCurrentWorkerIndex() {
+    return tWorkerIndex;
+}
+
+void JobSystem::WorkerLoop(unsigned int workerIndex) {
+    tWorkerIndex = workerIndex;
+#ifdef ENGINE_ENABLE_PROFILER
+    const std::string threadName = "Worker " + std::to_string(workerIndex);
+    PROFILE_THREAD(threadName.c_str());
+#endif
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_QueueMutex);
+            m_QueueCondition.wait(lock, [this] { return m_Stopping || !m_Queue.empty(); });
+            if (m_Stopping && m_Queue.empty()) return;
+            task = std::move(m_Queue.front());
+            m_Queue.pop_front();
+        }
+        {
+            PROFILE_SCOPE("Job");
+            task();
+        }
+        m_InFlight.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+bool JobSystem::TryRunOne() {
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
+        if (m_Queue.empty()) return false;
+        task = std::move(m_Queue.front());
+        m_Queue.pop_front();
+    }
+    {
+        PROFILE_SCOPE("Job");
+        task();
+    }
+    m_InFlight.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void JobSystem::Submit(std::function<void()> task) {
+    m_InFlight.fetch_add(1, std::memory_order_acq_rel);
+    {
+        std::lock_guard<std::mutex> lock(m_QueueMutex);
+        m_Queue.push_back(std::move(task));
+    }
+    m_QueueCondition.notify_one();
+}
+
+void JobSystem::Wait() {
+    while (m_InFlight.load(std::memory_order_acquire) > 0) {
+        if (!TryRunOne()) std::this_thread::yield();
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t minChunkSize, const std::function<void(size_t, size_t, unsigned int)>& fn) {
+    if (count == 0) return;
+    minChunkSize = std::max<size_t>(minChunkSize, 1);
+
+    // Aim for a few chunks per worker so uneven chunks still balance
+    const size_t workers = GetWorkerCount();
+    size_t chunkSize = std::max(minChunkSize, (count + workers * 4 - 1) / (workers * 4));
+    const size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+    if (chunkCount <= 1 || m_Threads.empty()) {
+        fn(0, count, GetCurrentWorkerIndex());
+        return;
+    }
+
+    // Chunks are claimed from a shared counter; the caller helps instead of idling
+    std::atomic<size_t> nextChunk{ 0 };
+    auto runChunks = [&]() {
+        for (;;) {
+            size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunkCount) return;
+            size_t begin = chunk * chunkSize;
+            size_t end = std::min(begin + chunkSize, count);
+            fn(begin, end, GetCurrentWorkerIndex());
+        }
+    };
+
+    const size_t helpers = std::min(m_Threads.size(), chunkCount - 1);
+    std::atomic<size_t> helpersDone{ 0 };
+    for (size_t i = 0; i < helpers; ++i) {
+        Submit([&runChunks, &helpersDone]() { runChunks(); helpersDone.fetch_add(1, std::memory_order_acq_rel); });
+    }
+    runChunks();
+    // Helper tasks reference this stack frame, so every one must have run before returning
+    while (helpersDone.load(std::memory_order_acquire) < helpers) {
+        if (!TryRunOne()) std::this_thread::yield();
+    }
+}
@@ -0,0 +1,162 @@
+// src/LightGrid.cpp
+
+#include "LightGrid.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+    const size_t LIGHT_CHUNK = 64; // Lights per job when computing bounds
+
+    uint32_t ToTile(float ndc, uint32_t tiles) {
+        const float tile = std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(tiles));
+        return static_cast<uint32_t>(std::min(std::max(tile, 0.0f), static_cast<float>(tiles - 1)));
+    }
+
+    bool SphereIntersectsAABB(const glm::vec3& center, float radius, const AABB& box) {
+        const glm::vec3 closest = glm::clamp(center, box.Min, box.Max);
+        const glm::vec3 delta = center - closest;
+        return glm::dot(delta, delta) <= radius * radius;
+    }
+}
+
+LightGrid::LightGrid(uint32_t tilesX, uint32_t tilesY, uint32_t slices)
+    : m_TilesX(std::max(tilesX, 1u)), m_TilesY(std::max(tilesY, 1u)), m_Slices(std::max(slices, 1u)) {
+    m_ClusterLights.resize(GetClusterCount());
+}
+
+// Cluster boxes live in "depth space": view space with z flipped, so depth grows into the screen.
+void LightGrid::UpdateClusterBounds(float xScale, float yScale, float nearPlane, float farPlane) {
+    m_XScale = xScale;
+    m_YScale = yScale;
+    m_Near = nearPlane;
+    m_Far = farPlane;
+    const float logRatio = std::log(farPlane / nearPlane);
+    m_SliceScale = static_cast<float>(m_Slices) / logRatio;
+    m_SliceBias = -static_cast<float>(m_Slices) * std::log(nearPlane) / logRatio;
+
+    m_ClusterBounds.resize(GetClusterCount());
+    for (uint32_t z = 0; z < m_Slices; ++z) {
+        const float depth0 = nearPlane * std::pow(farPlane / nearPlane, static_cast<float>(z) / m_Slices);
+        const float depth1 = nearPlane * std::pow(farPlane / nearPlane, static_cast<float>(z + 1) / m_Slices);
+        for (uint32_t y = 0; y < m_TilesY; ++y) {
+            const float ndcY0 = 2.0f * y / m_TilesY - 1.0f;
+            const float ndcY1 = 2.0f * (y + 1) / m_TilesY - 1.0f;
+            for (uint32_t x = 0; x < m_TilesX; ++x) {
+                const float ndcX0 = 2.0f * x / m_TilesX - 1.0f;
+                const float ndcX1 = 2.0f * (x + 1) / m_TilesX - 1.0f;
+                AABB box;
+                for (float depth : { depth0, depth1 }) {
+                    box.Expand(glm::vec3(ndcX0 * depth / xScale, ndcY0 * depth / yScale, depth));
+                    box.Expand(glm::vec3(ndcX1 * depth / xScale, ndcY1 * depth / yScale, depth));
+                }
+                m_ClusterBounds[(z * m_TilesY + y) * m_TilesX + x] = box;
+            }
+        }
+    }
+}
+
+uint32_t LightGrid::GetSlice(float depth) const {
+    const float slice = std::floor(std::log(std::max(depth, m_Near)) * m_SliceScale + m_SliceBias);
+    return static_cast<uint32_t>(std::min(std::max(slice, 0.0f), static_cast<float>(m_Slices - 1)));
+}
+
+void LightGrid::Build(const glm::mat4& view, const glm::mat4& projection, const std::vector<Light>& lights, ClusteredLightData& out, JobSystem* jobs) {
+    PROFILE_SCOPE("LightGrid::Build");
+    auto start = std::chrono::steady_clock::now();
+    m_Stats = Stats{};
+    m_Stats.Lights = static_cast<uint32_t>(lights.size());
+
+    // glm::perspective: [2][2] = -(f+n)/(f-n), [3][2] = -2fn/(f-n)
+    const float nearPlane = projection[3][2] / (projection[2][2] - 1.0f);
+    const float farPlane = projection[3][2] / (projection[2][2] + 1.0f);
+    if (projection[0][0] != m_XScale || projection[1][1] != m_YScale || nearPlane != m_Near || farPlane != m_Far) {
+        UpdateClusterBounds(projection[0][0], projection[1][1], nearPlane, farPlane);
+    }
+
+    // Per light: view-space sphere and the range of clusters it can touch. Also packs the light for upload.
+    m_LightBounds.resize(lights.size());
+    out.Lights.resize(lights.size() * ClusteredLightData::TexelsPerLight);
+    auto bound = [&](size_t begin, size_t end, unsigned int) {
+        for (size_t i = begin; i < end; ++i) {
+            const Light& light = lights[i];
+            glm::vec4* texels = &out.Lights[i * ClusteredLightData::TexelsPerLight];
+            texels[0] = glm::vec4(light.Position, light.Range);
+            texels[1] = glm::vec4(light.Color * light.Intensity, light.SpotOuterCos);
+            texels[2] = glm::vec4(glm::normalize(light.Direction), light.SpotInnerCos);
+
+            LightBounds& bounds = m_LightBounds[i];
+            const glm::vec3 viewPos = glm::vec3(view * glm::vec4(light.Position, 1.0f));
+            bounds.Center = glm::vec3(viewPos.x, viewPos.y, -viewPos.z);
+            bounds.Radius = light.Range;
+            const float depthMin = std::max(bounds.Center.z - light.Range, m_Near);
+            const float depthMax = std::min(bounds.Center.z + light.Range, m_Far);
+            bounds.Visible = depthMin <= depthMax;
+            if (!bounds.Visible) continue;
+
+            // x/d and y/d are extreme at the nearest or farthest depth of the sphere's box
+            const float xMin = bounds.Center.x - light.Range, xMax = bounds.Center.x + light.Range;
+            const float yMin = bounds.Center.y - light.Range, yMax = bounds.Center.y + light.Range;
+            const float ndcX0 = std::min(xMin / depthMin, xMin / depthMax) * m_XScale;
+            const float ndcX1 = std::max(xMax / depthMin, xMax / depthMax) * m_XScale;
+            const float ndcY0 = std::min(yMin / depthMin, yMin / depthMax) * m_YScale;
+            const float ndcY1 = std::max(yMax / depthMin, yMax / depthMax) * m_YScale;
+            if (ndcX1 < -1.0f || ndcX0 > 1.0f || ndcY1 < -1.0f || ndcY0 > 1.0f) { bounds.Visible = false; continue; }
+            bounds.TileX0 = ToTile(ndcX0, m_TilesX);
+            bounds.TileX1 = ToTile(ndcX1, m_TilesX);
+            bounds.TileY0 = ToTile(ndcY0, m_TilesY);
+            bounds.TileY1 = ToTile(ndcY1, m_TilesY);
+            bounds.Slice0 = GetSlice(depthMin);
+            bounds.Slice1 = GetSlice(depthMax);
+        }
+    };
+    if (jobs) jobs->ParallelFor(lights.size(), LIGHT_CHUNK, bound);
+    else bound(0, lights.size(), 0);
+
+    // Each slice's clusters are only written by the job binning that slice
+    auto binSlices = [&](size_t begin, size_t end, unsigned int) {
+        for (size_t slice = begin; slice < end; ++slice) BinSlice(static_cast<uint32_t>(slice), lights);
+    };
+    if (jobs) jobs->ParallelFor(m_Slices, 1, binSlices);
+    else binSlices(0, m_Slices, 0);
+
+    // Flatten into offset/count pairs and one index list
+    const uint32_t clusterCount = GetClusterCount();
+    out.Clusters.resize(static_cast<size_t>(clusterCount) * 2);
+    out.Indices.clear();
+    for (uint32_t cluster = 0; cluster < clusterCount; ++cluster) {
+        const std::vector<uint32_t>& indices = m_ClusterLights[cluster];
+        const uint32_t count = static_cast<uint32_t>(indices.size());
+        out.Clusters[cluster * 2] = static_cast<uint32_t>(out.Indices.size());
+        out.Clusters[cluster * 2 + 1] = count;
+        out.Indices.insert(out.Indices.end(), indices.begin(), indices.end());
+        m_Stats.MaxPerCluster = std::max(m_Stats.MaxPerCluster, count);
+        if (count > 0) m_Stats.OccupiedClusters++;
+    }
+    for (const LightBounds& bounds : m_LightBounds) m_Stats.VisibleLights += bounds.Visible ? 1 : 0;
+    m_Stats.Assignments = static_cast<uint32_t>(out.Indices.size());
+    out.Dimensions = glm::uvec3(m_TilesX, m_TilesY, m_Slices);
+    out.SliceScale = m_SliceScale;
+    out.SliceBias = m_SliceBias;
+    m_Stats.Milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void LightGrid::BinSlice(uint32_t slice, const std::vector<Light>& lights) {
+    const uint32_t sliceBase = slice * m_TilesX * m_TilesY;
+    for (uint32_t i = 0; i < m_TilesX * m_TilesY; ++i) m_ClusterLights[sliceBase + i].clear();
+    for (size_t i = 0; i < lights.size(); ++i) {
+        const LightBounds& bounds = m_LightBounds[i];
+        if (!bounds.Visible || slice < bounds.Slice0 || slice > bounds.Slice1) continue;
+        for (uint32_t y = bounds.TileY0; y <= bounds.TileY1; ++y) {
+            for (uint32_t x = bounds.TileX0; x <= bounds.TileX1; ++x) {
+                const uint32_t cluster = sliceBase + y * m_TilesX + x;
+                if (SphereIntersectsAABB(bounds.Center, bounds.Radius, m_ClusterBounds[cluster])) {
+                    m_ClusterLights[cluster].push_back(static_cast<uint32_t>(i));
+                }
+            }
+        }
+    }
+}
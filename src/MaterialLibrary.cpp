@@ -0,0 +1,82 @@
+// src/MaterialLibrary.cpp
+
+#include "MaterialLibrary.h"
+#include "TextureArray.h"
+#include "Profiler.h"
+#include "stb_image.h"
+
+#include <iostream>
+
+namespace {
+    const int SOLID_COLOR_SIZE = 4; // Texels per side; big enough that filtering never leaves the color
+}
+
+MaterialLibrary::MaterialLibrary() {}
+
+MaterialLibrary::~MaterialLibrary() {}
+
+const Material* MaterialLibrary::AddTexture(const std::string& filePath) {
+    PROFILE_SCOPE("MaterialLibrary::AddTexture");
+    stbi_set_flip_vertically_on_load(true); // Flip UVs for OpenGL convention
+    int width = 0, height = 0, channels = 0;
+    unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &channels, 4); // Arrays are RGBA8 throughout
+    if (!data) {
+        std::cerr << "ERROR::MATERIALS::Failed to load texture file: " << filePath << std::endl;
+        return nullptr;
+    }
+    TexturePacker::Image image;
+    image.Width = width;
+    image.Height = height;
+    image.Pixels.assign(data, data + static_cast<size_t>(width) * height * 4);
+    stbi_image_free(data);
+    std::cout << "INFO::MATERIALS::Loaded texture file: " << filePath << " (" << width << "x" << height << ", " << channels << " channels)" << std::endl;
+    return Add(filePath, std::move(image));
+}
+
+const Material* MaterialLibrary::AddSolidColor(const std::string& name, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    TexturePacker::Image image;
+    image.Width = SOLID_COLOR_SIZE;
+    image.Height = SOLID_COLOR_SIZE;
+    for (int i = 0; i < SOLID_COLOR_SIZE * SOLID_COLOR_SIZE; ++i) image.Pixels.insert(image.Pixels.end(), { r, g, b, a });
+    return Add(name, std::move(image));
+}
+
+const Material* MaterialLibrary::Add(const std::string& name, TexturePacker::Image image) {
+    std::unique_ptr<Material> material = std::make_unique<Material>();
+    material->Name = name;
+    m_Materials.push_back(std::move(material));
+    m_Pending.push_back(std::move(image));
+    return m_Materials.back().get();
+}
+
+bool MaterialLibrary::Build(const TexturePacker::Settings& settings) {
+    if (m_Pending.empty()) return true;
+    PROFILE_SCOPE("MaterialLibrary::Build");
+    TexturePacker::Result layout;
+    if (!TexturePacker::Pack(m_Pending, settings, layout)) return false;
+
+    const size_t arrayBase = m_Arrays.size();
+    for (const TexturePacker::Group& group : layout.Groups) {
+        std::unique_ptr<TextureArray> array = std::make_unique<TextureArray>();
+        if (!array->Create(group.Width, group.Height, group.Layers, group.Pixels.data(), !group.Atlas)) return false;
+        m_Arrays.push_back(std::move(array));
+        m_Stats.Arrays++;
+        if (group.Atlas) m_Stats.AtlasPages += static_cast<uint32_t>(group.Layers);
+        else m_Stats.ArrayLayers += static_cast<uint32_t>(group.Layers);
+        m_Stats.Bytes += group.Pixels.size();
+    }
+
+    const size_t first = m_Materials.size() - m_Pending.size();
+    for (size_t i = 0; i < m_Pending.size(); ++i) {
+        const TexturePacker::Placement& placement = layout.Placements[i];
+        Material& material = *m_Materials[first + i];
+        material.Array = m_Arrays[arrayBase + static_cast<size_t>(placement.Group)].get();
+        material.Layer = placement.Layer;
+        material.UVTransform = placement.UVTransform;
+    }
+    m_Stats.Materials = static_cast<uint32_t>(m_Materials.size());
+    m_Pending.clear();
+    std::cout << "INFO::MATERIALS::" << m_Stats.Materials << " material(s) in " << m_Stats.Arrays << " texture array(s): " << m_Stats.ArrayLayers
+              << " whole-texture layer(s), " << m_Stats.AtlasPages << " atlas page(s), " << m_Stats.Bytes / 1024 << " KiB." << std::endl;
+    return true;
+}
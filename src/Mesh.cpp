@@ -2,95 +2,238 @@
 
 #include "Mesh.h"       // Include the header for this implementation file
 #include <glad/glad.h>  // Include GLAD for OpenGL functions
+#include <algorithm>
 #include <iostream>     // For logging output (optional)
-#include <cstddef>      // For offsetof macro
+#include <utility>
 
-// Constructor: Takes vertex data and indices, initializes index count, calls setup
-Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
+// Constructor: Takes vertex data and indices, sub-allocates them from the shared geometry buffer
+Mesh::Mesh(GeometryBuffer& geometry, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+    : m_Geometry(&geometry) {
     // Basic validation
     if (vertices.empty()) { // Indices can technically be empty for glDrawArrays, but usually not for Mesh class
         std::cerr << "ERROR::MESH::Cannot create mesh with empty vertices." << std::endl;
-        // Initialize members to zero to indicate an invalid state
-        m_VAO = 0; m_VBO = 0; m_EBO = 0; m_IndexCount = 0;
-        return;
+        return; // m_Range stays empty to indicate an invalid state
     }
     // We'll always use indices with this Mesh class design
     if (indices.empty()) {
          std::cerr << "ERROR::MESH::Cannot create mesh with empty indices (use glDrawElements)." << std::endl;
-         m_VAO = 0; m_VBO = 0; m_EBO = 0; m_IndexCount = 0;
          return;
     }
 
-    m_IndexCount = static_cast<GLsizei>(indices.size());
     SetupMesh(vertices, indices); // Call the private setup function
 }
 
-// Destructor: Cleans up OpenGL buffer objects and vertex array object
-Mesh::~Mesh() {
-    // Check if IDs are valid before deleting
-    if (m_VBO != 0) {
-        glDeleteBuffers(1, &m_VBO);
-        // std::cout << "INFO::MESH::Deleted VBO (ID: " << m_VBO << ")" << std::endl; // Optional log
+// Dynamic constructor: Reserves every copy at full capacity, then commits the initial data into the first
+Mesh::Mesh(GeometryBuffer& geometry, GLuint maxVertices, GLuint maxIndices,
+           const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+    : m_Geometry(&geometry), m_MaxVertices(maxVertices), m_MaxIndices(maxIndices) {
+    if (maxVertices == 0 || maxIndices == 0 || vertices.size() > maxVertices || indices.size() > maxIndices) {
+        std::cerr << "ERROR::MESH::Dynamic mesh needs a non-zero capacity that fits its initial data." << std::endl;
+        return;
     }
-    if (m_EBO != 0) {
-        glDeleteBuffers(1, &m_EBO);
-        // std::cout << "INFO::MESH::Deleted EBO (ID: " << m_EBO << ")" << std::endl; // Optional log
+    m_Copies.resize(DynamicCopies);
+    for (Copy& copy : m_Copies) {
+        if (!m_Geometry->Reserve(maxVertices, maxIndices, copy.Allocation)) {
+            std::cerr << "ERROR::MESH::Failed to reserve dynamic geometry." << std::endl;
+            Release();
+            return;
+        }
     }
-    if (m_VAO != 0) {
-        glDeleteVertexArrays(1, &m_VAO);
-        // std::cout << "INFO::MESH::Deleted VAO (ID: " << m_VAO << ")" << std::endl; // Optional log
+    m_Vertices = vertices;
+    m_Indices = indices;
+    MarkVertices(0, static_cast<GLuint>(m_Vertices.size()));
+    MarkIndices(0, static_cast<GLuint>(m_Indices.size()));
+    m_Pending = true;
+    m_Current = DynamicCopies - 1; // The first Commit() lands on copy 0
+    Commit();
+}
+
+// Destructor: Returns the range(s) to the shared buffer (the GL objects belong to the GeometryBuffer)
+Mesh::~Mesh() {
+    Release();
+}
+
+Mesh::Mesh(Mesh&& other) noexcept {
+    *this = std::move(other);
+}
+
+Mesh& Mesh::operator=(Mesh&& other) noexcept {
+    if (this == &other) return *this;
+    Release();
+    m_Geometry = other.m_Geometry;
+    m_Range = other.m_Range;
+    m_Bounds = other.m_Bounds;
+    m_BoundingSphere = other.m_BoundingSphere;
+    m_Copies = std::move(other.m_Copies);
+    m_Vertices = std::move(other.m_Vertices);
+    m_Indices = std::move(other.m_Indices);
+    m_MaxVertices = other.m_MaxVertices;
+    m_MaxIndices = other.m_MaxIndices;
+    m_Current = other.m_Current;
+    m_Pending = other.m_Pending;
+    m_BoundsDirty = other.m_BoundsDirty;
+    m_FixedBounds = other.m_FixedBounds;
+    m_Stats = other.m_Stats;
+    // The ranges and fences belong to this mesh now
+    other.m_Geometry = nullptr;
+    other.m_Range = GeometryRange{};
+    other.m_Copies.clear();
+    other.m_Vertices.clear();
+    other.m_Indices.clear();
+    other.m_Pending = false;
+    return *this;
+}
+
+void Mesh::Release() {
+    if (m_Geometry) {
+        if (m_Copies.empty()) {
+            if (m_Range.IsValid()) m_Geometry->Free(m_Range);
+        } else {
+            for (const Copy& copy : m_Copies) m_Geometry->Free(copy.Allocation);
+        }
+    }
+    for (const Copy& copy : m_Copies) {
+        if (copy.Fence) glDeleteSync(copy.Fence);
     }
+    m_Copies.clear();
+    m_Range = GeometryRange{};
 }
 
-// SetupMesh: Configures the VAO, VBO, EBO, and vertex attributes
+// SetupMesh: Copies vertices/indices into the shared buffers; attribute layout lives in GeometryBuffer
 void Mesh::SetupMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
-    // 1. Create buffers/arrays
-    glGenVertexArrays(1, &m_VAO);
-    glGenBuffers(1, &m_VBO);
-    glGenBuffers(1, &m_EBO);
-
-    // 2. Bind the Vertex Array Object first
-    glBindVertexArray(m_VAO);
-
-    // 3. Bind and load vertex data into Vertex Buffer Object (VBO)
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    // Use vector's size() and data() for buffer size and data pointer
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
-
-    // 4. Bind and load index data into Element Buffer Object (EBO)
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-    // Use vector's size() and data() for buffer size and data pointer
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
-
-    // 5. Set the vertex attribute pointers
-    // Position attribute (location = 0)
-    glEnableVertexAttribArray(0);
-    //                   index, size, type,      normalized, stride,         pointer offset
-    glVertexAttribPointer(0,     3,    GL_FLOAT, GL_FALSE,   sizeof(Vertex), (void*)offsetof(Vertex, Position));
-
-    // Normal attribute (location = 1)
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1,     3,    GL_FLOAT, GL_FALSE,   sizeof(Vertex), (void*)offsetof(Vertex, Normal));
-
-    // Texture coordinate attribute (location = 2)
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2,     2,    GL_FLOAT, GL_FALSE,   sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
-
-    // 6. Unbind the VAO (NOT the EBO, VAO retains the EBO binding)
-    glBindVertexArray(0);
-    // Can also unbind the GL_ARRAY_BUFFER, though the VAO state takes precedence when VAO is bound
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if (!m_Geometry->Allocate(vertices, indices, m_Range)) {
+        std::cerr << "ERROR::MESH::Failed to allocate geometry range." << std::endl;
+        return;
+    }
+    Bounds::Compute(vertices, m_Bounds, m_BoundingSphere); // Used for culling
+    // std::cout << "INFO::MESH::Setup complete (BaseVertex: " << m_Range.BaseVertex << ", Verts: " << vertices.size() << ", Indices: " << m_Range.IndexCount << ")" << std::endl; // Optional log
+}
+
+// UpdateVertices: Changes the CPU copy only; Commit() uploads
+bool Mesh::UpdateVertices(GLuint first, const Vertex* vertices, GLuint count) {
+    if (m_Copies.empty()) {
+        std::cerr << "ERROR::MESH::Only dynamic meshes can be updated." << std::endl;
+        return false;
+    }
+    if (!vertices || first > m_Vertices.size() || first + count > m_MaxVertices) {
+        std::cerr << "ERROR::MESH::Vertex update [" << first << ", " << first + count << ") outside the mesh (" << m_Vertices.size()
+                  << " of " << m_MaxVertices << " vertices)." << std::endl;
+        return false;
+    }
+    if (first + count > m_Vertices.size()) m_Vertices.resize(first + count);
+    std::copy(vertices, vertices + count, m_Vertices.begin() + first);
+    MarkVertices(first, first + count);
+    return true;
+}
+
+bool Mesh::UpdateIndices(GLuint first, const unsigned int* indices, GLuint count) {
+    if (m_Copies.empty()) {
+        std::cerr << "ERROR::MESH::Only dynamic meshes can be updated." << std::endl;
+        return false;
+    }
+    if (!indices || first > m_Indices.size() || first + count > m_MaxIndices) {
+        std::cerr << "ERROR::MESH::Index update [" << first << ", " << first + count << ") outside the mesh (" << m_Indices.size()
+                  << " of " << m_MaxIndices << " indices)." << std::endl;
+        return false;
+    }
+    if (first + count > m_Indices.size()) m_Indices.resize(first + count);
+    std::copy(indices, indices + count, m_Indices.begin() + first);
+    MarkIndices(first, first + count);
+    return true;
+}
 
-    // std::cout << "INFO::MESH::Setup complete (VAO: " << m_VAO << ", Verts: " << vertices.size() << ", Indices: " << m_IndexCount << ")" << std::endl; // Optional log
+bool Mesh::Resize(GLuint vertexCount, GLuint indexCount) {
+    if (m_Copies.empty() || vertexCount > m_MaxVertices || indexCount > m_MaxIndices) {
+        std::cerr << "ERROR::MESH::Cannot resize to " << vertexCount << " vertices, " << indexCount << " indices." << std::endl;
+        return false;
+    }
+    const GLuint oldVertices = GetVertexCount();
+    const GLuint oldIndices = GetIndexCount();
+    m_Vertices.resize(vertexCount, Vertex{});
+    m_Indices.resize(indexCount, 0u);
+    if (vertexCount > oldVertices) MarkVertices(oldVertices, vertexCount);
+    if (indexCount > oldIndices) MarkIndices(oldIndices, indexCount);
+    if (vertexCount != oldVertices) m_BoundsDirty = true;
+    if (vertexCount != oldVertices || indexCount != oldIndices) m_Pending = true; // Drawn counts change even when shrinking
+    return true;
 }
 
-// Bind: Binds the Vertex Array Object for rendering
+void Mesh::MarkVertices(GLuint begin, GLuint end) {
+    if (begin >= end) return;
+    for (Copy& copy : m_Copies) copy.Vertices.Add(begin, end);
+    m_Pending = true;
+    m_BoundsDirty = true;
+}
+
+void Mesh::MarkIndices(GLuint begin, GLuint end) {
+    if (begin >= end) return;
+    for (Copy& copy : m_Copies) copy.Indices.Add(begin, end);
+    m_Pending = true;
+}
+
+// Commit: The next range catches up on everything written since it was last drawn, then becomes the drawn one
+void Mesh::Commit() {
+    if (m_Copies.empty() || !m_Pending) return;
+    Copy& previous = m_Copies[m_Current];
+    m_Current = (m_Current + 1) % static_cast<int>(m_Copies.size());
+    Copy& copy = m_Copies[m_Current];
+
+    // Draws issued so far read the previous range; fence them so it is only rewritten once they are done
+    if (previous.Fence) glDeleteSync(previous.Fence);
+    previous.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    previous.FenceGeneration = m_Geometry->GetGeneration();
+
+    // Only a passed fence proves the GPU is done with the range. Without one it may still be read
+    // by draws of whoever freed it last, or be the target of the copy a buffer reallocation queued.
+    bool unsynchronized = false;
+    if (copy.Fence) {
+        if (copy.FenceGeneration == m_Geometry->GetGeneration()) {
+            const GLenum status = glClientWaitSync(copy.Fence, 0, 0);
+            unsynchronized = (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED);
+        }
+        glDeleteSync(copy.Fence);
+        copy.Fence = nullptr;
+    }
+    if (!unsynchronized) m_Stats.SynchronizedUploads++;
+
+    // Dirty ranges may reach past counts that shrank since
+    uint64_t bytes = 0;
+    const GLuint vertexEnd = std::min(copy.Vertices.End, GetVertexCount());
+    if (copy.Vertices.Begin < vertexEnd) {
+        m_Geometry->UpdateVertices(copy.Allocation, copy.Vertices.Begin, &m_Vertices[copy.Vertices.Begin], vertexEnd - copy.Vertices.Begin, unsynchronized);
+        bytes += static_cast<uint64_t>(vertexEnd - copy.Vertices.Begin) * (sizeof(Vertex) + GeometryBuffer::PositionStride);
+    }
+    const GLuint indexEnd = std::min(copy.Indices.End, GetIndexCount());
+    if (copy.Indices.Begin < indexEnd) {
+        m_Geometry->UpdateIndices(copy.Allocation, copy.Indices.Begin, &m_Indices[copy.Indices.Begin], indexEnd - copy.Indices.Begin, unsynchronized);
+        bytes += static_cast<uint64_t>(indexEnd - copy.Indices.Begin) * sizeof(unsigned int);
+    }
+    copy.Vertices = DirtyRange{};
+    copy.Indices = DirtyRange{};
+
+    m_Range = copy.Allocation;
+    m_Range.VertexCount = GetVertexCount();
+    m_Range.IndexCount = static_cast<GLsizei>(GetIndexCount());
+    if (m_BoundsDirty && !m_FixedBounds && !m_Vertices.empty()) Bounds::Compute(m_Vertices, m_Bounds, m_BoundingSphere);
+    m_BoundsDirty = false;
+    m_Pending = false;
+    m_Stats.Commits++;
+    m_Stats.UploadedBytes += bytes;
+}
+
+void Mesh::SetFixedBounds(const AABB& bounds) {
+    m_Bounds = bounds;
+    m_BoundingSphere.Center = bounds.GetCenter();
+    m_BoundingSphere.Radius = glm::length(bounds.GetExtents());
+    m_FixedBounds = true;
+}
+
+// Bind: Binds the shared VAO (identical for every mesh in the same GeometryBuffer)
 void Mesh::Bind() const {
-    // Only bind if VAO is valid
-    if (m_VAO != 0) {
-        glBindVertexArray(m_VAO);
+    if (m_Geometry && m_Range.IsValid()) {
+        m_Geometry->Bind();
     } else {
-        std::cerr << "WARN::MESH::Attempting to bind invalid mesh VAO." << std::endl;
+        std::cerr << "WARN::MESH::Attempting to bind invalid mesh." << std::endl;
     }
 }
 
@@ -100,18 +243,12 @@ void Mesh::Unbind() const {
     glBindVertexArray(0);
 }
 
-// Draw: Renders the mesh using its indices
+// Draw: Renders the mesh's index range with glDrawElementsBaseVertex
 void Mesh::Draw() const {
-    // Check if VAO and index count are valid before drawing
-    if (m_VAO != 0 && m_IndexCount > 0) {
-        // Assumes VAO is already bound via Mesh::Bind() before calling Draw()
-        // Draw using the indices stored in the EBO bound to the VAO
-        glDrawElements(GL_TRIANGLES,        // Mode
-                       m_IndexCount,        // Count of indices
-                       GL_UNSIGNED_INT,     // Type of indices
-                       0);                  // Offset (usually 0)
+    // Assumes the shared VAO is already bound via Mesh::Bind() before calling Draw()
+    if (m_Geometry && m_Range.IsValid()) {
+        m_Geometry->Draw(m_Range);
     } else {
-        if (m_VAO == 0) std::cerr << "WARN::MESH::Attempting to draw invalid mesh VAO." << std::endl;
-        if (m_IndexCount == 0) std::cerr << "WARN::MESH::Attempting to draw mesh with zero indices." << std::endl;
+        std::cerr << "WARN::MESH::Attempting to draw invalid mesh." << std::endl;
     }
-}
\ No newline at end of file
+}
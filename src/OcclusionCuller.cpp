@@ -0,0 +1,430 @@
+// src/OcclusionCuller.cpp
+
+#include "OcclusionCuller.h"
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <unordered_map>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define OCCLUSION_CULLER_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define OCCLUSION_CULLER_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define OCCLUSION_CULLER_NEON 1
+#endif
+
+namespace {
+    const uint32_t FULL_TILE_MASK = 0xFFFFFFFFu;
+    const size_t PARALLEL_SETUP_MIN_TRIANGLES = 1024;
+    const size_t PARALLEL_TEST_MIN_OBJECTS = 256;
+
+    double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+bool OcclusionCuller::Initialize(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        std::cerr << "ERROR::OCCLUSION::Invalid depth buffer size " << width << "x" << height << std::endl;
+        return false;
+    }
+    m_TilesX = (width + TileWidth - 1) / TileWidth;
+    m_TilesY = (height + TileHeight - 1) / TileHeight;
+    m_Width = m_TilesX * TileWidth;
+    m_Height = m_TilesY * TileHeight;
+    m_Tiles.assign(static_cast<size_t>(m_TilesX) * m_TilesY, Tile{});
+    std::cout << "INFO::OCCLUSION::Masked depth buffer " << m_Width << "x" << m_Height << " (" << m_TilesX * m_TilesY << " tiles)." << std::endl;
+    return true;
+}
+
+// --- Occluder meshes ---
+
+OccluderMesh OcclusionCuller::SimplifyOccluder(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, float cellSize) {
+    OccluderMesh result;
+    if (vertices.empty() || indices.size() < 3) return result;
+
+    AABB box;
+    for (const Vertex& v : vertices) box.Expand(glm::vec3(v.Position[0], v.Position[1], v.Position[2]));
+    if (cellSize <= 0.0f) {
+        glm::vec3 size = box.Max - box.Min;
+        cellSize = std::max(std::max(size.x, size.y), size.z) / 32.0f;
+        if (cellSize <= 0.0f) cellSize = 1.0f;
+    }
+
+    // Every vertex snaps to the average position of the grid cell it falls in
+    std::unordered_map<uint64_t, uint32_t> cellToCluster;
+    std::vector<glm::vec3> sums;
+    std::vector<uint32_t> counts;
+    std::vector<uint32_t> remap(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        glm::vec3 p(vertices[i].Position[0], vertices[i].Position[1], vertices[i].Position[2]);
+        glm::vec3 cell = glm::floor((p - box.Min) / cellSize);
+        uint64_t key = (static_cast<uint64_t>(cell.x) & 0x1FFFFF) | ((static_cast<uint64_t>(cell.y) & 0x1FFFFF) << 21) | ((static_cast<uint64_t>(cell.z) & 0x1FFFFF) << 42);
+        auto inserted = cellToCluster.emplace(key, static_cast<uint32_t>(sums.size()));
+        if (inserted.second) { sums.push_back(glm::vec3(0.0f)); counts.push_back(0); }
+        uint32_t cluster = inserted.first->second;
+        sums[cluster] += p;
+        counts[cluster]++;
+        remap[i] = cluster;
+    }
+
+    result.Positions.resize(sums.size());
+    for (size_t c = 0; c < sums.size(); ++c) result.Positions[c] = sums[c] / static_cast<float>(counts[c]);
+
+    // Triangles that collapsed into a line or point are dropped
+    result.Indices.reserve(indices.size());
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        if (indices[t] >= vertices.size() || indices[t + 1] >= vertices.size() || indices[t + 2] >= vertices.size()) continue;
+        uint32_t a = remap[indices[t]], b = remap[indices[t + 1]], c = remap[indices[t + 2]];
+        if (a == b || b == c || a == c) continue;
+        result.Indices.push_back(a); result.Indices.push_back(b); result.Indices.push_back(c);
+    }
+    return result;
+}
+
+uint32_t OcclusionCuller::AddOccluderMesh(OccluderMesh mesh) {
+    m_OccluderMeshes.push_back(std::move(mesh));
+    return static_cast<uint32_t>(m_OccluderMeshes.size() - 1);
+}
+
+// --- Per frame ---
+
+void OcclusionCuller::BeginFrame(const glm::mat4& viewProjection) {
+    m_ViewProjection = viewProjection;
+    m_ClipVertices.clear();
+    m_Indices.clear();
+    m_LastStats = Stats{};
+    std::fill(m_Tiles.begin(), m_Tiles.end(), Tile{});
+}
+
+void OcclusionCuller::SubmitOccluder(uint32_t meshIndex, const glm::mat4& model) {
+    if (meshIndex >= m_OccluderMeshes.size() || m_Tiles.empty()) return;
+    const OccluderMesh& mesh = m_OccluderMeshes[meshIndex];
+    const glm::mat4 mvp = m_ViewProjection * model;
+    const uint32_t base = static_cast<uint32_t>(m_ClipVertices.size());
+    for (const glm::vec3& position : mesh.Positions) m_ClipVertices.push_back(mvp * glm::vec4(position, 1.0f));
+    for (uint32_t index : mesh.Indices) m_Indices.push_back(base + index);
+    m_LastStats.OccluderTriangles += static_cast<uint32_t>(mesh.Indices.size() / 3);
+}
+
+OcclusionCuller::ScreenVertex OcclusionCuller::ToScreen(const glm::vec4& clip) const {
+    float invW = 1.0f / clip.w;
+    return ScreenVertex{ (clip.x * invW * 0.5f + 0.5f) * m_Width, (clip.y * invW * 0.5f + 0.5f) * m_Height, clip.z * invW * 0.5f + 0.5f };
+}
+
+void OcclusionCuller::SetupClippedTriangle(size_t triangleIndex, TriangleSetup& first, TriangleSetup& second) const {
+    first.Valid = false;
+    second.Valid = false;
+    const glm::vec4 input[3] = { m_ClipVertices[m_Indices[triangleIndex * 3]],
+                                 m_ClipVertices[m_Indices[triangleIndex * 3 + 1]],
+                                 m_ClipVertices[m_Indices[triangleIndex * 3 + 2]] };
+    // Signed distance to the near plane (z = -w in GL clip space)
+    float distance[3];
+    int insideCount = 0;
+    for (int i = 0; i < 3; ++i) {
+        distance[i] = input[i].z + input[i].w;
+        if (distance[i] >= 0.0f) ++insideCount;
+    }
+    if (insideCount == 0) return;
+    if (insideCount == 3) {
+        first.Valid = SetupTriangle(ToScreen(input[0]), ToScreen(input[1]), ToScreen(input[2]), first);
+        return;
+    }
+
+    // Walls running past the camera are the common case in corridors, so clip rather than drop
+    glm::vec4 polygon[4];
+    int count = 0;
+    for (int i = 0; i < 3; ++i) {
+        int next = (i + 1) % 3;
+        if (distance[i] >= 0.0f) polygon[count++] = input[i];
+        if ((distance[i] >= 0.0f) != (distance[next] >= 0.0f)) {
+            float t = distance[i] / (distance[i] - distance[next]);
+            polygon[count++] = input[i] + (input[next] - input[i]) * t;
+        }
+    }
+    for (int i = 0; i < count; ++i) {
+        if (polygon[i].w <= 0.0f) return; // Only happens with non-perspective matrices; skipping is safe
+    }
+    ScreenVertex screen[4];
+    for (int i = 0; i < count; ++i) screen[i] = ToScreen(polygon[i]);
+    first.Valid = SetupTriangle(screen[0], screen[1], screen[2], first);
+    if (count == 4) second.Valid = SetupTriangle(screen[0], screen[2], screen[3], second);
+}
+
+bool OcclusionCuller::SetupTriangle(const ScreenVertex& v0, const ScreenVertex& v1, const ScreenVertex& v2, TriangleSetup& out) const {
+    const ScreenVertex* p[3] = { &v0, &v1, &v2 };
+    float area = (v1.X - v0.X) * (v2.Y - v0.Y) - (v1.Y - v0.Y) * (v2.X - v0.X);
+    if (area < 0.0f) { std::swap(p[1], p[2]); area = -area; }
+    if (area < 2.0f) return false; // Under one pixel of area can't fully cover any pixel
+
+    float minZ = std::min(std::min(p[0]->Z, p[1]->Z), p[2]->Z);
+    if (minZ >= 1.0f) return false; // Entirely past the far plane
+    out.ZMax = std::max(std::max(p[0]->Z, p[1]->Z), p[2]->Z);
+
+    float minX = std::min(std::min(p[0]->X, p[1]->X), p[2]->X), maxX = std::max(std::max(p[0]->X, p[1]->X), p[2]->X);
+    float minY = std::min(std::min(p[0]->Y, p[1]->Y), p[2]->Y), maxY = std::max(std::max(p[0]->Y, p[1]->Y), p[2]->Y);
+    int pixelMinX = std::max(0, static_cast<int>(std::floor(minX))), pixelMaxX = std::min(m_Width - 1, static_cast<int>(std::ceil(maxX)) - 1);
+    int pixelMinY = std::max(0, static_cast<int>(std::floor(minY))), pixelMaxY = std::min(m_Height - 1, static_cast<int>(std::ceil(maxY)) - 1);
+    if (pixelMinX > pixelMaxX || pixelMinY > pixelMaxY) return false;
+    out.TileMinX = pixelMinX / TileWidth; out.TileMaxX = pixelMaxX / TileWidth;
+    out.TileMinY = pixelMinY / TileHeight; out.TileMaxY = pixelMaxY / TileHeight;
+
+    // Edge functions are positive inside (counter-clockwise after the swap above). Pulling each
+    // edge in by half a pixel's extent along its normal means "centre passes" = "whole pixel inside".
+    for (int e = 0; e < 3; ++e) {
+        const ScreenVertex& a = *p[e];
+        const ScreenVertex& b = *p[(e + 1) % 3];
+        out.EdgeA[e] = a.Y - b.Y;
+        out.EdgeB[e] = b.X - a.X;
+        out.EdgeC[e] = a.X * b.Y - a.Y * b.X - 0.5f * (std::fabs(out.EdgeA[e]) + std::fabs(out.EdgeB[e]));
+    }
+
+    // NDC depth is linear in screen space, so it is a plane over the triangle
+    glm::vec3 d1(p[1]->X - p[0]->X, p[1]->Y - p[0]->Y, p[1]->Z - p[0]->Z);
+    glm::vec3 d2(p[2]->X - p[0]->X, p[2]->Y - p[0]->Y, p[2]->Z - p[0]->Z);
+    glm::vec3 normal = glm::cross(d1, d2); // normal.z == area
+    out.ZA = -normal.x / normal.z;
+    out.ZB = -normal.y / normal.z;
+    out.ZC = p[0]->Z - out.ZA * p[0]->X - out.ZB * p[0]->Y;
+    return true;
+}
+
+void OcclusionCuller::RasterizeOccluders(JobSystem* jobs) {
+    auto start = std::chrono::steady_clock::now();
+    const size_t triangleCount = m_Indices.size() / 3;
+    m_Triangles.resize(triangleCount * 2);
+
+    auto setupRange = [this](size_t begin, size_t end, unsigned int) {
+        for (size_t t = begin; t < end; ++t) SetupClippedTriangle(t, m_Triangles[t * 2], m_Triangles[t * 2 + 1]);
+    };
+    if (jobs && triangleCount >= PARALLEL_SETUP_MIN_TRIANGLES) jobs->ParallelFor(triangleCount, PARALLEL_SETUP_MIN_TRIANGLES / 4, setupRange);
+    else setupRange(0, triangleCount, 0);
+
+    uint32_t valid = 0;
+    for (const TriangleSetup& tri : m_Triangles) valid += tri.Valid ? 1 : 0;
+    m_LastStats.RasterizedTriangles = valid;
+
+    // Each band of tile rows is owned by one worker, so tiles need no locking and the
+    // result doesn't depend on how many workers there are
+    if (valid > 0) {
+        if (jobs && m_TilesY > 1) {
+            jobs->ParallelFor(static_cast<size_t>(m_TilesY), 2, [this](size_t begin, size_t end, unsigned int) {
+                RasterizeBand(static_cast<int>(begin), static_cast<int>(end));
+            });
+        } else {
+            RasterizeBand(0, m_TilesY);
+        }
+    }
+    m_LastStats.RasterMilliseconds = MillisecondsSince(start);
+}
+
+void OcclusionCuller::RasterizeBand(int tileRowBegin, int tileRowEnd) {
+    for (const TriangleSetup& tri : m_Triangles) {
+        if (!tri.Valid) continue;
+        int rowBegin = std::max(tri.TileMinY, tileRowBegin);
+        int rowEnd = std::min(tri.TileMaxY, tileRowEnd - 1);
+        for (int ty = rowBegin; ty <= rowEnd; ++ty) {
+            float tileY = static_cast<float>(ty * TileHeight);
+            for (int tx = tri.TileMinX; tx <= tri.TileMaxX; ++tx) {
+                float tileX = static_cast<float>(tx * TileWidth);
+                Tile& tile = m_Tiles[static_cast<size_t>(ty) * m_TilesX + tx];
+                // Farthest the triangle's plane gets over the tile, capped by its farthest vertex
+                float depth = tri.ZA * (tri.ZA > 0.0f ? tileX + TileWidth : tileX) + tri.ZB * (tri.ZB > 0.0f ? tileY + TileHeight : tileY) + tri.ZC;
+                depth = std::min(depth, tri.ZMax);
+                if (depth >= tile.ZMax0) continue; // Can't improve on what already covers the tile
+                uint32_t coverage = ComputeCoverage(tri, tileX, tileY);
+                if (coverage != 0) UpdateTile(tile, coverage, depth);
+            }
+        }
+    }
+}
+
+uint32_t OcclusionCuller::ComputeCoverage(const TriangleSetup& tri, float tileX, float tileY) {
+    const float firstX = tileX + 0.5f, lastX = tileX + TileWidth - 0.5f;
+    const float firstY = tileY + 0.5f, lastY = tileY + TileHeight - 0.5f;
+
+    // Trivial reject/accept from the extreme pixel centres of the tile
+    bool fullyInside = true;
+    for (int e = 0; e < 3; ++e) {
+        float a = tri.EdgeA[e], b = tri.EdgeB[e], c = tri.EdgeC[e];
+        float maxValue = a * (a > 0.0f ? lastX : firstX) + b * (b > 0.0f ? lastY : firstY) + c;
+        if (maxValue < 0.0f) return 0;
+        float minValue = a * (a > 0.0f ? firstX : lastX) + b * (b > 0.0f ? firstY : lastY) + c;
+        if (minValue < 0.0f) fullyInside = false;
+    }
+    if (fullyInside) return FULL_TILE_MASK;
+
+    // One tile row (8 pixels) at a time: value = A * column + rowStart
+    uint32_t coverage = 0;
+#if defined(OCCLUSION_CULLER_AVX2)
+    const __m256 columns = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    for (int row = 0; row < TileHeight; ++row) {
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int e = 0; e < 3; ++e) {
+            float rowStart = tri.EdgeA[e] * firstX + tri.EdgeB[e] * (firstY + row) + tri.EdgeC[e];
+            __m256 value = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(tri.EdgeA[e]), columns), _mm256_set1_ps(rowStart));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(value, zero, _CMP_GE_OQ));
+        }
+        coverage |= static_cast<uint32_t>(_mm256_movemask_ps(inside)) << (row * TileWidth);
+    }
+#elif defined(OCCLUSION_CULLER_SSE)
+    const __m128 columnsLow = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const __m128 columnsHigh = _mm_setr_ps(4.0f, 5.0f, 6.0f, 7.0f);
+    const __m128 zero = _mm_setzero_ps();
+    for (int row = 0; row < TileHeight; ++row) {
+        __m128 insideLow = _mm_castsi128_ps(_mm_set1_epi32(-1)), insideHigh = insideLow;
+        for (int e = 0; e < 3; ++e) {
+            __m128 a = _mm_set1_ps(tri.EdgeA[e]);
+            __m128 rowStart = _mm_set1_ps(tri.EdgeA[e] * firstX + tri.EdgeB[e] * (firstY + row) + tri.EdgeC[e]);
+            insideLow = _mm_and_ps(insideLow, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a, columnsLow), rowStart), zero));
+            insideHigh = _mm_and_ps(insideHigh, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a, columnsHigh), rowStart), zero));
+        }
+        uint32_t rowBits = static_cast<uint32_t>(_mm_movemask_ps(insideLow)) | (static_cast<uint32_t>(_mm_movemask_ps(insideHigh)) << 4);
+        coverage |= rowBits << (row * TileWidth);
+    }
+#elif defined(OCCLUSION_CULLER_NEON)
+    const float columnValuesLow[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+    const float columnValuesHigh[4] = { 4.0f, 5.0f, 6.0f, 7.0f };
+    const uint32_t laneBitValues[4] = { 1u, 2u, 4u, 8u };
+    const float32x4_t columnsLow = vld1q_f32(columnValuesLow), columnsHigh = vld1q_f32(columnValuesHigh);
+    const uint32x4_t laneBits = vld1q_u32(laneBitValues);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    for (int row = 0; row < TileHeight; ++row) {
+        uint32x4_t insideLow = vdupq_n_u32(0xFFFFFFFFu), insideHigh = insideLow;
+        for (int e = 0; e < 3; ++e) {
+            float32x4_t a = vdupq_n_f32(tri.EdgeA[e]);
+            float32x4_t rowStart = vdupq_n_f32(tri.EdgeA[e] * firstX + tri.EdgeB[e] * (firstY + row) + tri.EdgeC[e]);
+            insideLow = vandq_u32(insideLow, vcgeq_f32(vmlaq_f32(rowStart, a, columnsLow), zero));
+            insideHigh = vandq_u32(insideHigh, vcgeq_f32(vmlaq_f32(rowStart, a, columnsHigh), zero));
+        }
+        // Horizontal add of the per-lane bits (works on ARMv7 and AArch64)
+        uint32x4_t bits = vorrq_u32(vandq_u32(insideLow, laneBits), vshlq_n_u32(vandq_u32(insideHigh, laneBits), 4));
+        uint32x2_t pairs = vorr_u32(vget_low_u32(bits), vget_high_u32(bits));
+        uint32_t rowBits = vget_lane_u32(pairs, 0) | vget_lane_u32(pairs, 1);
+        coverage |= rowBits << (row * TileWidth);
+    }
+#else
+    for (int row = 0; row < TileHeight; ++row) {
+        for (int column = 0; column < TileWidth; ++column) {
+            bool inside = true;
+            for (int e = 0; e < 3 && inside; ++e) {
+                float rowStart = tri.EdgeA[e] * firstX + tri.EdgeB[e] * (firstY + row) + tri.EdgeC[e];
+                inside = tri.EdgeA[e] * column + rowStart >= 0.0f;
+            }
+            if (inside) coverage |= 1u << (row * TileWidth + column);
+        }
+    }
+#endif
+    return coverage;
+}
+
+void OcclusionCuller::UpdateTile(Tile& tile, uint32_t coverage, float triangleDepth) {
+    if (coverage == FULL_TILE_MASK) {
+        tile.ZMax0 = triangleDepth; // Caller guarantees it is nearer than the current ZMax0
+        if (tile.ZMax1 >= tile.ZMax0) { tile.Mask = 0; tile.ZMax1 = 0.0f; } // Working layer is now redundant
+        return;
+    }
+    // Drop the working layer if merging this much nearer triangle into it would mostly
+    // waste it (it is closer to the background than to the new triangle)
+    if (tile.Mask != 0 && triangleDepth < tile.ZMax1 && (tile.ZMax1 - triangleDepth) > (tile.ZMax0 - tile.ZMax1)) {
+        tile.Mask = 0;
+        tile.ZMax1 = 0.0f;
+    }
+    tile.Mask |= coverage;
+    tile.ZMax1 = std::max(tile.ZMax1, triangleDepth);
+    if (tile.Mask == FULL_TILE_MASK) {
+        // Working layer covers the whole tile: it becomes the reference layer
+        tile.ZMax0 = std::min(tile.ZMax0, tile.ZMax1);
+        tile.Mask = 0;
+        tile.ZMax1 = 0.0f;
+    }
+}
+
+// --- Occludee tests ---
+
+bool OcclusionCuller::IsOccluded(const AABB& worldBox) const {
+    if (m_Tiles.empty() || worldBox.IsEmpty()) return false;
+
+    float ndcMinX = 1e30f, ndcMinY = 1e30f, ndcMaxX = -1e30f, ndcMaxY = -1e30f;
+    float nearestDepth = 1e30f;
+    for (int corner = 0; corner < 8; ++corner) {
+        glm::vec3 point((corner & 1) ? worldBox.Max.x : worldBox.Min.x,
+                        (corner & 2) ? worldBox.Max.y : worldBox.Min.y,
+                        (corner & 4) ? worldBox.Max.z : worldBox.Min.z);
+        glm::vec4 clip = m_ViewProjection * glm::vec4(point, 1.0f);
+        if (clip.w <= 0.0f || clip.z < -clip.w) return false; // Touches the near plane: assume visible
+        float invW = 1.0f / clip.w;
+        ndcMinX = std::min(ndcMinX, clip.x * invW); ndcMaxX = std::max(ndcMaxX, clip.x * invW);
+        ndcMinY = std::min(ndcMinY, clip.y * invW); ndcMaxY = std::max(ndcMaxY, clip.y * invW);
+        nearestDepth = std::min(nearestDepth, clip.z * invW * 0.5f + 0.5f);
+    }
+
+    // Every pixel the box touches, even partially
+    int pixelMinX = std::max(0, static_cast<int>(std::floor((ndcMinX * 0.5f + 0.5f) * m_Width)));
+    int pixelMaxX = std::min(m_Width - 1, static_cast<int>(std::ceil((ndcMaxX * 0.5f + 0.5f) * m_Width)) - 1);
+    int pixelMinY = std::max(0, static_cast<int>(std::floor((ndcMinY * 0.5f + 0.5f) * m_Height)));
+    int pixelMaxY = std::min(m_Height - 1, static_cast<int>(std::ceil((ndcMaxY * 0.5f + 0.5f) * m_Height)) - 1);
+    if (pixelMinX > pixelMaxX || pixelMinY > pixelMaxY) return false; // Off-screen is the frustum culler's call
+
+    for (int ty = pixelMinY / TileHeight; ty <= pixelMaxY / TileHeight; ++ty) {
+        for (int tx = pixelMinX / TileWidth; tx <= pixelMaxX / TileWidth; ++tx) {
+            const Tile& tile = m_Tiles[static_cast<size_t>(ty) * m_TilesX + tx];
+            if (nearestDepth > tile.ZMax0) continue;
+            if (tile.Mask != 0 && nearestDepth > tile.ZMax1) {
+                // Behind the working layer: occluded here if the layer covers the box's pixels in this tile
+                int column0 = std::max(pixelMinX - tx * TileWidth, 0), column1 = std::min(pixelMaxX - tx * TileWidth, TileWidth - 1);
+                int row0 = std::max(pixelMinY - ty * TileHeight, 0), row1 = std::min(pixelMaxY - ty * TileHeight, TileHeight - 1);
+                uint32_t rowBits = (0xFFu >> (TileWidth - 1 - (column1 - column0))) << column0;
+                uint32_t boxMask = 0;
+                for (int row = row0; row <= row1; ++row) boxMask |= rowBits << (row * TileWidth);
+                if ((boxMask & ~tile.Mask) == 0) continue;
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+void OcclusionCuller::CullOccludees(const std::vector<AABB>& worldBounds, std::vector<uint32_t>& visible, JobSystem* jobs) {
+    auto start = std::chrono::steady_clock::now();
+    const size_t count = visible.size();
+    m_OccludedFlags.assign(count, 0);
+
+    auto testRange = [&](size_t begin, size_t end, unsigned int) {
+        for (size_t i = begin; i < end; ++i) {
+            uint32_t object = visible[i];
+            m_OccludedFlags[i] = (object < worldBounds.size() && IsOccluded(worldBounds[object])) ? 1 : 0;
+        }
+    };
+    if (jobs && count >= PARALLEL_TEST_MIN_OBJECTS) jobs->ParallelFor(count, PARALLEL_TEST_MIN_OBJECTS / 4, testRange);
+    else testRange(0, count, 0);
+
+    size_t kept = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (!m_OccludedFlags[i]) visible[kept++] = visible[i];
+    }
+    visible.resize(kept);
+
+    m_LastStats.Tested = static_cast<uint32_t>(count);
+    m_LastStats.Rejected = static_cast<uint32_t>(count - kept);
+    m_LastStats.TestMilliseconds = MillisecondsSince(start);
+}
+
+void OcclusionCuller::ResolveDepth(std::vector<float>& outDepth) const {
+    outDepth.assign(static_cast<size_t>(m_Width) * m_Height, 1.0f);
+    for (int y = 0; y < m_Height; ++y) {
+        for (int x = 0; x < m_Width; ++x) {
+            const Tile& tile = m_Tiles[static_cast<size_t>(y / TileHeight) * m_TilesX + x / TileWidth];
+            uint32_t bit = 1u << ((y % TileHeight) * TileWidth + x % TileWidth);
+            outDepth[static_cast<size_t>(y) * m_Width + x] = (tile.Mask & bit) ? std::min(tile.ZMax0, tile.ZMax1) : tile.ZMax0;
+        }
+    }
+}
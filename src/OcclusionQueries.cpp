@@ -0,0 +1,161 @@
+// src/OcclusionQueries.cpp
+
+#include "OcclusionQueries.h"
+#include "FileUtils.h"
+#include "Shader.h"
+#include "VertexArray.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    // Boxes this close to the camera could be cut by the near plane and report zero samples
+    // while the object is on screen, so they are drawn without a query.
+    const float CAMERA_INSIDE_MARGIN = 0.25f;
+}
+
+OcclusionQueries::OcclusionQueries() {}
+
+OcclusionQueries::~OcclusionQueries() {
+    Shutdown();
+}
+
+bool OcclusionQueries::Initialize(GeometryBuffer& geometry) {
+    std::string vertPath = FileUtils::GetResourcePath("shaders/bounds.vert");
+    std::string fragPath = FileUtils::GetResourcePath("shaders/bounds.frag");
+    if (vertPath.empty() || fragPath.empty()) {
+        std::cerr << "ERROR::OCCLUSION_QUERIES::Could not get bounds shader path(s)." << std::endl;
+        return false;
+    }
+    m_BoundsShader = std::make_unique<Shader>(vertPath, fragPath);
+    if (m_BoundsShader->GetProgramID() == 0) {
+        std::cerr << "ERROR::OCCLUSION_QUERIES::Failed to load bounds shader." << std::endl;
+        m_BoundsShader.reset();
+        return false;
+    }
+
+    // Unit cube, 8 corners / 12 triangles, in the shared buffer so the query pass keeps the same VAO
+    std::vector<Vertex> corners(8);
+    for (int i = 0; i < 8; ++i) {
+        corners[i] = Vertex{ { (i & 1) ? 0.5f : -0.5f, (i & 2) ? 0.5f : -0.5f, (i & 4) ? 0.5f : -0.5f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f } };
+    }
+    std::vector<unsigned int> indices = { 0, 2, 3, 0, 3, 1,  4, 5, 7, 4, 7, 6,  0, 1, 5, 0, 5, 4,
+                                          2, 6, 7, 2, 7, 3,  0, 4, 6, 0, 6, 2,  1, 3, 7, 1, 7, 5 };
+    if (!geometry.Allocate(corners, indices, m_CubeRange)) {
+        std::cerr << "ERROR::OCCLUSION_QUERIES::Failed to allocate the query cube." << std::endl;
+        m_BoundsShader.reset();
+        return false;
+    }
+    m_Geometry = &geometry;
+    std::cout << "INFO::OCCLUSION_QUERIES::Initialized (" << QueryRingSize << " queries per object)." << std::endl;
+    return true;
+}
+
+void OcclusionQueries::Shutdown() {
+    for (Entry& entry : m_Entries) glDeleteQueries(QueryRingSize, entry.Queries);
+    m_Entries.clear();
+    if (m_Geometry && m_CubeRange.IsValid()) m_Geometry->Free(m_CubeRange);
+    m_CubeRange = GeometryRange{};
+    m_Geometry = nullptr;
+    m_BoundsShader.reset();
+}
+
+uint32_t OcclusionQueries::Register() {
+    Entry entry;
+    glGenQueries(QueryRingSize, entry.Queries);
+    m_Entries.push_back(entry);
+    return static_cast<uint32_t>(m_Entries.size() - 1);
+}
+
+void OcclusionQueries::BeginFrame() {
+    ++m_FrameIndex;
+    m_Stats = Stats{};
+
+    // Non-blocking harvest: only read results the driver says are already available
+    uint64_t latencySum = 0;
+    for (Entry& entry : m_Entries) {
+        for (int slot = 0; slot < QueryRingSize; ++slot) {
+            if (!entry.Pending[slot]) continue;
+            GLuint available = 0;
+            glGetQueryObjectuiv(entry.Queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) continue;
+            GLuint anyPassed = 0;
+            glGetQueryObjectuiv(entry.Queries[slot], GL_QUERY_RESULT, &anyPassed);
+            entry.Pending[slot] = false;
+            if (anyPassed) m_Stats.Hits++; else m_Stats.Misses++;
+            uint32_t latency = static_cast<uint32_t>(m_FrameIndex - entry.IssueFrame[slot]);
+            latencySum += latency;
+            m_Stats.MaxLatencyFrames = std::max(m_Stats.MaxLatencyFrames, latency);
+        }
+    }
+    uint32_t results = m_Stats.Hits + m_Stats.Misses;
+    m_Stats.AverageLatencyFrames = results > 0 ? double(latencySum) / results : 0.0;
+}
+
+void OcclusionQueries::BeginQueryPass(const glm::mat4& viewProjection, const glm::vec3& cameraPosition) {
+    m_ViewProjection = viewProjection;
+    m_CameraPosition = cameraPosition;
+    if (!m_BoundsShader || !m_Geometry) return;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &m_PreviousProgram);
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &m_PreviousVertexArray);
+    // Boxes only test against depth; they must not write anything
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthMask(GL_FALSE);
+    m_BoundsShader->Use();
+    m_Geometry->Bind();
+}
+
+void OcclusionQueries::Query(uint32_t handle, const AABB& worldBox) {
+    if (handle >= m_Entries.size() || !m_BoundsShader || !m_Geometry) return;
+    Entry& entry = m_Entries[handle];
+    const int slot = static_cast<int>(m_FrameIndex % QueryRingSize);
+    if (entry.Pending[slot]) m_Stats.Late++; // Result never arrived in time; the slot gets overwritten
+    entry.Pending[slot] = false;
+    entry.IssueFrame[slot] = 0;
+
+    if (worldBox.IsEmpty()) return;
+    glm::vec3 nearMin = worldBox.Min - glm::vec3(CAMERA_INSIDE_MARGIN);
+    glm::vec3 nearMax = worldBox.Max + glm::vec3(CAMERA_INSIDE_MARGIN);
+    bool cameraInside = m_CameraPosition.x >= nearMin.x && m_CameraPosition.y >= nearMin.y && m_CameraPosition.z >= nearMin.z &&
+                        m_CameraPosition.x <= nearMax.x && m_CameraPosition.y <= nearMax.y && m_CameraPosition.z <= nearMax.z;
+    if (cameraInside) return; // Next frame draws it unconditionally
+
+    // Keep flat boxes from collapsing to zero-area triangles (which would always report "occluded")
+    glm::vec3 size = glm::max(worldBox.Max - worldBox.Min, glm::vec3(1e-3f));
+    glm::mat4 boxTransform = glm::scale(glm::translate(glm::mat4(1.0f), worldBox.GetCenter()), size);
+    m_BoundsShader->SetMat4("uMVP", m_ViewProjection * boxTransform);
+    glBeginQuery(GL_ANY_SAMPLES_PASSED, entry.Queries[slot]);
+    m_Geometry->Draw(m_CubeRange);
+    glEndQuery(GL_ANY_SAMPLES_PASSED);
+    entry.IssueFrame[slot] = m_FrameIndex;
+    entry.Pending[slot] = true;
+    m_Stats.Issued++;
+}
+
+void OcclusionQueries::EndQueryPass() {
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glDepthMask(GL_TRUE);
+    if (!m_BoundsShader || !m_Geometry) return;
+    // The draws after the pass set their uniforms on whatever program is current, which must not
+    // be the bounds shader
+    glUseProgram(static_cast<GLuint>(m_PreviousProgram));
+    glBindVertexArray(static_cast<GLuint>(m_PreviousVertexArray));
+}
+
+bool OcclusionQueries::BeginConditionalDraw(uint32_t handle) {
+    if (handle >= m_Entries.size()) return false;
+    const Entry& entry = m_Entries[handle];
+    const int previousSlot = static_cast<int>((m_FrameIndex + QueryRingSize - 1) % QueryRingSize);
+    if (entry.IssueFrame[previousSlot] == 0 || entry.IssueFrame[previousSlot] != m_FrameIndex - 1) {
+        m_Stats.Unconditional++;
+        return false;
+    }
+    glBeginConditionalRender(entry.Queries[previousSlot], GL_QUERY_NO_WAIT);
+    m_Stats.Conditional++;
+    return true;
+}
+
+void OcclusionQueries::EndConditionalDraw() {
+    glEndConditionalRender();
+}
@@ -0,0 +1,172 @@
+// src/Profiler.cpp
+
+#include "Profiler.h"
+
+#ifdef ENGINE_ENABLE_PROFILER
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+namespace Profiler {
+    struct Track {
+        std::string Name;                // Guarded by the registry mutex
+        uint32_t Id = 0;                 // Trace thread id
+        uint32_t Depth = 0;              // Open scopes; owning thread only
+        std::atomic<uint64_t> Head{ 0 }; // Events ever recorded; the newest is at (Head - 1) % RingSize
+        Event Events[RingSize];
+    };
+}
+
+namespace {
+    const uint64_t FRAME_MARK_COUNT = 64;
+
+    std::mutex gRegistryMutex;
+    std::vector<std::unique_ptr<Profiler::Track>> gTracks; // Never shrinks: a ring outlives its thread
+    thread_local Profiler::Track* tTrack = nullptr;
+
+    int64_t gFrameMarks[FRAME_MARK_COUNT] = {};
+    std::atomic<uint64_t> gFrameCount{ 0 };
+
+    Profiler::Track* AddTrack(const char* name) {
+        std::lock_guard<std::mutex> lock(gRegistryMutex);
+        gTracks.push_back(std::make_unique<Profiler::Track>());
+        Profiler::Track* track = gTracks.back().get();
+        track->Id = static_cast<uint32_t>(gTracks.size());
+        track->Name = name ? name : "Thread " + std::to_string(track->Id);
+        return track;
+    }
+
+    Profiler::Track* GetThreadTrack() {
+        if (!tTrack) tTrack = AddTrack(nullptr);
+        return tTrack;
+    }
+
+    // Appends the events of 'track' that overlap [begin, end]. The owning thread may keep
+    // writing meanwhile; anything it overwrote during the copy is dropped again.
+    void CopyEvents(const Profiler::Track& track, int64_t begin, int64_t end, std::vector<Profiler::Event>& out) {
+        const uint64_t head = track.Head.load(std::memory_order_acquire);
+        const uint64_t oldest = head > Profiler::RingSize ? head - Profiler::RingSize : 0;
+        // Events are recorded when they end, so walk back until they end before 'begin'
+        uint64_t first = head;
+        while (first > oldest && track.Events[(first - 1) % Profiler::RingSize].End >= begin) --first;
+
+        const size_t outStart = out.size();
+        for (uint64_t i = first; i < head; ++i) out.push_back(track.Events[i % Profiler::RingSize]);
+
+        const uint64_t after = track.Head.load(std::memory_order_acquire);
+        if (after > Profiler::RingSize && after - Profiler::RingSize > first) {
+            const uint64_t overwritten = std::min<uint64_t>(after - Profiler::RingSize - first, head - first);
+            out.erase(out.begin() + outStart, out.begin() + outStart + static_cast<size_t>(overwritten));
+        }
+        out.erase(std::remove_if(out.begin() + outStart, out.end(), [end](const Profiler::Event& event) { return event.Begin > end; }), out.end());
+    }
+}
+
+namespace Profiler {
+
+    void SetThreadName(const char* name) {
+        Track* track = GetThreadTrack();
+        std::lock_guard<std::mutex> lock(gRegistryMutex);
+        track->Name = name;
+    }
+
+    Track* CreateTrack(const char* name) {
+        return AddTrack(name);
+    }
+
+    void RecordEvent(Track* track, const char* name, uint32_t depth, int64_t begin, int64_t end) {
+        const uint64_t head = track->Head.load(std::memory_order_relaxed);
+        track->Events[head % RingSize] = Event{ name, begin, end, depth };
+        track->Head.store(head + 1, std::memory_order_release);
+    }
+
+    void BeginScope() {
+        GetThreadTrack()->Depth++;
+    }
+
+    void EndScope(const char* name, int64_t begin) {
+        const int64_t end = Now();
+        Track* track = GetThreadTrack();
+        track->Depth--;
+        RecordEvent(track, name, track->Depth, begin, end);
+    }
+
+    void MarkFrame() {
+        const uint64_t count = gFrameCount.load(std::memory_order_relaxed);
+        gFrameMarks[count % FRAME_MARK_COUNT] = Now();
+        gFrameCount.store(count + 1, std::memory_order_release);
+    }
+
+    bool GetFrameRange(int framesAgo, int64_t& begin, int64_t& end) {
+        const uint64_t count = gFrameCount.load(std::memory_order_acquire);
+        if (framesAgo < 1 || uint64_t(framesAgo) + 1 > count || uint64_t(framesAgo) + 1 >= FRAME_MARK_COUNT) return false;
+        begin = gFrameMarks[(count - 1 - framesAgo) % FRAME_MARK_COUNT];
+        end = gFrameMarks[(count - framesAgo) % FRAME_MARK_COUNT];
+        return true;
+    }
+
+    void Collect(int64_t begin, int64_t end, std::vector<TrackSnapshot>& tracks) {
+        std::lock_guard<std::mutex> lock(gRegistryMutex);
+        size_t used = 0;
+        for (const std::unique_ptr<Track>& track : gTracks) {
+            if (used == tracks.size()) tracks.emplace_back();
+            TrackSnapshot& snapshot = tracks[used]; // Reused between calls to keep the event capacity
+            snapshot.Events.clear();
+            CopyEvents(*track, begin, end, snapshot.Events);
+            if (snapshot.Events.empty()) continue;
+            snapshot.Name = track->Name;
+            snapshot.MaxDepth = 0;
+            for (const Event& event : snapshot.Events) snapshot.MaxDepth = std::max(snapshot.MaxDepth, event.Depth);
+            ++used;
+        }
+        tracks.resize(used);
+    }
+
+    bool WriteChromeTrace(const std::string& path) {
+        std::ofstream file(path);
+        if (!file) {
+            std::cerr << "ERROR::PROFILER::Could not open trace file: " << path << std::endl;
+            return false;
+        }
+        // Chrome trace event format: complete ("X") events, timestamps and durations in microseconds
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        file.setf(std::ios::fixed);
+        file.precision(3);
+        size_t written = 0;
+        bool first = true;
+        std::vector<Event> events;
+        {
+            std::lock_guard<std::mutex> lock(gRegistryMutex);
+            for (const std::unique_ptr<Track>& track : gTracks) {
+                events.clear();
+                CopyEvents(*track, INT64_MIN, INT64_MAX, events);
+                file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << track->Id
+                     << ",\"args\":{\"name\":\"" << track->Name << "\"}}";
+                first = false;
+                for (const Event& event : events) {
+                    file << ",\n{\"name\":\"" << event.Name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << track->Id
+                         << ",\"ts\":" << event.Begin / 1000.0 << ",\"dur\":" << (event.End - event.Begin) / 1000.0 << "}";
+                }
+                written += events.size();
+            }
+        }
+        // Frame boundaries as global instant events
+        const uint64_t frameCount = gFrameCount.load(std::memory_order_acquire);
+        for (uint64_t i = frameCount > FRAME_MARK_COUNT ? frameCount - FRAME_MARK_COUNT : 0; i < frameCount; ++i) {
+            file << (first ? "" : ",\n") << "{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":"
+                 << gFrameMarks[i % FRAME_MARK_COUNT] / 1000.0 << "}";
+            first = false;
+        }
+        file << "\n]}\n";
+        std::cout << "INFO::PROFILER::Wrote " << written << " events to " << path << std::endl;
+        return true;
+    }
+
+} // namespace Profiler
+
+#endif // ENGINE_ENABLE_PROFILER
@@ -0,0 +1,294 @@
+// src/RenderGraph.cpp
+
+#include "RenderGraph.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    bool Contains(const std::vector<RenderResource>& resources, RenderResource resource) {
+        return std::find(resources.begin(), resources.end(), resource) != resources.end();
+    }
+}
+
+uint64_t RenderGraph::GetBytes(const RenderTextureDesc& desc) {
+    uint64_t bytesPerPixel = 4;
+    if (desc.Format == RenderFormat::RGBA16F) bytesPerPixel = 8;
+    return static_cast<uint64_t>(std::max(desc.Width, 0)) * static_cast<uint64_t>(std::max(desc.Height, 0)) * bytesPerPixel;
+}
+
+bool RenderGraph::IsDepthFormat(RenderFormat format) {
+    return format == RenderFormat::Depth24;
+}
+
+void RenderGraph::Reset() {
+    m_Passes.clear();
+    m_Resources.clear();
+    m_Physical.clear();
+    m_PhysicalLastPass.clear();
+    m_Order.clear();
+    m_Stats = Stats{};
+}
+
+RenderResource RenderGraph::CreateTexture(const char* name, const RenderTextureDesc& desc) {
+    Resource resource;
+    resource.Name = name;
+    resource.Desc = desc;
+    m_Resources.push_back(resource);
+    return static_cast<RenderResource>(m_Resources.size() - 1);
+}
+
+RenderResource RenderGraph::Import(const char* name, bool output, uint32_t framebuffer, int width, int height) {
+    Resource resource;
+    resource.Name = name;
+    resource.Desc.Width = width;
+    resource.Desc.Height = height;
+    resource.Imported = true;
+    resource.Output = output;
+    resource.Framebuffer = framebuffer;
+    m_Resources.push_back(resource);
+    return static_cast<RenderResource>(m_Resources.size() - 1);
+}
+
+void RenderGraph::AddPass(const char* name, std::initializer_list<RenderResource> reads, std::initializer_list<RenderResource> writes,
+                          ExecuteFunction execute, bool sideEffects) {
+    Pass pass;
+    pass.Name = name;
+    pass.Reads.assign(reads.begin(), reads.end());
+    pass.Writes.assign(writes.begin(), writes.end());
+    pass.Execute = std::move(execute);
+    pass.SideEffects = sideEffects;
+    m_Passes.push_back(std::move(pass));
+}
+
+bool RenderGraph::Compile() {
+    m_Physical.clear();
+    m_PhysicalLastPass.clear();
+    m_Stats = Stats{};
+    if (!Validate() || !Sort()) return false;
+    Cull();
+    PlaceTransients();
+    return true;
+}
+
+bool RenderGraph::Validate() const {
+    for (const Pass& pass : m_Passes) {
+        for (RenderResource resource : pass.Reads) {
+            if (resource >= m_Resources.size()) {
+                std::cerr << "ERROR::RENDER_GRAPH::Pass '" << pass.Name << "' reads an unknown resource." << std::endl;
+                return false;
+            }
+        }
+        int colors = 0, depths = 0;
+        bool usesFramebuffer = false;
+        for (RenderResource resource : pass.Writes) {
+            if (resource >= m_Resources.size()) {
+                std::cerr << "ERROR::RENDER_GRAPH::Pass '" << pass.Name << "' writes an unknown resource." << std::endl;
+                return false;
+            }
+            const Resource& info = m_Resources[resource];
+            if (info.Imported) usesFramebuffer |= info.Framebuffer != NoFramebuffer;
+            else if (IsDepthFormat(info.Desc.Format)) depths++;
+            else colors++;
+        }
+        if (colors > 1 || depths > 1 || (usesFramebuffer && colors + depths > 0)) {
+            std::cerr << "ERROR::RENDER_GRAPH::Pass '" << pass.Name
+                      << "' renders into more than one color or depth target, or into transients and an imported framebuffer." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Topological sort of the passes. Hard edges: a pass that reads a resource without writing it
+// comes after every writer of that resource. Soft edges: of two passes writing the same resource,
+// the one declared first comes first, unless the hard edges (or soft ones already taken) already
+// put them the other way round. Among the passes that are ready, the first declared runs next.
+bool RenderGraph::Sort() {
+    const uint32_t count = static_cast<uint32_t>(m_Passes.size());
+    m_Edges.assign(static_cast<size_t>(count) * count, false);
+    for (uint32_t reader = 0; reader < count; ++reader) {
+        const Pass& pass = m_Passes[reader];
+        for (RenderResource resource : pass.Reads) {
+            if (Contains(pass.Writes, resource)) continue;
+            for (uint32_t writer = 0; writer < count; ++writer) {
+                if (writer != reader && Contains(m_Passes[writer].Writes, resource)) m_Edges[writer * count + reader] = true;
+            }
+        }
+    }
+    for (uint32_t first = 0; first < count; ++first) {
+        for (uint32_t second = first + 1; second < count; ++second) {
+            if (m_Edges[first * count + second]) continue;
+            bool shared = false;
+            for (RenderResource resource : m_Passes[first].Writes) shared = shared || Contains(m_Passes[second].Writes, resource);
+            if (shared && !Reaches(second, first)) m_Edges[first * count + second] = true;
+        }
+    }
+
+    // Kahn's algorithm; m_Visited marks the passes already placed
+    m_Order.clear();
+    m_Visited.assign(count, false);
+    while (m_Order.size() < count) {
+        uint32_t next = count;
+        for (uint32_t candidate = 0; candidate < count && next == count; ++candidate) {
+            if (m_Visited[candidate]) continue;
+            bool ready = true;
+            for (uint32_t before = 0; before < count && ready; ++before) ready = m_Visited[before] || !m_Edges[before * count + candidate];
+            if (ready) next = candidate;
+        }
+        if (next == count) {
+            std::cerr << "ERROR::RENDER_GRAPH::Passes read each other's writes in a cycle:";
+            for (uint32_t pass = 0; pass < count; ++pass) {
+                if (!m_Visited[pass]) std::cerr << " '" << m_Passes[pass].Name << "'";
+            }
+            std::cerr << "." << std::endl;
+            return false;
+        }
+        m_Visited[next] = true;
+        m_Order.push_back(next);
+    }
+
+    // A transient read before anything wrote it holds whatever an aliased texture left behind
+    std::vector<bool> written(m_Resources.size(), false);
+    for (uint32_t index : m_Order) {
+        const Pass& pass = m_Passes[index];
+        for (RenderResource resource : pass.Reads) {
+            if (!m_Resources[resource].Imported && !written[resource]) {
+                std::cerr << "ERROR::RENDER_GRAPH::Pass '" << pass.Name << "' reads '" << m_Resources[resource].Name
+                          << "' before any pass writes it." << std::endl;
+                return false;
+            }
+        }
+        for (RenderResource resource : pass.Writes) written[resource] = true;
+    }
+    return true;
+}
+
+// Whether 'to' has to run after 'from' through the edges placed so far.
+bool RenderGraph::Reaches(uint32_t from, uint32_t to) {
+    const uint32_t count = static_cast<uint32_t>(m_Passes.size());
+    m_Visited.assign(count, false);
+    m_Stack.assign(1, from);
+    m_Visited[from] = true;
+    while (!m_Stack.empty()) {
+        const uint32_t pass = m_Stack.back();
+        m_Stack.pop_back();
+        if (pass == to) return true;
+        for (uint32_t next = 0; next < count; ++next) {
+            if (m_Edges[pass * count + next] && !m_Visited[next]) {
+                m_Visited[next] = true;
+                m_Stack.push_back(next);
+            }
+        }
+    }
+    return false;
+}
+
+// Walks the passes backwards, keeping the ones with side effects or outputs and then every earlier
+// pass that writes something a kept pass reads. A write doesn't end a resource's dependency on
+// earlier writers: passes may cover only part of a target (or blend), so those stay too.
+void RenderGraph::Cull() {
+    m_Needed.assign(m_Resources.size(), false);
+    for (size_t position = m_Order.size(); position-- > 0;) {
+        Pass& pass = m_Passes[m_Order[position]];
+        bool keep = pass.SideEffects;
+        for (RenderResource resource : pass.Writes) keep = keep || m_Resources[resource].Output || m_Needed[resource];
+        pass.Culled = !keep;
+        if (!keep) {
+            m_Stats.CulledPasses++;
+            continue;
+        }
+        for (RenderResource resource : pass.Reads) m_Needed[resource] = true;
+    }
+    m_Stats.Passes = static_cast<uint32_t>(m_Passes.size()) - m_Stats.CulledPasses;
+}
+
+void RenderGraph::PlaceTransients() {
+    for (Resource& resource : m_Resources) resource.FirstPass = resource.LastPass = resource.Physical = -1;
+
+    // Lifetimes (in execution positions) and attachments, kept passes only
+    for (int i = 0; i < static_cast<int>(m_Order.size()); ++i) {
+        Pass& pass = m_Passes[m_Order[i]];
+        pass.Color = pass.Depth = pass.Target = InvalidRenderResource;
+        pass.DiscardBefore.clear();
+        pass.DiscardAfter.clear();
+        if (pass.Culled) continue;
+        for (const std::vector<RenderResource>* list : {&pass.Reads, &pass.Writes}) {
+            for (RenderResource resource : *list) {
+                Resource& info = m_Resources[resource];
+                if (info.Imported) {
+                    if (info.Framebuffer != NoFramebuffer && pass.Target == InvalidRenderResource) pass.Target = resource;
+                    continue;
+                }
+                if (info.FirstPass < 0) info.FirstPass = i;
+                info.LastPass = i;
+            }
+        }
+        for (RenderResource resource : pass.Writes) {
+            const Resource& info = m_Resources[resource];
+            if (info.Imported) continue;
+            if (IsDepthFormat(info.Desc.Format)) pass.Depth = resource;
+            else pass.Color = resource;
+        }
+        if (pass.Color != InvalidRenderResource || pass.Depth != InvalidRenderResource) pass.Target = InvalidRenderResource;
+    }
+
+    // Greedy aliasing in order of first use: a transient takes the first physical texture of the
+    // same size and format whose previous tenant is dead by then
+    m_Transients.clear();
+    for (RenderResource resource = 0; resource < m_Resources.size(); ++resource) {
+        if (!m_Resources[resource].Imported && m_Resources[resource].FirstPass >= 0) m_Transients.push_back(resource);
+    }
+    std::stable_sort(m_Transients.begin(), m_Transients.end(), [this](RenderResource a, RenderResource b) {
+        return m_Resources[a].FirstPass < m_Resources[b].FirstPass;
+    });
+    for (RenderResource resource : m_Transients) {
+        Resource& info = m_Resources[resource];
+        int physical = -1;
+        for (size_t j = 0; j < m_Physical.size() && physical < 0; ++j) {
+            if (m_Physical[j] == info.Desc && m_PhysicalLastPass[j] < info.FirstPass) physical = static_cast<int>(j);
+        }
+        if (physical < 0) {
+            physical = static_cast<int>(m_Physical.size());
+            m_Physical.push_back(info.Desc);
+            m_PhysicalLastPass.push_back(-1);
+            m_Stats.PhysicalBytes += GetBytes(info.Desc);
+        }
+        m_PhysicalLastPass[physical] = info.LastPass;
+        info.Physical = physical;
+        m_Stats.TransientBytes += GetBytes(info.Desc);
+    }
+    m_Stats.Transients = static_cast<uint32_t>(m_Transients.size());
+    m_Stats.PhysicalTextures = static_cast<uint32_t>(m_Physical.size());
+
+    // Discards, and the most bytes alive at once
+    for (int i = 0; i < static_cast<int>(m_Order.size()); ++i) {
+        Pass& pass = m_Passes[m_Order[i]];
+        if (pass.Culled) continue;
+        for (RenderResource attachment : {pass.Color, pass.Depth}) {
+            if (attachment == InvalidRenderResource) continue;
+            const Resource& info = m_Resources[attachment];
+            if (info.FirstPass == i && !Contains(pass.Reads, attachment)) pass.DiscardBefore.push_back(attachment);
+            if (info.LastPass == i) pass.DiscardAfter.push_back(attachment);
+        }
+        m_Stats.Discards += static_cast<uint32_t>(pass.DiscardBefore.size() + pass.DiscardAfter.size());
+        uint64_t live = 0;
+        for (RenderResource resource : m_Transients) {
+            const Resource& info = m_Resources[resource];
+            if (info.FirstPass <= i && i <= info.LastPass) live += GetBytes(info.Desc);
+        }
+        m_Stats.PeakLiveBytes = std::max(m_Stats.PeakLiveBytes, live);
+    }
+}
+
+std::string RenderGraph::Describe() const {
+    std::string kept, culled;
+    for (uint32_t index : m_Order) {
+        const Pass& pass = m_Passes[index];
+        std::string& list = pass.Culled ? culled : kept;
+        if (!list.empty()) list += pass.Culled ? ", " : " > ";
+        list += pass.Name;
+    }
+    if (!culled.empty()) kept += " (culled: " + culled + ")";
+    return kept;
+}
@@ -0,0 +1,196 @@
+// src/RenderGraphExecutor.cpp
+
+#include "RenderGraphExecutor.h"
+#include "GLExtensions.h"
+#include "GpuProfiler.h"
+
+#include <iostream>
+
+namespace {
+    const char* GetFormatName(RenderFormat format) {
+        switch (format) {
+            case RenderFormat::RGBA8: return "RGBA8";
+            case RenderFormat::RGBA16F: return "RGBA16F";
+            case RenderFormat::Depth24: return "Depth24";
+        }
+        return "unknown";
+    }
+
+    GLenum GetAttachment(const RenderTextureDesc& desc) {
+        return RenderGraph::IsDepthFormat(desc.Format) ? GL_DEPTH_ATTACHMENT : GL_COLOR_ATTACHMENT0;
+    }
+}
+
+RenderGraphExecutor::RenderGraphExecutor() {}
+
+RenderGraphExecutor::~RenderGraphExecutor() {
+    Shutdown();
+}
+
+void RenderGraphExecutor::Shutdown() {
+    for (const CachedFramebuffer& cached : m_Framebuffers) glDeleteFramebuffers(1, &cached.Framebuffer);
+    for (const PooledTexture& pooled : m_Pool) glDeleteTextures(1, &pooled.Texture);
+    m_Framebuffers.clear();
+    m_Pool.clear();
+    m_Physical.clear();
+    m_Stats = Stats{};
+}
+
+void RenderGraphExecutor::Execute(const RenderGraph& graph, GpuProfiler* profiler) {
+    m_Frame++;
+    m_Graph = &graph;
+    const std::vector<RenderTextureDesc>& physical = graph.GetPhysicalTextures();
+    m_Physical.resize(physical.size());
+    for (size_t i = 0; i < physical.size(); ++i) m_Physical[i] = AcquireTexture(physical[i]);
+    Evict();
+
+    m_Stats.Invalidated = 0;
+    for (uint32_t index : graph.GetOrder()) {
+        const RenderGraph::Pass& pass = graph.GetPasses()[index];
+        if (pass.Culled) continue;
+        GpuProfileScope scope(profiler, pass.Name);
+        BindTarget(pass);
+        Invalidate(pass.DiscardBefore);
+        if (pass.Execute) pass.Execute(*this);
+        if (!pass.DiscardAfter.empty()) {
+            BindTarget(pass); // The pass may have bound something else since
+            Invalidate(pass.DiscardAfter);
+        }
+    }
+    m_Graph = nullptr;
+
+    m_Stats.Textures = static_cast<uint32_t>(m_Pool.size());
+    m_Stats.Bytes = 0;
+    for (const PooledTexture& pooled : m_Pool) m_Stats.Bytes += RenderGraph::GetBytes(pooled.Desc);
+    m_Stats.Framebuffers = static_cast<uint32_t>(m_Framebuffers.size());
+}
+
+GLuint RenderGraphExecutor::GetTexture(RenderResource resource) const {
+    if (!m_Graph || resource >= m_Graph->GetResources().size()) return 0;
+    const int physical = m_Graph->GetResources()[resource].Physical;
+    return physical >= 0 ? m_Physical[physical] : 0;
+}
+
+GLuint RenderGraphExecutor::GetFramebuffer(RenderResource resource) const {
+    const GLuint texture = GetTexture(resource);
+    if (!texture) return 0;
+    const bool depth = RenderGraph::IsDepthFormat(m_Graph->GetResources()[resource].Desc.Format);
+    return FindFramebuffer(depth ? 0 : texture, depth ? texture : 0);
+}
+
+GLuint RenderGraphExecutor::AcquireTexture(const RenderTextureDesc& desc) {
+    for (PooledTexture& pooled : m_Pool) {
+        if (pooled.Desc == desc && pooled.LastUsed != m_Frame) {
+            pooled.LastUsed = m_Frame;
+            return pooled.Texture;
+        }
+    }
+
+    PooledTexture pooled;
+    pooled.Desc = desc;
+    pooled.LastUsed = m_Frame;
+    glGenTextures(1, &pooled.Texture);
+    glBindTexture(GL_TEXTURE_2D, pooled.Texture);
+    const GLint filter = RenderGraph::IsDepthFormat(desc.Format) ? GL_NEAREST : GL_LINEAR;
+    switch (desc.Format) {
+        case RenderFormat::RGBA8:
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, desc.Width, desc.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            break;
+        case RenderFormat::RGBA16F:
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, desc.Width, desc.Height, 0, GL_RGBA, GL_HALF_FLOAT, nullptr);
+            break;
+        case RenderFormat::Depth24:
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, desc.Width, desc.Height, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, nullptr);
+            break;
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    m_Pool.push_back(pooled);
+    m_Stats.Created++;
+    std::cout << "INFO::RENDER_GRAPH::Pooled " << desc.Width << "x" << desc.Height << " " << GetFormatName(desc.Format) << " texture ("
+              << RenderGraph::GetBytes(desc) / 1024 << " KB, " << m_Pool.size() << " in the pool)." << std::endl;
+    return pooled.Texture;
+}
+
+// Frees textures the graph stopped asking for (a smaller scene target, a pass switched off), and
+// the framebuffers they were attached to.
+void RenderGraphExecutor::Evict() {
+    for (size_t i = 0; i < m_Pool.size();) {
+        if (m_Frame - m_Pool[i].LastUsed <= EvictAfterFrames) {
+            ++i;
+            continue;
+        }
+        const GLuint texture = m_Pool[i].Texture;
+        for (size_t j = 0; j < m_Framebuffers.size();) {
+            if (m_Framebuffers[j].Color == texture || m_Framebuffers[j].Depth == texture) {
+                glDeleteFramebuffers(1, &m_Framebuffers[j].Framebuffer);
+                m_Framebuffers[j] = m_Framebuffers.back();
+                m_Framebuffers.pop_back();
+            } else {
+                ++j;
+            }
+        }
+        glDeleteTextures(1, &texture);
+        m_Pool[i] = m_Pool.back();
+        m_Pool.pop_back();
+    }
+}
+
+GLuint RenderGraphExecutor::FindFramebuffer(GLuint color, GLuint depth) const {
+    for (const CachedFramebuffer& cached : m_Framebuffers) {
+        if (cached.Color == color && cached.Depth == depth) return cached.Framebuffer;
+    }
+
+    // Passes may ask for one mid-pass (to blit from), so leave their bindings as they were
+    GLint drawFramebuffer = 0, readFramebuffer = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFramebuffer);
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer);
+    CachedFramebuffer cached;
+    cached.Color = color;
+    cached.Depth = depth;
+    glGenFramebuffers(1, &cached.Framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, cached.Framebuffer);
+    if (color) glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+    if (depth) glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depth, 0);
+    if (!color) {
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+    }
+    const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(drawFramebuffer));
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(readFramebuffer));
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "ERROR::RENDER_GRAPH::Incomplete framebuffer (status 0x" << std::hex << status << std::dec << ")." << std::endl;
+        glDeleteFramebuffers(1, &cached.Framebuffer);
+        return 0;
+    }
+    m_Framebuffers.push_back(cached);
+    return cached.Framebuffer;
+}
+
+void RenderGraphExecutor::BindTarget(const RenderGraph::Pass& pass) const {
+    const std::vector<RenderGraph::Resource>& resources = m_Graph->GetResources();
+    if (pass.Color != InvalidRenderResource || pass.Depth != InvalidRenderResource) {
+        const RenderResource sized = pass.Color != InvalidRenderResource ? pass.Color : pass.Depth;
+        glBindFramebuffer(GL_FRAMEBUFFER, FindFramebuffer(GetTexture(pass.Color), GetTexture(pass.Depth)));
+        glViewport(0, 0, resources[sized].Desc.Width, resources[sized].Desc.Height);
+    } else if (pass.Target != InvalidRenderResource) {
+        const RenderGraph::Resource& target = resources[pass.Target];
+        glBindFramebuffer(GL_FRAMEBUFFER, target.Framebuffer);
+        glViewport(0, 0, target.Desc.Width, target.Desc.Height);
+    }
+}
+
+void RenderGraphExecutor::Invalidate(const std::vector<RenderResource>& attachments) {
+    if (attachments.empty() || !GLExtensions::InvalidateFramebuffer) return;
+    GLenum names[2];
+    GLsizei count = 0;
+    for (RenderResource resource : attachments) {
+        if (count < 2) names[count++] = GetAttachment(m_Graph->GetResources()[resource].Desc);
+    }
+    GLExtensions::InvalidateFramebuffer(GL_FRAMEBUFFER, count, names);
+    m_Stats.Invalidated += static_cast<uint32_t>(count);
+}
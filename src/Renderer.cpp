@@ -1,12 +1,32 @@
 #include "Renderer.h"
 #include "Shader.h"
 #include "Mesh.h" // <-- Include Mesh
+#include "GLExtensions.h"
+#include "StreamingBuffer.h"
+#include "CommandList.h"
+#include "MaterialLibrary.h"
+#include "TextureArray.h"
+#include "Framebuffer.h"
+#include "GeometryBuffer.h"
 
 #include <SDL2/SDL.h>
 #include <glad/glad.h>
 #include <SDL2/SDL_opengl.h>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
 
+namespace {
+    const GLsizeiptr FRAME_STREAM_BYTES = 4 * 1024 * 1024; // Per frame, per region
+    const int FRAME_STREAM_REGIONS = 3;                    // Triple-buffered
+
+    // DRAW_BATCH attribute locations in lit_textured.vert and depth_only.vert; a mat4 takes four
+    const GLuint BATCH_MODEL_LOCATION = 3;
+    const GLuint BATCH_MVP_LOCATION = 7;
+    const GLuint BATCH_MATERIAL_UV_LOCATION = 11;
+    const GLuint BATCH_MATERIAL_LAYER_LOCATION = 12;
+}
+
 Renderer::Renderer() : m_Context(nullptr) {}
 
 Renderer::~Renderer() {
@@ -44,6 +64,7 @@ bool Renderer::Initialize(SDL_Window* window) {
         return false;
     }
     std::cout << "INFO::RENDERER::GLAD initialized." << std::endl;
+    GLExtensions::Load((GLADloadproc)SDL_GL_GetProcAddress); // Post-4.1 entry points, if the driver has them
     std::cout << "INFO::RENDERER::OpenGL Version: " << glGetString(GL_VERSION) << std::endl;
     std::cout << "INFO::RENDERER::GLSL Version: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << std::endl;
     std::cout << "INFO::RENDERER::Vendor: " << glGetString(GL_VENDOR) << std::endl;
@@ -64,11 +85,17 @@ bool Renderer::Initialize(SDL_Window* window) {
     int width, height;
     SDL_GetWindowSize(window, &width, &height);
     glViewport(0, 0, width, height);
+    // Swap interval is left to the application's pacing mode (SetSwapInterval)
 
-
-    // Enable VSync (optional, but good for reducing tearing)
-    if (SDL_GL_SetSwapInterval(1) < 0) {
-        std::cout << "WARN::RENDERER: Unable to set VSync! SDL Error: " << SDL_GetError() << std::endl;
+    // --- Per-frame streaming storage for the per-draw data of draw batches, the ring's only user ---
+    if (GLExtensions::HasMultiDrawIndirect() && GLExtensions::HasBaseInstance()) {
+        m_FrameStream = std::make_unique<StreamingBuffer>();
+        if (!m_FrameStream->Initialize(GL_ARRAY_BUFFER, FRAME_STREAM_BYTES, FRAME_STREAM_REGIONS)) {
+            std::cout << "WARN::RENDERER: Frame streaming buffer unavailable." << std::endl;
+            m_FrameStream.reset();
+        }
+    } else {
+        std::cout << "INFO::RENDERER::No multi-draw indirect with base instance, frame streaming buffer not created." << std::endl;
     }
 
 
@@ -76,6 +103,8 @@ bool Renderer::Initialize(SDL_Window* window) {
 }
 
 void Renderer::Shutdown() {
+    m_FrameStream.reset(); // Needs the context for glDeleteSync/glDeleteBuffers
+    m_Offscreen.reset();
     if (m_Context) {
         SDL_GL_DeleteContext(m_Context);
         m_Context = nullptr;
@@ -83,9 +112,16 @@ void Renderer::Shutdown() {
     }
 }
 
-void Renderer::Clear() const {
+void Renderer::BeginFrame() {
+    if (m_FrameStream) m_FrameStream->BeginFrame();
+    m_BatchStats = BatchStats();
+    if (m_Offscreen) m_Offscreen->Bind(); // ImGui and other passes may have rebound state since
+}
+
+void Renderer::Clear() {
     // Clear the color buffer and depth buffer
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    m_BoundVAO = 0; // Don't trust the cache across frames
 }
 
 // Change parameter type to Mesh
@@ -96,8 +132,11 @@ void Renderer::PrepareDraw(const Shader& shader, const Mesh& mesh, const glm::ma
     // Set MVP uniform (assuming shader has SetMat4)
     shader.SetMat4("uMVP", mvpMatrix); // Assuming PrepareDraw still sets MVP
 
-    // Bind the Mesh's VAO
-    mesh.Bind();            // <-- Call Mesh::Bind()
+    // Meshes sharing a GeometryBuffer share a VAO, so only bind when it changes
+    if (mesh.GetVAO() != m_BoundVAO) {
+        mesh.Bind();
+        m_BoundVAO = mesh.GetVAO();
+    }
     m_CurrentMesh = &mesh; // <-- Store pointer to Mesh
 }
 
@@ -109,11 +148,192 @@ void Renderer::DrawPrepared() const {
     }
 }
 
+void Renderer::SubmitPacket(const Shader& shader, const DrawPacket& packet, const DrawUniforms& uniforms) {
+    if (!packet.MeshRef) return;
+    if (packet.MaterialRef) {
+        // Materials in the same array only change the layer and rect uniforms
+        const Material& material = *packet.MaterialRef;
+        if (material.Array && material.Array != m_BoundArray) {
+            material.Array->Bind(0);
+            m_BoundArray = material.Array;
+        }
+        if (&material != m_BoundMaterial || &shader != m_MaterialShader) {
+            shader.Use();
+            shader.SetFloat("uMaterialLayer", static_cast<float>(material.Layer));
+            shader.SetVec4("uMaterialUV", material.UVTransform);
+            m_BoundMaterial = &material;
+            m_MaterialShader = &shader;
+        }
+    }
+    PrepareDraw(shader, *packet.MeshRef, uniforms.MVP);
+    shader.SetMat4("uModel", uniforms.Model);
+    DrawPrepared();
+}
+
+void Renderer::SubmitDepthPacket(const Shader& shader, const DrawPacket& packet, const DrawUniforms& uniforms) {
+    if (packet.MeshRef) SubmitDepthDraw(shader, *packet.MeshRef, uniforms.MVP);
+}
+
+void Renderer::SubmitDepthDraw(const Shader& shader, const Mesh& mesh, const glm::mat4& mvp) {
+    if (!mesh.GetGeometry()) return;
+    shader.Use();
+    m_CurrentShader = &shader;
+    shader.SetMat4("uMVP", mvp);
+    if (mesh.GetPositionVAO() != m_BoundVAO) {
+        mesh.GetGeometry()->BindPositionOnly();
+        m_BoundVAO = mesh.GetPositionVAO();
+    }
+    mesh.GetGeometry()->Draw(mesh.GetRange());
+    m_CurrentMesh = nullptr; // DrawPrepared would draw through the wrong VAO
+}
+
+bool Renderer::SupportsDrawBatches() const {
+    return m_FrameStream && GLExtensions::HasMultiDrawIndirect() && GLExtensions::HasBaseInstance();
+}
+
+void Renderer::SubmitBatched(const Shader& shader, const DrawPacket& packet, const DrawUniforms& uniforms) {
+    Batch(shader, packet, uniforms, false);
+}
+
+void Renderer::SubmitDepthBatched(const Shader& shader, const DrawPacket& packet, const DrawUniforms& uniforms) {
+    Batch(shader, packet, uniforms, true);
+}
+
+void Renderer::Batch(const Shader& shader, const DrawPacket& packet, const DrawUniforms& uniforms, bool positionOnly) {
+    if (!packet.MeshRef || !packet.MeshRef->GetGeometry() || !packet.MeshRef->GetRange().IsValid()) return;
+    GeometryBuffer* geometry = packet.MeshRef->GetGeometry();
+    const Material* material = positionOnly ? nullptr : packet.MaterialRef;
+    const TextureArray* array = material ? material->Array : nullptr;
+
+    // Anything that needs a bind between two draws ends the batch
+    if (!m_BatchRanges.empty() &&
+        (&shader != m_BatchShader || geometry != m_BatchGeometry || positionOnly != m_BatchPositionOnly ||
+         (array && m_BatchArray && array != m_BatchArray))) {
+        FlushBatch();
+    }
+    m_BatchShader = &shader;
+    m_BatchGeometry = geometry;
+    m_BatchPositionOnly = positionOnly;
+    if (array) m_BatchArray = array;
+
+    BatchInstance instance;
+    instance.Model = uniforms.Model;
+    instance.MVP = uniforms.MVP;
+    instance.MaterialUV = material ? material->UVTransform : glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+    instance.MaterialLayer = material ? static_cast<float>(material->Layer) : 0.0f;
+    m_BatchInstances.push_back(instance);
+    m_BatchRanges.push_back(packet.MeshRef->GetRange());
+}
+
+void Renderer::FlushBatch() {
+    if (m_BatchRanges.empty()) return;
+    GeometryBuffer& geometry = *m_BatchGeometry;
+    m_BatchShader->Use();
+    m_CurrentShader = m_BatchShader;
+    m_CurrentMesh = nullptr; // DrawPrepared would draw a stale mesh
+    if (m_BatchArray && m_BatchArray != m_BoundArray) {
+        m_BatchArray->Bind(0);
+        m_BoundArray = m_BatchArray;
+    }
+    const GLuint vao = m_BatchPositionOnly ? geometry.GetPositionVAO() : geometry.GetVAO();
+    if (vao != m_BoundVAO) {
+        if (m_BatchPositionOnly) geometry.BindPositionOnly();
+        else geometry.Bind();
+        m_BoundVAO = vao;
+    }
+
+    // BeginFrame waited on this region's fence, so the GPU no longer reads what gets overwritten here
+    const GLsizeiptr bytes = static_cast<GLsizeiptr>(m_BatchInstances.size() * sizeof(BatchInstance));
+    StreamAllocation allocation;
+    if (m_FrameStream && geometry.SupportsMultiDrawIndirect()) allocation = m_FrameStream->Allocate(bytes);
+    if (allocation.IsValid()) {
+        std::memcpy(allocation.Data, m_BatchInstances.data(), static_cast<size_t>(bytes));
+        m_FrameStream->Commit(allocation);
+        SetBatchAttributes(m_FrameStream->GetBufferID(), allocation.Offset);
+        // Draw i fetches instance i of the allocation
+        m_BatchCommands.clear();
+        for (size_t i = 0; i < m_BatchRanges.size(); ++i) {
+            m_BatchCommands.push_back(GeometryBuffer::MakeCommand(m_BatchRanges[i], 1, static_cast<GLuint>(i)));
+        }
+        geometry.DrawBatch(m_BatchCommands);
+        ++m_BatchStats.Batches;
+        m_BatchStats.Draws += static_cast<uint32_t>(m_BatchCommands.size());
+    } else {
+        // No room left in the stream this frame: same program, one draw each with constant attributes
+        for (GLuint location = BATCH_MODEL_LOCATION; location <= BATCH_MATERIAL_LAYER_LOCATION; ++location) {
+            glDisableVertexAttribArray(location);
+        }
+        for (size_t i = 0; i < m_BatchRanges.size(); ++i) {
+            SetBatchConstants(m_BatchInstances[i]);
+            geometry.Draw(m_BatchRanges[i]);
+        }
+    }
+
+    m_BatchInstances.clear();
+    m_BatchRanges.clear();
+    m_BatchShader = nullptr;
+    m_BatchGeometry = nullptr;
+    m_BatchArray = nullptr;
+}
+
+void Renderer::SetBatchAttributes(unsigned int buffer, intptr_t offset) {
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    auto attribute = [offset](GLuint location, GLint size, size_t member) {
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, size, GL_FLOAT, GL_FALSE, sizeof(BatchInstance),
+                              (void*)(static_cast<size_t>(offset) + member));
+        glVertexAttribDivisor(location, 1);
+    };
+    for (GLuint column = 0; column < 4; ++column) {
+        attribute(BATCH_MODEL_LOCATION + column, 4, offsetof(BatchInstance, Model) + column * sizeof(glm::vec4));
+        attribute(BATCH_MVP_LOCATION + column, 4, offsetof(BatchInstance, MVP) + column * sizeof(glm::vec4));
+    }
+    attribute(BATCH_MATERIAL_UV_LOCATION, 4, offsetof(BatchInstance, MaterialUV));
+    attribute(BATCH_MATERIAL_LAYER_LOCATION, 1, offsetof(BatchInstance, MaterialLayer));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Renderer::SetBatchConstants(const BatchInstance& instance) {
+    for (GLuint column = 0; column < 4; ++column) {
+        glVertexAttrib4fv(BATCH_MODEL_LOCATION + column, &instance.Model[column][0]);
+        glVertexAttrib4fv(BATCH_MVP_LOCATION + column, &instance.MVP[column][0]);
+    }
+    glVertexAttrib4fv(BATCH_MATERIAL_UV_LOCATION, &instance.MaterialUV[0]);
+    glVertexAttrib1f(BATCH_MATERIAL_LAYER_LOCATION, instance.MaterialLayer);
+}
 
 void Renderer::Present(SDL_Window* window) {
     if (window && m_Context) {
-       SDL_GL_SwapWindow(window);
+       if (m_FrameStream) m_FrameStream->EndFrame(); // Fence everything this frame wrote
+       if (m_Offscreen) glFlush(); // Nothing on screen; the image stays in the target for readback
+       else SDL_GL_SwapWindow(window);
        m_CurrentShader = nullptr;
        m_CurrentMesh = nullptr; // <-- Reset m_CurrentMesh
+       m_BoundVAO = 0;
+       m_BoundArray = nullptr;
+       m_BoundMaterial = nullptr;
+       m_MaterialShader = nullptr;
+       m_LastBatchStats = m_BatchStats;
+    }
+}
+
+bool Renderer::SetOffscreenTarget(int width, int height) {
+    if (!m_Offscreen) m_Offscreen = std::make_unique<Framebuffer>();
+    if (!m_Offscreen->Create(width, height)) {
+        m_Offscreen.reset();
+        return false;
+    }
+    m_Offscreen->Bind();
+    return true;
+}
+
+int Renderer::SetSwapInterval(int interval) {
+    if (SDL_GL_SetSwapInterval(interval) == 0) return interval;
+    if (interval < 0) {
+        std::cout << "WARN::RENDERER: Adaptive VSync unsupported, using regular VSync. SDL Error: " << SDL_GetError() << std::endl;
+        interval = 1;
+        if (SDL_GL_SetSwapInterval(interval) == 0) return interval;
     }
-}
\ No newline at end of file
+    std::cout << "WARN::RENDERER: Unable to set swap interval " << interval << "! SDL Error: " << SDL_GetError() << std::endl;
+    return SDL_GL_GetSwapInterval();
+}
@@ -0,0 +1,41 @@
+// src/ResolutionScaler.cpp
+
+#include "ResolutionScaler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const double TARGET_UTILIZATION = 0.9; // Aim under the budget so noise doesn't push frames over
+    const double SMOOTHING = 0.25;         // Weight of a new measurement in the running estimates
+    const float RISE_RATE = 0.1f;          // Share of the way up taken per measurement
+    const float MAX_RISE = 0.02f;          // Scale gained per measurement at most; drops are not limited
+}
+
+float ResolutionScaler::Update(double milliseconds, uint32_t latencyFrames, const Settings& settings) {
+    const float minScale = std::min(settings.MinScale, settings.MaxScale);
+    const float maxScale = settings.MaxScale;
+    const bool known = latencyFrames >= 1 && latencyFrames <= static_cast<uint32_t>(HistorySize) && latencyFrames <= m_Frames;
+    if (milliseconds > 0.0 && known && settings.BudgetMilliseconds > 0.0f) {
+        const float renderedScale = m_History[(m_Frames - latencyFrames) % HistorySize];
+        const double costPerPixel = milliseconds / std::max(renderedScale * renderedScale, 1e-4f);
+        m_CostPerPixel = m_CostPerPixel > 0.0 ? m_CostPerPixel + (costPerPixel - m_CostPerPixel) * SMOOTHING : costPerPixel;
+        m_SmoothedMilliseconds = m_SmoothedMilliseconds > 0.0 ? m_SmoothedMilliseconds + (milliseconds - m_SmoothedMilliseconds) * SMOOTHING : milliseconds;
+        m_Headroom = static_cast<float>(1.0 - m_SmoothedMilliseconds / settings.BudgetMilliseconds);
+
+        // Over budget: drop straight to the estimate. Under: climb slowly, so one quiet frame
+        // doesn't bounce the scale back up into a spike
+        const float fit = static_cast<float>(std::sqrt(settings.BudgetMilliseconds * TARGET_UTILIZATION / m_CostPerPixel));
+        if (fit < m_Scale) m_Scale = fit;
+        else m_Scale += std::min((fit - m_Scale) * RISE_RATE, MAX_RISE);
+    }
+    m_Scale = std::clamp(m_Scale, minScale, maxScale);
+    m_History[m_Frames % HistorySize] = m_Scale;
+    m_Frames++;
+    return m_Scale;
+}
+
+void ResolutionScaler::Reset(float scale) {
+    *this = ResolutionScaler{};
+    m_Scale = scale;
+}
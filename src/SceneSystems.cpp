@@ -0,0 +1,192 @@
+// src/SceneSystems.cpp
+
+#include "SceneSystems.h"
+#include "JobSystem.h"
+
+#include <SDL2/SDL_mixer.h>
+#include <glm/gtc/quaternion.hpp>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    const float TWO_PI = 6.28318530718f;
+    const float PI = 3.14159265359f;
+
+    // Angles are kept wrapped, so a step can cross the wrap; take the short way between them
+    float LerpAngle(float from, float to, float alpha) {
+        float delta = to - from;
+        if (delta > PI) delta -= TWO_PI;
+        else if (delta < -PI) delta += TWO_PI;
+        return from + delta * alpha;
+    }
+}
+
+namespace SceneSystems {
+
+    System CreateRotationSystem(World& world) {
+        Query query = world.CreateQuery<Spin>();
+        System system;
+        system.Name = "Rotation";
+        system.Reads = MaskOf<Spin>();
+        system.Writes = MaskOf<Spin>();
+        system.Run = [query](World& world, float deltaTime, JobSystem* jobs) {
+            world.ForEachChunkParallel(query, jobs, [&](const ChunkView& chunk) {
+                Spin* spins = chunk.Get<Spin>();
+                for (size_t i = 0; i < chunk.Size(); ++i) {
+                    spins[i].PreviousAngle = spins[i].Angle;
+                    spins[i].Angle = std::fmod(spins[i].Angle + spins[i].Speed * deltaTime, TWO_PI);
+                }
+            });
+        };
+        return system;
+    }
+
+    System CreateSpinPoseSystem(World& world, TransformSystem& transforms, const float& alpha) {
+        Query query = world.CreateQuery<Spin, TransformComponent>();
+        System system;
+        system.Name = "SpinPose";
+        system.Reads = MaskOf<Spin, TransformComponent>();
+        system.Writes = MaskOf<TransformComponent>();
+        system.Run = [query, &transforms, &alpha](World& world, float deltaTime, JobSystem* jobs) {
+            if (deltaTime <= 0.0f) return; // Paused: leave the hierarchy clean
+            // Distinct handles touch distinct slots in the hierarchy, so chunks can run in parallel
+            world.ForEachChunkParallel(query, jobs, [&](const ChunkView& chunk) {
+                const Spin* spins = chunk.Get<Spin>();
+                const TransformComponent* nodes = chunk.Get<TransformComponent>();
+                for (size_t i = 0; i < chunk.Size(); ++i) {
+                    const float angle = LerpAngle(spins[i].PreviousAngle, spins[i].Angle, alpha);
+                    transforms.SetLocalRotation(nodes[i].Handle, glm::angleAxis(angle, spins[i].Axis));
+                }
+            });
+        };
+        return system;
+    }
+
+    System CreateRenderListSystem(World& world, TransformSystem& transforms, std::vector<SceneObject>& renderList) {
+        Query query = world.CreateQuery<MeshRenderer, TransformComponent>();
+        System system;
+        system.Name = "RenderList";
+        system.Reads = MaskOf<MeshRenderer, TransformComponent>();
+        system.Writes = MaskOf<TransformComponent>(); // Updates the hierarchy's world matrices
+        system.Run = [query, &transforms, &renderList](World& world, float, JobSystem* jobs) {
+            transforms.Update(jobs); // Only dirty subtrees are recomputed
+            renderList.clear();
+            world.ForEachChunk(query, [&](const ChunkView& chunk) {
+                const Entity* entities = chunk.GetEntities();
+                const MeshRenderer* renderers = chunk.Get<MeshRenderer>();
+                const TransformComponent* nodes = chunk.Get<TransformComponent>();
+                for (size_t i = 0; i < chunk.Size(); ++i) {
+                    if (!renderers[i].MeshRef) continue;
+                    SceneObject object;
+                    object.Owner = entities[i];
+                    object.MeshRef = renderers[i].MeshRef;
+                    object.MaterialRef = renderers[i].MaterialRef;
+                    object.Transform = nodes[i].Handle;
+                    object.Model = transforms.GetWorldMatrix(nodes[i].Handle);
+                    object.OccluderIndex = renderers[i].OccluderIndex;
+                    object.OcclusionQuery = renderers[i].OcclusionQuery;
+                    object.Static = renderers[i].Static;
+                    renderList.push_back(object);
+                }
+            });
+        };
+        return system;
+    }
+
+    System CreateLightOrbitSystem(World& world) {
+        Query query = world.CreateQuery<LightOrbit>();
+        System system;
+        system.Name = "LightOrbit";
+        system.Reads = MaskOf<LightOrbit>();
+        system.Writes = MaskOf<LightOrbit>();
+        system.Run = [query](World& world, float deltaTime, JobSystem* jobs) {
+            world.ForEachChunkParallel(query, jobs, [&](const ChunkView& chunk) {
+                LightOrbit* orbits = chunk.Get<LightOrbit>();
+                for (size_t i = 0; i < chunk.Size(); ++i) {
+                    orbits[i].PreviousAngle = orbits[i].Angle;
+                    orbits[i].Angle = std::fmod(orbits[i].Angle + orbits[i].Speed * deltaTime, TWO_PI);
+                }
+            });
+        };
+        return system;
+    }
+
+    System CreateLightPoseSystem(World& world, const float& alpha) {
+        Query query = world.CreateQuery<LightOrbit, Light>();
+        System system;
+        system.Name = "LightPose";
+        system.Reads = MaskOf<LightOrbit, Light>();
+        system.Writes = MaskOf<Light>();
+        system.Run = [query, &alpha](World& world, float deltaTime, JobSystem* jobs) {
+            if (deltaTime <= 0.0f) return;
+            world.ForEachChunkParallel(query, jobs, [&](const ChunkView& chunk) {
+                const LightOrbit* orbits = chunk.Get<LightOrbit>();
+                Light* lights = chunk.Get<Light>();
+                for (size_t i = 0; i < chunk.Size(); ++i) {
+                    const LightOrbit& orbit = orbits[i];
+                    const float angle = LerpAngle(orbit.PreviousAngle, orbit.Angle, alpha);
+                    lights[i].Position = orbit.Center + glm::vec3(orbit.Radius * std::cos(angle), orbit.Height, orbit.Radius * std::sin(angle));
+                    if (lights[i].SpotOuterCos > -1.0f) lights[i].Direction = glm::normalize(orbit.Center - lights[i].Position);
+                }
+            });
+        };
+        return system;
+    }
+
+    System CreateLightListSystem(World& world, std::vector<Light>& lights) {
+        Query query = world.CreateQuery<Light>();
+        System system;
+        system.Name = "LightList";
+        system.Reads = MaskOf<Light>();
+        system.Run = [query, &lights](World& world, float, JobSystem*) {
+            lights.clear();
+            world.ForEachChunk(query, [&](const ChunkView& chunk) {
+                const Light* source = chunk.Get<Light>();
+                lights.insert(lights.end(), source, source + chunk.Size());
+            });
+        };
+        return system;
+    }
+
+    System CreateAudioSystem(World& world) {
+        Query query = world.CreateQuery<AudioSource>();
+        System system;
+        system.Name = "Audio";
+        system.Reads = MaskOf<AudioSource>();
+        system.Writes = MaskOf<AudioSource>();
+        system.MainThreadOnly = true;
+        system.Run = [query](World& world, float, JobSystem*) {
+            world.ForEachChunk(query, [&](const ChunkView& chunk) {
+                AudioSource* sources = chunk.Get<AudioSource>();
+                for (size_t i = 0; i < chunk.Size(); ++i) {
+                    AudioSource& source = sources[i];
+                    switch (source.Request) {
+                    case AudioRequest::Play:
+                        if (source.Channel != -1) Mix_HaltChannel(source.Channel);
+                        source.Channel = source.Clip ? Mix_PlayChannel(-1, source.Clip, source.Loops) : -1;
+                        if (source.Clip && source.Channel == -1) std::cerr << "ERROR::AUDIO::Mix_PlayChannel failed: " << Mix_GetError() << std::endl;
+                        else if (source.Clip) std::cout << "INFO::AUDIO::Playing sound on channel " << source.Channel << std::endl;
+                        break;
+                    case AudioRequest::Pause:
+                        if (source.Channel != -1) Mix_Pause(source.Channel);
+                        break;
+                    case AudioRequest::Resume:
+                        if (source.Channel != -1) Mix_Resume(source.Channel);
+                        break;
+                    case AudioRequest::Stop:
+                        if (source.Channel != -1) Mix_HaltChannel(source.Channel);
+                        source.Channel = -1;
+                        break;
+                    case AudioRequest::None:
+                        break;
+                    }
+                    source.Request = AudioRequest::None;
+                    // Mix_Playing stays true while paused, so this only catches sounds that ran out
+                    if (source.Channel != -1 && !Mix_Playing(source.Channel)) source.Channel = -1;
+                }
+            });
+        };
+        return system;
+    }
+
+} // namespace SceneSystems
@@ -2,6 +2,7 @@
 
 #include "Shader.h"      // Header for this implementation file
 #include "FileUtils.h"   // Needed for FileUtils::ReadFile
+#include "Profiler.h"
 
 #include <glad/glad.h>   // Needed for GL types (GLuint, GLint) and functions
 #include <glm/gtc/type_ptr.hpp> // Needed for glm::value_ptr
@@ -24,6 +25,7 @@ namespace { // Use an anonymous namespace for internal linkage
 // --- Shader Class Implementation ---
 
 Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath) {
+    PROFILE_SCOPE("Shader::Load");
     // 1. Retrieve the vertex/fragment source code from filePath
     std::string vertexCode = FileUtils::ReadFileToString(vertexPath);   // <-- Use ReadFileToString
     std::string fragmentCode = FileUtils::ReadFileToString(fragmentPath); // <-- Use ReadFileToString
@@ -59,6 +61,16 @@ Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath) {
     }
 }
 
+Shader::Shader(GLuint program) : m_ProgramID(program) {}
+
+GLuint Shader::CompileStage(GLenum type, const std::string& source, const std::string& name) {
+    return CompileShader(type, source.c_str(), name);
+}
+
+GLuint Shader::LinkStages(GLuint vertexShader, GLuint fragmentShader) {
+    return LinkProgram(vertexShader, fragmentShader);
+}
+
 Shader::~Shader() {
     if (m_ProgramID != 0) {
         glDeleteProgram(m_ProgramID);
@@ -96,10 +108,18 @@ void Shader::SetMat4(const std::string& name, const glm::mat4& mat) const {
     if (m_ProgramID == 0) return;
     glUniformMatrix4fv(glGetUniformLocation(m_ProgramID, name.c_str()), 1, GL_FALSE, glm::value_ptr(mat));
 }
+void Shader::SetVec2(const std::string& name, const glm::vec2& value) const {
+    if (m_ProgramID == 0) return;
+    glUniform2fv(glGetUniformLocation(m_ProgramID, name.c_str()), 1, glm::value_ptr(value));
+}
 void Shader::SetVec3(const std::string& name, const glm::vec3& value) const {
     if (m_ProgramID == 0) return;
     glUniform3fv(glGetUniformLocation(m_ProgramID, name.c_str()), 1, glm::value_ptr(value));
 }
+void Shader::SetVec4(const std::string& name, const glm::vec4& value) const {
+    if (m_ProgramID == 0) return;
+    glUniform4fv(glGetUniformLocation(m_ProgramID, name.c_str()), 1, glm::value_ptr(value));
+}
 
 
 // --- Static Error Checking Method ---
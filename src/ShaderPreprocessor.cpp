@@ -0,0 +1,123 @@
+// src/ShaderPreprocessor.cpp
+
+#include "ShaderPreprocessor.h"
+#include "FileUtils.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    const int MAX_INCLUDE_DEPTH = 16;
+
+    bool IsIdentifierChar(char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    }
+
+    // "#include "path"" with optional whitespace; fills 'path'. Any other #include form is an error.
+    bool ParseInclude(const std::string& line, std::string& path, bool& malformed) {
+        size_t pos = line.find_first_not_of(" \t");
+        if (pos == std::string::npos || line[pos] != '#') return false;
+        pos = line.find_first_not_of(" \t", pos + 1);
+        if (pos == std::string::npos || line.compare(pos, 7, "include") != 0) return false;
+        const size_t open = line.find('"', pos + 7);
+        const size_t close = open == std::string::npos ? open : line.find('"', open + 1);
+        malformed = close == std::string::npos;
+        if (!malformed) path = line.substr(open + 1, close - open - 1);
+        return true;
+    }
+
+    bool ExpandFile(const std::filesystem::path& path, int depth, std::string& out, std::vector<std::string>& files) {
+        if (depth > MAX_INCLUDE_DEPTH) {
+            std::cerr << "ERROR::SHADER_PREPROCESSOR::Includes nested too deeply at " << path.string() << std::endl;
+            return false;
+        }
+        const std::string normalized = path.lexically_normal().string();
+        for (const std::string& seen : files) {
+            if (seen == normalized) return true; // Already spliced in once
+        }
+        std::string text = FileUtils::ReadFileToString(normalized);
+        if (text.empty()) return false; // ReadFileToString reported it
+        const size_t fileIndex = files.size();
+        files.push_back(normalized);
+        if (fileIndex > 0) out += "#line 1 " + std::to_string(fileIndex) + "\n";
+
+        std::istringstream stream(text);
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(stream, line)) {
+            ++lineNumber;
+            std::string includePath;
+            bool malformed = false;
+            if (!ParseInclude(line, includePath, malformed)) {
+                out += line;
+                out += '\n';
+                continue;
+            }
+            if (malformed) {
+                std::cerr << "ERROR::SHADER_PREPROCESSOR::Malformed #include at " << normalized << ":" << lineNumber << std::endl;
+                return false;
+            }
+            const size_t includeIndex = files.size();
+            if (!ExpandFile(path.parent_path() / includePath, depth + 1, out, files)) {
+                std::cerr << "ERROR::SHADER_PREPROCESSOR::  included from " << normalized << ":" << lineNumber << std::endl;
+                return false;
+            }
+            // Back in this file: the next line is lineNumber + 1
+            if (files.size() != includeIndex) out += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(fileIndex) + "\n";
+        }
+        return true;
+    }
+}
+
+namespace ShaderPreprocessor {
+
+    bool Expand(const std::string& filePath, std::string& outSource, std::vector<std::string>& outFiles) {
+        outSource.clear();
+        outFiles.clear();
+        return ExpandFile(std::filesystem::path(filePath), 0, outSource, outFiles);
+    }
+
+    std::string AddDefines(const std::string& source, const std::vector<std::string>& defines) {
+        if (defines.empty()) return source;
+        std::string block;
+        for (const std::string& define : defines) block += "#define " + define + " 1\n";
+
+        // #version has to stay the first statement
+        size_t insertAt = 0;
+        const size_t version = source.find("#version");
+        if (version != std::string::npos) {
+            const size_t lineEnd = source.find('\n', version);
+            insertAt = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+        }
+        // Keep line numbers of the rest of the file unchanged for compiler messages
+        const int nextLine = 1 + static_cast<int>(std::count(source.begin(), source.begin() + insertAt, '\n'));
+        block += "#line " + std::to_string(nextLine) + " 0\n";
+        std::string result = source.substr(0, insertAt);
+        if (insertAt > 0 && result.back() != '\n') result += '\n';
+        return result + block + source.substr(insertAt);
+    }
+
+    bool References(const std::string& source, const std::string& identifier) {
+        if (identifier.empty()) return false;
+        for (size_t pos = source.find(identifier); pos != std::string::npos; pos = source.find(identifier, pos + 1)) {
+            const bool startsToken = pos == 0 || !IsIdentifierChar(source[pos - 1]);
+            const size_t end = pos + identifier.size();
+            const bool endsToken = end == source.size() || !IsIdentifierChar(source[end]);
+            if (startsToken && endsToken) return true;
+        }
+        return false;
+    }
+
+    uint64_t Hash(const std::string& text) {
+        uint64_t hash = 14695981039346656037ull;
+        for (char c : text) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+}
@@ -0,0 +1,146 @@
+// src/ShaderVariants.cpp
+
+#include "ShaderVariants.h"
+#include "ShaderPreprocessor.h"
+#include "FileUtils.h"
+#include "Profiler.h"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+ShaderVariants::ShaderVariants(const std::string& vertexPath, const std::string& fragmentPath) {
+    m_Vertex.Path = vertexPath;
+    m_Fragment.Path = fragmentPath;
+}
+
+ShaderVariants::~ShaderVariants() {
+    Clear();
+}
+
+uint32_t ShaderVariants::DeclareFeature(const std::string& define) {
+    if (uint32_t existing = GetFeatureMask(define)) return existing;
+    if (m_Features.size() >= static_cast<size_t>(MaxFeatures)) {
+        std::cerr << "ERROR::SHADER_VARIANTS::Too many features, ignoring " << define << std::endl;
+        return 0;
+    }
+    m_Features.push_back(define);
+    return 1u << (m_Features.size() - 1);
+}
+
+uint32_t ShaderVariants::GetFeatureMask(const std::string& define) const {
+    for (size_t i = 0; i < m_Features.size(); ++i) {
+        if (m_Features[i] == define) return 1u << i;
+    }
+    return 0;
+}
+
+bool ShaderVariants::Load() {
+    PROFILE_SCOPE("ShaderVariants::Load");
+    for (StageSource* stage : { &m_Vertex, &m_Fragment }) {
+        if (!ShaderPreprocessor::Expand(stage->Path, stage->Text, stage->Files)) {
+            std::cerr << "ERROR::SHADER_VARIANTS::Could not expand " << stage->Path << std::endl;
+            return false;
+        }
+        stage->UsedFeatures.clear();
+        for (size_t i = 0; i < m_Features.size(); ++i) {
+            if (ShaderPreprocessor::References(stage->Text, m_Features[i])) stage->UsedFeatures.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return true;
+}
+
+GLuint ShaderVariants::GetStage(GLenum type, const StageSource& stage, uint32_t features, uint64_t& outHash) {
+    std::vector<std::string> defines;
+    for (uint32_t index : stage.UsedFeatures) {
+        if (features & (1u << index)) defines.push_back(m_Features[index]);
+    }
+    const std::string source = ShaderPreprocessor::AddDefines(stage.Text, defines);
+    outHash = ShaderPreprocessor::Hash(source) ^ static_cast<uint64_t>(type);
+    auto found = m_Stages.find(outHash);
+    if (found != m_Stages.end()) {
+        m_Stats.StageReuses++;
+        return found->second;
+    }
+
+    const GLuint shader = Shader::CompileStage(type, source, stage.Path + DescribeVariant(features));
+    if (shader == 0) {
+        for (size_t i = 1; i < stage.Files.size(); ++i) std::cerr << "  source string " << i << ": " << stage.Files[i] << std::endl;
+        return 0;
+    }
+    m_Stats.StageCompiles++;
+    m_Stages.emplace(outHash, shader);
+    return shader;
+}
+
+const Shader* ShaderVariants::Get(uint32_t features) {
+    auto found = m_Variants.find(features);
+    if (found != m_Variants.end()) return found->second;
+
+    PROFILE_SCOPE("ShaderVariants::Compile");
+    auto start = std::chrono::steady_clock::now();
+    const Shader* program = nullptr;
+    uint64_t vertexHash = 0, fragmentHash = 0;
+    const GLuint vertex = GetStage(GL_VERTEX_SHADER, m_Vertex, features, vertexHash);
+    const GLuint fragment = vertex ? GetStage(GL_FRAGMENT_SHADER, m_Fragment, features, fragmentHash) : 0;
+    if (vertex && fragment) {
+        const uint64_t programKey = vertexHash * 31 + fragmentHash;
+        auto existing = m_Programs.find(programKey);
+        if (existing != m_Programs.end()) {
+            program = existing->second.get();
+        } else if (GLuint id = Shader::LinkStages(vertex, fragment)) {
+            program = m_Programs.emplace(programKey, std::make_unique<Shader>(id)).first->second.get();
+            m_Stats.Programs++;
+        }
+    }
+    if (!program) std::cerr << "ERROR::SHADER_VARIANTS::Variant" << DescribeVariant(features) << " failed to build." << std::endl;
+    m_Variants.emplace(features, program);
+    m_Stats.Variants++;
+    m_Stats.CompileMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return program;
+}
+
+int ShaderVariants::Prewarm(const std::string& manifestPath) {
+    PROFILE_SCOPE("ShaderVariants::Prewarm");
+    std::istringstream manifest(FileUtils::ReadFileToString(manifestPath));
+    std::string line;
+    int built = 0;
+    while (std::getline(manifest, line)) {
+        const size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        std::istringstream words(line);
+        std::string word;
+        uint32_t features = 0;
+        bool any = false, valid = true;
+        while (words >> word) {
+            any = true;
+            if (word == "-") continue;
+            const uint32_t bit = GetFeatureMask(word);
+            if (bit == 0) {
+                std::cout << "WARN::SHADER_VARIANTS::Unknown feature " << word << " in " << manifestPath << std::endl;
+                valid = false;
+            }
+            features |= bit;
+        }
+        if (any && valid && Get(features)) built++;
+    }
+    std::cout << "INFO::SHADER_VARIANTS::Pre-warmed " << built << " variant(s) of " << m_Fragment.Path << " (" << m_Stats.StageCompiles
+              << " stage compiles, " << m_Stats.StageReuses << " reused, " << m_Stats.CompileMilliseconds << " ms)." << std::endl;
+    return built;
+}
+
+void ShaderVariants::Clear() {
+    m_Variants.clear();
+    m_Programs.clear(); // Shader deletes its program
+    for (auto& stage : m_Stages) glDeleteShader(stage.second);
+    m_Stages.clear();
+    m_Stats = Stats{};
+}
+
+std::string ShaderVariants::DescribeVariant(uint32_t features) const {
+    std::string text = " [";
+    for (size_t i = 0; i < m_Features.size(); ++i) {
+        if (features & (1u << i)) text += (text.size() > 2 ? " " : "") + m_Features[i];
+    }
+    return text + "]";
+}
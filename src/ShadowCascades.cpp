@@ -0,0 +1,88 @@
+// src/ShadowCascades.cpp
+
+#include "ShadowCascades.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const float RADIUS_GRANULARITY = 16.0f; // Radii are rounded up to 1/16 unit so they never change by float noise
+    const float CASTER_MARGIN = 20.0f;      // Depth range kept towards the light for casters outside the cascade
+    const float CACHE_PADDING = 1.25f;      // Cached cascades cover this much more, so the camera can move inside them
+}
+
+ShadowCascades::ShadowCascades(int cascadeCount, int resolution, float shadowDistance, float splitLambda, int firstCachedCascade)
+    : m_CascadeCount(std::min(std::max(cascadeCount, 1), MaxCascades)),
+      m_Resolution(std::max(resolution, 1)),
+      m_ShadowDistance(shadowDistance),
+      m_SplitLambda(splitLambda),
+      m_FirstCachedCascade(std::max(firstCachedCascade, 0)) {}
+
+void ShadowCascades::Update(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& lightDirection, uint32_t staticVersion, bool useCache) {
+    // glm::perspective: [2][2] = -(f+n)/(f-n), [3][2] = -2fn/(f-n)
+    const float nearPlane = projection[3][2] / (projection[2][2] - 1.0f);
+    const float farPlane = std::min(projection[3][2] / (projection[2][2] + 1.0f), m_ShadowDistance);
+    // Half the frustum's diagonal per unit of view depth
+    const float diagonal = std::sqrt(1.0f / (projection[0][0] * projection[0][0]) + 1.0f / (projection[1][1] * projection[1][1]));
+    const glm::mat4 cameraToWorld = glm::inverse(view);
+
+    const glm::vec3 direction = glm::normalize(lightDirection);
+    const glm::vec3 up = std::abs(direction.y) > 0.99f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    // Rotation only: texel snapping in this space is independent of where the cascade is
+    const glm::mat4 lightRotation = glm::lookAt(glm::vec3(0.0f), direction, up);
+
+    if (!useCache || direction != m_CachedLightDirection || staticVersion != m_CachedStaticVersion) {
+        for (CacheState& cache : m_Caches) cache.Valid = false;
+    }
+    m_CachedLightDirection = direction;
+    m_CachedStaticVersion = staticVersion;
+
+    float splitNear = nearPlane;
+    for (int i = 0; i < m_CascadeCount; ++i) {
+        // Practical split scheme: blend of logarithmic and uniform splits
+        const float fraction = static_cast<float>(i + 1) / m_CascadeCount;
+        const float logSplit = nearPlane * std::pow(farPlane / nearPlane, fraction);
+        const float uniformSplit = nearPlane + (farPlane - nearPlane) * fraction;
+        const float splitFar = m_SplitLambda * logSplit + (1.0f - m_SplitLambda) * uniformSplit;
+
+        // Smallest sphere around the slice, centered on the view axis; it does not change as the camera turns
+        const float nearExtent = splitNear * diagonal, farExtent = splitFar * diagonal;
+        const float centerDepth = std::min(std::max((1.0f + diagonal * diagonal) * (splitNear + splitFar) * 0.5f, splitNear), splitFar);
+        float radius = std::max(std::sqrt((centerDepth - splitNear) * (centerDepth - splitNear) + nearExtent * nearExtent),
+                                std::sqrt((splitFar - centerDepth) * (splitFar - centerDepth) + farExtent * farExtent));
+        radius = std::ceil(radius * RADIUS_GRANULARITY) / RADIUS_GRANULARITY;
+        const glm::vec3 worldCenter = glm::vec3(cameraToWorld * glm::vec4(0.0f, 0.0f, -centerDepth, 1.0f));
+        glm::vec3 center = glm::vec3(lightRotation * glm::vec4(worldCenter, 1.0f));
+
+        Cascade& cascade = m_Cascades[i];
+        cascade.SplitFar = splitFar;
+        cascade.Cached = useCache && i >= m_FirstCachedCascade;
+        cascade.StaticDirty = true;
+        if (cascade.Cached) {
+            CacheState& cache = m_Caches[i];
+            const float paddedRadius = std::ceil(radius * CACHE_PADDING * RADIUS_GRANULARITY) / RADIUS_GRANULARITY;
+            if (cache.Valid && cache.Radius == paddedRadius && glm::length(center - cache.Center) + radius <= cache.Radius) {
+                cascade.StaticDirty = false; // Still inside the area the cache was rendered for
+            } else {
+                const float texel = 2.0f * paddedRadius / m_Resolution;
+                cache.Center = glm::vec3(std::floor(center.x / texel) * texel, std::floor(center.y / texel) * texel, center.z);
+                cache.Radius = paddedRadius;
+                cache.Valid = true;
+            }
+            center = cache.Center;
+            radius = cache.Radius;
+        } else {
+            const float texel = 2.0f * radius / m_Resolution;
+            center.x = std::floor(center.x / texel) * texel;
+            center.y = std::floor(center.y / texel) * texel;
+        }
+
+        // Light space looks down -z, so depth is -z
+        const glm::mat4 lightProjection = glm::ortho(center.x - radius, center.x + radius, center.y - radius, center.y + radius,
+                                                     -center.z - radius - CASTER_MARGIN, -center.z + radius);
+        cascade.ViewProjection = lightProjection * lightRotation;
+        cascade.TexelSize = 2.0f * radius / m_Resolution;
+        splitNear = splitFar;
+    }
+}
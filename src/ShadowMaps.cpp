@@ -0,0 +1,146 @@
+// src/ShadowMaps.cpp
+
+#include "ShadowMaps.h"
+#include "Shader.h"
+
+#include <iostream>
+#include <string>
+
+namespace {
+    const float POLYGON_OFFSET_FACTOR = 2.0f; // Slope-scaled bias against acne
+    const float POLYGON_OFFSET_UNITS = 4.0f;
+
+    GLuint CreateDepthArray(int resolution, int layers, bool compare) {
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24, resolution, resolution, layers, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+        // Linear filtering with comparison gives 2x2 PCF per tap for free
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, compare ? GL_LINEAR : GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, compare ? GL_LINEAR : GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+        const float border[4] = { 1.0f, 1.0f, 1.0f, 1.0f }; // Outside the map counts as lit
+        glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, border);
+        if (compare) {
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+        }
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        return texture;
+    }
+
+    // Depth-only framebuffer with layer 0 of 'texture' attached; 0 if incomplete
+    GLuint CreateLayerFramebuffer(GLuint texture) {
+        GLuint framebuffer = 0;
+        glGenFramebuffers(1, &framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, texture, 0, 0);
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+        GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        if (status != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "ERROR::SHADOWS::Incomplete shadow framebuffer (status 0x" << std::hex << status << std::dec << ")." << std::endl;
+            glDeleteFramebuffers(1, &framebuffer);
+            return 0;
+        }
+        return framebuffer;
+    }
+}
+
+ShadowMaps::ShadowMaps() {}
+
+ShadowMaps::~ShadowMaps() {
+    Shutdown();
+}
+
+bool ShadowMaps::Initialize(int resolution, int layers) {
+    Shutdown();
+    if (resolution <= 0 || layers <= 0) {
+        std::cerr << "ERROR::SHADOWS::Invalid shadow map size " << resolution << " x " << layers << " layer(s)." << std::endl;
+        return false;
+    }
+    m_DepthArray = CreateDepthArray(resolution, layers, true);
+    m_CacheArray = CreateDepthArray(resolution, layers, false);
+    m_Framebuffer = CreateLayerFramebuffer(m_DepthArray);
+    m_CacheFramebuffer = CreateLayerFramebuffer(m_CacheArray);
+    if (!m_Framebuffer || !m_CacheFramebuffer || glGetError() != GL_NO_ERROR) {
+        std::cerr << "ERROR::SHADOWS::Shadow map setup failed." << std::endl;
+        Shutdown();
+        return false;
+    }
+    m_Resolution = resolution;
+    m_Layers = layers;
+    std::cout << "INFO::SHADOWS::Created " << layers << " cascade(s) of " << resolution << "x" << resolution << " (plus static cache)." << std::endl;
+    return true;
+}
+
+void ShadowMaps::Shutdown() {
+    if (m_Framebuffer) glDeleteFramebuffers(1, &m_Framebuffer);
+    if (m_CacheFramebuffer) glDeleteFramebuffers(1, &m_CacheFramebuffer);
+    if (m_DepthArray) glDeleteTextures(1, &m_DepthArray);
+    if (m_CacheArray) glDeleteTextures(1, &m_CacheArray);
+    m_Framebuffer = 0;
+    m_CacheFramebuffer = 0;
+    m_DepthArray = 0;
+    m_CacheArray = 0;
+    m_Resolution = 0;
+    m_Layers = 0;
+}
+
+void ShadowMaps::BeginPass() {
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &m_SavedFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, m_SavedViewport);
+    glViewport(0, 0, m_Resolution, m_Resolution);
+    glEnable(GL_DEPTH_CLAMP); // Casters in front of the near plane still land in the map
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(POLYGON_OFFSET_FACTOR, POLYGON_OFFSET_UNITS);
+}
+
+void ShadowMaps::EndPass() {
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glDisable(GL_DEPTH_CLAMP);
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(m_SavedFramebuffer));
+    glViewport(m_SavedViewport[0], m_SavedViewport[1], m_SavedViewport[2], m_SavedViewport[3]);
+}
+
+void ShadowMaps::BeginLayer(int layer) {
+    glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_DepthArray, 0, layer);
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+void ShadowMaps::RestoreLayer(int layer) {
+    BlitLayer(m_CacheFramebuffer, m_Framebuffer, layer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer); // Draws continue into the restored layer
+}
+
+void ShadowMaps::StoreLayer(int layer) {
+    BlitLayer(m_Framebuffer, m_CacheFramebuffer, layer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+}
+
+void ShadowMaps::BlitLayer(GLuint source, GLuint destination, int layer) {
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, source);
+    glFramebufferTextureLayer(GL_READ_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, source == m_Framebuffer ? m_DepthArray : m_CacheArray, 0, layer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, destination);
+    glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, destination == m_Framebuffer ? m_DepthArray : m_CacheArray, 0, layer);
+    glBlitFramebuffer(0, 0, m_Resolution, m_Resolution, 0, 0, m_Resolution, m_Resolution, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+}
+
+void ShadowMaps::Bind(const Shader& shader, int cascadeCount, const glm::mat4* viewProjections, const glm::vec4& splits, const glm::vec4& texelSizes) const {
+    shader.SetInt("uShadowMap", TextureUnit); // Always set: sampler types may not share a unit
+    const bool active = cascadeCount > 0 && m_DepthArray != 0;
+    shader.SetInt("uCascadeCount", active ? cascadeCount : 0);
+    if (!active) return;
+
+    glActiveTexture(GL_TEXTURE0 + TextureUnit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_DepthArray);
+    glActiveTexture(GL_TEXTURE0);
+    for (int i = 0; i < cascadeCount; ++i) {
+        shader.SetMat4("uCascadeMatrices[" + std::to_string(i) + "]", viewProjections[i]);
+    }
+    shader.SetVec4("uCascadeSplits", splits);
+    shader.SetVec4("uCascadeTexelSizes", texelSizes);
+}
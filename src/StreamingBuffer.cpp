@@ -0,0 +1,154 @@
+// src/StreamingBuffer.cpp
+
+#include "StreamingBuffer.h"
+#include "GLExtensions.h"
+
+#include <iostream>
+
+namespace {
+    const GLuint64 FENCE_TIMEOUT_NS = 1000000000ull; // Re-poll once a second rather than hang forever
+}
+
+StreamingBuffer::StreamingBuffer() {}
+
+StreamingBuffer::~StreamingBuffer() {
+    Shutdown();
+}
+
+bool StreamingBuffer::Initialize(GLenum target, GLsizeiptr bytesPerFrame, int frameCount) {
+    if (m_Buffer != 0) {
+        std::cerr << "WARN::STREAM::Buffer already initialized." << std::endl;
+        return true;
+    }
+    if (bytesPerFrame <= 0 || frameCount < 1) {
+        std::cerr << "ERROR::STREAM::Invalid size (" << bytesPerFrame << " bytes x " << frameCount << " frames)." << std::endl;
+        return false;
+    }
+
+    m_Target = target;
+    m_BytesPerFrame = bytesPerFrame;
+    m_FrameCount = frameCount;
+    m_Fences.assign(frameCount, nullptr);
+    const GLsizeiptr totalSize = bytesPerFrame * frameCount;
+
+    glGenBuffers(1, &m_Buffer);
+    glBindBuffer(m_Target, m_Buffer);
+    if (GLExtensions::HasBufferStorage()) {
+        // Map once for the lifetime of the buffer; coherent so no explicit flushes are needed
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GLExtensions::BufferStorage(m_Target, totalSize, nullptr, flags);
+        m_PersistentData = static_cast<unsigned char*>(glMapBufferRange(m_Target, 0, totalSize, flags));
+        if (!m_PersistentData) {
+            std::cerr << "WARN::STREAM::Persistent mapping failed, falling back to per-allocation mapping." << std::endl;
+            // Immutable storage can't be respecified, so start over with a mutable buffer
+            glBindBuffer(m_Target, 0);
+            glDeleteBuffers(1, &m_Buffer);
+            glGenBuffers(1, &m_Buffer);
+            glBindBuffer(m_Target, m_Buffer);
+            glBufferData(m_Target, totalSize, nullptr, GL_STREAM_DRAW);
+        }
+    } else {
+        glBufferData(m_Target, totalSize, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(m_Target, 0);
+
+    std::cout << "INFO::STREAM::Created streaming buffer (ID: " << m_Buffer << ", " << frameCount << " x "
+              << bytesPerFrame << " bytes, " << (IsPersistent() ? "persistent" : "unsynchronized map") << ")" << std::endl;
+    return true;
+}
+
+void StreamingBuffer::Shutdown() {
+    for (GLsync& fence : m_Fences) {
+        if (fence) { glDeleteSync(fence); fence = nullptr; }
+    }
+    m_Fences.clear();
+    if (m_Buffer != 0) {
+        if (m_PersistentData) {
+            glBindBuffer(m_Target, m_Buffer);
+            glUnmapBuffer(m_Target);
+            glBindBuffer(m_Target, 0);
+            m_PersistentData = nullptr;
+        }
+        glDeleteBuffers(1, &m_Buffer);
+        m_Buffer = 0;
+        std::cout << "INFO::STREAM::Deleted streaming buffer (CPU waited on GPU for " << m_WaitedFrames << " frames)." << std::endl;
+    }
+    m_InFrame = false;
+}
+
+void StreamingBuffer::BeginFrame() {
+    if (m_Buffer == 0 || m_InFrame) return;
+
+    GLsync& fence = m_Fences[m_FrameIndex];
+    if (fence) {
+        // Cheap poll first; only count a wait when the GPU is genuinely still reading this region
+        GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (result == GL_TIMEOUT_EXPIRED) {
+            ++m_WaitedFrames;
+            do {
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NS);
+            } while (result == GL_TIMEOUT_EXPIRED);
+        }
+        if (result == GL_WAIT_FAILED) {
+            std::cerr << "ERROR::STREAM::glClientWaitSync failed." << std::endl;
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    m_FrameHead = 0;
+    m_InFrame = true;
+}
+
+StreamAllocation StreamingBuffer::Allocate(GLsizeiptr size, GLsizeiptr alignment) {
+    StreamAllocation allocation;
+    if (!m_InFrame || size <= 0) return allocation;
+
+    if (alignment < 1) alignment = 1;
+    GLsizeiptr start = (m_FrameHead + alignment - 1) / alignment * alignment;
+    if (start + size > m_BytesPerFrame) {
+        if (!m_OverflowReported) {
+            std::cerr << "WARN::STREAM::Frame region exhausted (" << start + size << " > " << m_BytesPerFrame << " bytes)." << std::endl;
+            m_OverflowReported = true;
+        }
+        return allocation;
+    }
+
+    const GLintptr offset = static_cast<GLintptr>(m_FrameIndex) * m_BytesPerFrame + start;
+    if (m_PersistentData) {
+        allocation.Data = m_PersistentData + offset;
+    } else {
+        // The fence already guarantees the GPU is done with this range, so skip the driver's sync
+        glBindBuffer(m_Target, m_Buffer);
+        allocation.Data = glMapBufferRange(m_Target, offset, size,
+                                           GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+        glBindBuffer(m_Target, 0);
+        if (!allocation.Data) {
+            std::cerr << "ERROR::STREAM::glMapBufferRange failed." << std::endl;
+            return allocation;
+        }
+    }
+    allocation.Offset = offset;
+    allocation.Size = size;
+    m_FrameHead = start + size;
+    return allocation;
+}
+
+void StreamingBuffer::Commit(const StreamAllocation& allocation) {
+    if (!allocation.IsValid() || m_PersistentData) return;
+    // GL 3.3 can't draw from a mapped buffer; unmapping also flushes the written range
+    glBindBuffer(m_Target, m_Buffer);
+    glUnmapBuffer(m_Target);
+    glBindBuffer(m_Target, 0);
+}
+
+void StreamingBuffer::EndFrame() {
+    if (m_Buffer == 0 || !m_InFrame) return;
+    m_Fences[m_FrameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_FrameIndex = (m_FrameIndex + 1) % m_FrameCount;
+    m_InFrame = false;
+}
+
+void StreamingBuffer::Bind() const {
+    glBindBuffer(m_Target, m_Buffer);
+}
@@ -0,0 +1,54 @@
+// src/SystemScheduler.cpp
+
+#include "SystemScheduler.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+
+#include <chrono>
+
+bool SystemScheduler::Conflicts(const System& a, const System& b) {
+    return (a.Writes & (b.Reads | b.Writes)) != 0 || (b.Writes & a.Reads) != 0;
+}
+
+void SystemScheduler::Add(System system) {
+    size_t phase = 0;
+    for (size_t p = 0; p < m_Phases.size(); ++p) {
+        for (uint32_t other : m_Phases[p]) {
+            if (Conflicts(system, m_Systems[other])) phase = p + 1;
+        }
+    }
+    if (phase == m_Phases.size()) m_Phases.emplace_back();
+    m_Phases[phase].push_back(static_cast<uint32_t>(m_Systems.size()));
+    m_Systems.push_back(std::move(system));
+    m_Milliseconds.push_back(0.0);
+}
+
+void SystemScheduler::Clear() {
+    m_Systems.clear();
+    m_Phases.clear();
+    m_Milliseconds.clear();
+}
+
+void SystemScheduler::RunSystem(uint32_t index, World& world, float deltaTime, JobSystem* jobs) {
+    PROFILE_SCOPE(m_Systems[index].Name);
+    auto start = std::chrono::steady_clock::now();
+    m_Systems[index].Run(world, deltaTime, jobs);
+    m_Milliseconds[index] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void SystemScheduler::Run(World& world, float deltaTime, JobSystem* jobs) {
+    for (const std::vector<uint32_t>& phase : m_Phases) {
+        if (!jobs || phase.size() == 1) {
+            for (uint32_t index : phase) RunSystem(index, world, deltaTime, phase.size() == 1 ? jobs : nullptr);
+            continue;
+        }
+        // Worker systems go to the pool, main-thread ones run here meanwhile; nobody gets 'jobs' to avoid nesting
+        for (uint32_t index : phase) {
+            if (!m_Systems[index].MainThreadOnly) jobs->Submit([this, index, &world, deltaTime]() { RunSystem(index, world, deltaTime, nullptr); });
+        }
+        for (uint32_t index : phase) {
+            if (m_Systems[index].MainThreadOnly) RunSystem(index, world, deltaTime, nullptr);
+        }
+        jobs->Wait();
+    }
+}
@@ -1,5 +1,6 @@
 #include "Texture.h"
 #include "stb_image.h" // Use stb_image for loading
+#include "Profiler.h"
 #include <iostream>
 
 Texture::Texture() : m_TextureID(0), m_Width(0), m_Height(0), m_Channels(0) {}
@@ -12,6 +13,7 @@ Texture::~Texture() {
 }
 
 bool Texture::Load(const std::string& filePath) {
+    PROFILE_SCOPE("Texture::Load");
     // Load image data using stb_image
     stbi_set_flip_vertically_on_load(true); // Flip UVs for OpenGL convention
     unsigned char* data = stbi_load(filePath.c_str(), &m_Width, &m_Height, &m_Channels, 0);
@@ -65,6 +67,21 @@ bool Texture::Load(const std::string& filePath) {
     return true;
 }
 
+bool Texture::CreateSolidColor(unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+    if (m_TextureID != 0) glDeleteTextures(1, &m_TextureID);
+    const unsigned char pixel[4] = { r, g, b, a };
+    m_Width = 1;
+    m_Height = 1;
+    m_Channels = 4;
+    glGenTextures(1, &m_TextureID);
+    glBindTexture(GL_TEXTURE_2D, m_TextureID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return m_TextureID != 0;
+}
+
 void Texture::Bind(unsigned int unit) const {
     if (m_TextureID != 0) {
         // Ensure unit is within reasonable bounds (e.g., 0-31)
@@ -0,0 +1,50 @@
+// src/TextureArray.cpp
+
+#include "TextureArray.h"
+
+#include <iostream>
+
+TextureArray::TextureArray() {}
+
+TextureArray::~TextureArray() {
+    if (m_TextureID != 0) glDeleteTextures(1, &m_TextureID);
+}
+
+bool TextureArray::Create(int width, int height, int layers, const uint8_t* pixels, bool repeat) {
+    if (m_TextureID != 0) glDeleteTextures(1, &m_TextureID);
+    m_TextureID = 0;
+    GLint maxLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    if (width <= 0 || height <= 0 || layers <= 0 || layers > maxLayers || !pixels) {
+        std::cerr << "ERROR::TEXTURE_ARRAY::Invalid array " << width << "x" << height << " x " << layers << " layer(s) (max " << maxLayers << ")." << std::endl;
+        return false;
+    }
+
+    glGenTextures(1, &m_TextureID);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_TextureID);
+    const GLint wrap = repeat ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, wrap);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, wrap);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY); // Mips filter per layer, so layers never bleed into each other
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    if (glGetError() != GL_NO_ERROR) {
+        std::cerr << "ERROR::TEXTURE_ARRAY::Upload of " << width << "x" << height << " x " << layers << " layer(s) failed." << std::endl;
+        glDeleteTextures(1, &m_TextureID);
+        m_TextureID = 0;
+        return false;
+    }
+    m_Width = width;
+    m_Height = height;
+    m_Layers = layers;
+    return true;
+}
+
+void TextureArray::Bind(unsigned int unit) const {
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_TextureID);
+}
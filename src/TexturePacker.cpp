@@ -0,0 +1,150 @@
+// src/TexturePacker.cpp
+
+#include "TexturePacker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <utility>
+
+// ImGui compiles its copy of stb_rect_pack as static functions in imgui_draw.cpp; this one stays
+// private to this file the same way
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function" // stbrp_setup_heuristic
+#endif
+#include "imstb_rectpack.h"
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+    const int BYTES_PER_TEXEL = 4;
+
+    int NextPowerOfTwo(int value) {
+        int result = 1;
+        while (result < value) result *= 2;
+        return result;
+    }
+
+    // Packs as many of 'rects' as fit into one size x size page; returns true if all did.
+    bool PackPage(std::vector<stbrp_rect>& rects, int size) {
+        std::vector<stbrp_node> nodes(static_cast<size_t>(size));
+        stbrp_context context;
+        stbrp_init_target(&context, size, size, nodes.data(), static_cast<int>(nodes.size()));
+        return stbrp_pack_rects(&context, rects.data(), static_cast<int>(rects.size())) == 1;
+    }
+
+    // Copies 'image' into 'layer' at (x, y) inside a border of 'padding' texels, the border
+    // repeating the image's edge texels.
+    void BlitPadded(const TexturePacker::Image& image, uint8_t* layer, int layerWidth, int x, int y, int padding) {
+        for (int row = -padding; row < image.Height + padding; ++row) {
+            const int sourceRow = std::clamp(row, 0, image.Height - 1);
+            uint8_t* destination = layer + (static_cast<size_t>(y + padding + row) * layerWidth + x) * BYTES_PER_TEXEL;
+            for (int column = -padding; column < image.Width + padding; ++column) {
+                const int sourceColumn = std::clamp(column, 0, image.Width - 1);
+                const uint8_t* source = image.Pixels.data() + (static_cast<size_t>(sourceRow) * image.Width + sourceColumn) * BYTES_PER_TEXEL;
+                std::copy(source, source + BYTES_PER_TEXEL, destination + static_cast<size_t>(column + padding) * BYTES_PER_TEXEL);
+            }
+        }
+    }
+}
+
+namespace TexturePacker {
+
+    bool Pack(const std::vector<Image>& images, const Settings& settings, Result& out) {
+        out.Groups.clear();
+        out.Placements.assign(images.size(), Placement{});
+        for (size_t i = 0; i < images.size(); ++i) {
+            const Image& image = images[i];
+            if (image.Width <= 0 || image.Height <= 0 || image.Pixels.size() != static_cast<size_t>(image.Width) * image.Height * BYTES_PER_TEXEL) {
+                std::cerr << "ERROR::TEXTURE_PACKER::Image " << i << " has no pixels or the wrong amount for " << image.Width << "x" << image.Height << "." << std::endl;
+                return false;
+            }
+        }
+
+        // Same-size textures become layers of one array; ordered map keeps the layout deterministic
+        std::map<std::pair<int, int>, std::vector<size_t>> bySize;
+        for (size_t i = 0; i < images.size(); ++i) bySize[{ images[i].Width, images[i].Height }].push_back(i);
+
+        const int padding = std::max(settings.Padding, 0);
+        std::vector<stbrp_rect> odd;
+        int64_t oddArea = 0;
+        int oddMaxSide = 0;
+        for (const auto& size : bySize) {
+            const int width = size.first.first;
+            const int height = size.first.second;
+            const std::vector<size_t>& members = size.second;
+            const bool fitsAtlas = width + 2 * padding <= settings.MaxAtlasSize && height + 2 * padding <= settings.MaxAtlasSize;
+            if (fitsAtlas && static_cast<int>(members.size()) < settings.MinArrayLayers) {
+                for (size_t index : members) {
+                    stbrp_rect rect = {};
+                    rect.id = static_cast<int>(index);
+                    rect.w = width + 2 * padding;
+                    rect.h = height + 2 * padding;
+                    odd.push_back(rect);
+                    oddArea += static_cast<int64_t>(rect.w) * rect.h;
+                    oddMaxSide = std::max({ oddMaxSide, rect.w, rect.h });
+                }
+                continue;
+            }
+
+            Group group;
+            group.Width = width;
+            group.Height = height;
+            group.Layers = static_cast<int>(members.size());
+            group.Pixels.reserve(static_cast<size_t>(width) * height * BYTES_PER_TEXEL * members.size());
+            for (size_t index : members) {
+                out.Placements[index].Group = static_cast<int>(out.Groups.size());
+                out.Placements[index].Layer = static_cast<int>(group.Pixels.size() / (static_cast<size_t>(width) * height * BYTES_PER_TEXEL));
+                group.Pixels.insert(group.Pixels.end(), images[index].Pixels.begin(), images[index].Pixels.end());
+            }
+            out.Groups.push_back(std::move(group));
+        }
+        if (odd.empty()) return true;
+
+        // Smallest power-of-two page that holds every odd texture, up to the limit; past it, more pages
+        int pageSize = NextPowerOfTwo(std::max(oddMaxSide, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(oddArea))))));
+        pageSize = std::min(pageSize, settings.MaxAtlasSize);
+        std::vector<stbrp_rect> page = odd;
+        while (!PackPage(page, pageSize) && pageSize < settings.MaxAtlasSize) {
+            pageSize = std::min(pageSize * 2, settings.MaxAtlasSize);
+            page = odd;
+        }
+
+        Group atlas;
+        atlas.Width = pageSize;
+        atlas.Height = pageSize;
+        atlas.Atlas = true;
+        const int atlasIndex = static_cast<int>(out.Groups.size());
+        const size_t pageBytes = static_cast<size_t>(pageSize) * pageSize * BYTES_PER_TEXEL;
+        const float scale = 1.0f / static_cast<float>(pageSize);
+        for (;;) {
+            atlas.Pixels.resize(pageBytes * (atlas.Layers + 1), 0);
+            uint8_t* layer = atlas.Pixels.data() + pageBytes * atlas.Layers;
+            std::vector<stbrp_rect> remaining;
+            for (const stbrp_rect& rect : page) {
+                if (!rect.was_packed) {
+                    remaining.push_back(rect);
+                    continue;
+                }
+                const Image& image = images[static_cast<size_t>(rect.id)];
+                BlitPadded(image, layer, pageSize, rect.x, rect.y, padding);
+                Placement& placement = out.Placements[static_cast<size_t>(rect.id)];
+                placement.Group = atlasIndex;
+                placement.Layer = atlas.Layers;
+                placement.UVTransform = glm::vec4((rect.x + padding) * scale, (rect.y + padding) * scale, image.Width * scale, image.Height * scale);
+            }
+            atlas.Layers++;
+            if (remaining.empty()) break;
+            page = std::move(remaining);
+            PackPage(page, pageSize); // Every odd rect fits an empty page, so each page takes at least one
+        }
+        out.Groups.push_back(std::move(atlas));
+        return true;
+    }
+
+}
@@ -0,0 +1,265 @@
+// src/TransformSystem.cpp
+
+#include "TransformSystem.h"
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+
+namespace {
+    const uint32_t NO_INDEX = ~0u;
+    const int32_t DEPTH_UNKNOWN = -2;
+    const int32_t DEPTH_DEAD = -3;
+    const size_t PARALLEL_CHUNK = 1024;
+
+    // Moves values[i] to newIndex[i], dropping entries whose new index is NO_INDEX
+    template <typename T>
+    void Permute(std::vector<T>& values, const std::vector<uint32_t>& newIndex, size_t newCount) {
+        std::vector<T> reordered(newCount);
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (newIndex[i] != NO_INDEX) reordered[newIndex[i]] = values[i];
+        }
+        values.swap(reordered);
+    }
+}
+
+// --- Hierarchy ---
+
+uint32_t TransformSystem::IndexOf(TransformHandle handle) const {
+    return handle < m_HandleToIndex.size() ? m_HandleToIndex[handle] : NO_INDEX;
+}
+
+bool TransformSystem::IsValid(TransformHandle handle) const {
+    uint32_t index = IndexOf(handle);
+    return index != NO_INDEX && m_Alive[index];
+}
+
+TransformHandle TransformSystem::Create(TransformHandle parent) {
+    uint32_t parentIndex = NO_INDEX;
+    if (parent != InvalidTransform) {
+        if (IsValid(parent)) parentIndex = IndexOf(parent);
+        else std::cerr << "WARN::TRANSFORMS::Create with invalid parent " << parent << ", creating a root." << std::endl;
+    }
+
+    TransformHandle handle;
+    if (!m_FreeHandles.empty()) {
+        handle = m_FreeHandles.back();
+        m_FreeHandles.pop_back();
+    } else {
+        handle = static_cast<TransformHandle>(m_HandleToIndex.size());
+        m_HandleToIndex.push_back(NO_INDEX);
+    }
+
+    m_HandleToIndex[handle] = static_cast<uint32_t>(m_Parents.size());
+    m_LocalPositions.push_back(glm::vec3(0.0f));
+    m_LocalRotations.push_back(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+    m_LocalScales.push_back(glm::vec3(1.0f));
+    m_WorldMatrices.push_back(glm::mat4(1.0f));
+    m_Parents.push_back(parentIndex);
+    m_Dirty.push_back(1);
+    m_Alive.push_back(1);
+    m_IndexToHandle.push_back(handle);
+    m_NeedsRebuild = true; // Appended out of depth order
+    return handle;
+}
+
+void TransformSystem::Destroy(TransformHandle handle) {
+    if (!IsValid(handle)) return;
+    m_Alive[IndexOf(handle)] = 0; // Descendants are found and released by the next Rebuild
+    m_NeedsRebuild = true;
+}
+
+bool TransformSystem::SetParent(TransformHandle handle, TransformHandle parent) {
+    if (!IsValid(handle)) return false;
+    uint32_t index = IndexOf(handle);
+    uint32_t parentIndex = NO_INDEX;
+    if (parent != InvalidTransform) {
+        if (!IsValid(parent)) return false;
+        parentIndex = IndexOf(parent);
+        for (uint32_t ancestor = parentIndex; ancestor != NO_INDEX; ancestor = m_Parents[ancestor]) {
+            if (ancestor == index) {
+                std::cerr << "WARN::TRANSFORMS::SetParent would create a cycle, ignored." << std::endl;
+                return false;
+            }
+        }
+    }
+    if (m_Parents[index] == parentIndex) return true;
+    m_Parents[index] = parentIndex;
+    m_Dirty[index] = 1;
+    m_NeedsRebuild = true;
+    return true;
+}
+
+TransformHandle TransformSystem::GetParent(TransformHandle handle) const {
+    if (!IsValid(handle)) return InvalidTransform;
+    uint32_t parentIndex = m_Parents[IndexOf(handle)];
+    return parentIndex == NO_INDEX ? InvalidTransform : m_IndexToHandle[parentIndex];
+}
+
+void TransformSystem::Clear() {
+    *this = TransformSystem();
+}
+
+void TransformSystem::Rebuild() {
+    const size_t count = m_Parents.size();
+
+    // Depth of every node (memoized walk up the parent chain); descendants of destroyed nodes die too
+    std::vector<int32_t> depth(count, DEPTH_UNKNOWN);
+    std::vector<uint32_t> chain;
+    int32_t maxDepth = -1;
+    for (size_t i = 0; i < count; ++i) {
+        if (depth[i] != DEPTH_UNKNOWN) continue;
+        chain.clear();
+        uint32_t node = static_cast<uint32_t>(i);
+        while (node != NO_INDEX && depth[node] == DEPTH_UNKNOWN) {
+            chain.push_back(node);
+            node = m_Parents[node];
+        }
+        int32_t current = (node == NO_INDEX) ? -1 : depth[node];
+        for (size_t c = chain.size(); c-- > 0;) {
+            uint32_t n = chain[c];
+            current = (current == DEPTH_DEAD || !m_Alive[n]) ? DEPTH_DEAD : current + 1;
+            depth[n] = current;
+            if (current > maxDepth) maxDepth = current;
+        }
+    }
+
+    // Counting sort by depth (stable, so siblings keep their creation order)
+    const size_t levels = static_cast<size_t>(maxDepth + 1);
+    m_LevelOffsets.assign(levels + 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        if (depth[i] >= 0) m_LevelOffsets[depth[i] + 1]++;
+    }
+    for (size_t level = 0; level < levels; ++level) m_LevelOffsets[level + 1] += m_LevelOffsets[level];
+    std::vector<uint32_t> cursor(m_LevelOffsets.begin(), m_LevelOffsets.end() - 1);
+    std::vector<uint32_t> newIndex(count, NO_INDEX);
+    for (size_t i = 0; i < count; ++i) {
+        if (depth[i] >= 0) newIndex[i] = cursor[depth[i]]++;
+        else {
+            m_HandleToIndex[m_IndexToHandle[i]] = NO_INDEX;
+            m_FreeHandles.push_back(m_IndexToHandle[i]);
+        }
+    }
+    const size_t aliveCount = levels > 0 ? m_LevelOffsets[levels] : 0;
+
+    std::vector<uint32_t> parents(aliveCount);
+    for (size_t i = 0; i < count; ++i) {
+        if (newIndex[i] == NO_INDEX) continue;
+        parents[newIndex[i]] = m_Parents[i] == NO_INDEX ? NO_INDEX : newIndex[m_Parents[i]];
+        m_HandleToIndex[m_IndexToHandle[i]] = newIndex[i];
+    }
+    m_Parents.swap(parents);
+    Permute(m_LocalPositions, newIndex, aliveCount);
+    Permute(m_LocalRotations, newIndex, aliveCount);
+    Permute(m_LocalScales, newIndex, aliveCount);
+    Permute(m_WorldMatrices, newIndex, aliveCount);
+    Permute(m_Dirty, newIndex, aliveCount);
+    Permute(m_Alive, newIndex, aliveCount);
+    Permute(m_IndexToHandle, newIndex, aliveCount);
+    if (levels == 0) m_LevelOffsets.clear();
+}
+
+// --- Local transforms ---
+
+void TransformSystem::SetLocalPosition(TransformHandle handle, const glm::vec3& position) {
+    if (!IsValid(handle)) return;
+    uint32_t index = IndexOf(handle);
+    m_LocalPositions[index] = position;
+    m_Dirty[index] = 1;
+}
+
+void TransformSystem::SetLocalRotation(TransformHandle handle, const glm::quat& rotation) {
+    if (!IsValid(handle)) return;
+    uint32_t index = IndexOf(handle);
+    m_LocalRotations[index] = rotation;
+    m_Dirty[index] = 1;
+}
+
+void TransformSystem::SetLocalScale(TransformHandle handle, const glm::vec3& scale) {
+    if (!IsValid(handle)) return;
+    uint32_t index = IndexOf(handle);
+    m_LocalScales[index] = scale;
+    m_Dirty[index] = 1;
+}
+
+void TransformSystem::SetLocal(TransformHandle handle, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale) {
+    if (!IsValid(handle)) return;
+    uint32_t index = IndexOf(handle);
+    m_LocalPositions[index] = position;
+    m_LocalRotations[index] = rotation;
+    m_LocalScales[index] = scale;
+    m_Dirty[index] = 1;
+}
+
+glm::vec3 TransformSystem::GetLocalPosition(TransformHandle handle) const {
+    return IsValid(handle) ? m_LocalPositions[IndexOf(handle)] : glm::vec3(0.0f);
+}
+
+glm::quat TransformSystem::GetLocalRotation(TransformHandle handle) const {
+    return IsValid(handle) ? m_LocalRotations[IndexOf(handle)] : glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+}
+
+glm::vec3 TransformSystem::GetLocalScale(TransformHandle handle) const {
+    return IsValid(handle) ? m_LocalScales[IndexOf(handle)] : glm::vec3(1.0f);
+}
+
+const glm::mat4& TransformSystem::GetWorldMatrix(TransformHandle handle) const {
+    static const glm::mat4 identity(1.0f);
+    return IsValid(handle) ? m_WorldMatrices[IndexOf(handle)] : identity;
+}
+
+// --- Update ---
+
+uint32_t TransformSystem::UpdateRange(size_t begin, size_t end) {
+    uint32_t recomputed = 0;
+    for (size_t i = begin; i < end; ++i) {
+        const uint32_t parent = m_Parents[i];
+        // Parents live on the previous level, which is already final for this frame
+        if (!m_Dirty[i] && (parent == NO_INDEX || !m_Dirty[parent])) continue;
+        m_Dirty[i] = 1; // Lets the next level see that this subtree moved
+
+        glm::mat4 local = glm::mat4_cast(m_LocalRotations[i]);
+        const glm::vec3& scale = m_LocalScales[i];
+        local[0] *= scale.x;
+        local[1] *= scale.y;
+        local[2] *= scale.z;
+        local[3] = glm::vec4(m_LocalPositions[i], 1.0f);
+        m_WorldMatrices[i] = (parent == NO_INDEX) ? local : m_WorldMatrices[parent] * local;
+        ++recomputed;
+    }
+    return recomputed;
+}
+
+void TransformSystem::Update(JobSystem* jobs) {
+    auto start = std::chrono::steady_clock::now();
+    m_LastStats = Stats{};
+    if (m_NeedsRebuild) {
+        Rebuild();
+        m_NeedsRebuild = false;
+        m_LastStats.Resorted = true;
+    }
+
+    const size_t levels = m_LevelOffsets.empty() ? 0 : m_LevelOffsets.size() - 1;
+    uint32_t recomputed = 0;
+    for (size_t level = 0; level < levels; ++level) {
+        const size_t begin = m_LevelOffsets[level], end = m_LevelOffsets[level + 1];
+        if (jobs && end - begin >= ParallelThreshold) {
+            // Nodes on one level never depend on each other
+            std::atomic<uint32_t> levelRecomputed{ 0 };
+            jobs->ParallelFor(end - begin, PARALLEL_CHUNK, [&](size_t first, size_t last, unsigned int) {
+                levelRecomputed += UpdateRange(begin + first, begin + last);
+            });
+            recomputed += levelRecomputed.load();
+        } else {
+            recomputed += UpdateRange(begin, end);
+        }
+    }
+    std::fill(m_Dirty.begin(), m_Dirty.end(), 0);
+
+    m_LastStats.Recomputed = recomputed;
+    m_LastStats.Skipped = static_cast<uint32_t>(Size()) - recomputed;
+    m_LastStats.Levels = static_cast<uint32_t>(levels);
+    m_LastStats.Milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
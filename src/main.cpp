@@ -2,10 +2,13 @@
 #include <iostream> // For initial error message
 
 int main(int argc, char* argv[]) {
+    AppConfig config;
+    if (!AppConfig::Parse(argc, argv, config)) return 1;
+
     Application app;
 
     try {
-        if (app.Initialize()) {
+        if (app.Initialize(config)) {
             app.Run(); // Contains the main loop
         } else {
              std::cerr << "FATAL: Application initialization failed!" << std::endl;